@@ -1109,6 +1109,10 @@ DECL_EXP bool PlugIn_GSHHS_CrossesLand(double lat1, double lon1, double lat2,
                                        double lon2) {
   return true;
 }
+DECL_EXP std::vector<bool> PlugIn_GSHHS_CrossesLandBatch(
+    const std::vector<PI_GSHHS_Segment> &segments) {
+  return std::vector<bool>(segments.size(), true);
+}
 
 DECL_EXP void PlugInPlaySound(wxString &sound_file) {};
 
@@ -43,6 +43,7 @@
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <sstream>
 
 #include "wx/wxprec.h"
 
@@ -141,6 +142,10 @@ Commands:
   print-hostname:
      Print official hostname for generate-key and store-key.
 
+  pipeline-stats [host:port]
+     Print navigation data latency and throughput statistics from a
+     running opencpn's REST server, by default localhost:8000.
+
 )""";
 
 static const char* const DOWNLOAD_REPO_PROTO =
@@ -359,6 +364,18 @@ public:
     std::cout << hostname << "\n";
   }
 
+  void pipeline_stats(const std::string& endpoint) {
+    std::string url = "http://" + endpoint + "/api/pipeline-stats";
+    std::stringstream ss;
+    Downloader downloader(url);
+    if (!downloader.download(&ss)) {
+      std::cerr << "Cannot get " << url << ": " << downloader.last_error()
+                << "\n";
+      exit(1);
+    }
+    std::cout << ss.str();
+  }
+
   void check_param_count(const wxCmdLineParser& parser, size_t count) {
     if (parser.GetParamCount() < count) {
       std::cerr << USAGE << "\n";
@@ -446,6 +463,11 @@ public:
     } else if (command == "print-hostname") {
       check_param_count(parser, 0);
       print_hostname();
+    } else if (command == "pipeline-stats") {
+      check_param_count(parser, 1);
+      pipeline_stats(parser.GetParamCount() > 1
+                         ? parser.GetParam(1).ToStdString()
+                         : std::string("localhost:8000"));
     } else {
       std::cerr << USAGE << "\n";
       exit(2);
@@ -0,0 +1,441 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Headless benchmark of the navigation data pipeline.
+ *
+ * Recorded (binary capture, see navmsg_capture.h) or synthetic NMEA 0183,
+ * NMEA 2000 and Signal K streams are fed as fast as possible through
+ * drivers derived from the real driver base classes into NavMsgBus, and
+ * on to CommBridge and AisDecoder. Throughput, CPU time, allocations and
+ * latency per stage are reported as json on stdout.
+ */
+
+#include "wx/wxprec.h"
+
+#ifndef WX_PRECOMP
+#include "wx/wx.h"
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/cmdline.h>
+#include <wx/fileconf.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+
+#include "rapidjson/document.h"
+
+#include "model/ais_decoder.h"
+#include "model/base_platform.h"
+#include "model/comm_bridge.h"
+#include "model/comm_drv_n0183.h"
+#include "model/comm_drv_n2k.h"
+#include "model/comm_drv_registry.h"
+#include "model/comm_drv_signalk.h"
+#include "model/comm_navmsg_bus.h"
+#include "model/config_vars.h"
+#include "model/conn_params.h"
+#include "model/navmsg_capture.h"
+#include "model/pipeline_stats.h"
+#include "model/route.h"
+#include "model/routeman.h"
+#include "model/select.h"
+
+void* g_pi_manager = reinterpret_cast<void*>(1L);
+
+// Count heap allocations made by the whole process.
+static std::atomic<uint64_t> g_allocations(0);
+
+void* operator new(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = std::malloc(size ? size : 1);
+  if (!p) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+static const char* USAGE = R"""(
+Usage: opencpn-bench [options] [capture file]
+
+Feed navigation messages through the driver -> NavMsgBus -> CommBridge /
+AisDecoder pipeline as fast as possible and print statistics as json.
+Without a capture file, synthetic data is used.
+
+Options:
+  -n, --count <n>      Number of messages, default 100000
+  -b, --batch <n>      Messages fed between event loop runs, default 64
+  -B, --bus <list>     Synthetic buses: n0183,n2000,signalk (default all)
+)""";
+
+/** NMEA 0183 driver using the real sentence validation and dispatch. */
+class BenchN0183Driver : public CommDriverN0183 {
+public:
+  BenchN0183Driver(const std::string& iface, DriverListener& listener)
+      : CommDriverN0183(NavAddr::Bus::N0183, iface), m_listener(listener) {}
+
+  bool SendMessage(std::shared_ptr<const NavMsg> msg,
+                   std::shared_ptr<const NavAddr> addr) override {
+    return false;
+  }
+  const ConnectionParams& GetParams() const override { return m_params; }
+
+  void Receive(const std::string& line) {
+    SendToListener(line, m_listener, m_params);
+  }
+
+private:
+  DriverListener& m_listener;
+  ConnectionParams m_params;
+};
+
+/** NMEA 2000 driver building messages like CommDriverN2KNet. */
+class BenchN2kDriver : public CommDriverN2K {
+public:
+  BenchN2kDriver(const std::string& iface, DriverListener& listener)
+      : CommDriverN2K(iface), m_listener(listener) {}
+
+  bool SendMessage(std::shared_ptr<const NavMsg> msg,
+                   std::shared_ptr<const NavAddr> addr) override {
+    return false;
+  }
+
+  void Receive(uint64_t pgn, const std::vector<unsigned char>& payload,
+               uint64_t name) {
+    auto msg = std::make_shared<const Nmea2000Msg>(
+        pgn, payload, GetAddress(N2kName(name)));
+    m_listener.Notify(std::move(msg));
+  }
+
+private:
+  DriverListener& m_listener;
+};
+
+/** Signal K driver extracting contexts like CommDriverSignalKNet. */
+class BenchSignalKDriver : public CommDriverSignalK {
+public:
+  BenchSignalKDriver(const std::string& iface, DriverListener& listener)
+      : CommDriverSignalK(iface), m_listener(listener) {}
+
+  void Receive(const std::string& json) {
+    rapidjson::Document root;
+    root.Parse(json);
+    if (root.HasParseError() || !root.IsObject()) return;
+    if (root.HasMember("self") && root["self"].IsString())
+      m_self = root["self"].GetString();
+    if (root.HasMember("context") && root["context"].IsString())
+      m_context = root["context"].GetString();
+    auto msg = std::make_shared<const SignalkMsg>(m_self, m_context,
+                                                  json + "\r\n", iface);
+    m_listener.Notify(std::move(msg));
+  }
+
+private:
+  DriverListener& m_listener;
+  std::string m_self;
+  std::string m_context;
+};
+
+/** Return sentence body wrapped as $body*hh with a correct checksum. */
+static std::string WithChecksum(char start, const std::string& body) {
+  unsigned char cs = 0;
+  for (char c : body) cs ^= static_cast<unsigned char>(c);
+  std::ostringstream ss;
+  ss << start << body << '*' << std::uppercase << std::hex
+     << std::setfill('0') << std::setw(2) << static_cast<int>(cs);
+  return ss.str();
+}
+
+static void PutLe(std::vector<unsigned char>& v, uint64_t value, int bytes) {
+  for (int i = 0; i < bytes; i++) v.push_back((value >> (8 * i)) & 0xff);
+}
+
+/** Wrap PGN data in the payload format used by the N2000 drivers. */
+static std::vector<unsigned char> N2kPayload(
+    uint32_t pgn, unsigned char source,
+    const std::vector<unsigned char>& data) {
+  std::vector<unsigned char> v = {0x93, 0x13, 2};
+  PutLe(v, pgn, 3);
+  v.push_back(255);  // destination
+  v.push_back(source);
+  PutLe(v, 0, 4);  // time
+  v.push_back(static_cast<unsigned char>(data.size()));
+  v.insert(v.end(), data.begin(), data.end());
+  v.push_back(0x55);  // crc, unchecked
+  return v;
+}
+
+/** One message of a synthetic or recorded stream. */
+struct BenchInput {
+  NavAddr::Bus bus;
+  std::string iface;
+  std::string text;                    ///< N0183 sentence or Signal K json
+  uint64_t pgn;                        ///< N2000 only
+  std::vector<unsigned char> payload;  ///< N2000 only
+  uint64_t name;                       ///< N2000 only
+};
+
+static std::vector<BenchInput> SyntheticInput(const std::string& buses) {
+  std::vector<BenchInput> inputs;
+  const bool all = buses.empty();
+  if (all || buses.find("n0183") != std::string::npos) {
+    const char* const sentences[] = {
+        "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W",
+        "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+        "GPVTG,084.4,T,081.3,M,022.4,N,041.5,K,A",
+        "HCHDT,083.9,T",
+        "GPGSV,3,1,11,03,03,111,00,04,15,270,00,06,01,010,00,13,06,292,00"};
+    for (auto s : sentences)
+      inputs.push_back({NavAddr::Bus::N0183, "bench-0183", WithChecksum('$', s),
+                        0, {}, 0});
+    inputs.push_back({NavAddr::Bus::N0183, "bench-0183",
+                      "!AIVDM,1,1,,A,1535SB002qOg@MVLTi@b;H8V08;?,0*47", 0,
+                      {}, 0});
+  }
+  if (all || buses.find("n2000") != std::string::npos) {
+    std::vector<unsigned char> pos;  // 129025 position, rapid update
+    PutLe(pos, static_cast<uint32_t>(481173000), 4);
+    PutLe(pos, static_cast<uint32_t>(115166600), 4);
+    std::vector<unsigned char> cogsog = {1, 0};  // 129026 COG & SOG
+    PutLe(cogsog, 14730, 2);  // 1.473 rad
+    PutLe(cogsog, 1152, 2);   // 11.52 m/s
+    PutLe(cogsog, 0xffff, 2);
+    std::vector<unsigned char> heading = {1};  // 127250 vessel heading
+    PutLe(heading, 14645, 2);
+    PutLe(heading, 0x7fff, 2);
+    PutLe(heading, 0x7fff, 2);
+    heading.push_back(0);  // true
+    inputs.push_back({NavAddr::Bus::N2000, "bench-n2k", "", 129025,
+                      N2kPayload(129025, 17, pos), 17});
+    inputs.push_back({NavAddr::Bus::N2000, "bench-n2k", "", 129026,
+                      N2kPayload(129026, 17, cogsog), 17});
+    inputs.push_back({NavAddr::Bus::N2000, "bench-n2k", "", 127250,
+                      N2kPayload(127250, 17, heading), 17});
+  }
+  if (all || buses.find("signalk") != std::string::npos) {
+    const char* const deltas[] = {
+        R"({"context": "vessels.urn:mrn:imo:mmsi:230099999", "updates":
+            [{"source": {"label": "bench"}, "values":
+              [{"path": "navigation.position", "value":
+                {"latitude": 48.1173, "longitude": 11.5167}}]}]})",
+        R"({"context": "vessels.urn:mrn:imo:mmsi:230099999", "updates":
+            [{"source": {"label": "bench"}, "values":
+              [{"path": "navigation.headingTrue", "value": 1.4645}]}]})"};
+    inputs.push_back({NavAddr::Bus::Signalk, "bench-sk",
+                      R"({"self": "vessels.urn:mrn:imo:mmsi:230099999",
+                          "version": "1.0.0"})",
+                      0, {}, 0});
+    for (auto d : deltas)
+      inputs.push_back({NavAddr::Bus::Signalk, "bench-sk", d, 0, {}, 0});
+  }
+  return inputs;
+}
+
+static std::vector<BenchInput> CaptureInput(const std::string& path) {
+  std::vector<BenchInput> inputs;
+  CaptureReader reader;
+  if (!reader.Open(path)) {
+    std::cerr << "Cannot open capture file " << path << "\n";
+    exit(1);
+  }
+  CaptureRecord r;
+  while (reader.Next(r)) {
+    BenchInput input{r.bus, r.iface, "", 0, {}, r.source_name};
+    if (r.bus == NavAddr::Bus::N2000) {
+      input.pgn = std::strtoull(r.id.c_str(), nullptr, 10);
+      input.payload = r.payload;
+    } else {
+      input.text.assign(r.payload.begin(), r.payload.end());
+    }
+    inputs.push_back(std::move(input));
+  }
+  return inputs;
+}
+
+class BenchApp : public wxAppConsole {
+public:
+  BenchApp() : wxAppConsole() { SetAppName("opencpn"); }
+
+  void OnInitCmdLine(wxCmdLineParser& parser) override {
+    parser.AddOption("n", "count", "Number of messages",
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption("b", "batch", "Messages between event loop runs",
+                     wxCMD_LINE_VAL_NUMBER);
+    parser.AddOption("B", "bus", "Synthetic buses");
+    parser.AddSwitch("h", "help", "Print help");
+    parser.AddParam("[capture file]", wxCMD_LINE_VAL_STRING,
+                    wxCMD_LINE_PARAM_OPTIONAL);
+  }
+
+  bool OnCmdLineParsed(wxCmdLineParser& parser) override {
+    wxInitializer initializer;
+    if (!initializer) {
+      std::cerr << "Failed to initialize the wxWidgets library, aborting.";
+      exit(1);
+    }
+    wxAppConsole::OnCmdLineParsed(parser);
+    if (parser.Found("help")) {
+      std::cout << USAGE << "\n";
+      exit(0);
+    }
+    long count = 100000;
+    long batch = 64;
+    wxString buses;
+    parser.Found("count", &count);
+    parser.Found("batch", &batch);
+    parser.Found("bus", &buses);
+    if (count <= 0 || batch <= 0) {
+      std::cerr << USAGE << "\n";
+      exit(1);
+    }
+
+    std::string input_name("synthetic");
+    std::vector<BenchInput> inputs;
+    if (parser.GetParamCount() > 0) {
+      input_name = parser.GetParam(0).ToStdString();
+      inputs = CaptureInput(input_name);
+    } else {
+      inputs = SyntheticInput(buses.ToStdString());
+    }
+    if (inputs.empty()) {
+      std::cerr << "No input messages\n";
+      exit(1);
+    }
+    Setup();
+    Run(inputs, input_name, count, batch);
+    exit(0);
+  }
+
+private:
+  std::map<std::string, BenchN0183Driver*> m_n0183_drivers;
+  std::map<std::string, BenchN2kDriver*> m_n2k_drivers;
+  std::map<std::string, BenchSignalKDriver*> m_sk_drivers;
+
+  /** Set up model globals like the GUI does, with a scratch config. */
+  void Setup() {
+    wxLog::SetActiveTarget(new wxLogStderr);
+    wxLog::SetLogLevel(wxLOG_Error);
+    wxString config_path = wxFileName::CreateTempFileName("opencpn-bench");
+    InitBaseConfig(new wxFileConfig("", "", config_path));
+    g_BasePlatform = new BasePlatform();
+    pSelect = new Select();
+    pSelectAIS = new Select();
+    pRouteList = new RouteList;
+    g_pRouteMan = new Routeman(RoutePropDlgCtx(), RoutemanDlgCtx());
+    g_pAIS = new AisDecoder(AisDecoderCallbacks());
+  }
+
+  template <typename D, typename M>
+  D* GetDriver(M& drivers, const std::string& iface) {
+    auto found = drivers.find(iface);
+    if (found != drivers.end()) return found->second;
+    auto driver = std::make_unique<D>(iface, NavMsgBus::GetInstance());
+    D* raw = driver.get();
+    CommDriverRegistry::GetInstance().Activate(std::move(driver));
+    drivers[iface] = raw;
+    return raw;
+  }
+
+  void Feed(const BenchInput& input) {
+    switch (input.bus) {
+      case NavAddr::Bus::N0183:
+        GetDriver<BenchN0183Driver>(m_n0183_drivers, input.iface)
+            ->Receive(input.text);
+        break;
+      case NavAddr::Bus::N2000:
+        GetDriver<BenchN2kDriver>(m_n2k_drivers, input.iface)
+            ->Receive(input.pgn, input.payload, input.name);
+        break;
+      case NavAddr::Bus::Signalk:
+        GetDriver<BenchSignalKDriver>(m_sk_drivers, input.iface)
+            ->Receive(input.text);
+        break;
+      default:
+        break;
+    }
+  }
+
+  void Run(const std::vector<BenchInput>& inputs, const std::string& name,
+           long count, long batch) {
+    CommBridge comm_bridge;
+    comm_bridge.Initialize();
+
+    // Warm up: create drivers, listeners and priority keys.
+    for (const auto& input : inputs) Feed(input);
+    ProcessPendingEvents();
+    PipelineStats::GetInstance().Reset();
+
+    uint64_t allocations = g_allocations.load();
+    std::clock_t cpu_start = std::clock();
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < count; i++) {
+      Feed(inputs[i % inputs.size()]);
+      if ((i + 1) % batch == 0) ProcessPendingEvents();
+    }
+    ProcessPendingEvents();
+    double seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    double cpu_seconds =
+        static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    allocations = g_allocations.load() - allocations;
+
+    auto& stats = PipelineStats::GetInstance();
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1);
+    os << "{\"input\": \"" << name << "\", \"messages\": " << count
+       << ", \"batch\": " << batch << ", \"seconds\": " << seconds
+       << ", \"msgs_per_sec\": " << count / seconds
+       << ", \"cpu_ns_per_msg\": " << cpu_seconds * 1e9 / count
+       << ", \"allocs_per_msg\": " << static_cast<double>(allocations) / count
+       << ", \"latency_us\": {";
+    const char* sep = "";
+    for (auto stage : {PipelineStage::kBusNotify, PipelineStage::kBridgeAccept,
+                       PipelineStage::kAisDecode}) {
+      const auto& h = stats.GetStage(stage).latency;
+      if (h.GetCount() == 0) continue;
+      os << sep << "\"" << PipelineStats::StageName(stage)
+         << "\": {\"count\": " << h.GetCount()
+         << ", \"p50\": " << h.Percentile(0.5) / 1000.0
+         << ", \"p99\": " << h.Percentile(0.99) / 1000.0
+         << ", \"max\": " << h.GetMax() / 1000.0 << "}";
+      sep = ", ";
+    }
+    os << "}}\n";
+    std::cout << os.str();
+  }
+};
+
+wxIMPLEMENT_APP_CONSOLE(BenchApp);
@@ -238,6 +238,9 @@ struct ChartTableEntry {
   std::vector<float> GetReducedAuxPlyPoints(int iTable);
 
   LLRegion quilt_candidate_region;
+  /** quilt_candidate_region reduced by quilt_reduced_factor, < 0 if unset. */
+  LLRegion quilt_reduced_candidate_region;
+  double quilt_reduced_factor;
 
   void SetScale(int scale);
   bool Scale_eq(int b) const { return abs(Scale - b) <= rounding; }
@@ -381,6 +384,12 @@ public:
 
   bool IsBusy() { return m_b_busy; }
 
+  /**
+   * Changes each time the chart table is built, and differs between
+   * database instances, so that data keyed on dbIndex can be dropped.
+   */
+  unsigned GetGeneration() const { return m_generation; }
+
 protected:
   virtual ChartBase *GetChart(const wxChar *theFilePath,
                               ChartClassDescriptor &chart_desc) const;
@@ -415,6 +424,7 @@ private:
   bool Check_CM93_Structure(wxString dir_name);
 
   bool bValid;
+  unsigned m_generation;
   wxArrayString m_chartDirs;
   int m_dbversion;
 
@@ -24,7 +24,10 @@
 #ifndef _CHARTIMG_H_
 #define _CHARTIMG_H_
 
+#include <vector>
+
 #include "model/georef.h"  // for GeoRef type
+#include "model/mapped_file.h"
 
 #include "chartbase.h"
 #include "chartdb.h"
@@ -96,6 +99,7 @@ public:
   TileOffsetCache *pTileOffset;  // entries for random access
 
   bool bValid;
+  bool bMapped;  // pPix points into the mapped bitmap file, not owned
   int size;
 };
 
@@ -245,6 +249,8 @@ protected:
   virtual int ReadBSBHdrLine(wxInputStream *, char *, int);
   virtual int AnalyzeRefpoints(bool b_testSolution = true);
   virtual bool AnalyzeSkew(void);
+  /** Solve the projected georef coefficients of cPoints. */
+  void SolveGeoref();
 
   virtual bool SetMinMax(void);
 
@@ -298,6 +304,10 @@ protected:
 
   wxString *pBitmapFilePath;
 
+  /** Bitmap file, mapped in PostInit() if possible to read lines in place. */
+  wxString m_bitmap_path;
+  MappedFile m_bitmap_map;
+
   unsigned char *ifs_buf;
   unsigned char *ifs_bufend;
   int ifs_bufsize;
@@ -307,6 +317,7 @@ protected:
   int m_nLineOffset;
 
   GeoRef cPoints;
+  std::vector<double> m_georef_input;  // Solver input of the cPoints solution
 
   double wpx[12], wpy[12], pwx[12], pwy[12];  // Embedded georef coefficients
   int wpx_type, wpy_type, pwx_type, pwy_type;
@@ -24,6 +24,8 @@
 #ifndef __CM93CHART_H__
 #define __CM93CHART_H__
 
+#include <list>
+
 #include <wx/listctrl.h>
 #include <wx/spinctrl.h>
 
@@ -199,6 +201,13 @@ typedef struct {
   int m_n_point3d_records;
   int m_n_point2d_records;
 
+  //          Allocated sizes, in items, of the other blocks
+  int m_n_vector_points;
+  int m_n_point3d_points;
+  int m_n_vector_descriptors;
+  int m_nrelated_object_pointers;
+  int m_n_attribute_bytes;
+
   List_Of_M_COVR_Desc m_cell_mcovr_list;
   bool b_have_offsets;
   bool b_have_user_offsets;
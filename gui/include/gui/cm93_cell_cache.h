@@ -0,0 +1,98 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+/**
+ * \file
+ *
+ * Cache of decoded CM93 cells.
+ */
+
+#ifndef CM93_CELL_CACHE_H_
+#define CM93_CELL_CACHE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <wx/string.h>
+
+#include "cm93.h"
+
+/**
+ * Decoded CM93 cells, stored as flat arrays in one file per cell.
+ *
+ * A CM93 cell is encoded byte by byte and made of small variable length
+ * records, possibly xz compressed. Once ingested, the cell tables are
+ * written to a cache file where the descriptor pointers are replaced by
+ * indexes. Loading a cell from the cache then maps the file, copies the
+ * point and attribute arrays in one go and fixes up the pointers.
+ *
+ * Cache files are in native byte order, below the private data directory
+ * and named from the hash of the cell path. They are validated against
+ * the size and modification time of the cell file. Cells are cached
+ * lazily, when first loaded, and the least recently used files are
+ * removed when the cache grows past a fixed size.
+ */
+class CM93CellCache {
+public:
+  static CM93CellCache& GetInstance();
+
+  /** Write pending cache files. */
+  ~CM93CellCache();
+
+  CM93CellCache(const CM93CellCache&) = delete;
+  CM93CellCache& operator=(const CM93CellCache&) = delete;
+
+  /**
+   * Load the cached cell decoded from source into pCIB, allocating its
+   * blocks as Ingest_CM93_Cell() does.
+   * @return false if there is no valid cache file, pCIB is then unchanged.
+   */
+  bool Load(const wxString& source, Cell_Info_Block* pCIB);
+
+  /**
+   * Queue the cache file write of cell cib, ingested from source. The cell
+   * is serialized on the calling thread and written by a background
+   * thread. Cells with pointers outside of their blocks are not cached.
+   */
+  void Store(const wxString& source, const Cell_Info_Block& cib);
+
+private:
+  CM93CellCache();
+
+  struct Job {
+    std::string path;
+    std::vector<unsigned char> data;
+  };
+
+  static wxString CacheDir();
+  static std::string CachePath(const wxString& source);
+
+  /** Write queued jobs, after pruning the cache directory dir. */
+  void Run(wxString dir);
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<Job> m_jobs;
+  std::thread m_thread;
+  bool m_stop;
+};
+
+#endif  // CM93_CELL_CACHE_H_
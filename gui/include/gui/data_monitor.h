@@ -29,16 +29,19 @@
 #include <wx/frame.h>
 
 #include "model/data_monitor_src.h"
+#include "model/navmsg_capture.h"
 #include "tty_scroll.h"
 #include "std_filesystem.h"
 
+class TtyPanel;
+
 /**
  * Internal helper class
  * \internal
  */
 class DataLogger {
 public:
-  enum class Format { kVdr, kDefault, kCsv };
+  enum class Format { kVdr, kDefault, kCsv, kCapture };
 
   DataLogger(wxWindow* parent, const fs::path& path);
 
@@ -58,6 +61,9 @@ public:
 
   fs::path GetDefaultLogfile();
 
+  /** Return log file extension including dot for given format. */
+  static std::string GetExtension(Format format);
+
   /** Notified with new path on filename change. */
   EventVar OnNewLogfile;
 
@@ -65,6 +71,7 @@ private:
   wxWindow* m_parent;
   fs::path m_path;
   std::ofstream m_stream;
+  CaptureWriter m_capture;
   bool m_is_logging;
   Format m_format;
   const NavmsgTimePoint m_log_start;
@@ -88,6 +95,7 @@ private:
   void OnFilterApply(const std::string& name);
 
   DataMonitorSrc m_monitor_src;
+  TtyPanel* m_tty_panel;
   wxWindow* m_quick_filter;
   DataLogger m_logger;
   ObsListener m_filter_list_lstnr;
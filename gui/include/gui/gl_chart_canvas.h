@@ -266,6 +266,27 @@ protected:
 
   ViewPort m_cache_vp;
   ChartBase *m_cache_current_ch;
+  unsigned long m_cache_quilt_hash;
+
+  //  How the chart layer was produced for a frame.  Own ship and AIS
+  //  updates normally reuse the retained FBO chart layer and only
+  //  composite the dynamic layers on top.
+  enum RenderUpdateType {
+    RENDER_UPDATE_FULL = 0,  // chart layer fully re-rendered into the FBO
+    RENDER_UPDATE_PAN,       // FBO shifted, exposed strips re-rendered
+    RENDER_UPDATE_RETAINED,  // FBO chart layer reused as is
+    RENDER_UPDATE_DIRECT,    // no FBO, charts rendered to the back buffer
+    RENDER_UPDATE_NUM
+  };
+  struct RenderUpdateStats {
+    int n_frames;
+    long chart_ms;
+    long total_ms;
+  };
+  RenderUpdateStats m_update_stats[RENDER_UPDATE_NUM];
+  wxStopWatch m_update_stats_sw;
+  void AccumulateRenderStats(RenderUpdateType type, long chart_ms,
+                             long total_ms);
 
   bool m_b_paint_enable;
   int m_in_glpaint;
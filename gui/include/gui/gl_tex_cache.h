@@ -29,6 +29,7 @@
 #include <wx/timer.h>
 #include <stdint.h>
 
+#include "model/mapped_file.h"
 #include "model/ocpn_types.h"
 #include "color_types.h"
 #include "bbox.h"
@@ -36,7 +37,7 @@
 
 class glTextureDescriptor;
 
-#define COMPRESSED_CACHE_MAGIC 0xf013  // change this when the format changes
+#define COMPRESSED_CACHE_MAGIC 0xf014  // change this when the format changes
 
 #define FACTORY_TIMER 10000
 
@@ -63,6 +64,11 @@ struct CatalogEntryKey {
   int y;
 };
 
+/**
+ * Location of a texture level in the cache file. Levels are LZ4
+ * compressed, unless compressed_size is the size of the level: these are
+ * stored as is and uploaded straight from the mapped file.
+ */
 struct CatalogEntryValue {
   int texture_offset;
   uint32_t compressed_size;
@@ -117,8 +123,15 @@ public:
                       ColorScheme color_scheme, int mem_used);
   int GetTextureLevel(glTextureDescriptor *ptd, const wxRect &rect, int level,
                       ColorScheme color_scheme);
+  /**
+   * Append the compressed levels of a tile to the cache file. With
+   * write_catalog false the file has no valid catalog until
+   * WriteCatalogAndHeader() is called.
+   */
   bool UpdateCacheAllLevels(const wxRect &rect, ColorScheme color_scheme,
-                            unsigned char **compcomp_array, int *compcomp_size);
+                            unsigned char **compcomp_array, int *compcomp_size,
+                            bool write_catalog = true);
+  bool WriteCatalogAndHeader();
   bool IsLevelInCache(int level, const wxRect &rect, ColorScheme color_scheme);
   wxString GetChartPath() { return m_ChartPath; }
   wxString GetHashKey() { return m_HashKey; }
@@ -136,6 +149,8 @@ public:
   int GetLRUTime() { return m_LRUtime; }
   void FreeSome(long target);
   void FreeIfCached();
+  /** Bytes of tile data held in ram, including the mapped cache file. */
+  size_t GetResidentBytes();
 
   glTextureDescriptor *GetpTD(wxRect &rect);
 
@@ -149,7 +164,6 @@ public:
 private:
   bool LoadCatalog(void);
   bool LoadHeader(void);
-  bool WriteCatalogAndHeader();
 
   bool UpdateCachePrecomp(unsigned char *data, int data_size,
                           const wxRect &rect, int level,
@@ -161,6 +175,15 @@ private:
 
   CatalogEntryValue *GetCacheEntryValue(int level, int x, int y,
                                         ColorScheme color_scheme);
+  /** Return the data of a cache entry in the mapped file, NULL if none. */
+  const unsigned char *MapCacheEntry(const CatalogEntryValue *v);
+  /**
+   * Return a compressed texture level ready for upload, pointing into the
+   * descriptor, the mapped cache file or the decode arena, which is only
+   * valid until the next call. NULL if the level is not available.
+   */
+  const unsigned char *GetCompressedLevel(glTextureDescriptor *ptd,
+                                          const wxRect &rect, int level);
   bool AddCacheEntryValue(const CatalogEntry &p);
   int ArrayIndex(int x, int y) const {
     return ((y / m_tex_dim) * m_stride) + (x / m_tex_dim);
@@ -183,6 +206,8 @@ private:
   bool m_catalogCorrupted;
 
   wxFFile *m_fs;
+  bool m_fs_dirty;  ///< m_fs written since flushed
+  MappedFile m_map;
   uint32_t m_chart_date_binary;
   uint32_t m_chartfile_date_binary;
   uint32_t m_chartfile_size;
@@ -26,6 +26,7 @@
 #define __GLTEXTUREMANAGER_H__
 
 #include <list>
+#include <vector>
 
 #include <wx/event.h>
 #include <wx/string.h>
@@ -131,7 +132,11 @@ public:
   bool PurgeChartTextures(ChartBase *pc, bool b_purge_factory = false);
   bool TextureCrunch(double factor);
   bool FactoryCrunch(double factor);
-  void BuildCompressedCache();
+  /**
+   * Build the compressed texture cache of all raster charts, nearest to
+   * ownship first. If headless, progress is logged instead of shown.
+   */
+  void BuildCompressedCache(bool headless = false);
 
   //    This is a hash table
   //    key is Chart full path
@@ -142,13 +147,14 @@ private:
   bool DoJob(JobTicket *pticket);
   bool DoThreadJob(JobTicket *pticket);
   bool StartTopJob();
+  glTexFactory *FindOldestUnusedFactory();
+  void CreateProgressDialog(int count);
+  void BuildCacheInParallel(const std::vector<wxString> &chart_paths);
 
   std::list<JobTicket *> running_list;
   std::list<JobTicket *> todo_list;
   int m_max_jobs;
 
-  int m_prevMemUsed;
-
   wxTimer m_timer;
   size_t m_ticks;
   wxGenericProgressDialog *m_progDialog;
@@ -34,6 +34,8 @@
 #include <string>
 #include <vector>
 
+#include "model/gshhs_crossing.h"
+
 #include "viewport.h"
 #include "poly_math.h"
 #include "color_types.h"
@@ -86,7 +88,6 @@ struct PolygonFileHeader {
 
 typedef std::vector<wxRealPoint> contour;
 typedef std::vector<contour> contour_list;
-#define GSSH_SUBM 16  // divide each cell to 16x16 sub cells
 
 //==========================================================================
 
@@ -104,10 +105,6 @@ public:
   std::vector<wxLineF> *getCoasts() { return &coasts; }
   contour_list &getPoly1() { return poly1; }
 
-  /* we remap the segments into a high resolution map to
-     greatly reduce intersection testing time */
-  std::vector<wxLineF> *high_res_map[GSSH_SUBM * GSSH_SUBM];
-
 private:
   int nbpoints;
   int x0cell, y0cell;
@@ -147,7 +144,6 @@ public:
   void drawGshhsPolyMapSeaBorders(ocpnDC &pnt, ViewPort &vp);
 
   void InitializeLoadQuality(int quality);  // 5 levels: 0=low ... 4=full
-  bool crossing1(wxLineF trajectWorld);
   int currentQuality;
   int ReadPolyVersion();
   int GetPolyVersion() { return polyHeader.version; }
@@ -159,8 +155,6 @@ private:
   PolygonFileHeader polyHeader;
   void readPolygonFileHeader(FILE *polyfile, PolygonFileHeader *header);
 
-  wxMutex mutex1, mutex2;
-
   ViewPort last_rendered_vp;
 };
 
@@ -242,8 +236,6 @@ public:
 
   int getQuality() { return quality; }
 
-  //    bool crossing( wxLineF traject, wxLineF trajectWorld ) const;
-  bool crossing1(wxLineF trajectWorld);
   // Open the polygon file, read and return the version from the header.
   int ReadPolyVersion();
   bool qualityAvailable[6];
@@ -293,9 +285,6 @@ private:
   void clearLists();
 };
 
-inline bool GshhsReader::crossing1(wxLineF trajectWorld) {
-  return this->gshhsPoly_reader->crossing1(trajectWorld);
-}
 #define GSHHS_SCL 1.0e-6 /* Convert micro-degrees to degrees */
 
 //-------------------------------------------------------------------------------
@@ -333,5 +322,11 @@ void gshhsCrossesLandReset();
  * The best available quality is used, regardless of the chart scale.
  */
 bool gshhsCrossesLand(double lat1, double lon1, double lat2, double lon2);
+/*
+ * Test all segments, in parallel. Sets crosses to one item per segment,
+ * non-zero if the segment crosses land.
+ */
+void gshhsCrossesLand(const std::vector<GshhsCrossing::Segment> &segments,
+                      std::vector<char> &crosses);
 
 #endif
@@ -281,6 +281,8 @@ private:
   bool CheckBlacklistedPlugin(wxString name, int major, int minor);
   bool CheckBlacklistedPlugin(opencpn_plugin* plugin);
   void OnNewMessageType();
+  /** Send the sentences queued by HandleN0183() to plugins, in order. */
+  void FlushNmeaSentences();
 
   ObservableListener evt_ais_json_listener;
   ObservableListener evt_blacklisted_plugin_listener;
@@ -303,6 +305,10 @@ private:
 
   std::unordered_map<std::string, ObsListener> m_0183_listeners;
 
+  /** Sentences waiting for FlushNmeaSentences(), with their messages. */
+  std::vector<wxString> m_pending_nmea;
+  std::vector<std::shared_ptr<const Nmea0183Msg>> m_pending_nmea_msgs;
+
   wxBitmap* BuildDimmedToolBitmap(wxBitmap* pbmp_normal,
                                   unsigned char dim_ratio);
 
@@ -27,6 +27,7 @@
 #include <vector>
 
 #include "model/config_vars.h"
+#include "model/quilt_region_cache.h"
 
 #include "LLRegion.h"
 #include "ocpn_region.h"
@@ -129,6 +130,7 @@ public:
     m_bcomposed = false;
     m_vp_quilt.Invalidate();
     m_zout_dbindex = -1;
+    m_region_cache.Clear();
 
     //  Quilting of skewed raster charts is allowed for OpenGL only
     m_bquiltskew = g_bopengl;
@@ -220,6 +222,7 @@ private:
   bool IsChartS57Overlay(int db_index);
 
   LLRegion m_covered_region;
+  QuiltRegionCache m_region_cache;
   OCPNRegion m_rendered_region;  // used only in dc mode
 
   PatchList m_PatchList;
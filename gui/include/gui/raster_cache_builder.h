@@ -0,0 +1,140 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * \file
+ *
+ * Multi-core builder of the compressed raster texture cache.
+ */
+
+#ifndef RASTER_CACHE_BUILDER_H_
+#define RASTER_CACHE_BUILDER_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <wx/gdicmn.h>
+#include <wx/string.h>
+
+class ChartBase;
+class glTexFactory;
+
+/**
+ * Build the compressed texture cache files of raster charts, keeping all
+ * cores busy.
+ *
+ * Charts are opened on the thread calling Build(), which may be the GUI
+ * thread, and their missing texture tiles are queued. Each worker thread
+ * owns a deque of tiles: it takes the newest tile of its own deque and,
+ * when empty, steals the oldest tile of another worker. All tiles of a
+ * chart are queued on the same deque, so workers mostly stay on one chart
+ * while idle workers take over the rest of large charts.
+ *
+ * The chart bits are read and the cache file appended under a per chart
+ * lock; mipmapping and compression run unlocked. The cache catalog is
+ * written every kCatalogInterval tiles and when the chart is done, instead
+ * of once per mipmap level. The file format is the one of glTexFactory.
+ */
+class RasterCacheBuilder {
+public:
+  struct Progress {
+    int charts_done;
+    int charts_total;
+    size_t tiles_done;
+    size_t tiles_queued;  ///< Tiles found missing so far
+    wxString chart_path;  ///< Last chart opened
+  };
+
+  /** Called regularly on the Build() thread, return false to abort. */
+  using ProgressFunc = std::function<bool(const Progress &)>;
+
+  /** @param n_threads Number of workers, the number of CPUs if <= 0. */
+  explicit RasterCacheBuilder(int n_threads = 0);
+  ~RasterCacheBuilder();
+
+  /** True if the texture format and options allow building the cache. */
+  static bool CanBuild();
+
+  /**
+   * Build the missing cache tiles of the charts, in order.
+   * @return false if aborted or the cache cannot be built.
+   */
+  bool Build(const std::vector<wxString> &chart_paths,
+             const ProgressFunc &progress);
+
+private:
+  static const int kCatalogInterval = 64;
+
+  struct Chart {
+    ChartBase *chart;
+    std::unique_ptr<glTexFactory> factory;
+    std::mutex mutex;     ///< Protects chart bits reads and factory writes
+    size_t remaining;     ///< Tiles not done, protected by mutex
+    int since_catalog;    ///< Tiles since the catalog write, ditto
+  };
+
+  struct Tile {
+    Chart *chart;
+    wxRect rect;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Tile> tiles;
+    std::thread thread;
+  };
+
+  /** Open the chart and queue its missing tiles, false if none. */
+  bool QueueChart(const wxString &path);
+  void CloseChart(Chart *chart);
+  /** Wait a little for finished charts and close them. */
+  void CloseFinished();
+  void Report(const ProgressFunc &progress);
+
+  void Run(size_t index);
+  bool Pop(size_t index, Tile &tile);
+  void DoTile(const Tile &tile);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  size_t m_next_worker;
+
+  std::list<std::unique_ptr<Chart>> m_charts;  ///< Open charts
+  std::vector<Chart *> m_finished;             ///< Done, to be closed
+
+  /** Protects m_finished and the waits below. */
+  std::mutex m_mutex;
+  std::condition_variable m_work_cv;  ///< Tiles queued or stop
+  std::condition_variable m_done_cv;  ///< Chart finished
+  std::atomic<size_t> m_queued;       ///< Tiles in all the deques
+  std::atomic<size_t> m_tiles_done;
+  std::atomic<bool> m_stop;
+  std::atomic<bool> m_abort;
+
+  Progress m_progress;
+  std::chrono::steady_clock::time_point m_last_report;
+};
+
+#endif  // RASTER_CACHE_BUILDER_H_
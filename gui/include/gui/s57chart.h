@@ -289,6 +289,18 @@ public:
 
 protected:
   void AssembleLineGeometry(void);
+  void ReleaseLineGeometrySources(void);
+
+  /**
+   * Restore the assembled line geometry (vertex buffer, connector segments
+   * and per-object segment lists) from the on-disk cache created by
+   * SaveLineGeometryCache(), skipping AssembleLineGeometry().
+   * @return false if the cache is missing, stale or inconsistent with the
+   * loaded SENC, in which case no chart state has been touched.
+   */
+  bool LoadLineGeometryCache(const wxString &SENCPath);
+  void SaveLineGeometryCache(const wxString &SENCPath, size_t n_candidates);
+  bool GetPendingLineObjects(std::unordered_map<int, S57Obj *> &pending);
 
   ObjRazRules *razRules[PRIO_NUM][LUPNAME_NUM];
   double m_next_safe_cnt;
@@ -382,6 +394,7 @@ private:
   wxString m_lastColorScheme;
   wxRect m_last_vprect;
   long m_plib_state_hash;
+  long m_plib_cs_state_hash;
   bool m_btex_mem;
   char m_usage_char;
 
@@ -21,12 +21,13 @@
 #ifndef __TTYSCROLL_H__
 #define __TTYSCROLL_H__
 
-#include <deque>
 #include <memory>
 
 #include <wx/scrolwin.h>
 #include <wx/textctrl.h>
+#include <wx/timer.h>
 
+#include "model/logline_buffer.h"
 #include "model/nmea_log.h"
 #include "model/navmsg_filter.h"
 
@@ -71,39 +72,48 @@ public:
   wxColor operator()(NavmsgStatus ns);
 };
 
-/** Scrolled TTY-like window for logging, etc. */
+/**
+ * Scrolled TTY-like window for logging, etc. Lines are kept unformatted in
+ * a bounded LoglineBuffer history; only the visible rows are formatted when
+ * drawn. New lines are filtered and the window repainted in batches from a
+ * timer rather than for each line.
+ */
 class TtyScroll : public wxScrolledWindow {
 public:
+  /** Default number of lines kept in history. */
+  static const size_t kDefaultHistory = 100000;
+
   /**
    * Create a TtyScroll instance
    * @param parent Parent window
    * @param n_lines Number of visible lines i. e., window height.
+   * @param history Number of lines retained for scrolling and filtering.
    */
-  TtyScroll(wxWindow* parent, int n_lines);
+  TtyScroll(wxWindow* parent, int n_lines, size_t history = kDefaultHistory);
 
   virtual ~TtyScroll() = default;
 
   /**
-   * Add a line to bottom of window, typically discarding top-most line.
-   * Subject to checks with respect to paused state and filter possibly
-   * discarding argument line.
+   * Add a line to bottom of window, discarding the oldest line in history
+   * when full. Ignored when paused. Lines not passing the filter are kept
+   * but not displayed.
    */
   virtual void Add(const Logline& line);
 
   /** Set the window to ignore Add() or not depending on pause. */
   void Pause(bool pause) { m_is_paused = pause; }
 
-  /**  Copy message contents to clipboard.  */
+  /**  Copy visible message contents to clipboard.  */
   void CopyToClipboard() const;
 
-  /** Apply a display filter */
-  void SetFilter(const NavmsgFilter& filter) { m_filter = filter; }
+  /** Apply a display filter, also to lines in history. */
+  void SetFilter(const NavmsgFilter& filter);
 
   /** Return current display filter */
   const NavmsgFilter& GetFilter() { return m_filter; }
 
   /** Apply a quick filter directly matched against lines */
-  void SetQuickFilter(const std::string s) { m_quick_filter = s; }
+  void SetQuickFilter(const std::string s);
 
   /** Set color scheme */
   void SetColors(std::unique_ptr<ColorByState> color_by_state);
@@ -113,15 +123,25 @@ protected:
   size_t m_n_lines;       // number of lines we draw
   wxCoord m_text_width;   // Width of widest line displayed
 
-  std::deque<Logline> m_lines;
+  LoglineBuffer m_lines;
   NavmsgFilter m_filter;
   bool m_is_paused;
+  bool m_is_dirty;  // Lines added since last refresh
   std::unique_ptr<ColorByState> m_color_by_state;
   std::string m_quick_filter;
+  wxTimer m_refresh_timer;
+
+  /** Number of rows in virtual window, at least m_n_lines. */
+  size_t GetRowCount() const;
+
+  /** Return line displayed in row, nullptr for empty rows. */
+  LoglineBuffer::LinePtr GetRowLine(size_t row) const;
 
+  void ApplyFilter();
   void DrawLine(wxDC& dc, const Logline& ll, int data_pos, int y);
   virtual void OnDraw(wxDC& dc);
   void OnSize(wxSizeEvent& event);
+  void OnRefreshTimer();
 };
 
 #endif
@@ -124,6 +124,21 @@ public:
    * @return wxPoint2DDouble Physical pixel coordinates.
    */
   wxPoint2DDouble GetDoublePixFromLL(double lat, double lon);
+  /**
+   * Convert n points from latitude and longitude to physical pixel
+   * coordinates, like GetDoublePixFromLL(). The projection is set up once
+   * for the whole array, use this for polygons and tile meshes.
+   * @param lat Latitudes in degrees, point i at lat[i * stride].
+   * @param lon Longitudes in degrees, point i at lon[i * stride].
+   * @param n Number of points.
+   * @param out Receives the n x, y pairs. Points which cannot be projected
+   * are not finite.
+   * @param stride Distance between two points in lat and lon.
+   */
+  void ProjectLLToPix(const double *lat, const double *lon, size_t n,
+                      float *out, size_t stride = 1);
+  void ProjectLLToPix(const float *lat, const float *lon, size_t n,
+                      float *out, size_t stride = 1);
 
   LLRegion GetLLRegion(const OCPNRegion &region);
   /**
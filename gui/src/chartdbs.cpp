@@ -887,6 +887,7 @@ void ChartTableEntry::Clear() {
 
   m_pfilename = NULL;  // a helper member, not on disk
   m_psFullPath = NULL;
+  quilt_reduced_factor = -1;
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -1058,8 +1059,12 @@ std::vector<float> ChartTableEntry::GetReducedAuxPlyPoints(int iTable) {
 
 WX_DEFINE_OBJARRAY(ChartTable);
 
+/** Last ChartDatabase generation handed out, see GetGeneration(). */
+static unsigned s_db_generation = 0;
+
 ChartDatabase::ChartDatabase() {
   bValid = false;
+  m_generation = ++s_db_generation;
   m_b_busy = false;
 
   m_ChartTableEntryDummy.Clear();
@@ -1165,6 +1170,7 @@ bool ChartDatabase::Read(const wxString &filePath) {
   int entries;
 
   bValid = false;
+  m_generation = ++s_db_generation;
 
   wxFileName file(filePath);
   if (!file.FileExists()) return false;
@@ -1442,6 +1448,7 @@ bool ChartDatabase::Create(ArrayOfCDI &dir_array,
   m_dir_array = dir_array;
 
   bValid = false;
+  m_generation = ++s_db_generation;
 
   m_chartDirs.Clear();
   active_chartTable.Clear();
@@ -1507,6 +1514,7 @@ bool ChartDatabase::Update(ArrayOfCDI &dir_array, bool bForce,
   m_dir_array = dir_array;
 
   bValid = false;  // database is not useable right now...
+  m_generation = ++s_db_generation;
   m_b_busy = true;
 
   //  Mark all charts provisionally invalid
@@ -22,6 +22,7 @@
  */
 
 #include <assert.h>
+#include <mutex>
 
 // For compilers that support precompilation, includes "wx.h".
 #include <wx/wxprec.h>
@@ -40,6 +41,7 @@
 #include <wx/fileconf.h>
 
 #include "model/chartdata_input_stream.h"
+#include "raster/raster.h"
 
 #include "config.h"
 #include "chartimg.h"
@@ -547,6 +549,7 @@ InitReturn ChartGEO::Init(const wxString &name, ChartInitFlag init_flags) {
   ifss_bitmap =
       new wxFFileInputStream(*pBitmapFilePath);  // open the bitmap file
   ifs_bitmap = new wxBufferedInputStream(*ifss_bitmap);
+  m_bitmap_path = *pBitmapFilePath;
 
   if (!ifss_bitmap->IsOk()) {
     free(pPlyTable);
@@ -1355,12 +1358,12 @@ InitReturn ChartKAP::Init(const wxString &name, ChartInitFlag init_flags) {
         m_nCOVREntries = covrRegion.contours.size();
         m_pCOVRTablePoints = (int *)malloc(m_nCOVREntries * sizeof(int));
         m_pCOVRTable = (float **)malloc(m_nCOVREntries * sizeof(float *));
-        std::list<poly_contour>::iterator it = covrRegion.contours.begin();
+        std::vector<poly_contour>::iterator it = covrRegion.contours.begin();
         for (int i = 0; i < m_nCOVREntries; i++) {
           m_pCOVRTablePoints[i] = it->size();
           m_pCOVRTable[i] =
               (float *)malloc(m_pCOVRTablePoints[i] * 2 * sizeof(float));
-          std::list<contour_pt>::iterator jt = it->begin();
+          poly_contour::iterator jt = it->begin();
           for (int j = 0; j < m_pCOVRTablePoints[i]; j++) {
             m_pCOVRTable[i][2 * j + 0] = jt->y;
             m_pCOVRTable[i][2 * j + 1] = jt->x;
@@ -1490,6 +1493,7 @@ InitReturn ChartKAP::Init(const wxString &name, ChartInitFlag init_flags) {
 
   ifss_bitmap = stream;
   ifs_bitmap = new wxBufferedInputStream(*ifss_bitmap);
+  m_bitmap_path = tempfile.empty() ? name : tempfile;
 
   //    Perform common post-init actions in ChartBaseBSB
   InitReturn pi_ret = PostInit();
@@ -1502,6 +1506,9 @@ InitReturn ChartKAP::Init(const wxString &name, ChartInitFlag init_flags) {
 // ============================================================================
 
 ChartBaseBSB::ChartBaseBSB() {
+  static std::once_flag routines_resolved;
+  std::call_once(routines_resolved, Raster_ResolveRoutines);
+
   //    Init some private data
   m_ChartFamily = CHART_FAMILY_RASTER;
 
@@ -1579,6 +1586,9 @@ ChartBaseBSB::~ChartBaseBSB() {
   free(pRefTable);
   //      free(pPlyTable);
 
+  // The stream may own the mapped temporary file, which Windows cannot
+  // delete while it is mapped.
+  m_bitmap_map.Close();
   delete ifs_bitmap;
   delete ifs_hdr;
   delete ifss_bitmap;
@@ -1614,7 +1624,7 @@ void ChartBaseBSB::FreeLineCacheRows(int start, int end) {
       CachedLine *pt = &pLineCache[ylc];
       if (pt->bValid) {
         free(pt->pTileOffset);
-        free(pt->pPix);
+        if (!pt->bMapped) free(pt->pPix);
         pt->bValid = false;
       }
     }
@@ -1925,12 +1935,17 @@ InitReturn ChartBaseBSB::PostInit() {
     for (int ylc = 0; ylc < Size_Y; ylc++) {
       pt = &pLineCache[ylc];
       pt->bValid = false;
+      pt->bMapped = false;
       pt->pPix = NULL;  //(unsigned char *)malloc(1);
       pt->pTileOffset = NULL;
     }
   } else
     pLineCache = NULL;
 
+  //    Map the bitmap file, so that lines are decoded in place rather than
+  //    read through the stream. Stream reads remain the fallback.
+  if (!m_bitmap_path.empty()) m_bitmap_map.Open(m_bitmap_path.ToStdString());
+
   //    Validate/Set Depth Unit Type
   wxString test_str = m_DepthUnits.Upper();
   if (test_str.IsSameAs("FEET", FALSE))
@@ -2007,7 +2022,7 @@ void ChartBaseBSB::InvalidateLineCache() {
     for (int ylc = 0; ylc < Size_Y; ylc++) {
       pt = &pLineCache[ylc];
       if (pt) {
-        free(pt->pPix);
+        if (!pt->bMapped) free(pt->pPix);
         pt->pPix = NULL;
         free(pt->pTileOffset);
         pt->pTileOffset = NULL;
@@ -3421,8 +3436,8 @@ bool ChartBaseBSB::GetAndScaleData(unsigned char *ppn, size_t data_size,
       int blur_factor = wxMax(2, Factor);
       int wb_size = (source.width) * (blur_factor * 2) * BPP / 8;
       s_data = (unsigned char *)malloc(wb_size);  // work buffer
-      unsigned char *pixel;
-      int y_offset;
+      uint32_t *box_work = (uint32_t *)malloc(
+          Raster_BoxFilterWorkSize(source.width) * sizeof(uint32_t));
 
       for (int y = dest.y; y < (dest.y + dest.height); y++) {
         //    Read "blur_factor" lines
@@ -3436,48 +3451,13 @@ bool ChartBaseBSB::GetAndScaleData(unsigned char *ppn, size_t data_size,
 
         target_data = data + (y * dest_line_length /*dest_stride * BPP/8*/);
 
-        for (int x = 0; x < target_width; x++) {
-          unsigned int avgRed = 0;
-          unsigned int avgGreen = 0;
-          unsigned int avgBlue = 0;
-          unsigned int pixel_count = 0;
-          unsigned char *pix0 = s_data + BPP / 8 * ((int)(x * factor));
-          y_offset = 0;
-
-          if ((x * Factor) < (Size_X - source.x)) {
-            // determine average
-            for (int y1 = 0; y1 < blur_factor; ++y1) {
-              pixel = pix0 + (BPP / 8 * y_offset);
-              for (int x1 = 0; x1 < blur_factor; ++x1) {
-                avgRed += pixel[0];
-                avgGreen += pixel[1];
-                avgBlue += pixel[2];
-
-                pixel += BPP / 8;
-
-                pixel_count++;
-              }
-              y_offset += source.width;
-            }
-
-            if (0 == pixel_count)  // Protect
-              pixel_count = 1;
-
-            target_data[0] = avgRed / pixel_count;    // >> scounter;
-            target_data[1] = avgGreen / pixel_count;  // >> scounter;
-            target_data[2] = avgBlue / pixel_count;   // >> scounter;
-            target_data += BPP / 8;
-          } else {
-            target_data[0] = 0;
-            target_data[1] = 0;
-            target_data[2] = 0;
-            target_data += BPP / 8;
-          }
-
-        }  // for x
-
+        //    Average blur_factor x blur_factor boxes, black past chart edge
+        Raster_BoxFilter_24(s_data, source.width, blur_factor, factor,
+                            Size_X - source.x, target_width, target_data,
+                            box_work);
       }  // for y
 
+      free(box_work);
     }  // SCALE_BILINEAR
 
     else if (scale_type == RENDER_LODEF) {
@@ -3906,7 +3886,9 @@ private:
   do {                      \
     free(pt->pTileOffset);  \
     pt->pTileOffset = NULL; \
-    free(pt->pPix);         \
+    if (!pt->bMapped) {     \
+      free(pt->pPix);       \
+    }                       \
     pt->pPix = NULL;        \
     pt->bValid = false;     \
     return 0;               \
@@ -3925,7 +3907,9 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
   unsigned char byNext;
   CachedLine *pt = NULL, cached_line;
   unsigned char *pCL;
+#ifdef USE_OLD_CACHE
   int rgbval;
+#endif
   unsigned char *lp;
   int ix = xs;
   int pos = 0;
@@ -3948,20 +3932,28 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
   if (!pt->bValid)  // not valid, allocate
   {
     pt->size = pline_table[y + 1] - pline_table[y];
+    pt->bMapped = false;
 
 #ifdef USE_OLD_CACHE
     pt->pPix = (unsigned char *)malloc(Size_X);
 #else
     pt->pTileOffset = (TileOffsetCache *)calloc(
         sizeof(TileOffsetCache) * (Size_X / TILE_SIZE + 1), 1);
-    pt->pPix = (unsigned char *)malloc(pt->size);
+    //  Lines inside the mapped file are decoded in place
+    if (m_bitmap_map.IsOk() && pline_table[y] > 0 &&
+        (size_t)pline_table[y + 1] <= m_bitmap_map.GetSize()) {
+      pt->pPix = const_cast<unsigned char *>(m_bitmap_map.GetData()) +
+                 pline_table[y];
+      pt->bMapped = true;
+    } else
+      pt->pPix = (unsigned char *)malloc(pt->size);
 #endif
     if (pline_table[y] == 0 || pline_table[y + 1] == 0) FAIL;
 
     // as of 2015, in wxWidgets buffered streams don't test for a zero seek
     // so we check here to possibly avoid this seek with a measured performance
     // gain
-    if (ifs_bitmap->TellI() != pline_table[y] &&
+    if (!pt->bMapped && ifs_bitmap->TellI() != pline_table[y] &&
         wxInvalidOffset == ifs_bitmap->SeekI(pline_table[y], wxFromStart))
       FAIL;
 
@@ -3979,7 +3971,7 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
 #else
     lp = pt->pPix;
 #endif
-    ifs_bitmap->Read(lp, pt->size);
+    if (!pt->bMapped) ifs_bitmap->Read(lp, pt->size);
 
 #ifdef USE_OLD_CACHE
     pCL = pt->pPix;
@@ -4172,147 +4164,8 @@ int ChartBaseBSB::BSBGetScanline(unsigned char *pLineBuf, int y, int xs, int xl,
   }
 
 nocachestart:
-  nValueShift = 7 - nColorSize;
-  byValueMask = (((1 << nColorSize)) - 1) << nValueShift;
-  byCountMask = (1 << (7 - nColorSize)) - 1;
-  int nPixValue = 0;  // satisfy stupid compiler warning
-  bool bLastPixValueValid = false;
-  while (ix < xl - 1) {
-    if (pos < pt->size) {
-      byNext = *lp++;
-      pos++;
-    } else {
-      break;
-    }
-
-    nPixValue = (byNext & byValueMask) >> nValueShift;
-    unsigned int nRunCount;
-
-    if (byNext == 0)
-      nRunCount = xl - ix;  // corrupted chart, just run to the end
-    else {
-      nRunCount = byNext & byCountMask;
-      while ((byNext & 0x80) != 0) {
-        if (pos < pt->size) {
-          byNext = *lp++;
-          pos++;
-        } else {
-          nRunCount = xl - ix;  // corrupted chart, just run to the end
-          break;
-        }
-        nRunCount = nRunCount * 128 + (byNext & 0x7f);
-      }
-
-      nRunCount++;
-    }
-
-    if (ix < xs) {
-      if (ix + nRunCount <= (unsigned int)xs) {
-        ix += nRunCount;
-        continue;
-      }
-      nRunCount -= xs - ix;
-      ix = xs;
-    }
-
-    if (ix + nRunCount >= (unsigned int)xl) {
-      nRunCount = xl - 1 - ix;
-      bLastPixValueValid = true;
-    }
-
-    rgbval = (int)(pPalette[nPixValue]);
-
-    //    Optimization for most usual case
-    // currently this is the only case possible...
-    //          if((BPP == 24) && (1 == sub_samp))
-    {
-      int count = nRunCount;
-      if (count < 16) {
-        // for short runs, use simple loop
-        while (count--) {
-          *(uint32_t *)prgb = rgbval;
-          prgb += 3;
-        }
-      } else if (rgbval == 0 || rgbval == 0xffffff) {
-        // optimization for black or white (could work for any gray too)
-        memset(prgb, rgbval, nRunCount * 3);
-        prgb += nRunCount * 3;
-      } else {
-        // note: this may not be optimal for all processors and compilers
-        // I optimized for x86_64 using gcc with -O3
-        // it is probably possible to gain even faster performance by ensuring
-        // alignment to 16 or 32byte boundary (depending on processor) then
-        // using inline assembly
-
-#ifdef __ARM_ARCH
-        //  ARM needs 8 byte alignment for *(uint64_T *x) = *(uint64_T *y)
-        //  because the compiler will (probably) use the ldrd/strd instuction
-        //  pair. So, advance the prgb pointer until it is 8-byte aligned, and
-        //  then carry on if enough bytes are left to process as 64 bit elements
-
-        if ((long)prgb & 7) {
-          while (count--) {
-            *(uint32_t *)prgb = rgbval;
-            prgb += 3;
-            if (!((long)prgb & 7)) {
-              if (count >= 8) break;
-            }
-          }
-        }
-#endif
-
-        // fill first 24 bytes
-        uint64_t *b = (uint64_t *)prgb;
-        for (int i = 0; i < 8; i++) {
-          *(uint32_t *)prgb = rgbval;
-          prgb += 3;
-        }
-        count -= 8;
-
-        // fill in blocks of 24 bytes
-        uint64_t *y = (uint64_t *)prgb;
-        int count_d8 = count >> 3;
-        prgb += 24 * count_d8;
-        while (count_d8--) {
-          *y++ = b[0];
-          *y++ = b[1];
-          *y++ = b[2];
-        }
-
-        // fill remaining bytes
-        int rcount = count & 0x7;
-        while (rcount--) {
-          *(uint32_t *)prgb = rgbval;
-          prgb += 3;
-        }
-      }
-    }
-
-    ix += nRunCount;
-  }
-
-  // Get the last pixel explicitely
-  //  irrespective of the sub_sampling factor
-
-  if (ix < xl) {
-    if (!bLastPixValueValid) {
-      if (pos < pt->size) {
-        byNext = *lp++;
-        pos++;
-      } else {
-        byNext = 0;
-      }
-      nPixValue = (byNext & byValueMask) >> nValueShift;
-    }
-    rgbval = (int)(pPalette[nPixValue]);  // last pixel
-    unsigned char a = rgbval & 0xff;
-
-    *prgb++ = a;
-    a = (rgbval >> 8) & 0xff;
-    *prgb++ = a;
-    a = (rgbval >> 16) & 0xff;
-    *prgb = a;
-  }
+  Raster_ExpandBSB_24(lp, pt->pPix + pt->size, ix, xs, xl, nColorSize,
+                      pPalette, prgb);
 #endif
 
 #ifdef PRINT_TIMINGS
@@ -4331,7 +4184,7 @@ nocachestart:
 #ifndef USE_OLD_CACHE
     free(pt->pTileOffset);
 #endif
-    free(pt->pPix);
+    if (!pt->bMapped) free(pt->pPix);
   }
 
   return 1;
@@ -4637,27 +4490,23 @@ int ChartBaseBSB::AnalyzeRefpoints(bool b_testSolution) {
   //          Build the Control Point Structure, etc
   cPoints.count = nRefpoint;
   if (cPoints.status) {
-    // AnalyzeRefpoints can be called twice
+    // AnalyzeRefpoints can be called twice, keep the coefficients of the
+    // previous solution for SolveGeoref()
     free(cPoints.tx);
     free(cPoints.ty);
     free(cPoints.lon);
     free(cPoints.lat);
-
-    free(cPoints.pwx);
-    free(cPoints.wpx);
-    free(cPoints.pwy);
-    free(cPoints.wpy);
+  } else {
+    cPoints.pwx = (double *)malloc(12 * sizeof(double));
+    cPoints.wpx = (double *)malloc(12 * sizeof(double));
+    cPoints.pwy = (double *)malloc(12 * sizeof(double));
+    cPoints.wpy = (double *)malloc(12 * sizeof(double));
   }
 
   cPoints.tx = (double *)malloc(nRefpoint * sizeof(double));
   cPoints.ty = (double *)malloc(nRefpoint * sizeof(double));
   cPoints.lon = (double *)malloc(nRefpoint * sizeof(double));
   cPoints.lat = (double *)malloc(nRefpoint * sizeof(double));
-
-  cPoints.pwx = (double *)malloc(12 * sizeof(double));
-  cPoints.wpx = (double *)malloc(12 * sizeof(double));
-  cPoints.pwy = (double *)malloc(12 * sizeof(double));
-  cPoints.wpy = (double *)malloc(12 * sizeof(double));
   cPoints.status = 1;
 
   //  Find the two REF points that are farthest apart
@@ -4722,7 +4571,7 @@ int ChartBaseBSB::AnalyzeRefpoints(bool b_testSolution) {
     toTM(latmin, lonmin, m_proj_lat, m_proj_lon, &cPoints.lonmin,
          &cPoints.latmin);
 
-    Georef_Calculate_Coefficients_Proj(&cPoints);
+    SolveGeoref();
 
   }
 
@@ -4775,7 +4624,7 @@ int ChartBaseBSB::AnalyzeRefpoints(bool b_testSolution) {
     toSM_ECC(latmin, lonmin, m_proj_lat, m_proj_lon, &cPoints.lonmin,
              &cPoints.latmin);
 
-    Georef_Calculate_Coefficients_Proj(&cPoints);
+    SolveGeoref();
 
     //              for(int h=0 ; h < 10 ; h++)
     //                    printf("pix to east %d  %g\n",  h, cPoints.pwx[h]); //
@@ -4869,7 +4718,7 @@ int ChartBaseBSB::AnalyzeRefpoints(bool b_testSolution) {
     toPOLY(latmin, lonmin, m_proj_lat, m_proj_lon, &cPoints.lonmin,
            &cPoints.latmin);
 
-    Georef_Calculate_Coefficients_Proj(&cPoints);
+    SolveGeoref();
 
     //              for(int h=0 ; h < 10 ; h++)
     //                    printf("pix to east %d  %g\n",  h, cPoints.pwx[h]); //
@@ -5078,6 +4927,23 @@ int ChartBaseBSB::AnalyzeRefpoints(bool b_testSolution) {
   return (0);
 }
 
+void ChartBaseBSB::SolveGeoref() {
+  //  The header pass and PostInit() analyze the same refpoints, only solve
+  //  again when the input of the solver changed.
+  std::vector<double> input = {
+      double(cPoints.count), double(cPoints.txmin), double(cPoints.txmax),
+      double(cPoints.tymin), double(cPoints.tymax), cPoints.lonmin,
+      cPoints.lonmax,        cPoints.latmin,        cPoints.latmax};
+  input.insert(input.end(), cPoints.tx, cPoints.tx + cPoints.count);
+  input.insert(input.end(), cPoints.ty, cPoints.ty + cPoints.count);
+  input.insert(input.end(), cPoints.lon, cPoints.lon + cPoints.count);
+  input.insert(input.end(), cPoints.lat, cPoints.lat + cPoints.count);
+  if (input == m_georef_input) return;
+
+  Georef_Calculate_Coefficients_Proj(&cPoints);
+  m_georef_input.swap(input);
+}
+
 double ChartBaseBSB::AdjustLongitude(double lon) {
   double lond = (m_LonMin + m_LonMax) / 2 - lon;
   if (lond > 180)
@@ -51,6 +51,7 @@
 #include "model/navobj_db.h"
 #include "model/navutil_base.h"
 #include "model/own_ship.h"
+#include "model/pipeline_stats.h"
 #include "model/plugin_comm.h"
 #include "model/route.h"
 #include "model/routeman.h"
@@ -12206,6 +12207,7 @@ void ChartCanvas::OnPaint(wxPaintEvent &event) {
   dc.DestroyClippingRegion();
 
   PaintCleanup();
+  PipelineStats::GetInstance().RecordCanvasRefresh();
 }
 
 void ChartCanvas::PaintCleanup() {
@@ -23,6 +23,7 @@
 
 #include <algorithm>
 #include <unordered_map>
+#include <vector>
 #include <stdio.h>
 
 // For compilers that support precompilation, includes "wx.h".
@@ -37,6 +38,7 @@
 #include <wx/mstream.h>
 #include <wx/regex.h>
 #include <wx/spinctrl.h>
+#include <wx/stopwatch.h>
 #include <wx/textfile.h>
 #include <wx/tokenzr.h>
 
@@ -45,6 +47,7 @@
 
 #include "chcanv.h"
 #include "cm93.h"
+#include "cm93_cell_cache.h"
 #include "detail_slider.h"
 #include "gui_lib.h"
 #include "line_clip.h"
@@ -941,94 +944,57 @@ void CreateDecodeTable() {
   }
 }
 
-static int read_and_decode_bytes(FILE *stream, void *p, int nbytes) {
-  if (0 == nbytes)  // declare victory if no bytes requested
-    return 1;
-
-  //    read into callers buffer
-  if (fread(p, nbytes, 1, stream) != 1) return 0;
-
-  //    decode inplace
-  unsigned char *q = (unsigned char *)p;
-
-  for (int i = 0; i < nbytes; i++) {
-    unsigned char a = *q;
-    int b = a;
-    unsigned char c = Decode_table[b];
-    *q = c;
-
-    q++;
+//    Decode nbytes inplace. The table lookup has no cheap SIMD form, so the
+//    loop is unrolled to keep several independent lookups in flight.
+static void decode_bytes(unsigned char *p, size_t nbytes) {
+  size_t i = 0;
+  for (; i + 8 <= nbytes; i += 8) {
+    unsigned char c0 = Decode_table[p[i]];
+    unsigned char c1 = Decode_table[p[i + 1]];
+    unsigned char c2 = Decode_table[p[i + 2]];
+    unsigned char c3 = Decode_table[p[i + 3]];
+    unsigned char c4 = Decode_table[p[i + 4]];
+    unsigned char c5 = Decode_table[p[i + 5]];
+    unsigned char c6 = Decode_table[p[i + 6]];
+    unsigned char c7 = Decode_table[p[i + 7]];
+    p[i] = c0;
+    p[i + 1] = c1;
+    p[i + 2] = c2;
+    p[i + 3] = c3;
+    p[i + 4] = c4;
+    p[i + 5] = c5;
+    p[i + 6] = c6;
+    p[i + 7] = c7;
   }
-  return 1;
+  for (; i < nbytes; i++) p[i] = Decode_table[p[i]];
 }
 
-static int read_and_decode_double(FILE *stream, double *p) {
-  double t;
-  //    read into temp buffer
-  if (fread(&t, sizeof(double), 1, stream) != 1) return 0;
-
-  //    decode inplace
-  unsigned char *q = (unsigned char *)&t;
-
-  for (unsigned int i = 0; i < sizeof(double); i++) {
-    unsigned char a = *q;
-    int b = a;
-    unsigned char c = Decode_table[b];
-    *q = c;
-
-    q++;
-  }
+//    A whole cell file, read and decoded at once
+struct cm93_stream {
+  const unsigned char *p;
+  const unsigned char *end;
+};
 
-  //    copy to target
-  *p = t;
+static int read_bytes(cm93_stream &stream, void *p, int nbytes) {
+  if (0 == nbytes)  // declare victory if no bytes requested
+    return 1;
 
+  if (nbytes < 0 || nbytes > stream.end - stream.p) return 0;
+  memcpy(p, stream.p, nbytes);
+  stream.p += nbytes;
   return 1;
 }
 
-static int read_and_decode_int(FILE *stream, int *p) {
-  int t;
-  //    read into temp buffer
-  if (fread(&t, sizeof(int), 1, stream) != 1) return 0;
-
-  //    decode inplace
-  unsigned char *q = (unsigned char *)&t;
-
-  for (unsigned int i = 0; i < sizeof(int); i++) {
-    unsigned char a = *q;
-    int b = a;
-    unsigned char c = Decode_table[b];
-    *q = c;
-
-    q++;
-  }
-
-  //    copy to target
-  *p = t;
-
-  return 1;
+static int read_double(cm93_stream &stream, double *p) {
+  return read_bytes(stream, p, sizeof(double));
 }
 
-static int read_and_decode_ushort(FILE *stream, unsigned short *p) {
-  unsigned short t;
-  //    read into temp buffer
-  if (fread(&t, sizeof(unsigned short), 1, stream) != 1) return 0;
-
-  //    decode inplace
-  unsigned char *q = (unsigned char *)&t;
-
-  for (unsigned int i = 0; i < sizeof(unsigned short); i++) {
-    unsigned char a = *q;
-    int b = a;
-    unsigned char c = Decode_table[b];
-    *q = c;
-
-    q++;
-  }
-
-  //    copy to target
-  *p = t;
+static int read_int(cm93_stream &stream, int *p) {
+  return read_bytes(stream, p, sizeof(int));
+}
 
-  return 1;
+static int read_ushort(cm93_stream &stream, unsigned short *p) {
+  return read_bytes(stream, p, sizeof(unsigned short));
 }
 
 //    Calculate the CM93 CellIndex integer for a given Lat/Lon, at a given scale
@@ -1222,7 +1188,8 @@ bool Is_CM93Cell_Present(wxString &fileprefix, double lat, double lon,
   return false;
 }
 
-static bool read_header_and_populate_cib(FILE *stream, Cell_Info_Block *pCIB) {
+static bool read_header_and_populate_cib(cm93_stream &stream,
+                                         Cell_Info_Block *pCIB) {
   //    Read header, populate Cell_Info_Block
 
   //    This 128 byte block is read element-by-element, to allow for
@@ -1233,40 +1200,40 @@ static bool read_header_and_populate_cib(FILE *stream, Cell_Info_Block *pCIB) {
 
   memset((void *)&header, 0, sizeof(header));
 
-  read_and_decode_double(stream, &header.lon_min);
-  read_and_decode_double(stream, &header.lat_min);
-  read_and_decode_double(stream, &header.lon_max);
-  read_and_decode_double(stream, &header.lat_max);
-
-  read_and_decode_double(stream, &header.easting_min);
-  read_and_decode_double(stream, &header.northing_min);
-  read_and_decode_double(stream, &header.easting_max);
-  read_and_decode_double(stream, &header.northing_max);
-
-  read_and_decode_ushort(stream, &header.usn_vector_records);
-  read_and_decode_int(stream, &header.n_vector_record_points);
-  read_and_decode_int(stream, &header.m_46);
-  read_and_decode_int(stream, &header.m_4a);
-  read_and_decode_ushort(stream, &header.usn_point3d_records);
-  read_and_decode_int(stream, &header.m_50);
-  read_and_decode_int(stream, &header.m_54);
-  read_and_decode_ushort(stream, &header.usn_point2d_records);
-  read_and_decode_ushort(stream, &header.m_5a);
-  read_and_decode_ushort(stream, &header.m_5c);
-  read_and_decode_ushort(stream, &header.usn_feature_records);
-
-  read_and_decode_int(stream, &header.m_60);
-  read_and_decode_int(stream, &header.m_64);
-  read_and_decode_ushort(stream, &header.m_68);
-  read_and_decode_ushort(stream, &header.m_6a);
-  read_and_decode_ushort(stream, &header.m_6c);
-  read_and_decode_int(stream, &header.m_nrelated_object_pointers);
-
-  read_and_decode_int(stream, &header.m_72);
-  read_and_decode_ushort(stream, &header.m_76);
-
-  read_and_decode_int(stream, &header.m_78);
-  read_and_decode_int(stream, &header.m_7c);
+  read_double(stream, &header.lon_min);
+  read_double(stream, &header.lat_min);
+  read_double(stream, &header.lon_max);
+  read_double(stream, &header.lat_max);
+
+  read_double(stream, &header.easting_min);
+  read_double(stream, &header.northing_min);
+  read_double(stream, &header.easting_max);
+  read_double(stream, &header.northing_max);
+
+  read_ushort(stream, &header.usn_vector_records);
+  read_int(stream, &header.n_vector_record_points);
+  read_int(stream, &header.m_46);
+  read_int(stream, &header.m_4a);
+  read_ushort(stream, &header.usn_point3d_records);
+  read_int(stream, &header.m_50);
+  read_int(stream, &header.m_54);
+  read_ushort(stream, &header.usn_point2d_records);
+  read_ushort(stream, &header.m_5a);
+  read_ushort(stream, &header.m_5c);
+  read_ushort(stream, &header.usn_feature_records);
+
+  read_int(stream, &header.m_60);
+  read_int(stream, &header.m_64);
+  read_ushort(stream, &header.m_68);
+  read_ushort(stream, &header.m_6a);
+  read_ushort(stream, &header.m_6c);
+  read_int(stream, &header.m_nrelated_object_pointers);
+
+  read_int(stream, &header.m_72);
+  read_ushort(stream, &header.m_76);
+
+  read_int(stream, &header.m_78);
+  read_int(stream, &header.m_7c);
 
   //    Calculate and record the cell coordinate transform coefficients
 
@@ -1297,19 +1264,25 @@ static bool read_header_and_populate_cib(FILE *stream, Cell_Info_Block *pCIB) {
   pCIB->p2dpoint_array =
       (cm93_point *)malloc(pCIB->m_n_point2d_records * sizeof(cm93_point));
 
-  pCIB->pprelated_object_block =
-      (Object **)malloc(header.m_nrelated_object_pointers * sizeof(Object *));
+  //    The pointer blocks are cleared, so CM93CellCache can tell unused
+  //    entries from pointers to other blocks.
+  pCIB->m_nrelated_object_pointers = header.m_nrelated_object_pointers;
+  pCIB->pprelated_object_block = (Object **)calloc(
+      header.m_nrelated_object_pointers, sizeof(Object *));
 
+  pCIB->m_n_vector_descriptors = header.m_4a + header.m_46;
   pCIB->object_vector_record_descriptor_block =
-      (vector_record_descriptor *)malloc((header.m_4a + header.m_46) *
+      (vector_record_descriptor *)calloc(header.m_4a + header.m_46,
                                          sizeof(vector_record_descriptor));
 
+  pCIB->m_n_attribute_bytes = header.m_78;
   pCIB->attribute_block_top = (unsigned char *)calloc(header.m_78, 1);
 
   pCIB->m_nvector_records = header.usn_vector_records;
   pCIB->edge_vector_descriptor_block = (geometry_descriptor *)malloc(
       header.usn_vector_records * sizeof(geometry_descriptor));
 
+  pCIB->m_n_vector_points = header.n_vector_record_points;
   pCIB->pvector_record_block_top =
       (cm93_point *)malloc(header.n_vector_record_points * sizeof(cm93_point));
 
@@ -1317,13 +1290,14 @@ static bool read_header_and_populate_cib(FILE *stream, Cell_Info_Block *pCIB) {
   pCIB->point3d_descriptor_block = (geometry_descriptor *)malloc(
       pCIB->m_n_point3d_records * sizeof(geometry_descriptor));
 
+  pCIB->m_n_point3d_points = header.m_50;
   pCIB->p3dpoint_array =
       (cm93_point_3d *)malloc(header.m_50 * sizeof(cm93_point_3d));
 
   return true;
 }
 
-static bool read_vector_record_table(FILE *stream, int count,
+static bool read_vector_record_table(cm93_stream &stream, int count,
                                      Cell_Info_Block *pCIB) {
   bool brv;
 
@@ -1334,21 +1308,21 @@ static bool read_vector_record_table(FILE *stream, int count,
     p->index = iedge;
 
     unsigned short npoints;
-    brv = !(read_and_decode_ushort(stream, &npoints) == 0);
+    brv = !(read_ushort(stream, &npoints) == 0);
     if (!brv) return false;
 
     p->n_points = npoints;
     p->p_points = q;
 
-    //           brv = read_and_decode_bytes(stream, q, p->n_points *
+    //           brv = read_bytes(stream, q, p->n_points *
     //           sizeof(cm93_point));
     //            if(!brv)
     //                  return false;
 
     unsigned short x, y;
     for (int index = 0; index < p->n_points; index++) {
-      if (!read_and_decode_ushort(stream, &x)) return false;
-      if (!read_and_decode_ushort(stream, &y)) return false;
+      if (!read_ushort(stream, &x)) return false;
+      if (!read_ushort(stream, &y)) return false;
 
       q[index].x = x;
       q[index].y = y;
@@ -1386,27 +1360,28 @@ static bool read_vector_record_table(FILE *stream, int count,
   return true;
 }
 
-static bool read_3dpoint_table(FILE *stream, int count, Cell_Info_Block *pCIB) {
+static bool read_3dpoint_table(cm93_stream &stream, int count,
+                               Cell_Info_Block *pCIB) {
   geometry_descriptor *p = pCIB->point3d_descriptor_block;
   cm93_point_3d *q = pCIB->p3dpoint_array;
 
   for (int i = 0; i < count; i++) {
     unsigned short npoints;
-    if (!read_and_decode_ushort(stream, &npoints)) return false;
+    if (!read_ushort(stream, &npoints)) return false;
 
     p->n_points = npoints;
     p->p_points = (cm93_point *)q;  // might not be the right cast
 
     //            unsigned short t = p->n_points;
 
-    //            if(!read_and_decode_bytes(stream, q, t*6))
+    //            if(!read_bytes(stream, q, t*6))
     //                  return false;
 
     unsigned short x, y, z;
     for (int index = 0; index < p->n_points; index++) {
-      if (!read_and_decode_ushort(stream, &x)) return false;
-      if (!read_and_decode_ushort(stream, &y)) return false;
-      if (!read_and_decode_ushort(stream, &z)) return false;
+      if (!read_ushort(stream, &x)) return false;
+      if (!read_ushort(stream, &y)) return false;
+      if (!read_ushort(stream, &z)) return false;
 
       q[index].x = x;
       q[index].y = y;
@@ -1420,14 +1395,15 @@ static bool read_3dpoint_table(FILE *stream, int count, Cell_Info_Block *pCIB) {
   return true;
 }
 
-static bool read_2dpoint_table(FILE *stream, int count, Cell_Info_Block *pCIB) {
-  //      int rv = read_and_decode_bytes(stream, pCIB->p2dpoint_array, count *
+static bool read_2dpoint_table(cm93_stream &stream, int count,
+                               Cell_Info_Block *pCIB) {
+  //      int rv = read_bytes(stream, pCIB->p2dpoint_array, count *
   //      4);
 
   unsigned short x, y;
   for (int index = 0; index < count; index++) {
-    if (!read_and_decode_ushort(stream, &x)) return false;
-    if (!read_and_decode_ushort(stream, &y)) return false;
+    if (!read_ushort(stream, &x)) return false;
+    if (!read_ushort(stream, &y)) return false;
 
     pCIB->p2dpoint_array[index].x = x;
     pCIB->p2dpoint_array[index].y = y;
@@ -1436,7 +1412,7 @@ static bool read_2dpoint_table(FILE *stream, int count, Cell_Info_Block *pCIB) {
   return true;
 }
 
-static bool read_feature_record_table(FILE *stream, int n_features,
+static bool read_feature_record_table(cm93_stream &stream, int n_features,
                                       Cell_Info_Block *pCIB) {
   try {
     Object *pobj = pCIB->pobject_block;  // head of object array
@@ -1461,11 +1437,10 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
     for (int iobject = 0; iobject < n_features; iobject++) {
       // read the object definition
-      read_and_decode_bytes(stream, &object_type, 1);  // read the object type
-      read_and_decode_bytes(stream, &geom_prim,
-                            1);  // read the object geometry primitive type
-      read_and_decode_ushort(stream,
-                             &obj_desc_bytes);  // read the object byte count
+      read_bytes(stream, &object_type, 1);  // read the object type
+      read_bytes(stream, &geom_prim,
+                 1);  // read the object geometry primitive type
+      read_ushort(stream, &obj_desc_bytes);  // read the object byte count
 
       pobj->otype = object_type;
       pobj->geotype = geom_prim;
@@ -1473,7 +1448,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
       switch (pobj->geotype & 0x0f) {
         case 4:  // AREA
         {
-          if (!read_and_decode_ushort(stream, &n_elements)) return false;
+          if (!read_ushort(stream, &n_elements)) return false;
 
           pobj->n_geom_elements = n_elements;
           t = (pobj->n_geom_elements * 2) + 2;
@@ -1485,7 +1460,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
                                           // object
 
           for (unsigned short i = 0; i < pobj->n_geom_elements; i++) {
-            if (!read_and_decode_ushort(stream, &index)) return false;
+            if (!read_ushort(stream, &index)) return false;
 
             if ((index & 0x1fff) > pCIB->m_nvector_records)
               return false;  // error in this cell, ignore all of it
@@ -1505,8 +1480,8 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
         case 2:  // LINE geometry
         {
-          if (!read_and_decode_ushort(
-                  stream, &n_elements))  // read geometry element count
+          if (!read_ushort(stream,
+                           &n_elements))  // read geometry element count
             return false;
 
           pobj->n_geom_elements = n_elements;
@@ -1521,7 +1496,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
           for (unsigned short i = 0; i < pobj->n_geom_elements; i++) {
             unsigned short geometry_index;
 
-            if (!read_and_decode_ushort(stream, &geometry_index)) return false;
+            if (!read_ushort(stream, &geometry_index)) return false;
 
             if ((geometry_index & 0x1fff) > pCIB->m_nvector_records)
               //                                    *(int *)(0) = 0; // error
@@ -1541,7 +1516,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
         }
 
         case 1: {
-          if (!read_and_decode_ushort(stream, &index)) return false;
+          if (!read_ushort(stream, &index)) return false;
 
           obj_desc_bytes -= 2;
 
@@ -1553,7 +1528,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
         }
 
         case 8: {
-          if (!read_and_decode_ushort(stream, &index)) return false;
+          if (!read_ushort(stream, &index)) return false;
           obj_desc_bytes -= 2;
 
           pobj->n_geom_elements = 1;  // one point
@@ -1569,7 +1544,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
       if ((pobj->geotype & 0x10) == 0x10)  // children/related
       {
         unsigned char nrelated;
-        if (!read_and_decode_bytes(stream, &nrelated, 1)) return false;
+        if (!read_bytes(stream, &nrelated, 1)) return false;
 
         pobj->n_related_objects = nrelated;
         t = (pobj->n_related_objects * 2) + 1;
@@ -1580,7 +1555,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
         Object **w = (Object **)pobj->p_related_object_pointer_array;
         for (unsigned char j = 0; j < pobj->n_related_objects; j++) {
-          if (!read_and_decode_ushort(stream, &index)) return false;
+          if (!read_ushort(stream, &index)) return false;
 
           if (index > pCIB->m_nfeature_records)
             //                              *(int *)(0) = 0; // error
@@ -1597,7 +1572,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
       if ((pobj->geotype & 0x20) == 0x20) {
         unsigned short nrelated;
-        if (!read_and_decode_ushort(stream, &nrelated)) return false;
+        if (!read_ushort(stream, &nrelated)) return false;
 
         pobj->n_related_objects = (unsigned char)(nrelated & 0xFF);
         obj_desc_bytes -= 2;
@@ -1609,7 +1584,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
       if ((pobj->geotype & 0x80) == 0x80)  // attributes
       {
         unsigned char nattr;
-        if (!read_and_decode_bytes(stream, &nattr, 1)) return false;  // m_od
+        if (!read_bytes(stream, &nattr, 1)) return false;  // m_od
 
         pobj->n_attributes = nattr;
         obj_desc_bytes -= 5;
@@ -1619,8 +1594,7 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
         puc10count += obj_desc_bytes;
 
-        if (!read_and_decode_bytes(stream, pobj->attributes_block,
-                                   obj_desc_bytes))
+        if (!read_bytes(stream, pobj->attributes_block, obj_desc_bytes))
           return false;  // the attributes....
 
         if ((pobj->geotype & 0x0f) == 1) {
@@ -1642,71 +1616,54 @@ static bool read_feature_record_table(FILE *stream, int n_features,
 
 bool Ingest_CM93_Cell(const char *cell_file_name, Cell_Info_Block *pCIB) {
   try {
-    int file_length;
-
-    //    Get the file length
+    //    Read and decode the whole file at once
     FILE *flstream = fopen(cell_file_name, "rb");
     if (!flstream) return false;
 
     fseek(flstream, 0, SEEK_END);
-    file_length = ftell(flstream);
+    long file_length = ftell(flstream);
+    fseek(flstream, 0, SEEK_SET);
+
+    if (file_length < 10) {
+      fclose(flstream);
+      return false;
+    }
+    std::vector<unsigned char> buffer(file_length);
+    size_t nread = fread(buffer.data(), 1, file_length, flstream);
     fclose(flstream);
+    if (nread != (size_t)file_length) return false;
 
-    //    Open the file
-    FILE *stream = fopen(cell_file_name, "rb");
-    if (!stream) return false;
+    decode_bytes(buffer.data(), buffer.size());
+    cm93_stream stream = {buffer.data(), buffer.data() + buffer.size()};
 
     //    Validate the integrity of the cell file
 
     unsigned short word0 = 0;
-    ;
     int int0 = 0;
     int int1 = 0;
-    ;
 
-    read_and_decode_ushort(stream,
-                           &word0);      // length of prolog + header (10 + 128)
-    read_and_decode_int(stream, &int0);  // length of table 1
-    read_and_decode_int(stream, &int1);  // length of table 2
+    read_ushort(stream, &word0);  // length of prolog + header (10 + 128)
+    read_int(stream, &int0);      // length of table 1
+    read_int(stream, &int1);      // length of table 2
 
     int test = word0 + int0 + int1;
-    if (test != file_length) {
-      fclose(stream);
-      return false;  // file is corrupt
-    }
+    if (test != file_length) return false;  // file is corrupt
 
     //    Cell is OK, proceed to ingest
 
-    if (!read_header_and_populate_cib(stream, pCIB)) {
-      fclose(stream);
-      return false;
-    }
+    if (!read_header_and_populate_cib(stream, pCIB)) return false;
 
-    if (!read_vector_record_table(stream, pCIB->m_nvector_records, pCIB)) {
-      fclose(stream);
+    if (!read_vector_record_table(stream, pCIB->m_nvector_records, pCIB))
       return false;
-    }
 
-    if (!read_3dpoint_table(stream, pCIB->m_n_point3d_records, pCIB)) {
-      fclose(stream);
+    if (!read_3dpoint_table(stream, pCIB->m_n_point3d_records, pCIB))
       return false;
-    }
 
-    if (!read_2dpoint_table(stream, pCIB->m_n_point2d_records, pCIB)) {
-      fclose(stream);
+    if (!read_2dpoint_table(stream, pCIB->m_n_point2d_records, pCIB))
       return false;
-    }
 
-    if (!read_feature_record_table(stream, pCIB->m_nfeature_records, pCIB)) {
-      fclose(stream);
+    if (!read_feature_record_table(stream, pCIB->m_nfeature_records, pCIB))
       return false;
-    }
-
-    //      int file_end = ftell(stream);
-
-    //      wxASSERT(file_end == file_length);
-
-    fclose(stream);
 
     return true;
   }
@@ -2235,6 +2192,7 @@ int cm93chart::CreateObjChain(int cell_index, int subcell,
 
   int iObj = 0;
   S57Obj *obj;
+  std::vector<PolyTessGeo *> deferred_tess;
 
   double scale = gFrame->GetBestVPScale(this);
   int nativescale = GetNativeScale();
@@ -2375,6 +2333,9 @@ int cm93chart::CreateObjChain(int cell_index, int subcell,
 
           //              Populate the chart context
           obj->m_chart_context = m_this_chart_context;
+
+          if (obj->pPolyTessGeo && !obj->pPolyTessGeo->IsOk())
+            deferred_tess.push_back(obj->pPolyTessGeo);
         }
       }
 
@@ -2390,6 +2351,15 @@ int cm93chart::CreateObjChain(int cell_index, int subcell,
 
   //     CALLGRIND_STOP_INSTRUMENTATION
 
+  //  Tesselate the cell's areas now, across all cores, rather than
+  //  one at a time on the first render.  Single core hosts keep the
+  //  lazy tesselation.
+  wxStopWatch sw;
+  int n_tess = PolyTessGeo::BuildDeferredTessBatch(deferred_tess);
+  if (g_bDebugCM93)
+    printf("   CM93 cell %d%c: tesselated %d areas in %ld ms\n", cell_index,
+           subcell, n_tess, sw.Time());
+
   return 1;
 }
 
@@ -4356,6 +4326,21 @@ int cm93chart::loadsubcell(int cellindex, wxChar sub_char) {
   //    chart mode info display
   m_LastFileName = file;
 
+  if (g_bDebugCM93) {
+    char str[256];
+    strncpy(str, msg.mb_str(), 255);
+    str[255] = 0;
+    printf("   %s\n", str);
+  }
+
+  wxStopWatch sw;
+  wxString source = compfile.Length() ? compfile : file;
+  if (CM93CellCache::GetInstance().Load(source, &m_CIB)) {
+    wxLogDebug("   cm93 cell loaded from cache in %.2f ms",
+               sw.TimeInMicro().ToDouble() / 1000.);
+    return 1;
+  }
+
   // Decompress if needed
   if (compfile.Length()) {
     file = wxFileName::CreateTempFileName(wxFileName(compfile).GetFullName());
@@ -4365,13 +4350,6 @@ int cm93chart::loadsubcell(int cellindex, wxChar sub_char) {
     }
   }
 
-  if (g_bDebugCM93) {
-    char str[256];
-    strncpy(str, msg.mb_str(), 255);
-    str[255] = 0;
-    printf("   %s\n", str);
-  }
-
   //    Ingest it
   if (!Ingest_CM93_Cell((const char *)file.mb_str(), &m_CIB)) {
     wxString msg("   cm93chart  Error ingesting ");
@@ -4383,6 +4361,10 @@ int cm93chart::loadsubcell(int cellindex, wxChar sub_char) {
   }
 
   if (compfile.Length()) wxRemoveFile(file);
+  wxLogDebug("   cm93 cell decoded in %.2f ms",
+             sw.TimeInMicro().ToDouble() / 1000.);
+
+  CM93CellCache::GetInstance().Store(source, m_CIB);
 
   return 1;
 }
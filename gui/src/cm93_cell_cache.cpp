@@ -0,0 +1,652 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+
+#include <wx/wxprec.h>
+#include <wx/dir.h>
+#include <wx/filename.h>
+
+#include "model/mapped_file.h"
+
+#include "cm93_cell_cache.h"
+#include "ocpn_platform.h"
+#include "ssl/sha1.h"
+
+namespace {
+
+const uint32_t kMagic = 0x434d3933;  // "CM93"
+const uint32_t kVersion = 1;
+
+/** Largest count accepted in a cache file. */
+const int32_t kMaxCount = 1 << 24;
+
+/** Index of a null pointer. */
+const int32_t kNone = -1;
+
+/** Cache size above which the least recently used files are removed. */
+const uint64_t kMaxCacheBytes = uint64_t(1) << 30;
+
+/** Age of a leftover temporary file, in seconds. */
+const time_t kStaleTmpAge = 3600;
+
+struct FileHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t source_size;
+  int64_t source_mtime;
+  double transform_x_rate;
+  double transform_y_rate;
+  double transform_x_origin;
+  double transform_y_origin;
+  double min_lat;
+  double min_lon;
+  int32_t n_vector_records;
+  int32_t n_vector_points;
+  int32_t n_point3d_records;
+  int32_t n_point3d_points;
+  int32_t n_point2d_records;
+  int32_t n_feature_records;
+  int32_t n_vector_descriptors;
+  int32_t n_related_pointers;
+  int32_t n_attribute_bytes;
+  int32_t reserved;
+};
+
+/** geometry_descriptor, p_points as index in the point array. */
+struct FileGeometry {
+  uint16_t n_points;
+  uint16_t x_min;
+  uint16_t y_min;
+  uint16_t x_max;
+  uint16_t y_max;
+  uint16_t reserved;
+  int32_t index;
+  int32_t points;
+};
+
+/** vector_record_descriptor, index in the edge vector descriptors. */
+struct FileVectorRecord {
+  int32_t geometry;
+  uint8_t segment_usage;
+  uint8_t reserved[3];
+};
+
+enum RelatedKind : uint8_t { kRelatedNone, kRelatedArray, kRelatedObject };
+
+/**
+ * Object. The block of geometry depends on the geotype. The related object
+ * pointer is either an array in the related object pointer block or the
+ * back link to an object.
+ */
+struct FileObject {
+  uint8_t otype;
+  uint8_t geotype;
+  uint16_t n_geom_elements;
+  int32_t geometry;
+  uint8_t n_related_objects;
+  uint8_t related_kind;
+  uint8_t n_attributes;
+  uint8_t reserved;
+  int32_t related;
+  int32_t attributes;
+};
+
+/** Offsets of the file sections, each 8 bytes aligned. */
+struct Layout {
+  size_t edges;
+  size_t vector_points;
+  size_t point3d;
+  size_t point3d_points;
+  size_t point2d;
+  size_t objects;
+  size_t vector_records;
+  size_t related;
+  size_t attributes;
+  size_t size;
+};
+
+bool GetLayout(const FileHeader &h, Layout &layout) {
+  const int32_t counts[] = {h.n_vector_records,     h.n_vector_points,
+                            h.n_point3d_records,    h.n_point3d_points,
+                            h.n_point2d_records,    h.n_feature_records,
+                            h.n_vector_descriptors, h.n_related_pointers,
+                            h.n_attribute_bytes};
+  for (int32_t count : counts)
+    if (count < 0 || count > kMaxCount) return false;
+
+  size_t offset = sizeof(FileHeader);
+  auto section = [&offset](int32_t count, size_t item_size) {
+    size_t start = offset;
+    offset += (count * item_size + 7) & ~size_t(7);
+    return start;
+  };
+  layout.edges = section(h.n_vector_records, sizeof(FileGeometry));
+  layout.vector_points = section(h.n_vector_points, sizeof(cm93_point));
+  layout.point3d = section(h.n_point3d_records, sizeof(FileGeometry));
+  layout.point3d_points = section(h.n_point3d_points, sizeof(cm93_point_3d));
+  layout.point2d = section(h.n_point2d_records, sizeof(cm93_point));
+  layout.objects = section(h.n_feature_records, sizeof(FileObject));
+  layout.vector_records =
+      section(h.n_vector_descriptors, sizeof(FileVectorRecord));
+  layout.related = section(h.n_related_pointers, sizeof(int32_t));
+  layout.attributes = section(h.n_attribute_bytes, 1);
+  layout.size = offset;
+  return true;
+}
+
+/**
+ * Convert pointer p into an index in the count items from base, the end
+ * of the block included.
+ * @return false if p is outside of the block.
+ */
+template <typename T>
+bool ToIndex(const void *p, const T *base, int count, int32_t &index) {
+  if (!p) {
+    index = kNone;
+    return true;
+  }
+  uintptr_t offset = uintptr_t(p) - uintptr_t(base);
+  if (!base || offset % sizeof(T) || offset / sizeof(T) > size_t(count))
+    return false;
+  index = int32_t(offset / sizeof(T));
+  return true;
+}
+
+/** Check that n items from index fit in a block of count items. */
+inline bool IsValidRange(int32_t index, int32_t n, int32_t count) {
+  return index == kNone || (index >= 0 && n <= count - index);
+}
+
+template <typename T>
+T *FromIndex(int32_t index, T *base) {
+  return index == kNone ? nullptr : base + index;
+}
+
+bool GetSourceStat(const wxString &source, uint64_t &size, int64_t &mtime) {
+  wxFileName fn(source);
+  wxULongLong file_size = fn.GetSize();
+  wxDateTime time = fn.GetModificationTime();
+  if (file_size == wxInvalidSize || !time.IsValid()) return false;
+  size = file_size.GetValue();
+  mtime = time.GetTicks();
+  return true;
+}
+
+bool Serialize(const Cell_Info_Block &cib, std::vector<unsigned char> &data) {
+  FileHeader header;
+  memset(&header, 0, sizeof(header));
+  header.magic = kMagic;
+  header.version = kVersion;
+  header.transform_x_rate = cib.transform_x_rate;
+  header.transform_y_rate = cib.transform_y_rate;
+  header.transform_x_origin = cib.transform_x_origin;
+  header.transform_y_origin = cib.transform_y_origin;
+  header.min_lat = cib.min_lat;
+  header.min_lon = cib.min_lon;
+  header.n_vector_records = cib.m_nvector_records;
+  header.n_vector_points = cib.m_n_vector_points;
+  header.n_point3d_records = cib.m_n_point3d_records;
+  header.n_point3d_points = cib.m_n_point3d_points;
+  header.n_point2d_records = cib.m_n_point2d_records;
+  header.n_feature_records = cib.m_nfeature_records;
+  header.n_vector_descriptors = cib.m_n_vector_descriptors;
+  header.n_related_pointers = cib.m_nrelated_object_pointers;
+  header.n_attribute_bytes = cib.m_n_attribute_bytes;
+
+  Layout layout;
+  if (!GetLayout(header, layout)) return false;
+  data.assign(layout.size, 0);
+  unsigned char *p = data.data();
+  memcpy(p, &header, sizeof(header));
+
+  auto *edges = reinterpret_cast<FileGeometry *>(p + layout.edges);
+  for (int i = 0; i < cib.m_nvector_records; i++) {
+    const geometry_descriptor &g = cib.edge_vector_descriptor_block[i];
+    edges[i] = {g.n_points, g.x_min, g.y_min, g.x_max, g.y_max, 0, g.index};
+    if (!ToIndex(g.p_points, cib.pvector_record_block_top,
+                 cib.m_n_vector_points, edges[i].points))
+      return false;
+  }
+  auto *point3d = reinterpret_cast<FileGeometry *>(p + layout.point3d);
+  for (int i = 0; i < cib.m_n_point3d_records; i++) {
+    const geometry_descriptor &g = cib.point3d_descriptor_block[i];
+    point3d[i] = {g.n_points, g.x_min, g.y_min, g.x_max, g.y_max, 0, g.index};
+    if (!ToIndex(g.p_points, cib.p3dpoint_array, cib.m_n_point3d_points,
+                 point3d[i].points))
+      return false;
+  }
+  if (cib.m_n_vector_points)
+    memcpy(p + layout.vector_points, cib.pvector_record_block_top,
+           cib.m_n_vector_points * sizeof(cm93_point));
+  if (cib.m_n_point3d_points)
+    memcpy(p + layout.point3d_points, cib.p3dpoint_array,
+           cib.m_n_point3d_points * sizeof(cm93_point_3d));
+  if (cib.m_n_point2d_records)
+    memcpy(p + layout.point2d, cib.p2dpoint_array,
+           cib.m_n_point2d_records * sizeof(cm93_point));
+  if (cib.m_n_attribute_bytes)
+    memcpy(p + layout.attributes, cib.attribute_block_top,
+           cib.m_n_attribute_bytes);
+
+  auto *objects = reinterpret_cast<FileObject *>(p + layout.objects);
+  for (int i = 0; i < cib.m_nfeature_records; i++) {
+    const Object &o = cib.pobject_block[i];
+    FileObject &f = objects[i];
+    f.otype = o.otype;
+    f.geotype = o.geotype;
+    f.n_geom_elements = o.n_geom_elements;
+    f.n_related_objects = o.n_related_objects;
+    f.n_attributes = o.n_attributes;
+
+    bool ok;
+    switch (o.geotype & 0x0f) {
+      case 2:
+      case 4:
+        ok = ToIndex(o.pGeometry, cib.object_vector_record_descriptor_block,
+                     cib.m_n_vector_descriptors, f.geometry);
+        break;
+      case 1:
+        ok = ToIndex(o.pGeometry, cib.p2dpoint_array, cib.m_n_point2d_records,
+                     f.geometry);
+        break;
+      case 8:
+        ok = ToIndex(o.pGeometry, cib.point3d_descriptor_block,
+                     cib.m_n_point3d_records, f.geometry);
+        break;
+      default:
+        ok = !o.pGeometry;
+        f.geometry = kNone;
+    }
+    if (!ok) return false;
+
+    // Back links are set in the related objects, whatever their geotype.
+    f.related_kind = kRelatedNone;
+    if (ToIndex(o.p_related_object_pointer_array, cib.pprelated_object_block,
+                cib.m_nrelated_object_pointers, f.related)) {
+      if (f.related != kNone) f.related_kind = kRelatedArray;
+    } else if (ToIndex(o.p_related_object_pointer_array, cib.pobject_block,
+                       cib.m_nfeature_records, f.related)) {
+      f.related_kind = kRelatedObject;
+    } else {
+      return false;
+    }
+
+    if (!ToIndex(o.attributes_block, cib.attribute_block_top,
+                 cib.m_n_attribute_bytes, f.attributes))
+      return false;
+  }
+
+  auto *records =
+      reinterpret_cast<FileVectorRecord *>(p + layout.vector_records);
+  for (int i = 0; i < cib.m_n_vector_descriptors; i++) {
+    const vector_record_descriptor &r =
+        cib.object_vector_record_descriptor_block[i];
+    records[i].segment_usage = r.segment_usage;
+    if (!ToIndex(r.pGeom_Description, cib.edge_vector_descriptor_block,
+                 cib.m_nvector_records, records[i].geometry))
+      return false;
+  }
+
+  auto *related = reinterpret_cast<int32_t *>(p + layout.related);
+  for (int i = 0; i < cib.m_nrelated_object_pointers; i++) {
+    if (!ToIndex(cib.pprelated_object_block[i], cib.pobject_block,
+                 cib.m_nfeature_records, related[i]))
+      return false;
+  }
+  return true;
+}
+
+/** Check all indexes of a mapped cache file before any allocation. */
+bool Validate(const FileHeader &h, const Layout &layout,
+              const unsigned char *p) {
+  auto *edges = reinterpret_cast<const FileGeometry *>(p + layout.edges);
+  for (int i = 0; i < h.n_vector_records; i++)
+    if (!IsValidRange(edges[i].points, edges[i].n_points, h.n_vector_points))
+      return false;
+  auto *point3d = reinterpret_cast<const FileGeometry *>(p + layout.point3d);
+  for (int i = 0; i < h.n_point3d_records; i++)
+    if (!IsValidRange(point3d[i].points, point3d[i].n_points,
+                      h.n_point3d_points))
+      return false;
+
+  // Attribute blocks follow each other in object order, so the block of
+  // an object ends where the next one starts. Each attribute takes at
+  // least one byte.
+  int32_t attributes_end = h.n_attribute_bytes;
+  auto *objects = reinterpret_cast<const FileObject *>(p + layout.objects);
+  for (int i = h.n_feature_records - 1; i >= 0; i--) {
+    const FileObject &f = objects[i];
+    int32_t geometry_count, n_geometry = 1;
+    switch (f.geotype & 0x0f) {
+      case 2:
+      case 4:
+        geometry_count = h.n_vector_descriptors;
+        n_geometry = f.n_geom_elements;
+        break;
+      case 1:
+        geometry_count = h.n_point2d_records;
+        break;
+      case 8:
+        geometry_count = h.n_point3d_records;
+        break;
+      default:
+        geometry_count = 0;
+        n_geometry = 0;
+    }
+    if (!IsValidRange(f.geometry, n_geometry, geometry_count)) return false;
+    if (f.attributes != kNone) {
+      if (!IsValidRange(f.attributes, f.n_attributes, attributes_end))
+        return false;
+      attributes_end = f.attributes;
+    }
+    switch (f.related_kind) {
+      case kRelatedNone:
+        break;
+      case kRelatedArray:
+        if (!IsValidRange(f.related, f.n_related_objects,
+                          h.n_related_pointers))
+          return false;
+        break;
+      case kRelatedObject:
+        if (!IsValidRange(f.related, 1, h.n_feature_records)) return false;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  auto *records =
+      reinterpret_cast<const FileVectorRecord *>(p + layout.vector_records);
+  for (int i = 0; i < h.n_vector_descriptors; i++)
+    if (!IsValidRange(records[i].geometry, 1, h.n_vector_records))
+      return false;
+
+  auto *related = reinterpret_cast<const int32_t *>(p + layout.related);
+  for (int i = 0; i < h.n_related_pointers; i++)
+    if (!IsValidRange(related[i], 1, h.n_feature_records)) return false;
+  return true;
+}
+
+/** Return a malloc'ed copy of size bytes at p. */
+void *CopyBlock(const unsigned char *p, size_t size) {
+  void *block = malloc(size);
+  if (block && size) memcpy(block, p, size);
+  return block;
+}
+
+void WriteFile(const std::string &path,
+               const std::vector<unsigned char> &data) {
+  // Write aside and rename, readers never see a partial file.
+  std::string tmp_path = path + ".tmp";
+  FILE *f = fopen(tmp_path.c_str(), "wb");
+  if (!f) return;
+  bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+  ok = fclose(f) == 0 && ok;
+  if (ok) {
+    remove(path.c_str());
+    ok = rename(tmp_path.c_str(), path.c_str()) == 0;
+  }
+  if (!ok) remove(tmp_path.c_str());
+}
+
+/**
+ * Remove the least recently used files in dir until it holds at most
+ * kMaxCacheBytes, and temporary files left by an interrupted write.
+ */
+void Prune(const wxString &dir) {
+  if (!wxDir::Exists(dir)) return;
+  wxArrayString files;
+  wxDir::GetAllFiles(dir, &files, wxEmptyString, wxDIR_FILES);
+
+  struct Entry {
+    time_t mtime;
+    uint64_t size;
+    wxString path;
+  };
+  std::vector<Entry> entries;
+  uint64_t total = 0;
+  time_t now = time(nullptr);
+  for (const wxString &path : files) {
+    wxFileName fn(path);
+    wxULongLong size = fn.GetSize();
+    wxDateTime modified = fn.GetModificationTime();
+    if (size == wxInvalidSize || !modified.IsValid()) continue;
+    if (fn.GetExt() == "tmp") {
+      if (now - modified.GetTicks() > kStaleTmpAge) wxRemoveFile(path);
+      continue;
+    }
+    entries.push_back({modified.GetTicks(), size.GetValue(), path});
+    total += size.GetValue();
+  }
+  if (total <= kMaxCacheBytes) return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) { return a.mtime < b.mtime; });
+  for (const Entry &entry : entries) {
+    if (total <= kMaxCacheBytes) break;
+    if (wxRemoveFile(entry.path)) total -= entry.size;
+  }
+}
+
+}  // namespace
+
+CM93CellCache &CM93CellCache::GetInstance() {
+  static CM93CellCache instance;
+  return instance;
+}
+
+CM93CellCache::CM93CellCache() : m_stop(false) {}
+
+CM93CellCache::~CM93CellCache() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_one();
+  if (m_thread.joinable()) m_thread.join();
+}
+
+wxString CM93CellCache::CacheDir() {
+  wxString sep = wxFileName::GetPathSeparator();
+  return g_Platform->GetPrivateDataDir() + sep + "cm93" + sep + "cells";
+}
+
+std::string CM93CellCache::CachePath(const wxString &source) {
+  wxCharBuffer buf = source.ToUTF8();
+  unsigned char sha1_out[20];
+  sha1((unsigned char *)buf.data(), strlen(buf.data()), sha1_out);
+
+  wxString name;
+  for (unsigned int i = 0; i < 20; i++)
+    name += wxString::Format("%02X", sha1_out[i]);
+
+  return (CacheDir() + wxFileName::GetPathSeparator() + name).ToStdString();
+}
+
+bool CM93CellCache::Load(const wxString &source, Cell_Info_Block *pCIB) {
+  uint64_t source_size;
+  int64_t source_mtime;
+  if (!GetSourceStat(source, source_size, source_mtime)) return false;
+
+  std::string path = CachePath(source);
+  if (!wxFileName::FileExists(path)) return false;
+  MappedFile file;
+  if (!file.Open(path) || file.GetSize() < sizeof(FileHeader)) return false;
+  const unsigned char *p = file.GetData();
+
+  FileHeader h;
+  memcpy(&h, p, sizeof(h));
+  Layout layout;
+  if (h.magic != kMagic || h.version != kVersion ||
+      h.source_size != source_size || h.source_mtime != source_mtime ||
+      !GetLayout(h, layout) || layout.size != file.GetSize() ||
+      !Validate(h, layout, p))
+    return false;
+
+  pCIB->transform_x_rate = h.transform_x_rate;
+  pCIB->transform_y_rate = h.transform_y_rate;
+  pCIB->transform_x_origin = h.transform_x_origin;
+  pCIB->transform_y_origin = h.transform_y_origin;
+  pCIB->min_lat = h.min_lat;
+  pCIB->min_lon = h.min_lon;
+
+  pCIB->m_nvector_records = h.n_vector_records;
+  pCIB->m_n_vector_points = h.n_vector_points;
+  pCIB->m_n_point3d_records = h.n_point3d_records;
+  pCIB->m_n_point3d_points = h.n_point3d_points;
+  pCIB->m_n_point2d_records = h.n_point2d_records;
+  pCIB->m_nfeature_records = h.n_feature_records;
+  pCIB->m_n_vector_descriptors = h.n_vector_descriptors;
+  pCIB->m_nrelated_object_pointers = h.n_related_pointers;
+  pCIB->m_n_attribute_bytes = h.n_attribute_bytes;
+
+  //    Same blocks as read_header_and_populate_cib(), freed the same way
+  pCIB->pvector_record_block_top = (cm93_point *)CopyBlock(
+      p + layout.vector_points, h.n_vector_points * sizeof(cm93_point));
+  pCIB->p3dpoint_array = (cm93_point_3d *)CopyBlock(
+      p + layout.point3d_points, h.n_point3d_points * sizeof(cm93_point_3d));
+  pCIB->p2dpoint_array = (cm93_point *)CopyBlock(
+      p + layout.point2d, h.n_point2d_records * sizeof(cm93_point));
+  pCIB->attribute_block_top = (unsigned char *)CopyBlock(
+      p + layout.attributes, h.n_attribute_bytes);
+
+  pCIB->edge_vector_descriptor_block = (geometry_descriptor *)malloc(
+      h.n_vector_records * sizeof(geometry_descriptor));
+  auto *edges = reinterpret_cast<const FileGeometry *>(p + layout.edges);
+  for (int i = 0; i < h.n_vector_records; i++) {
+    const FileGeometry &f = edges[i];
+    pCIB->edge_vector_descriptor_block[i] = {
+        f.n_points, f.x_min, f.y_min, f.x_max, f.y_max, f.index,
+        FromIndex(f.points, pCIB->pvector_record_block_top)};
+  }
+
+  pCIB->point3d_descriptor_block = (geometry_descriptor *)malloc(
+      h.n_point3d_records * sizeof(geometry_descriptor));
+  auto *point3d = reinterpret_cast<const FileGeometry *>(p + layout.point3d);
+  for (int i = 0; i < h.n_point3d_records; i++) {
+    const FileGeometry &f = point3d[i];
+    pCIB->point3d_descriptor_block[i] = {
+        f.n_points, f.x_min, f.y_min, f.x_max, f.y_max, f.index,
+        (cm93_point *)FromIndex(f.points, pCIB->p3dpoint_array)};
+  }
+
+  pCIB->pobject_block =
+      (Object *)calloc(h.n_feature_records * sizeof(Object), 1);
+  pCIB->object_vector_record_descriptor_block =
+      (vector_record_descriptor *)calloc(h.n_vector_descriptors,
+                                         sizeof(vector_record_descriptor));
+  pCIB->pprelated_object_block =
+      (Object **)calloc(h.n_related_pointers, sizeof(Object *));
+
+  auto *records =
+      reinterpret_cast<const FileVectorRecord *>(p + layout.vector_records);
+  for (int i = 0; i < h.n_vector_descriptors; i++) {
+    vector_record_descriptor &r =
+        pCIB->object_vector_record_descriptor_block[i];
+    r.pGeom_Description =
+        FromIndex(records[i].geometry, pCIB->edge_vector_descriptor_block);
+    r.segment_usage = records[i].segment_usage;
+  }
+
+  auto *related = reinterpret_cast<const int32_t *>(p + layout.related);
+  for (int i = 0; i < h.n_related_pointers; i++)
+    pCIB->pprelated_object_block[i] =
+        FromIndex(related[i], pCIB->pobject_block);
+
+  auto *objects = reinterpret_cast<const FileObject *>(p + layout.objects);
+  for (int i = 0; i < h.n_feature_records; i++) {
+    const FileObject &f = objects[i];
+    Object &o = pCIB->pobject_block[i];
+    o.otype = f.otype;
+    o.geotype = f.geotype;
+    o.n_geom_elements = f.n_geom_elements;
+    o.n_related_objects = f.n_related_objects;
+    o.n_attributes = f.n_attributes;
+    switch (f.geotype & 0x0f) {
+      case 2:
+      case 4:
+        o.pGeometry = FromIndex(f.geometry,
+                                pCIB->object_vector_record_descriptor_block);
+        break;
+      case 1:
+        o.pGeometry = FromIndex(f.geometry, pCIB->p2dpoint_array);
+        break;
+      case 8:
+        o.pGeometry = FromIndex(f.geometry, pCIB->point3d_descriptor_block);
+        break;
+      default:
+        o.pGeometry = nullptr;
+    }
+    if (f.related_kind == kRelatedArray)
+      o.p_related_object_pointer_array =
+          FromIndex(f.related, pCIB->pprelated_object_block);
+    else if (f.related_kind == kRelatedObject)
+      o.p_related_object_pointer_array =
+          FromIndex(f.related, pCIB->pobject_block);
+    o.attributes_block = FromIndex(f.attributes, pCIB->attribute_block_top);
+  }
+
+  // Recently used files are the last pruned.
+  file.Close();
+  wxFileName(path).Touch();
+  return true;
+}
+
+void CM93CellCache::Store(const wxString &source, const Cell_Info_Block &cib) {
+  Job job;
+  if (!Serialize(cib, job.data)) return;
+  // Do not write a file that Load() would reject every time.
+  FileHeader *header = reinterpret_cast<FileHeader *>(job.data.data());
+  Layout layout;
+  if (!GetLayout(*header, layout) ||
+      !Validate(*header, layout, job.data.data()))
+    return;
+  if (!GetSourceStat(source, header->source_size, header->source_mtime))
+    return;
+
+  job.path = CachePath(source);
+  wxFileName fn(job.path);
+  if (!fn.DirExists()) wxFileName::Mkdir(fn.GetPath(), 0777, wxPATH_MKDIR_FULL);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_jobs.push_back(std::move(job));
+    if (!m_thread.joinable())
+      m_thread = std::thread(&CM93CellCache::Run, this, CacheDir());
+  }
+  m_cv.notify_one();
+}
+
+void CM93CellCache::Run(wxString dir) {
+  Prune(dir);
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+    if (m_jobs.empty()) return;
+    Job job = std::move(m_jobs.front());
+    m_jobs.pop_front();
+    lock.unlock();
+    WriteFile(job.path, job.data);
+    lock.lock();
+  }
+}
@@ -30,6 +30,8 @@
 #include <wx/choice.h>
 #include <wx/filedlg.h>
 #include <wx/menu.h>
+#include <wx/msgdlg.h>
+#include <wx/numdlg.h>
 #include <wx/panel.h>
 #include <wx/sizer.h>
 #include <wx/statline.h>
@@ -42,6 +44,8 @@
 #endif
 
 #include "model/base_platform.h"
+#include "model/comm_drv_capture.h"
+#include "model/comm_navmsg_bus.h"
 #include "model/data_monitor_src.h"
 #include "model/filters_on_disk.h"
 #include "model/navmsg_filter.h"
@@ -200,7 +204,7 @@ static void AddStdLogline(const Logline& ll, std::ostream& stream, char fs,
     ws << (!ll.error_msg.empty() ? ll.error_msg : "Unknown  error");
   else
     ws << "ok";
-  ws << fs << ll.message << "\n";
+  ws << fs << ll.GetText() << "\n";
   stream << ws;
 }
 
@@ -246,14 +250,6 @@ public:
     m_on_right_click = std::move(f);
   }
 
-  /** Invoke Add(s) for possibly existing instance. */
-  static void AddIfExists(const Logline& ll) {
-    auto window = wxWindow::FindWindowByName("TtyPanel");
-    if (!window) return;
-    auto tty_panel = dynamic_cast<TtyPanel*>(window);
-    if (tty_panel) tty_panel->Add(ll);
-  }
-
 protected:
   wxSize DoGetBestClientSize() const override {
     return {1, static_cast<int>(m_lines * GetCharHeight())};
@@ -470,10 +466,16 @@ public:
       csv_btn->Bind(wxEVT_RADIOBUTTON, [&](const wxCommandEvent& e) {
         m_set_logtype(DataLogger::Format::kCsv, "CSV");
       });
+      auto capture_btn =
+          new wxRadioButton(this, wxID_ANY, _("Binary capture"));
+      capture_btn->Bind(wxEVT_RADIOBUTTON, [&](const wxCommandEvent& e) {
+        m_set_logtype(DataLogger::Format::kCapture, _("Binary capture"));
+      });
       auto left_vbox = new wxStaticBoxSizer(wxVERTICAL, this, _("Log format"));
       left_vbox->Add(default_btn, flags.DoubleBorder());
       left_vbox->Add(vdr_btn, flags);
       left_vbox->Add(csv_btn, flags);
+      left_vbox->Add(capture_btn, flags);
 
       /* Right column: log file */
       m_logger.SetLogfile(m_logger.GetDefaultLogfile());
@@ -561,6 +563,7 @@ public:
     kDeleteFilter,
     kEditActiveFilter,
     kLogSetup,
+    kReplayCapture,
     kViewStdColors,
   };
 
@@ -568,6 +571,7 @@ public:
       : m_parent(parent), m_logger(logger) {
     AppendCheckItem(static_cast<int>(Id::kViewStdColors), _("Use colors"));
     Append(static_cast<int>(Id::kLogSetup), _("Logging..."));
+    Append(static_cast<int>(Id::kReplayCapture), _("Replay capture..."));
     auto filters = new wxMenu("");
     AppendId(filters, Id::kNewFilter, _("Create new..."));
     AppendId(filters, Id::kEditFilter, _("Edit..."));
@@ -582,6 +586,10 @@ public:
           ConfigureLogging();
           break;
 
+        case Id::kReplayCapture:
+          ReplayCapture();
+          break;
+
         case Id::kViewStdColors:
           SetColor(static_cast<int>(Id::kViewStdColors));
           break;
@@ -624,6 +632,28 @@ public:
     monitor->Layout();
   }
 
+  /** Replay a binary capture file to the message bus. */
+  void ReplayCapture() {
+    wxFileDialog dlg(m_parent, _("Select capture file"),
+                     m_logger.GetDefaultLogfile().parent_path().string(), "",
+                     _("Binary capture file (*.ocap)|*.ocap"),
+                     wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+    if (dlg.ShowModal() == wxID_CANCEL) return;
+    long speed = wxGetNumberFromUser(
+        _("Replay speed relative to capture time,\n"
+          "0 replays as fast as possible."),
+        _("Speed:"), _("Replay capture"), 1, 0, 1000, m_parent);
+    if (speed < 0) return;
+    m_replay.reset();  // Stops a running replay.
+    m_replay = std::make_unique<CaptureReplayDriver>(
+        dlg.GetPath().ToStdString(), NavMsgBus::GetInstance(), speed);
+    if (!m_replay->Start()) {
+      wxMessageDialog msg_dlg(m_parent, _("Cannot open capture file"));
+      msg_dlg.ShowModal();
+      m_replay.reset();
+    }
+  }
+
 private:
   static wxMenuItem* AppendId(wxMenu* root, Id id, const wxString& label) {
     return root->Append(static_cast<int>(id), label);
@@ -631,10 +661,9 @@ private:
 
   void SetLogFormat(DataLogger::Format format, const std::string& label) const {
     m_logger.SetFormat(format);
-    std::string extension =
-        format == DataLogger::Format::kDefault ? ".log" : ".csv";
     fs::path path = m_logger.GetLogfile();
-    path = path.parent_path() / (path.stem().string() + extension);
+    path = path.parent_path() /
+           (path.stem().string() + DataLogger::GetExtension(format));
     m_logger.SetLogfile(path);
   }
 
@@ -655,6 +684,7 @@ private:
   wxWindow* m_parent;
   DataLogger& m_logger;
   std::string m_filter;
+  std::unique_ptr<CaptureReplayDriver> m_replay;
 };
 
 /** Button to start/stop logging. */
@@ -838,6 +868,14 @@ DataLogger::DataLogger(wxWindow* parent) : DataLogger(parent, NullLogfile()) {}
 void DataLogger::SetLogging(bool logging) { m_is_logging = logging; }
 
 void DataLogger::SetLogfile(const fs::path& path) {
+  if (m_format == Format::kCapture) {
+    m_stream.close();
+    m_capture.Open(path.string());
+    m_path = path;
+    OnNewLogfile.Notify(path.string());
+    return;
+  }
+  m_capture.Close();
   m_stream = std::ofstream(path);
   m_stream << "# timestamp_format: EPOCH_MILLIS\n";
   const auto now = std::chrono::system_clock::now();
@@ -855,19 +893,36 @@ fs::path DataLogger::GetDefaultLogfile() {
   if (m_path.stem() != NullLogfile().stem()) return m_path;
   fs::path path(g_BasePlatform->GetHomeDir().ToStdString());
   path /= "monitor";
-  path += (m_format == Format::kDefault ? ".log" : ".csv");
+  path += GetExtension(m_format);
   return path;
 }
 
+std::string DataLogger::GetExtension(Format format) {
+  switch (format) {
+    case Format::kDefault:
+      return ".log";
+    case Format::kCapture:
+      return ".ocap";
+    default:
+      return ".csv";
+  }
+}
+
 std::string DataLogger::GetFileDlgTypes() const {
   if (m_format == Format::kDefault)
     return _("Log file (*.log)|*.log");
+  else if (m_format == Format::kCapture)
+    return _("Binary capture file (*.ocap)|*.ocap");
   else
     return _("Spreadsheet csv file(*.csv)|*.csv");
 }
 
 void DataLogger::Add(const Logline& ll) {
   if (!m_is_logging || !ll.navmsg) return;
+  if (m_format == Format::kCapture) {
+    m_capture.Add(*ll.navmsg);
+    return;
+  }
   if (m_format == Format::kVdr && ll.navmsg->to_vdr().empty()) return;
   if (m_format == DataLogger::Format::kVdr)
     AddVdrLogline(ll, m_stream);
@@ -882,12 +937,14 @@ DataMonitor::DataMonitor(wxWindow* parent)
               wxDEFAULT_FRAME_STYLE | wxFRAME_FLOAT_ON_PARENT,
               kDataMonitorWindowName),
       m_monitor_src([&](const std::shared_ptr<const NavMsg>& navmsg) {
-        TtyPanel::AddIfExists(Logline(navmsg));
+        if (m_tty_panel) m_tty_panel->Add(Logline(navmsg));
       }),
+      m_tty_panel(nullptr),
       m_quick_filter(nullptr),
       m_logger(parent) {
   auto vbox = new wxBoxSizer(wxVERTICAL);
   auto tty_panel = new TtyPanel(this, 12);
+  m_tty_panel = tty_panel;
   vbox->Add(tty_panel, wxSizerFlags(1).Expand().Border());
   vbox->Add(new wxStaticLine(this), wxSizerFlags().Expand().Border());
 
@@ -935,14 +992,12 @@ DataMonitor::DataMonitor(wxWindow* parent)
 }
 
 void DataMonitor::Add(const Logline& ll) {
-  TtyPanel::AddIfExists(ll);
+  m_tty_panel->Add(ll);
   m_logger.Add(ll);
 }
 
 bool DataMonitor::IsVisible() const {
-  wxWindow* w = wxWindow::FindWindowByName("TtyPanel");
-  assert(w && "No TtyPanel found");
-  return w->IsShownOnScreen();
+  return m_tty_panel->IsShownOnScreen();
 }
 
 void DataMonitor::OnFilterListChange() {
@@ -32,6 +32,7 @@
 #include "dychart.h"
 
 #include <algorithm>
+#include <list>
 #include <stdint.h>
 #include <vector>
 
@@ -58,6 +59,7 @@
 #include "model/config_vars.h"
 #include "model/gui_vars.h"
 #include "model/own_ship.h"
+#include "model/pipeline_stats.h"
 #include "model/plugin_comm.h"
 #include "model/route.h"
 #include "model/routeman.h"
@@ -340,6 +342,8 @@ void glChartCanvas::Init() {
   SetBackgroundStyle(wxBG_STYLE_CUSTOM);  // on WXMSW, this prevents flashing
 
   m_cache_current_ch = NULL;
+  m_cache_quilt_hash = 0;
+  memset(m_update_stats, 0, sizeof(m_update_stats));
 
   m_b_paint_enable = true;
   m_in_glpaint = false;
@@ -2856,7 +2860,7 @@ void glChartCanvas::DrawRegion(ViewPort &vp, const LLRegion &region) {
   gluTessNormal(tobj, 0, 0, 1);
 
   gluTessBeginPolygon(tobj, NULL);
-  for (std::list<poly_contour>::const_iterator i = region.contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = region.contours.begin();
        i != region.contours.end(); i++) {
     gluTessBeginContour(tobj);
     contour_pt l = *i->rbegin();
@@ -3093,12 +3097,8 @@ void glChartCanvas::RenderRasterChartRegionGL(ChartBase *chart, ViewPort &vp,
         coords = tile->m_coords;
       else {
         coords = new float[2 * tile->m_ncoords];
-        for (int i = 0; i < tile->m_ncoords; i++) {
-          wxPoint2DDouble p = vp.GetDoublePixFromLL(tile->m_coords[2 * i + 0],
-                                                    tile->m_coords[2 * i + 1]);
-          coords[2 * i + 0] = p.m_x;
-          coords[2 * i + 1] = p.m_y;
-        }
+        vp.ProjectLLToPix(tile->m_coords, tile->m_coords + 1, tile->m_ncoords,
+                          coords, 2);
       }
 
 #if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
@@ -3808,6 +3808,7 @@ void glChartCanvas::Render() {
 
   if (m_binPinch) printf("    %ld Render Start\n", m_glstopwatch.Time());
   long render_start_time = m_glstopwatch.Time();
+  wxStopWatch frame_sw;
 
 #if defined(USE_ANDROID_GLES2) || defined(ocpnUSE_GLSL)
   loadShaders(GetCanvasIndex());
@@ -3952,6 +3953,9 @@ void glChartCanvas::Render() {
 
   bool bpost_hilite = !m_pParentCanvas->m_pQuilt->GetHiliteRegion().Empty();
   bool useFBO = false;
+  RenderUpdateType update_type = RENDER_UPDATE_DIRECT;
+  unsigned long quilt_hash =
+      VPoint.b_quilt ? m_pParentCanvas->m_pQuilt->GetXStackHash() : 0;
   int sx = gl_width;
   int sy = gl_height;
 
@@ -3971,8 +3975,10 @@ void glChartCanvas::Render() {
         m_cache_vp.rotation == VPoint.rotation &&
         m_cache_vp.clat == VPoint.clat && m_cache_vp.clon == VPoint.clon &&
         m_cache_vp.IsValid() && m_cache_vp.pix_height == VPoint.pix_height &&
-        m_cache_current_ch == m_pParentCanvas->m_singleChart) {
+        m_cache_current_ch == m_pParentCanvas->m_singleChart &&
+        m_cache_quilt_hash == quilt_hash) {
       b_newview = false;
+      update_type = RENDER_UPDATE_RETAINED;
     }
 
 #ifdef USE_ANDROID_GLES2
@@ -4069,6 +4075,7 @@ void glChartCanvas::Render() {
       if (b_full) accelerated_pan = false;
 
       if (accelerated_pan) {
+        update_type = RENDER_UPDATE_PAN;
         if ((dx != 0) || (dy != 0)) {  // Anything to do?
 
           // calculate the new regions to render
@@ -4223,6 +4230,7 @@ void glChartCanvas::Render() {
 
       else {  // must redraw the entire screen
         // qDebug() << "Fullpage";
+        update_type = RENDER_UPDATE_FULL;
         glFramebufferTexture2D(GL_FRAMEBUFFER_EXT, GL_COLOR_ATTACHMENT0,
                                g_texture_rectangle_format,
                                m_cache_tex[!m_cache_page], 0);
@@ -4353,6 +4361,7 @@ void glChartCanvas::Render() {
     m_cache_vp.Validate();
 
     m_cache_current_ch = m_pParentCanvas->m_singleChart;
+    m_cache_quilt_hash = quilt_hash;
 
     if (VPoint.b_quilt) m_pParentCanvas->m_pQuilt->SetRenderedVP(VPoint);
 
@@ -4360,6 +4369,7 @@ void glChartCanvas::Render() {
   {
     RenderCharts(m_gldc, screen_region);
   }
+  long chart_layer_ms = frame_sw.Time();
 
   if (m_binPinch)
     printf("        Render Charts Done  %ld\n",
@@ -4558,6 +4568,7 @@ void glChartCanvas::Render() {
   if (g_b_needFinish) glFinish();
 
   SwapBuffers();
+  PipelineStats::GetInstance().RecordCanvasRefresh();
 
   g_glTextureManager->TextureCrunch(0.8);
   g_glTextureManager->FactoryCrunch(0.6);
@@ -4565,6 +4576,8 @@ void glChartCanvas::Render() {
   m_pParentCanvas->PaintCleanup();
   m_bforcefull = false;
 
+  AccumulateRenderStats(update_type, chart_layer_ms, frame_sw.Time());
+
   if (m_binPinch)
     printf("    Render Finished:  %ld\n",
            m_glstopwatch.Time() - render_start_time);
@@ -4572,6 +4585,41 @@ void glChartCanvas::Render() {
   n_render++;
 }
 
+void glChartCanvas::AccumulateRenderStats(RenderUpdateType type,
+                                          long chart_ms, long total_ms) {
+  if (!g_bDebugOGL) return;
+
+  RenderUpdateStats &stats = m_update_stats[type];
+  stats.n_frames++;
+  stats.chart_ms += chart_ms;
+  stats.total_ms += total_ms;
+
+  //  Report once every ten seconds, as frames per second and mean frame
+  //  cost for each update type.  GPU busy time is not portably available,
+  //  the share of each update type in the wall time stands in for it.
+  long elapsed = m_update_stats_sw.Time();
+  if (elapsed < 10000) return;
+
+  static const char *const type_names[RENDER_UPDATE_NUM] = {
+      "full", "pan", "retained", "direct"};
+  wxString msg;
+  msg.Printf("OpenGL canvas %d render stats over %ld ms:", GetCanvasIndex(),
+             elapsed);
+  for (int i = 0; i < RENDER_UPDATE_NUM; i++) {
+    RenderUpdateStats &s = m_update_stats[i];
+    if (!s.n_frames) continue;
+    msg += wxString::Format(
+        "  %s: %.1f fps, %.1f ms/frame (charts %.1f), %.1f%% busy",
+        type_names[i], s.n_frames * 1000.0 / elapsed,
+        (double)s.total_ms / s.n_frames,
+        (double)s.chart_ms / s.n_frames, 100.0 * s.total_ms / elapsed);
+  }
+  wxLogMessage(msg);
+
+  memset(m_update_stats, 0, sizeof(m_update_stats));
+  m_update_stats_sw.Start();
+}
+
 void glChartCanvas::RenderS57TextOverlay(ViewPort &VPoint) {
   //  Render the decluttered Text overlay for quilted vector charts, except for
   //  CM93 Composite
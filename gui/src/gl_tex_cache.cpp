@@ -23,6 +23,7 @@
  */
 
 #include <stdint.h>
+#include <vector>
 
 #include <wx/wxprec.h>
 #include <wx/tokenzr.h>
@@ -165,6 +166,7 @@ glTexFactory::glTexFactory(ChartBase *chart, int raster_format) {
   m_catalogCorrupted = false;
 
   m_fs = 0;
+  m_fs_dirty = false;
   m_LRUtime = 0;
   m_ntex = 0;
   m_tiles = NULL;
@@ -376,6 +378,14 @@ void glTexFactory::FreeSome(long target) {
 
     if (ptd) ptd->FreeMap();
   }
+  // Mapped again on demand
+  m_map.Close();
+}
+
+size_t glTexFactory::GetResidentBytes() {
+  int map_size = 0, comp_size = 0, compcomp_size = 0;
+  AccumulateMemStatistics(map_size, comp_size, compcomp_size);
+  return (size_t)map_size + comp_size + compcomp_size + m_map.GetSize();
 }
 
 void glTexFactory::DeleteAllDescriptors() {
@@ -555,10 +565,11 @@ bool glTexFactory::BuildTexture(glTextureDescriptor *ptd, int base_level,
     int texture_level = 0;
     for (int level = base_level; level < ptd->level_min; level++) {
       int size = TextureTileSize(level, true);
-      int status = GetTextureLevel(ptd, rect, level, ptd->m_colorscheme);
+      const unsigned char *data = GetCompressedLevel(ptd, rect, level);
+      if (!data) break;
       int dim = TextureDim(level);
       glCompressedTexImage2D(GL_TEXTURE_2D, texture_level, g_raster_format, dim,
-                             dim, 0, size, ptd->comp_array[level]);
+                             dim, 0, size, data);
 
       ptd->tex_mem_used += size;
       g_tex_mem_used += size;
@@ -878,64 +889,92 @@ bool glTexFactory::UpdateCacheLevel(const wxRect &rect, int level,
   //      This texture is already done
   if (v != 0) return false;
 
-  return UpdateCachePrecomp(data, size, rect, level, color_scheme);
+  return UpdateCachePrecomp(data, size, rect, level, color_scheme, false);
 }
 
 bool glTexFactory::UpdateCacheAllLevels(const wxRect &rect,
                                         ColorScheme color_scheme,
                                         unsigned char **compcomp_array,
-                                        int *compcomp_size) {
+                                        int *compcomp_size,
+                                        bool write_catalog) {
   if (!g_GLOptions.m_bTextureCompressionCaching) return false;
 
   bool work = false;
 
+  // All levels are appended before the catalog is rewritten once.
   for (int level = 0; level < g_mipmap_max_level + 1; level++)
     work |= UpdateCacheLevel(rect, level, color_scheme, compcomp_array[level],
                              compcomp_size[level]);
-  if (work) {
+  if (work && write_catalog) {
     WriteCatalogAndHeader();
   }
 
   return work;
 }
 
+// LZ4 compressed levels are decoded here just before their upload, so one
+// buffer serves all the factories. Only used from the GL thread.
+static std::vector<unsigned char> s_decode_arena;
+
+static const unsigned char *UnpackLevel(const unsigned char *data,
+                                        int data_size, int size) {
+  if (data_size == size) return data;  // stored as is
+  if ((int)s_decode_arena.size() < size) s_decode_arena.resize(size);
+  char *dest = (char *)s_decode_arena.data();
+  if (LZ4_decompress_safe((const char *)data, dest, data_size, size) != size)
+    return NULL;
+  return s_decode_arena.data();
+}
+
+const unsigned char *glTexFactory::MapCacheEntry(const CatalogEntryValue *v) {
+  if (!m_fs || !m_fs->IsOpened()) return NULL;
+  // Tiles written by this factory may still be in the stdio buffer
+  if (m_fs_dirty) {
+    m_fs->Flush();
+    m_fs_dirty = false;
+  }
+  size_t end = (size_t)v->texture_offset + v->compressed_size;
+  if (end > m_map.GetSize()) {
+    // Appended since mapped
+    m_map.Open(m_CompressedCacheFilePath.ToStdString());
+    if (end > m_map.GetSize()) return NULL;
+  }
+  return m_map.GetData() + v->texture_offset;
+}
+
+const unsigned char *glTexFactory::GetCompressedLevel(glTextureDescriptor *ptd,
+                                                      const wxRect &rect,
+                                                      int level) {
+  if (ptd->comp_array[level]) return ptd->comp_array[level];
+
+  int size = TextureTileSize(level, true);
+  if (ptd->compcomp_array[level])
+    return UnpackLevel(ptd->compcomp_array[level], ptd->compcomp_size[level],
+                       size);
+
+  if (!g_GLOptions.m_bTextureCompressionCaching) return NULL;
+  CatalogEntryValue *p =
+      GetCacheEntryValue(level, rect.x, rect.y, ptd->m_colorscheme);
+  const unsigned char *data = p ? MapCacheEntry(p) : NULL;
+  if (!data) return NULL;
+  return UnpackLevel(data, p->compressed_size, size);
+}
+
 int glTexFactory::GetTextureLevel(glTextureDescriptor *ptd, const wxRect &rect,
                                   int level, ColorScheme color_scheme) {
   //  Already available in the texture descriptor?
+  //  The compressed data is only decoded by GetCompressedLevel() when
+  //  uploaded.
   if (g_GLOptions.m_bTextureCompression) {
     if (ptd->comp_array[level]) return COMPRESSED_BUFFER_OK;
-    if (ptd->compcomp_array[level]) {
-      // If we have the compcomp bits in ram decompress them
-      int size = TextureTileSize(level, true);
-      unsigned char *cb = (unsigned char *)malloc(size);
-      LZ4_decompress_fast((char *)ptd->compcomp_array[level], (char *)cb, size);
-      ptd->comp_array[level] = cb;
-      return COMPRESSED_BUFFER_OK;
-    } else if (g_GLOptions.m_bTextureCompressionCaching) {
+    if (ptd->compcomp_array[level]) return COMPRESSED_BUFFER_OK;
+    if (g_GLOptions.m_bTextureCompressionCaching) {
       //  If cacheing compressed textures, look in the cache
       //  Search for the requested texture
       //  Search the catalog for this particular texture
       CatalogEntryValue *p =
           GetCacheEntryValue(level, rect.x, rect.y, color_scheme);
-
-      //      Requested texture level is found in the cache
-      //      so go load it
-      if (p != 0) {
-        int size = TextureTileSize(level, true);
-
-        if (m_fs->IsOpened()) {
-          m_fs->Seek(p->texture_offset);
-          ptd->comp_array[level] = (unsigned char *)malloc(size);
-          int max_compressed_size = LZ4_COMPRESSBOUND(g_tile_size);
-          char *compressed_data = (char *)malloc(p->compressed_size);
-          m_fs->Read(compressed_data, p->compressed_size);
-          LZ4_decompress_fast(compressed_data, (char *)ptd->comp_array[level],
-                              size);
-          free(compressed_data);
-        }
-
-        return COMPRESSED_BUFFER_OK;
-      }
+      if (p && MapCacheEntry(p)) return COMPRESSED_BUFFER_OK;
     }
   }
 
@@ -1146,6 +1185,7 @@ bool glTexFactory::UpdateCachePrecomp(unsigned char *data, int data_size,
   //      old catalog
   m_fs->Seek(m_catalog_offset);
   m_fs->Write(data, data_size);
+  m_fs_dirty = true;
 
   //      Write the catalog and Header (which follows the catalog at the end of
   //      the file
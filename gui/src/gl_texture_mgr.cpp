@@ -74,6 +74,7 @@
 #include "ocpn_frame.h"
 #include "ocpn_platform.h"
 #include "quilt.h"
+#include "raster_cache_builder.h"
 #include "squish.h"
 #include "viewport.h"
 
@@ -564,6 +565,12 @@ bool JobTicket::DoJob(const wxRect &rect) {
       char *src = (char *)comp_bits_array[level];
       int compressed_size =
           LZ4_compressHC2(src, (char *)compressed_data, csize, 4);
+      // Levels LZ4 barely shrinks are kept as is, they are then uploaded
+      // straight from the mapped cache file without decoding.
+      if (compressed_size == 0 || compressed_size > csize * 3 / 4) {
+        memcpy(compressed_data, src, csize);
+        compressed_size = csize;
+      }
       // shrink buffer to actual size.
       // This will greatly reduce ram usage, ratio usually 10:1
       // there might be a more efficient way than realloc...
@@ -713,7 +720,6 @@ glTextureManager::glTextureManager() {
     nCPU = 1;
 
   m_max_jobs = wxMax(nCPU, 1);
-  m_prevMemUsed = 0;
 
   if (bthread_debug) printf(" nCPU: %d    m_max_jobs :%d\n", nCPU, m_max_jobs);
 
@@ -1225,30 +1231,11 @@ bool glTextureManager::TextureCrunch(double factor) {
 }
 
 #define MAX_CACHE_FACTORY 50
-bool glTextureManager::FactoryCrunch(double factor) {
-  if (m_chart_texfactory_hash.size() == 0) {
-    /* nothing to free */
-    return false;
-  }
-
-  int mem_used;
-  platform::GetMemoryStatus(0, &mem_used);
-  double hysteresis = 0.90;
-  ChartPathHashTexfactType::iterator it0;
-
-  bool bMemCrunch =
-      (g_memCacheLimit &&
-       ((mem_used > (double)(g_memCacheLimit)*factor * hysteresis &&
-         mem_used > (double)(m_prevMemUsed)*factor * hysteresis) ||
-        (m_chart_texfactory_hash.size() > MAX_CACHE_FACTORY)));
-
-  if (!bMemCrunch) return false;
-
-  //  Need more, so delete the oldest factory
-  //      Find the oldest unused factory
+glTexFactory *glTextureManager::FindOldestUnusedFactory() {
   int lru_oldest = 2147483647;
   glTexFactory *ptf_oldest = NULL;
 
+  ChartPathHashTexfactType::iterator it0;
   for (it0 = m_chart_texfactory_hash.begin();
        it0 != m_chart_texfactory_hash.end(); ++it0) {
     glTexFactory *ptf = it0->second;
@@ -1284,32 +1271,52 @@ bool glTextureManager::FactoryCrunch(double factor) {
       }
     }
   }
+  return ptf_oldest;
+}
 
-  //      Found one?
-  if (!ptf_oldest) return false;
-
-  ptf_oldest->FreeSome(g_memCacheLimit * factor * hysteresis);
-
-  platform::GetMemoryStatus(0, &mem_used);
-
-  bMemCrunch = (g_memCacheLimit &&
-                ((mem_used > (double)(g_memCacheLimit)*factor * hysteresis &&
-                  mem_used > (double)(m_prevMemUsed)*factor * hysteresis) ||
-                 (m_chart_texfactory_hash.size() > MAX_CACHE_FACTORY)));
-
-  if (!bMemCrunch) return false;
-
-  //  Need more, so delete the oldest chart too
-
-  m_chart_texfactory_hash.erase(
-      ptf_oldest->GetHashKey());  // This chart  becoming invalid
+bool glTextureManager::FactoryCrunch(double factor) {
+  if (m_chart_texfactory_hash.size() == 0) {
+    /* nothing to free */
+    return false;
+  }
 
-  delete ptf_oldest;
+  // The factories may keep factor of the memory cache limit in tile data
+  // and mapped cache files, counted by themselves instead of measuring the
+  // whole process memory.
+  double hysteresis = 0.90;
+  size_t budget = (size_t)(g_memCacheLimit * 1024. * factor * hysteresis);
+  size_t resident = 0;
+  for (auto &hash : m_chart_texfactory_hash)
+    if (hash.second) resident += hash.second->GetResidentBytes();
+
+  auto over_budget = [&] {
+    return (g_memCacheLimit && resident > budget) ||
+           m_chart_texfactory_hash.size() > MAX_CACHE_FACTORY;
+  };
+
+  bool freed = false;
+  while (over_budget()) {
+    glTexFactory *ptf_oldest = FindOldestUnusedFactory();
+    if (!ptf_oldest) break;
+
+    //  Free the tile data of the oldest unused factory
+    size_t used = ptf_oldest->GetResidentBytes();
+    ptf_oldest->FreeSome(budget);
+    resident -= used - ptf_oldest->GetResidentBytes();
+    freed = true;
+    if (!over_budget()) break;
+
+    //  Need more, so delete the oldest chart too
+    resident -= ptf_oldest->GetResidentBytes();
+    m_chart_texfactory_hash.erase(
+        ptf_oldest->GetHashKey());  // This chart  becoming invalid
+    delete ptf_oldest;
+  }
 
-  return true;
+  return freed;
 }
 
-void glTextureManager::BuildCompressedCache() {
+void glTextureManager::BuildCompressedCache(bool headless) {
   idx_sorted_by_distance.Clear();
 
   // Building the cache may take a long time....
@@ -1393,69 +1400,22 @@ void glTextureManager::BuildCompressedCache() {
     ct_array.Add(pct);
   }
 
-  // create progress dialog
-  long style = wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_ESTIMATED_TIME |
-               wxPD_REMAINING_TIME | wxPD_CAN_ABORT;
-
-  wxString msg0;
-  msg0 =
-      "                                                                    "
-      "           \n  \n  ";
-
-#ifdef __WXQT__
-  msg0 =
-      "Very "
-      "longgggggggggggggggggggggggggggggggggggggggggggg\ngggggggggggggggggg"
-      "gggggggggggggggggggggggggg top line ";
-#endif
-
-  for (int i = 0; i < m_max_jobs + 1; i++)
-    msg0 += "\n                                             ";
-
-  m_progDialog = new wxGenericProgressDialog();
-
-  wxFont *qFont = GetOCPNScaledFont(_("Dialog"));
-  int fontSize = qFont->GetPointSize();
-  wxFont *sFont;
-  wxSize csz = gFrame->GetClientSize();
-  if (csz.x < 500 || csz.y < 500)
-    sFont = FontMgr::Get().FindOrCreateFont(
-        10, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
-  else
-    sFont = FontMgr::Get().FindOrCreateFont(fontSize, wxFONTFAMILY_TELETYPE,
-                                            wxFONTSTYLE_NORMAL,
-                                            wxFONTWEIGHT_NORMAL);
-
-  m_progDialog->SetFont(*sFont);
-
-  //  Should we use "compact" screen layout?
-  wxScreenDC sdc;
-  int height, width;
-  sdc.GetTextExtent("[WWWWWWWWWWWWWWWWWWWWWWWWWWWWWW]", &width, &height, NULL,
-                    NULL, sFont);
-  if (width > (csz.x / 2)) m_bcompact = true;
-
-  m_progDialog->Create(_("OpenCPN Compressed Cache Update"), msg0, count + 1,
-                       NULL, style);
-
-  //    Make sure the dialog is big enough to be readable
-  m_progDialog->Hide();
-  wxSize sz = m_progDialog->GetSize();
-  sz.x = csz.x * 9 / 10;
-  m_progDialog->SetSize(sz);
-
-  m_progDialog->Layout();
-  wxSize sza = m_progDialog->GetSize();
-
-  m_progDialog->Centre();
-  m_progDialog->Show();
-  m_progDialog->Raise();
+  if (!headless) CreateProgressDialog(count);
 
   m_skipout = false;
   m_skip = false;
-  int yield = 0;
+  m_jcnt = 0;
+  if (RasterCacheBuilder::CanBuild()) {
+    std::vector<wxString> chart_paths;
+    for (unsigned int j = 0; j < ct_array.GetCount(); j++)
+      chart_paths.push_back(ct_array[j].chart_path);
+    BuildCacheInParallel(chart_paths);
+    m_jcnt = ct_array.GetCount();
+  }
 
-  for (m_jcnt = 0; m_jcnt < ct_array.GetCount(); m_jcnt++) {
+  // FXT1 textures are compressed by the GPU, through the job queue.
+  int yield = 0;
+  for (; m_jcnt < ct_array.GetCount(); m_jcnt++) {
     wxString filename = ct_array[m_jcnt].chart_path;
     wxString CompressedCacheFilePath = CompressedCachePath(filename);
     double distance = ct_array[m_jcnt].distance;
@@ -1515,7 +1475,7 @@ void glTextureManager::BuildCompressedCache() {
     if (yield == 200) {
       ::wxYield();
       yield = 0;
-      if (!m_progDialog->Update(m_jcnt)) {
+      if (m_progDialog && !m_progDialog->Update(m_jcnt)) {
         m_skip = true;
         m_skipout = true;
       }
@@ -1553,3 +1513,94 @@ void glTextureManager::BuildCompressedCache() {
   delete m_progDialog;
   m_progDialog = nullptr;
 }
+
+void glTextureManager::CreateProgressDialog(int count) {
+  long style = wxPD_SMOOTH | wxPD_ELAPSED_TIME | wxPD_ESTIMATED_TIME |
+               wxPD_REMAINING_TIME | wxPD_CAN_ABORT;
+
+  wxString msg0;
+  msg0 =
+      "                                                                    "
+      "           \n  \n  ";
+
+#ifdef __WXQT__
+  msg0 =
+      "Very "
+      "longgggggggggggggggggggggggggggggggggggggggggggg\ngggggggggggggggggg"
+      "gggggggggggggggggggggggggg top line ";
+#endif
+
+  for (int i = 0; i < m_max_jobs + 1; i++)
+    msg0 += "\n                                             ";
+
+  m_progDialog = new wxGenericProgressDialog();
+
+  wxFont *qFont = GetOCPNScaledFont(_("Dialog"));
+  int fontSize = qFont->GetPointSize();
+  wxFont *sFont;
+  wxSize csz = gFrame->GetClientSize();
+  if (csz.x < 500 || csz.y < 500)
+    sFont = FontMgr::Get().FindOrCreateFont(
+        10, wxFONTFAMILY_TELETYPE, wxFONTSTYLE_NORMAL, wxFONTWEIGHT_NORMAL);
+  else
+    sFont = FontMgr::Get().FindOrCreateFont(fontSize, wxFONTFAMILY_TELETYPE,
+                                            wxFONTSTYLE_NORMAL,
+                                            wxFONTWEIGHT_NORMAL);
+
+  m_progDialog->SetFont(*sFont);
+
+  //  Should we use "compact" screen layout?
+  wxScreenDC sdc;
+  int height, width;
+  sdc.GetTextExtent("[WWWWWWWWWWWWWWWWWWWWWWWWWWWWWW]", &width, &height, NULL,
+                    NULL, sFont);
+  if (width > (csz.x / 2)) m_bcompact = true;
+
+  m_progDialog->Create(_("OpenCPN Compressed Cache Update"), msg0, count + 1,
+                       NULL, style);
+
+  //    Make sure the dialog is big enough to be readable
+  m_progDialog->Hide();
+  wxSize sz = m_progDialog->GetSize();
+  sz.x = csz.x * 9 / 10;
+  m_progDialog->SetSize(sz);
+
+  m_progDialog->Layout();
+  wxSize sza = m_progDialog->GetSize();
+
+  m_progDialog->Centre();
+  m_progDialog->Show();
+  m_progDialog->Raise();
+}
+
+void glTextureManager::BuildCacheInParallel(
+    const std::vector<wxString> &chart_paths) {
+  int logged = -1;
+  RasterCacheBuilder builder(m_max_jobs);
+  builder.Build(chart_paths, [&](const RasterCacheBuilder::Progress &p) {
+    wxString msg;
+    msg.Printf(_("Charts: %d/%d    Tiles: %lu/%lu"), p.charts_done,
+               p.charts_total, (unsigned long)p.tiles_done,
+               (unsigned long)p.tiles_queued);
+    if (!m_progDialog) {
+      if (p.charts_done != logged) wxLogMessage("Raster cache: " + msg);
+      logged = p.charts_done;
+      return true;
+    }
+
+    int bar_length = NBAR_LENGTH;
+    if (m_bcompact) bar_length = 20;
+    float cutoff = -1.;
+    if (p.tiles_queued)
+      cutoff = p.tiles_done * bar_length / (float)p.tiles_queued;
+    wxString block = wxString::Format("%c", 0x2588);
+    msg += "\n\n[";
+    for (int i = 0; i < bar_length; i++) msg += i < cutoff ? block : "-";
+    msg += "]\n";
+    if (!m_bcompact) msg += wxFileName(p.chart_path).GetFullName();
+
+    if (!m_progDialog->Update(p.charts_done, msg, &m_skip)) m_skip = true;
+    if (m_skip) m_skipout = true;
+    return !m_skipout;
+  });
+}
@@ -182,14 +182,11 @@ GshhsPolyCell::GshhsPolyCell(FILE *fpoly_, int x0_, int y0_,
   for (int i = 0; i < 6; i++) polyv[i] = NULL;
 
   ReadPolygonFile();
-
-  for (int i = 0; i < GSSH_SUBM * GSSH_SUBM; i++) high_res_map[i] = NULL;
 }
 
 GshhsPolyCell::~GshhsPolyCell() {
   ClearPolyV();
 
-  for (int i = 0; i < GSSH_SUBM * GSSH_SUBM; i++) delete high_res_map[i];
   for (int i = 0; i < 6; i++) delete[] polyv[i];
 }
 
@@ -539,12 +536,7 @@ void GshhsPolyCell::DrawPolygonFilledGL(ocpnDC &pnt, contour_list *p,
 #endif
   } else {
     float *pvt = new float[2 * (*pvc)];
-    for (int i = 0; i < *pvc; i++) {
-      float_2Dpt *pc = *pv + i;
-      wxPoint2DDouble q = vp.GetDoublePixFromLL(pc->y, pc->x);
-      pvt[i * 2] = q.m_x;
-      pvt[(i * 2) + 1] = q.m_y;
-    }
+    vp.ProjectLLToPix(&(*pv)->y, &(*pv)->x, *pvc, pvt, 2);
 
     GLShaderProgram *shader = pcolor_tri_shader_program[pnt.m_canvasIndex];
     shader->Bind();
@@ -737,153 +729,6 @@ void GshhsPolyReader::InitializeLoadQuality(
   }
 }
 
-static inline bool my_intersects(const wxLineF &line1, const wxLineF &line2) {
-  double x1 = line1.m_p1.x, y1 = line1.m_p1.y, x2 = line1.m_p2.x,
-         y2 = line1.m_p2.y;
-  double x3 = line2.m_p1.x, y3 = line2.m_p1.y, x4 = line2.m_p2.x,
-         y4 = line2.m_p2.y;
-
-  // implementation is based on Graphics Gems III's "Faster Line Segment
-  // Intersection"
-  double ax = x2 - x1, ay = y2 - y1;
-  double bx = x3 - x4, by = y3 - y4;
-  double cx = x1 - x3, cy = y1 - y3;
-
-#define INTER_LIMIT 1e-7
-  double denominator = ay * bx - ax * by;
-  if (denominator < 1e-10) {
-    if (fabs((y1 * ax - ay * x1) * bx - (y3 * bx - by * x3) * ax) > INTER_LIMIT)
-      return false; /* different intercepts, no intersection */
-    if (fabs((x1 * ay - ax * y1) * by - (x3 * by - bx * y3) * ay) > INTER_LIMIT)
-      return false; /* different intercepts, no intersection */
-
-    return true;
-  }
-
-  const double reciprocal = 1 / denominator;
-  const double na = (by * cx - bx * cy) * reciprocal;
-
-  if (na < -INTER_LIMIT || na > 1 + INTER_LIMIT) return false;
-
-  const double nb = (ax * cy - ay * cx) * reciprocal;
-  if (nb < -INTER_LIMIT || nb > 1 + INTER_LIMIT) return false;
-
-  return true;
-}
-
-bool GshhsPolyReader::crossing1(wxLineF trajectWorld) {
-  double x1 = trajectWorld.p1().x, y1 = trajectWorld.p1().y;
-  double x2 = trajectWorld.p2().x, y2 = trajectWorld.p2().y;
-
-  int clonmin, clonmax, clatmax, clatmin;
-  clonmin = (int)floor(GSSH_SUBM * wxMin(x1, x2));
-  clonmax = (int)ceil(GSSH_SUBM * wxMax(x1, x2));
-
-  if (clonmin < 0) {
-    clonmin += GSSH_SUBM * 360;
-    clonmax += GSSH_SUBM * 360;
-  }
-
-  if (clonmax - clonmin > GSSH_SUBM * 180) { /* dont go long way around world */
-    clonmin = (int)floor(GSSH_SUBM * wxMax(x1, x2)) - GSSH_SUBM * 360;
-    clonmax = (int)ceil(GSSH_SUBM * wxMin(x1, x2));
-  }
-
-  clatmin = (int)floor(GSSH_SUBM * wxMin(y1, y2));
-  clatmax = (int)ceil(GSSH_SUBM * wxMax(y1, y2));
-  wxASSERT(clatmin >= -GSSH_SUBM * 90 && clatmax <= GSSH_SUBM * 89);
-
-  // TODO: optimize by traversing only the cells the segment passes through,
-  //       rather than all of the cells which fit in the bounding box,
-  //       this may make a worthwhile difference for longer segments in some
-  //       cases.
-  int clon, clonx, clat;
-  for (clon = clonmin; clon < clonmax; clon++) {
-    clonx = clon;
-    while (clonx < 0) clonx += GSSH_SUBM * 360;
-    while (clonx >= GSSH_SUBM * 360) clonx -= GSSH_SUBM * 360;
-
-    wxASSERT(clonx >= 0 && clonx < GSSH_SUBM * 360);
-
-    if (clonx < GSSH_SUBM * 180) {
-      if (x1 > 180) x1 -= 360;
-      if (x2 > 180) x2 -= 360;
-    } else {
-      if (x1 < 180) x1 += 360;
-      if (x2 < 180) x2 += 360;
-    }
-
-    wxLineF rtrajectWorld(x1, y1, x2, y2);
-
-    for (clat = clatmin; clat < clatmax; clat++) {
-      int cloni = clonx / GSSH_SUBM,
-          clati = (GSSH_SUBM * 90 + clat) / GSSH_SUBM;
-      GshhsPolyCell *&cel = allCells[cloni][clati];
-      if (!cel) {
-        mutex1.Lock();
-        if (!cel) {
-          /* load the needed cell from disk */
-          cel = new GshhsPolyCell(fpoly, cloni, clati - 90, &polyHeader);
-          wxASSERT(cel);
-        }
-        mutex1.Unlock();
-      }
-
-      int hash = GSSH_SUBM * (GSSH_SUBM * (90 - clati) + clat - cloni) + clonx;
-      std::vector<wxLineF> *&high_res_map = cel->high_res_map[hash];
-      wxASSERT(hash >= 0 && hash < GSSH_SUBM * GSSH_SUBM);
-      if (!high_res_map) {
-        mutex2.Lock();
-        if (!high_res_map) {
-          /* Build the needed sub cell of line segments from the cell */
-          contour_list &poly1 = cel->getPoly1();
-
-          double minlat = (double)clat / GSSH_SUBM,
-                 maxlat = (double)(clat + 1) / GSSH_SUBM;
-          double minlon = (double)clonx / GSSH_SUBM,
-                 maxlon = (double)(clonx + 1) / GSSH_SUBM;
-          high_res_map = new std::vector<wxLineF>;
-          for (unsigned int pi = 0; pi < poly1.size(); pi++) {
-            contour &c = poly1[pi];
-            double lx = c[c.size() - 1].x, ly = c[c.size() - 1].y;
-            /* must compute states because sometimes a
-               segment starts and ends outside our cell, but passes
-               through it so must be included */
-            int lstatex = lx < minlon ? -1 : lx > maxlon ? 1 : 0;
-            int lstatey = ly < minlat ? -1 : ly > maxlat ? 1 : 0;
-
-            for (unsigned int pj = 0; pj < c.size(); pj++) {
-              double clon = c[pj].x, clat = c[pj].y;
-              // gshhs data shouldn't, but sometimes contains zero segments
-              // which enlarges our table, but
-              // more importantly, the fast segment intersection test
-              // and doesn't correctly account for it
-              if (lx == clon && ly == clat) continue;
-
-              int statex = clon < minlon ? -1 : clon > maxlon ? 1 : 0;
-              int statey = clat < minlat ? -1 : clat > maxlat ? 1 : 0;
-
-              if ((!statex || lstatex != statex) &&
-                  (!statey || lstatey != statey))
-                high_res_map->push_back(wxLineF(lx, ly, clon, clat));
-
-              lx = clon, ly = clat;
-              lstatex = statex, lstatey = statey;
-            }
-          }
-        }
-        mutex2.Unlock();
-      }
-
-      for (std::vector<wxLineF>::iterator it2 = high_res_map->begin();
-           it2 != high_res_map->end(); it2++)
-        if (my_intersects(rtrajectWorld, *it2)) return true;
-    }
-  }
-
-  return false;
-}
-
 void GshhsPolyReader::readPolygonFileHeader(FILE *polyfile,
                                             PolygonFileHeader *header) {
   fseek(polyfile, 0, SEEK_SET);
@@ -1474,40 +1319,47 @@ int GshhsReader::selectBestQuality(ViewPort &vp) {
   return bestQuality;
 }
 
-// A GshhsReader instance which is used to detect if a trajectory
-// crosses land.
-static GshhsReader *gshhs_reader = NULL;
+// Polygon file of the best available quality, used to detect if a
+// trajectory crosses land.
+static GshhsCrossing *gshhs_crossing = NULL;
 
 /* so plugins can determine if a line segment crosses land, must call from main
-   thread once at startup to initialize array */
+   thread once at startup to open the polygon file */
 void gshhsCrossesLandInit() {
   wxLogMessage("GSHHSChart::gshhsCrossesLandInit()");
-  if (!gshhs_reader) {
-    gshhs_reader = new GshhsReader();
-  }
+  if (gshhs_crossing) return;
   /* load best possible quality for crossing tests */
   int bestQuality = 4;
-  while (!gshhs_reader->qualityAvailable[bestQuality] && bestQuality > 0)
+  while (!GshhsReader::gshhsFilesExists(bestQuality) && bestQuality > 0)
     bestQuality--;
-  gshhs_reader->LoadQuality(bestQuality);
-  wxLogMessage("GSHHG: Loaded quality %d for land crossing detection.",
-               bestQuality);
+  gshhs_crossing = new GshhsCrossing(
+      GshhsReader::getFileName_Land(bestQuality).ToStdString());
+  if (gshhs_crossing->IsOk())
+    wxLogMessage("GSHHG: Loaded quality %d for land crossing detection.",
+                 bestQuality);
+  else
+    wxLogMessage("GSHHG: Cannot load quality %d for land crossing detection.",
+                 bestQuality);
 }
 
 void gshhsCrossesLandReset() {
   wxLogMessage("GSHHSChart::gshhsCrossesLandReset()");
-  if (gshhs_reader) delete gshhs_reader;
-  gshhs_reader = NULL;
+  delete gshhs_crossing;
+  gshhs_crossing = NULL;
   gshhsCrossesLandInit();
 }
 
 bool gshhsCrossesLand(double lat1, double lon1, double lat2, double lon2) {
-  if (!gshhs_reader) {
+  if (!gshhs_crossing) {
     gshhsCrossesLandInit();
   }
-  if (lon1 < 0) lon1 += 360;
-  if (lon2 < 0) lon2 += 360;
+  return gshhs_crossing->CrossesLand(lat1, lon1, lat2, lon2);
+}
 
-  wxLineF trajectWorld(lon1, lat1, lon2, lat2);
-  return gshhs_reader->crossing1(trajectWorld);
+void gshhsCrossesLand(const std::vector<GshhsCrossing::Segment> &segments,
+                      std::vector<char> &crosses) {
+  if (!gshhs_crossing) {
+    gshhsCrossesLandInit();
+  }
+  gshhs_crossing->CrossesLand(segments, crosses);
 }
@@ -200,7 +200,7 @@ using namespace std::literals::chrono_literals;
 const char *const kUsage =
     R"(Usage:
   opencpn -h | --help
-  opencpn [-p] [-f] [-G] [-g] [-P] [-l <str>] [-u <num>] [-U] [-s] [GPX file ...]
+  opencpn [-p] [-f] [-G] [-g] [-B] [-P] [-l <str>] [-u <num>] [-U] [-s] [GPX file ...]
   opencpn --remote [-R] | -q] | -e] |-o <str>]
 
 Options for starting opencpn
@@ -211,6 +211,7 @@ Options for starting opencpn
   -G, --no_opengl              	Disable OpenGL video acceleration. This setting will
                                 be remembered.
   -g, --rebuild_gl_raster_cache	Rebuild OpenGL raster cache on start.
+  -B, --build_gl_raster_cache  	Build OpenGL raster cache without dialogs, then exit.
   -D, --rebuild_chart_db        Rescan chart directories and rebuild the chart database
   -P, --parse_all_enc          	Convert all S-57 charts to OpenCPN's internal format on start.
   -l, --loglevel=<str>         	Amount of logging: error, warning, message, info, debug or trace
@@ -420,6 +421,7 @@ void MyApp::OnInitCmdLine(wxCmdLineParser &parser) {
   parser.AddSwitch("G", "no_opengl");
   parser.AddSwitch("W", "config_wizard");
   parser.AddSwitch("g", "rebuild_gl_raster_cache");
+  parser.AddSwitch("B", "build_gl_raster_cache");
   parser.AddSwitch("D", "rebuild_chart_db");
   parser.AddSwitch("P", "parse_all_enc");
   parser.AddOption("l", "loglevel");
@@ -477,6 +479,7 @@ bool MyApp::OnCmdLineParsed(wxCmdLineParser &parser) {
   g_start_fullscreen = parser.Found("fullscreen");
   g_bdisable_opengl = parser.Found("no_opengl");
   g_rebuild_gl_cache = parser.Found("rebuild_gl_raster_cache");
+  g_build_gl_cache_headless = parser.Found("build_gl_raster_cache");
   g_NeedDBUpdate = parser.Found("rebuild_chart_db") ? 2 : 0;
   g_parse_all_enc = parser.Found("parse_all_enc");
   g_config_wizard = parser.Found("config_wizard");
@@ -503,6 +506,7 @@ bool MyApp::OnCmdLineParsed(wxCmdLineParser &parser) {
       "fullscreen",
       "no_opengl",
       "rebuild_gl_raster_cache",
+      "build_gl_raster_cache",
       "rebuild_chart_db",
       "parse_all_enc",
       "unit_test_1",
@@ -1360,6 +1364,17 @@ bool MyApp::OnInit() {
 
     if (g_glTextureManager) g_glTextureManager->BuildCompressedCache();
   }
+
+  if (g_build_gl_cache_headless) {
+    if (g_bopengl && g_GLOptions.m_bTextureCompression &&
+        g_GLOptions.m_bTextureCompressionCaching && g_glTextureManager)
+      g_glTextureManager->BuildCompressedCache(true);
+    else
+      wxLogMessage(
+          "Cannot build raster cache: OpenGL texture compression caching "
+          "is disabled");
+    gFrame->FastClose();
+  }
 #endif
 
   // FIXME (dave)
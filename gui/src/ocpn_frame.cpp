@@ -841,6 +841,7 @@ void MyFrame::RebuildChartDatabase() {
 
     delete ChartData;
     ChartData = new ChartDB();
+    InvalidateAllQuilts();
 
     wxString line(
         _("Rebuilding chart database from configuration file entries..."));
@@ -6693,6 +6694,7 @@ void MyFrame::applySettingsString(wxString settings) {
   int last_UIScaleFactor = g_GUIScaleFactor;
   bool previous_expert = g_bUIexpert;
   g_last_ChartScaleFactor = g_ChartScaleFactor;
+  int last_symbol_style = ps52plib ? ps52plib->m_nSymbolStyle : 0;
   ArrayOfCDI *pNewDirArray = new ArrayOfCDI;
 
   int rr =
@@ -6707,8 +6709,10 @@ void MyFrame::applySettingsString(wxString settings) {
   if (rr & S52_CHANGED) {
     if (ps52plib) {
       ps52plib->FlushSymbolCaches(ChartCtxFactory());
-      ps52plib
-          ->ClearCNSYLUPArray();  // some CNSY depends on renderer (e.g. CARC)
+      // Some CNSY depends on renderer (e.g. CARC) or symbol style. Charts
+      // pick up other changes through the CS state hash.
+      if ((rr & GL_CHANGED) || ps52plib->m_nSymbolStyle != last_symbol_style)
+        ps52plib->ClearCNSYLUPArray();
       ps52plib->GenerateStateHash();
     }
   }
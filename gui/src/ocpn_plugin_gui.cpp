@@ -54,6 +54,7 @@
 #include "config_mgr.h"
 #include "font_mgr.h"
 #include "gl_chart_canvas.h"
+#include "gshhs.h"
 #include "gui_lib.h"
 #include "navutil.h"
 #include "ocpn_app.h"
@@ -461,6 +462,7 @@ int AddChartToDBInPlace(wxString& full_path, bool b_RefreshCanvas) {
       pConfig->LoadChartDirArray(XnewChartDirArray);
       delete ChartData;
       ChartData = new ChartDB();
+      gFrame->InvalidateAllQuilts();
       ChartData->LoadBinary(ChartListFileName, XnewChartDirArray);
 
       // Update group contents
@@ -491,6 +493,7 @@ int RemoveChartFromDBInPlace(wxString& full_path) {
     pConfig->LoadChartDirArray(XnewChartDirArray);
     delete ChartData;
     ChartData = new ChartDB();
+    gFrame->InvalidateAllQuilts();
     ChartData->LoadBinary(ChartListFileName, XnewChartDirArray);
 
     // Update group contents
@@ -749,6 +752,17 @@ bool PlugIn_GSHHS_CrossesLand(double lat1, double lon1, double lat2,
   //}
 }
 
+std::vector<bool> PlugIn_GSHHS_CrossesLandBatch(
+    const std::vector<PI_GSHHS_Segment>& segments) {
+  std::vector<GshhsCrossing::Segment> legs;
+  legs.reserve(segments.size());
+  for (const auto& s : segments)
+    legs.push_back({s.lat1, s.lon1, s.lat2, s.lon2});
+  std::vector<char> crosses;
+  gshhsCrossesLand(legs, crosses);
+  return std::vector<bool>(crosses.begin(), crosses.end());
+}
+
 void PlugInPlaySound(wxString& sound_file) {
   PlugInPlaySoundEx(sound_file, -1);
 }
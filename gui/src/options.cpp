@@ -7606,6 +7606,7 @@ void options::ApplyChanges(wxCommandEvent& event) {
     // for later comparison
     ps52plib->GenerateStateHash();
     long stateHash = ps52plib->GetStateHash();
+    int lastSymbolStyle = ps52plib->m_nSymbolStyle;
 
     if (m_returnChanges & GL_CHANGED) {
       // Do this now to handle the screen refresh that is automatically
@@ -7652,6 +7653,11 @@ void options::ApplyChanges(wxCommandEvent& event) {
 
     ps52plib->m_nSymbolStyle =
         pPointStyle->GetSelection() == 0 ? PAPER_CHART : SIMPLIFIED;
+    // The dynamic CS LUPs depend on the renderer and the symbol style.
+    // Charts pick up other changes through the CS state hash.
+    if (ps52plib->m_nSymbolStyle != lastSymbolStyle &&
+        !(m_returnChanges & GL_CHANGED))
+      ps52plib->ClearCNSYLUPArray();
 
     ps52plib->m_nBoundaryStyle = pBoundStyle->GetSelection() == 0
                                      ? PLAIN_BOUNDARIES
@@ -108,6 +108,7 @@
 #include "model/nav_object_database.h"
 #include "model/navutil_base.h"
 #include "model/ocpn_utils.h"
+#include "model/pipeline_stats.h"
 #include "model/plugin_cache.h"
 #include "model/plugin_comm.h"
 #include "model/plugin_handler.h"
@@ -959,23 +960,54 @@ void PlugInManager::HandleN0183(std::shared_ptr<const Nmea0183Msg> n0183_msg) {
   assert(n0183_msg->bus == NavAddr::Bus::N0183);
   const std::string& payload = n0183_msg->payload;
 
+  bool passes_input_filter = payload[0] == '!';
   if (payload[0] == '$') {
     const auto& drivers = CommDriverRegistry::GetInstance().GetDrivers();
     auto& target_driver = FindDriver(drivers, n0183_msg->source->iface);
 
     // Get the params for the driver sending this message, check if it
     // passes the input filter
-    bool passes_input_filter = true;
+    passes_input_filter = true;
     auto drv_n0183 = dynamic_cast<CommDriverN0183*>(target_driver.get());
     if (drv_n0183) {
       ConnectionParams params = drv_n0183->GetParams();
       passes_input_filter =
           params.SentencePassesFilter(payload.c_str(), FILTER_INPUT);
     }
-    if (passes_input_filter) SendNMEASentenceToAllPlugIns(payload.c_str());
-  } else if (payload[0] == '!') {
-    SendAISSentenceToAllPlugIns(payload.c_str());
   }
+  if (!passes_input_filter) {
+    PipelineStats::GetInstance().Record(PipelineStage::kPluginDispatch,
+                                        *n0183_msg);
+    return;
+  }
+  // Sentences arriving in the same event loop pass are sent as one batch,
+  // setting up the plugin fault guard once. AIS sentences share the queue
+  // so that plugins see all sentences in arrival order.
+  if (m_pending_nmea.empty()) CallAfter(&PlugInManager::FlushNmeaSentences);
+  m_pending_nmea.push_back(payload.c_str());
+  m_pending_nmea_msgs.push_back(n0183_msg);
+}
+
+void PlugInManager::FlushNmeaSentences() {
+  std::vector<wxString> sentences;
+  std::vector<std::shared_ptr<const Nmea0183Msg>> msgs;
+  sentences.swap(m_pending_nmea);
+  msgs.swap(m_pending_nmea_msgs);
+
+  // Consecutive NMEA sentences go as one batch, AIS ones one by one.
+  std::vector<wxString> batch;
+  for (const auto& sentence : sentences) {
+    if (sentence[0] != '!') {
+      batch.push_back(sentence);
+      continue;
+    }
+    SendNMEASentencesToAllPlugIns(batch);
+    batch.clear();
+    SendAISSentenceToAllPlugIns(sentence);
+  }
+  SendNMEASentencesToAllPlugIns(batch);
+  for (const auto& msg : msgs)
+    PipelineStats::GetInstance().Record(PipelineStage::kPluginDispatch, *msg);
 }
 
 void PlugInManager::HandleSignalK(std::shared_ptr<const SignalkMsg> sK_msg) {
@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <chrono>
 
 #include <wx/wxprec.h>
 #include <wx/list.h>
@@ -29,6 +30,7 @@
 
 #include "model/config_vars.h"
 #include "model/ocpn_utils.h"
+#include "model/pipeline_stats.h"
 
 #include "chartdb.h"
 #include "chartimg.h"
@@ -210,8 +212,17 @@ const LLRegion &QuiltCandidate::GetCandidateRegion() {
 
 LLRegion &QuiltCandidate::GetReducedCandidateRegion(double factor) {
   if (factor != last_factor) {
-    reduced_candidate_region = GetCandidateRegion();
-    reduced_candidate_region.Reduce(factor);
+    // Candidates are rebuilt on every Compose(), keep the reduced region
+    // with the chart so that it is only computed again on zoom changes.
+    ChartTableEntry &cte =
+        const_cast<ChartTableEntry &>(ChartData->GetChartTableEntry(dbIndex));
+    if (cte.quilt_reduced_factor != factor ||
+        cte.quilt_reduced_candidate_region.Empty()) {
+      cte.quilt_reduced_candidate_region = GetCandidateRegion();
+      cte.quilt_reduced_candidate_region.Reduce(factor);
+      cte.quilt_reduced_factor = factor;
+    }
+    reduced_candidate_region = cte.quilt_reduced_candidate_region;
     last_factor = factor;
   }
 
@@ -739,7 +750,7 @@ void Quilt::InvalidateAllQuiltPatchs() {
       m_bbusy = true;
       m_bbusy = false;
   */
-  return;
+  m_region_cache.Clear();
 }
 
 std::vector<int> Quilt::GetQuiltIndexArray() {
@@ -1729,6 +1740,15 @@ bool Quilt::Compose(const ViewPort &vp_in) {
   UnlockQuilt();
   m_bbusy = true;
 
+  auto compose_start = std::chrono::steady_clock::now();
+  PipelineTiming compose_kind = PipelineTiming::kQuiltPan;
+  if (!m_vp_quilt.IsValid() || !m_bcomposed)
+    compose_kind = PipelineTiming::kQuiltChartSet;
+  else if (m_vp_quilt.view_scale_ppm != vp_in.view_scale_ppm ||
+           m_vp_quilt.m_projection_type != vp_in.m_projection_type ||
+           m_vp_quilt.rotation != vp_in.rotation)
+    compose_kind = PipelineTiming::kQuiltZoom;
+
   ViewPort vp_local = vp_in;  // need a non-const copy
 
   //    Get Reference Chart parameters
@@ -2209,6 +2229,7 @@ bool Quilt::Compose(const ViewPort &vp_in) {
 
   //  If the reference chart is cm93, we need to render it first.
   bool b_skipCM93 = false;
+  int cm93_dbIndex = -1;
   if (m_reference_type == CHART_TYPE_CM93COMP) {
     // find cm93 in the list
     for (int i = m_PatchList.GetCount() - 1; i >= 0; i--) {
@@ -2229,47 +2250,60 @@ bool Quilt::Compose(const ViewPort &vp_in) {
         m_covered_region.Union(piqp->quilt_region);
 
         b_skipCM93 = true;  // did this already...
+        cm93_dbIndex = piqp->dbIndex;
         break;
       }
     }
   }
 
   //  Proceeding from largest scale to smallest....
+  //  The regions of the patches before clipping to the viewport are kept
+  //  from the last Compose() while the patch list starts the same way, so
+  //  that a pan only clips them again.
+
+  // this operation becomes expensive with lots of charts
+  bool b_subtract = !b_has_overlays && m_PatchList.GetCount() < 25;
+  m_region_cache.Begin(b_subtract, cm93_dbIndex, &m_covered_region);
 
   for (int i = m_PatchList.GetCount() - 1; i >= 0; i--) {
     wxPatchListNode *pcinode = m_PatchList.Item(i);
     QuiltPatch *piqp = pcinode->GetData();
-    if (!piqp->b_Valid)  // skip invalid entries
-      continue;
-
     const ChartTableEntry &cte = ChartData->GetChartTableEntry(piqp->dbIndex);
 
-    if (b_skipCM93) {
-      if (cte.GetChartType() == CHART_TYPE_CM93COMP) continue;
-    }
-
-    //    Start with the chart's full region coverage.
-    piqp->ActiveRegion = piqp->quilt_region;
-
-    // this operation becomes expensive with lots of charts
-    if (!b_has_overlays && m_PatchList.GetCount() < 25)
-      piqp->ActiveRegion.Subtract(m_covered_region);
+    bool b_used = piqp->b_Valid;  // skip invalid entries
+    if (b_skipCM93 && cte.GetChartType() == CHART_TYPE_CM93COMP)
+      b_used = false;
 
+    //    Maintain the present full quilt coverage region
+    if (b_used) {
+      piqp->b_overlay = false;
+      if (cte.GetChartFamily() == CHART_FAMILY_VECTOR)
+        piqp->b_overlay =
+            s57chart::IsCellOverlayType(cte.GetFullSystemPath());
+    }
+
+    QuiltRegionCache::Patch patch;
+    patch.db_index = piqp->dbIndex;
+    patch.generation = ChartData->GetGeneration();
+    patch.entry = &cte;
+    patch.scale = cte.GetScale();
+    patch.proj = piqp->ProjType;
+    patch.used = b_used;
+    patch.overlay = piqp->b_overlay;
+    patch.region = &piqp->quilt_region;
+    const LLRegion *region = m_region_cache.Add(patch);
+    if (!region) continue;
+
+    //    Start with the chart's region, less larger scale charts
+    piqp->ActiveRegion = *region;
     piqp->ActiveRegion.Intersect(cvp_region);
 
     //    Could happen that a larger scale chart covers completely a smaller
     //    scale chart
     if (piqp->ActiveRegion.Empty() && (piqp->dbIndex != m_refchart_dbIndex))
       piqp->b_eclipsed = true;
-
-    //    Maintain the present full quilt coverage region
-    piqp->b_overlay = false;
-    if (cte.GetChartFamily() == CHART_FAMILY_VECTOR) {
-      piqp->b_overlay = s57chart::IsCellOverlayType(cte.GetFullSystemPath());
-    }
-
-    if (!piqp->b_overlay) m_covered_region.Union(piqp->quilt_region);
   }
+  m_region_cache.End();
 #else
   // this is the old algorithm does the same thing in n^2/2 operations instead
   // of 2*n-1
@@ -2592,7 +2626,15 @@ bool Quilt::Compose(const ViewPort &vp_in) {
     xa_hash = ((xa_hash << 5) + xa_hash) + dbindex; /* hash * 33 + dbindex */
   }
 
+  if (compose_kind == PipelineTiming::kQuiltPan && xa_hash != m_xa_hash)
+    compose_kind = PipelineTiming::kQuiltChartSet;
   m_xa_hash = xa_hash;
+
+  auto compose_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - compose_start)
+                        .count();
+  PipelineStats::GetInstance().RecordTiming(compose_kind, compose_ns);
+
   m_bbusy = false;
   return true;
 }
@@ -0,0 +1,306 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * \file
+ *
+ * Implement raster_cache_builder.h -- multi-core raster cache builder
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+#include <wx/wxprec.h>
+#include <wx/thread.h>
+
+#include "model/config_vars.h"
+
+#include "chartbase.h"
+#include "chartdb.h"
+#include "chartimg.h"
+#include "dychart.h"
+#include "gl_tex_cache.h"
+#include "gl_texture_mgr.h"
+#include "ocpn_gl_options.h"
+#include "raster_cache_builder.h"
+#include "viewport.h"
+
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+extern GLuint g_raster_format;
+extern glTextureManager *g_glTextureManager;
+
+RasterCacheBuilder::RasterCacheBuilder(int n_threads)
+    : m_next_worker(0),
+      m_queued(0),
+      m_tiles_done(0),
+      m_stop(false),
+      m_abort(false),
+      m_progress() {
+  if (n_threads <= 0) n_threads = g_nCPUCount;
+  if (n_threads <= 0) n_threads = wxThread::GetCPUCount();
+  n_threads = std::max(n_threads, 1);
+  for (int i = 0; i < n_threads; i++)
+    m_workers.push_back(std::make_unique<Worker>());
+}
+
+RasterCacheBuilder::~RasterCacheBuilder() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  for (auto &worker : m_workers)
+    if (worker->thread.joinable()) worker->thread.join();
+}
+
+bool RasterCacheBuilder::CanBuild() {
+  if (!g_GLOptions.m_bTextureCompression ||
+      !g_GLOptions.m_bTextureCompressionCaching)
+    return false;
+  // FXT1 is compressed by the GPU, on the GUI thread only.
+  return g_raster_format == GL_COMPRESSED_RGB_S3TC_DXT1_EXT ||
+         g_raster_format == GL_ETC1_RGB8_OES;
+}
+
+bool RasterCacheBuilder::Build(const std::vector<wxString> &chart_paths,
+                               const ProgressFunc &progress) {
+  if (!ChartData || !CanBuild()) return false;
+
+  m_progress = Progress();
+  m_progress.charts_total = chart_paths.size();
+  m_queued = 0;
+  m_tiles_done = 0;
+  m_stop = false;
+  m_abort = false;
+  for (size_t i = 0; i < m_workers.size(); i++)
+    m_workers[i]->thread = std::thread(&RasterCacheBuilder::Run, this, i);
+
+  // Enough charts to keep the workers busy while bounding the memory used
+  // by open charts and their factories.
+  const size_t max_open = 2 * m_workers.size();
+  for (const wxString &path : chart_paths) {
+    while (m_charts.size() >= max_open && !m_abort) {
+      CloseFinished();
+      Report(progress);
+    }
+    if (m_abort) break;
+    if (!QueueChart(path)) m_progress.charts_done++;
+    Report(progress);
+  }
+  while (!m_charts.empty()) {
+    CloseFinished();
+    Report(progress);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work_cv.notify_all();
+  for (auto &worker : m_workers) worker->thread.join();
+
+  if (!m_abort) {
+    m_progress.chart_path.clear();
+    progress(m_progress);
+  }
+  return !m_abort;
+}
+
+bool RasterCacheBuilder::QueueChart(const wxString &path) {
+  ChartBase *pchart = ChartData->OpenChartFromDBAndLock(path, FULL_INIT);
+  if (!pchart) /* probably a corrupt chart */
+    return false;
+  m_progress.chart_path = path;
+
+  ChartBaseBSB *pBSBChart = dynamic_cast<ChartBaseBSB *>(pchart);
+  if (!pBSBChart) {
+    ChartData->DeleteCacheChart(pchart);
+    return false;
+  }
+
+  // bad things if more than one texfactory for a chart
+  g_glTextureManager->PurgeChartTextures(pchart, true);
+
+  auto chart = std::make_unique<Chart>();
+  chart->chart = pchart;
+  chart->factory = std::make_unique<glTexFactory>(pchart, g_raster_format);
+  chart->since_catalog = 0;
+
+  int dim = g_GLOptions.m_iTextureDimension;
+  int nx_tex = ceil((float)pBSBChart->GetSize_X() / dim);
+  int ny_tex = ceil((float)pBSBChart->GetSize_Y() / dim);
+
+  // Queued last to first: the owner pops from the back and reads the chart
+  // from the top, thieves take the bottom.
+  std::deque<Tile> tiles;
+  for (int y = 0; y < ny_tex; y++) {
+    for (int x = 0; x < nx_tex; x++) {
+      wxRect rect(x * dim, y * dim, dim, dim);
+      for (int level = 0; level < g_mipmap_max_level + 1; level++) {
+        if (!chart->factory->IsLevelInCache(level, rect, global_color_scheme)) {
+          tiles.push_front({chart.get(), rect});
+          break;
+        }
+      }
+    }
+  }
+  if (tiles.empty()) {
+    CloseChart(chart.get());
+    return false;
+  }
+
+  chart->remaining = tiles.size();
+  m_progress.tiles_queued += tiles.size();
+  m_charts.push_back(std::move(chart));
+  Worker &worker = *m_workers[m_next_worker++ % m_workers.size()];
+  {
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tiles.insert(worker.tiles.end(), tiles.begin(), tiles.end());
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queued += tiles.size();
+  }
+  m_work_cv.notify_all();
+  return true;
+}
+
+void RasterCacheBuilder::CloseChart(Chart *chart) {
+  chart->factory->WriteCatalogAndHeader();
+  chart->factory.reset();
+  ChartData->DeleteCacheChart(chart->chart);
+}
+
+void RasterCacheBuilder::CloseFinished() {
+  std::vector<Chart *> finished;
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait_for(lock, std::chrono::milliseconds(100),
+                       [&] { return !m_finished.empty(); });
+    finished.swap(m_finished);
+  }
+  for (Chart *chart : finished) {
+    CloseChart(chart);
+    m_charts.remove_if([chart](const std::unique_ptr<Chart> &c) {
+      return c.get() == chart;
+    });
+    m_progress.charts_done++;
+  }
+}
+
+void RasterCacheBuilder::Report(const ProgressFunc &progress) {
+  // Limit the callback rate, it may yield to the GUI.
+  using Clock = std::chrono::steady_clock;
+  static const auto kInterval = std::chrono::milliseconds(100);
+  auto now = Clock::now();
+  if (now - m_last_report < kInterval) return;
+  m_last_report = now;
+
+  m_progress.tiles_done = m_tiles_done;
+  if (!progress(m_progress)) m_abort = true;
+}
+
+void RasterCacheBuilder::Run(size_t index) {
+  Tile tile;
+  while (true) {
+    if (Pop(index, tile)) {
+      DoTile(tile);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_work_cv.wait(lock, [&] { return m_queued > 0 || m_stop; });
+    if (m_queued == 0) return;
+  }
+}
+
+bool RasterCacheBuilder::Pop(size_t index, Tile &tile) {
+  // Newest tile of our own deque first, then the oldest of the others.
+  size_t n = m_workers.size();
+  for (size_t i = 0; i < n; i++) {
+    Worker &worker = *m_workers[(index + i) % n];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tiles.empty()) continue;
+    if (i == 0) {
+      tile = worker.tiles.back();
+      worker.tiles.pop_back();
+    } else {
+      tile = worker.tiles.front();
+      worker.tiles.pop_front();
+    }
+    m_queued--;
+    return true;
+  }
+  return false;
+}
+
+void RasterCacheBuilder::DoTile(const Tile &tile) {
+  Chart *chart = tile.chart;
+  if (!m_abort) {
+    JobTicket ticket;
+    ticket.pFact = chart->factory.get();
+    ticket.m_rect = tile.rect;
+    ticket.level_min_request = 0;
+    ticket.ident = 0;
+    ticket.b_throttle = false;
+    ticket.pthread = nullptr;
+    ticket.m_ChartPath = chart->factory->GetChartPath();
+    ticket.b_abort = false;
+    ticket.b_isaborted = false;
+    ticket.bpost_zip_compress = true;
+    ticket.binplace = false;
+    ticket.b_inCompressAll = true;
+
+    // GetChartBits() serializes the reads of a chart.
+    wxRect rect(tile.rect);
+    ticket.level0_bits = (unsigned char *)malloc(rect.width * rect.height * 4);
+    static_cast<ChartBaseBSB *>(chart->chart)
+        ->GetChartBits(rect, ticket.level0_bits, 1);
+
+    if (ticket.DoJob(tile.rect)) {
+      std::lock_guard<std::mutex> lock(chart->mutex);
+      chart->factory->UpdateCacheAllLevels(
+          tile.rect, global_color_scheme, ticket.compcomp_bits_array,
+          ticket.compcomp_size_array, false);
+      if (++chart->since_catalog >= kCatalogInterval) {
+        chart->factory->WriteCatalogAndHeader();
+        chart->since_catalog = 0;
+      }
+    }
+    for (int i = 0; i < g_mipmap_max_level + 1; i++) {
+      free(ticket.comp_bits_array[i]);
+      free(ticket.compcomp_bits_array[i]);
+    }
+  }
+  m_tiles_done++;
+
+  bool finished;
+  {
+    std::lock_guard<std::mutex> lock(chart->mutex);
+    finished = --chart->remaining == 0;
+  }
+  if (finished) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_finished.push_back(chart);
+    m_done_cv.notify_one();
+  }
+}
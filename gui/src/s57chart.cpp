@@ -80,7 +80,12 @@
 #endif
 
 #include <algorithm>  // for std::sort
+#include <list>
 #include <map>
+#include <unordered_set>
+
+#include <wx/file.h>
+#include <wx/stopwatch.h>
 
 #include "ssl/sha1.h"
 #ifdef ocpnUSE_GL
@@ -251,6 +256,7 @@ s57chart::s57chart() {
 
   m_bLinePrioritySet = false;
   m_plib_state_hash = 0;
+  m_plib_cs_state_hash = 0;
 
   m_btex_mem = false;
 
@@ -1350,6 +1356,21 @@ void s57chart::AssembleLineGeometry() {
   // And so we can empty the temp buffer
   connector_segment_vector.clear();
 
+  ReleaseLineGeometrySources();
+
+#ifdef ocpnUSE_GL
+  if (g_b_EnableVBO) {
+    if (grow_buffer) {
+      if (m_LineVBO_name > 0) {
+        glDeleteBuffers(1, (GLuint *)&m_LineVBO_name);
+        m_LineVBO_name = -1;
+      }
+    }
+  }
+#endif
+}
+
+void s57chart::ReleaseLineGeometrySources() {
   // We can convert the edge hashmap to a vector, to allow  us to destroy the
   // hashmap and at the same time free up the point storage in the VE_Elements,
   // since all the points are now in the VBO buffer
@@ -1371,17 +1392,378 @@ void s57chart::AssembleLineGeometry() {
     delete pcs;
   }
   m_vc_hash.clear();
+}
 
-#ifdef ocpnUSE_GL
-  if (g_b_EnableVBO) {
-    if (grow_buffer) {
-      if (m_LineVBO_name > 0) {
-        glDeleteBuffers(1, (GLuint *)&m_LineVBO_name);
-        m_LineVBO_name = -1;
+//------------------------------------------------------------------------
+//      Line geometry cache
+//
+//      The output of AssembleLineGeometry() depends only on the SENC
+//      contents, so it is persisted next to the SENC file.  Reopening a
+//      cell (e.g. after ChartDB::PurgeCacheUnusedCharts() dropped it) is
+//      then one file read and a straight copy into the line vertex buffer,
+//      ready for BuildLineVBO().
+//
+//      Layout, native byte order as for the SENC itself:
+//        LineGeomCacheHeader
+//        LineGeomCacheEdge       [n_edges]
+//        LineGeomCacheConnector  [n_connectors]
+//        LineGeomCacheObject     [n_objects]
+//        LineGeomCacheSegment    [n_segments]
+//        float                   [vbo_bytes / sizeof(float)]
+//------------------------------------------------------------------------
+
+static const char kLineGeomCacheMagic[8] = {'O', 'C', 'P', 'N',
+                                            'L', 'G', 'C', '\0'};
+static const uint32_t kLineGeomCacheVersion = 1;
+
+struct LineGeomCacheHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t n_edges;
+  uint64_t senc_size;
+  int64_t senc_mtime;
+  double ref_lat;
+  double ref_lon;
+  uint32_t n_candidates;  // objects awaiting line assembly at ingest
+  uint32_t n_connectors;
+  uint32_t n_objects;
+  uint32_t spare;
+  uint64_t n_segments;
+  uint64_t vbo_bytes;
+};
+
+struct LineGeomCacheEdge {
+  uint32_t index;  // VE_Element::index
+  uint32_t spare;
+  uint64_t vbo_offset;
+};
+
+struct LineGeomCacheConnector {
+  int32_t vbo_offset;
+  float lat_avg;
+  float lon_avg;
+};
+
+struct LineGeomCacheObject {
+  int32_t index;  // S57Obj::Index, the SENC feature ID
+  uint32_t n_segments;
+};
+
+struct LineGeomCacheSegment {
+  uint32_t type;  // SegmentType
+  uint32_t ref;   // VE_Element::index, or connector table index
+};
+
+static wxString GetLineGeomCacheFile(const wxString &SENCPath) {
+  wxFileName fn(SENCPath);
+  fn.SetExt("lgc");
+  return fn.GetFullPath();
+}
+
+static bool GetLineGeomCacheKey(const wxString &SENCPath, double ref_lat,
+                                double ref_lon, LineGeomCacheHeader &hdr) {
+  wxFileName fn(SENCPath);
+  wxULongLong size = fn.GetSize();
+  if (size == wxInvalidSize) return false;
+  wxDateTime mtime = fn.GetModificationTime();
+  if (!mtime.IsValid()) return false;
+
+  memset(&hdr, 0, sizeof(hdr));
+  memcpy(hdr.magic, kLineGeomCacheMagic, sizeof(hdr.magic));
+  hdr.version = kLineGeomCacheVersion;
+  hdr.senc_size = size.GetValue();
+  hdr.senc_mtime = mtime.GetTicks();
+  hdr.ref_lat = ref_lat;
+  hdr.ref_lon = ref_lon;
+  return true;
+}
+
+bool s57chart::GetPendingLineObjects(
+    std::unordered_map<int, S57Obj *> &pending) {
+  for (int i = 0; i < PRIO_NUM; ++i) {
+    for (int j = 0; j < LUPNAME_NUM; j++) {
+      for (ObjRazRules *top = razRules[i][j]; top; top = top->next) {
+        S57Obj *obj = top->obj;
+        if (obj->m_ls_list || !obj->m_n_lsindex) continue;
+        //  Feature IDs must be unique to serve as cache keys
+        if (!pending.emplace(obj->Index, obj).second) return false;
       }
     }
   }
-#endif
+  return true;
+}
+
+bool s57chart::LoadLineGeometryCache(const wxString &SENCPath) {
+  //  Only a freshly ingested SENC may be restored, cm93 and friends
+  //  grow the buffer incrementally.
+  if (m_vbo_byte_length || m_line_vertex_buffer) return false;
+
+  wxString cache_file = GetLineGeomCacheFile(SENCPath);
+  if (!wxFileExists(cache_file)) return false;
+
+  LineGeomCacheHeader key;
+  if (!GetLineGeomCacheKey(SENCPath, ref_lat, ref_lon, key)) return false;
+
+  wxFile file(cache_file);
+  if (!file.IsOpened()) return false;
+  wxFileOffset file_length = file.Length();
+  if (file_length < (wxFileOffset)sizeof(LineGeomCacheHeader)) return false;
+
+  std::vector<unsigned char> buf(file_length);
+  if (file.Read(buf.data(), file_length) != file_length) return false;
+
+  LineGeomCacheHeader hdr;
+  memcpy(&hdr, buf.data(), sizeof(hdr));
+  if (hdr.n_segments > (uint64_t)file_length ||
+      hdr.vbo_bytes > (uint64_t)file_length)
+    return false;
+  if (memcmp(hdr.magic, key.magic, sizeof(hdr.magic)) ||
+      hdr.version != key.version || hdr.senc_size != key.senc_size ||
+      hdr.senc_mtime != key.senc_mtime || hdr.ref_lat != key.ref_lat ||
+      hdr.ref_lon != key.ref_lon)
+    return false;
+
+  uint64_t expected = sizeof(LineGeomCacheHeader) +
+                      hdr.n_edges * sizeof(LineGeomCacheEdge) +
+                      hdr.n_connectors * sizeof(LineGeomCacheConnector) +
+                      hdr.n_objects * sizeof(LineGeomCacheObject) +
+                      hdr.n_segments * sizeof(LineGeomCacheSegment) +
+                      hdr.vbo_bytes;
+  if (expected != (uint64_t)file_length) return false;
+
+  const unsigned char *run = buf.data() + sizeof(LineGeomCacheHeader);
+
+  std::vector<LineGeomCacheEdge> edges(hdr.n_edges);
+  memcpy(edges.data(), run, hdr.n_edges * sizeof(LineGeomCacheEdge));
+  run += hdr.n_edges * sizeof(LineGeomCacheEdge);
+
+  std::vector<LineGeomCacheConnector> connectors(hdr.n_connectors);
+  memcpy(connectors.data(), run,
+         hdr.n_connectors * sizeof(LineGeomCacheConnector));
+  run += hdr.n_connectors * sizeof(LineGeomCacheConnector);
+
+  std::vector<LineGeomCacheObject> objects(hdr.n_objects);
+  memcpy(objects.data(), run, hdr.n_objects * sizeof(LineGeomCacheObject));
+  run += hdr.n_objects * sizeof(LineGeomCacheObject);
+
+  std::vector<LineGeomCacheSegment> segments(hdr.n_segments);
+  memcpy(segments.data(), run, hdr.n_segments * sizeof(LineGeomCacheSegment));
+  run += hdr.n_segments * sizeof(LineGeomCacheSegment);
+
+  const unsigned char *vbo_data = run;
+
+  //  Validate everything against the freshly loaded SENC before any
+  //  chart state is modified, so a failure falls back cleanly.
+  size_t n_live_edges = 0;
+  for (const auto &it : m_ve_hash)
+    if (it.second) n_live_edges++;
+  if (n_live_edges != hdr.n_edges) return false;
+
+  for (const auto &edge : edges) {
+    auto found = m_ve_hash.find(edge.index);
+    if (found == m_ve_hash.end() || !found->second) return false;
+    if (edge.vbo_offset + found->second->nCount * 2 * sizeof(float) >
+        hdr.vbo_bytes)
+      return false;
+  }
+
+  for (const auto &connector : connectors) {
+    if (connector.vbo_offset < 0 ||
+        (uint64_t)connector.vbo_offset + 4 * sizeof(float) > hdr.vbo_bytes)
+      return false;
+  }
+
+  std::unordered_map<int, S57Obj *> pending;
+  if (!GetPendingLineObjects(pending)) return false;
+  if (pending.size() != hdr.n_candidates) return false;
+
+  uint64_t n_segments = 0;
+  std::unordered_set<int> restored;
+  for (const auto &object : objects) {
+    if (pending.find(object.index) == pending.end()) return false;
+    if (!restored.insert(object.index).second) return false;
+    n_segments += object.n_segments;
+  }
+  if (n_segments != hdr.n_segments) return false;
+
+  for (const auto &segment : segments) {
+    switch (segment.type) {
+      case TYPE_EE:
+      case TYPE_EE_REV: {
+        auto found = m_ve_hash.find(segment.ref);
+        if (found == m_ve_hash.end() || !found->second) return false;
+        break;
+      }
+      case TYPE_CE:
+      case TYPE_CC:
+      case TYPE_EC:
+        if (segment.ref >= hdr.n_connectors) return false;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  //  All good, commit.
+  m_line_vertex_buffer = (float *)malloc(hdr.vbo_bytes);
+  if (!m_line_vertex_buffer) return false;
+  memcpy(m_line_vertex_buffer, vbo_data, hdr.vbo_bytes);
+  m_vbo_byte_length = hdr.vbo_bytes;
+
+  for (const auto &edge : edges)
+    m_ve_hash[edge.index]->vbo_offset = edge.vbo_offset;
+
+  size_t pcs_base = m_pcs_vector.size();
+  for (const auto &connector : connectors) {
+    connector_segment *pcs = new connector_segment;
+    pcs->vbo_offset = connector.vbo_offset;
+    pcs->max_priority_cs = 0;
+    pcs->cs_lat_avg = connector.lat_avg;
+    pcs->cs_lon_avg = connector.lon_avg;
+    m_pcs_vector.push_back(pcs);
+  }
+
+  const LineGeomCacheSegment *pseg = segments.data();
+  for (const auto &object : objects) {
+    S57Obj *obj = pending[object.index];
+    pending.erase(object.index);
+
+    line_segment_element list_top;
+    list_top.next = 0;
+    line_segment_element *le_current = &list_top;
+
+    for (uint32_t k = 0; k < object.n_segments; k++, pseg++) {
+      line_segment_element *pls = new line_segment_element;
+      pls->next = 0;
+      pls->priority = 0;
+      pls->ls_type = (SegmentType)pseg->type;
+      if (pls->ls_type == TYPE_EE || pls->ls_type == TYPE_EE_REV)
+        pls->pedge = m_ve_hash[pseg->ref];
+      else
+        pls->pcs = m_pcs_vector[pcs_base + pseg->ref];
+
+      le_current->next = pls;
+      le_current = pls;
+    }
+
+    obj->m_ls_list = list_top.next;
+    if (obj->m_ls_list == NULL) obj->m_n_lsindex = 0;
+
+    free(obj->m_lsindex_array);
+    obj->m_lsindex_array = NULL;
+  }
+
+  //  Objects AssembleLineGeometry() found to have no usable segments
+  //  were not recorded, treat them the same way it does.
+  for (const auto &it : pending) {
+    S57Obj *obj = it.second;
+    obj->m_n_lsindex = 0;
+    free(obj->m_lsindex_array);
+    obj->m_lsindex_array = NULL;
+  }
+
+  ReleaseLineGeometrySources();
+
+  return true;
+}
+
+void s57chart::SaveLineGeometryCache(const wxString &SENCPath,
+                                     size_t n_candidates) {
+  LineGeomCacheHeader hdr;
+  if (!GetLineGeomCacheKey(SENCPath, ref_lat, ref_lon, hdr)) return;
+  hdr.n_candidates = n_candidates;
+
+  std::vector<LineGeomCacheEdge> edges;
+  edges.reserve(m_pve_vector.size());
+  for (VE_Element *pedge : m_pve_vector) {
+    LineGeomCacheEdge edge;
+    edge.index = pedge->index;
+    edge.spare = 0;
+    edge.vbo_offset = pedge->vbo_offset;
+    edges.push_back(edge);
+  }
+
+  std::unordered_map<connector_segment *, uint32_t> connector_index;
+  std::vector<LineGeomCacheConnector> connectors;
+  connectors.reserve(m_pcs_vector.size());
+  for (connector_segment *pcs : m_pcs_vector) {
+    connector_index[pcs] = connectors.size();
+    LineGeomCacheConnector connector;
+    connector.vbo_offset = pcs->vbo_offset;
+    connector.lat_avg = pcs->cs_lat_avg;
+    connector.lon_avg = pcs->cs_lon_avg;
+    connectors.push_back(connector);
+  }
+
+  std::vector<LineGeomCacheObject> objects;
+  std::vector<LineGeomCacheSegment> segments;
+  std::unordered_set<int> seen;
+  for (int i = 0; i < PRIO_NUM; ++i) {
+    for (int j = 0; j < LUPNAME_NUM; j++) {
+      for (ObjRazRules *top = razRules[i][j]; top; top = top->next) {
+        S57Obj *obj = top->obj;
+        if (!obj->m_ls_list) continue;
+        //  Feature IDs must be unique to serve as keys
+        if (!seen.insert(obj->Index).second) return;
+
+        LineGeomCacheObject object;
+        object.index = obj->Index;
+        object.n_segments = 0;
+        for (line_segment_element *pls = obj->m_ls_list; pls;
+             pls = pls->next) {
+          LineGeomCacheSegment segment;
+          segment.type = pls->ls_type;
+          if (pls->ls_type == TYPE_EE || pls->ls_type == TYPE_EE_REV) {
+            segment.ref = pls->pedge->index;
+          } else {
+            auto found = connector_index.find(pls->pcs);
+            if (found == connector_index.end()) return;
+            segment.ref = found->second;
+          }
+          segments.push_back(segment);
+          object.n_segments++;
+        }
+        objects.push_back(object);
+      }
+    }
+  }
+
+  if (objects.size() > n_candidates) return;
+
+  hdr.n_edges = edges.size();
+  hdr.n_connectors = connectors.size();
+  hdr.n_objects = objects.size();
+  hdr.n_segments = segments.size();
+  hdr.vbo_bytes = m_vbo_byte_length;
+
+  //  Write to a temporary file first, so that a concurrent reader
+  //  never sees a partial cache.
+  wxString cache_file = GetLineGeomCacheFile(SENCPath);
+  wxString tmp_file = cache_file + ".tmp";
+  {
+    wxFile file;
+    if (!file.Create(tmp_file, true)) return;
+    bool ok = file.Write(&hdr, sizeof(hdr)) == sizeof(hdr);
+    ok &= file.Write(edges.data(), edges.size() * sizeof(LineGeomCacheEdge)) ==
+          edges.size() * sizeof(LineGeomCacheEdge);
+    ok &= file.Write(connectors.data(),
+                     connectors.size() * sizeof(LineGeomCacheConnector)) ==
+          connectors.size() * sizeof(LineGeomCacheConnector);
+    ok &= file.Write(objects.data(),
+                     objects.size() * sizeof(LineGeomCacheObject)) ==
+          objects.size() * sizeof(LineGeomCacheObject);
+    ok &= file.Write(segments.data(),
+                     segments.size() * sizeof(LineGeomCacheSegment)) ==
+          segments.size() * sizeof(LineGeomCacheSegment);
+    ok &= file.Write(m_line_vertex_buffer, m_vbo_byte_length) ==
+          m_vbo_byte_length;
+    if (!ok) {
+      file.Close();
+      wxRemoveFile(tmp_file);
+      return;
+    }
+  }
+  if (!wxRenameFile(tmp_file, cache_file, true)) wxRemoveFile(tmp_file);
 }
 
 void s57chart::BuildLineVBO() {
@@ -1755,6 +2137,11 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
 #endif
   // qDebug() << "Done areas" << sw.GetTime();
 
+  //    Symbols and soundings are collected across objects and drawn in
+  //    as few calls as possible
+  ps52plib->ResetSymbolBatchStats();
+  ps52plib->BeginSymbolBatch();
+
   //    Render the lines and points
   for (i = 0; i < PRIO_NUM; ++i) {
     if (ps52plib->m_nBoundaryStyle == SYMBOLIZED_BOUNDARIES)
@@ -1795,8 +2182,16 @@ bool s57chart::DoRenderOnGL(const wxGLContext &glc, const ViewPort &VPoint) {
       ps52plib->RenderObjectToGL(glc, crnt);
     }
   }
+  ps52plib->EndSymbolBatch();
   // qDebug() << "Done Points" << sw.GetTime();
 
+  if (g_bDebugS57) {
+    unsigned draw_calls, quads;
+    ps52plib->GetSymbolBatchStats(draw_calls, quads);
+    printf("  %s: %u symbol quads in %u draw calls\n",
+           (const char *)m_Name.mb_str(), quads, draw_calls);
+  }
+
 #endif  // #ifdef ocpnUSE_GL
 
   return true;
@@ -4312,9 +4707,22 @@ int s57chart::BuildRAZFromSENCFile(const wxString &FullPath) {
   m_ID = sencfile.getReadID();
   m_Name = sencfile.getReadName();
 
-  ObjRazRules *top;
+  wxStopWatch sw_geom;
+  bool b_cached_geom = LoadLineGeometryCache(FullPath);
+  if (!b_cached_geom) {
+    std::unordered_map<int, S57Obj *> pending;
+    bool b_cacheable = GetPendingLineObjects(pending);
+
+    AssembleLineGeometry();
 
-  AssembleLineGeometry();
+    if (b_cacheable) SaveLineGeometryCache(FullPath, pending.size());
+  }
+
+  if (g_bDebugS57) {
+    wxLogMessage("  %s line geometry for %s in %ld ms",
+                 b_cached_geom ? "Restored" : "Assembled", m_Name,
+                 sw_geom.Time());
+  }
 
   return ret_val;
 }
@@ -4480,6 +4888,14 @@ void s57chart::UpdateLUPs(s57chart *pOwner) {
   ObjRazRules *top;
   ObjRazRules *nxx;
   LUPrec *LUP;
+  wxStopWatch sw;
+
+  //  Text, noshow list and display category changes alter the state hash
+  //  but not the output of the conditional symbology procedures.
+  //  Keep the already resolved CS rules unless their inputs changed.
+  bool b_reset_cs = (m_plib_cs_state_hash != ps52plib->GetCSStateHash());
+  m_plib_cs_state_hash = ps52plib->GetCSStateHash();
+
   for (int i = 0; i < PRIO_NUM; ++i) {
     //  SIMPLIFIED is set, PAPER_CHART is bare
     if ((razRules[i][0]) && (NULL == razRules[i][1])) {
@@ -4564,6 +4980,8 @@ void s57chart::UpdateLUPs(s57chart *pOwner) {
       }
     }
 
+    if (!b_reset_cs) continue;
+
     //  Traverse this priority level again,
     //  clearing any object CS rules and flags,
     //  so that the next render operation will re-evaluate the CS
@@ -4610,6 +5028,10 @@ void s57chart::UpdateLUPs(s57chart *pOwner) {
   // charts
   // TODO really should make the dynamic LUPs belong to the chart class that
   // created them
+
+  if (g_bDebugS57)
+    wxLogMessage("  s57chart::UpdateLUPs %s: %ld ms%s", m_Name,
+                 sw.Time(), b_reset_cs ? ", CS reset" : "");
 }
 
 ListOfObjRazRules *s57chart::GetLightsObjRuleListVisibleAtLatLon(
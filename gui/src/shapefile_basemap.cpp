@@ -427,14 +427,7 @@ void ShapeBaseChart::DoDrawPolygonFilledGL(ocpnDC &pnt, ViewPort &vp,
   mat4x4_translate_in_place(mvp, -vp.pix_width / 2, vp.pix_height / 2, 0);
 
   float *pvt = new float[2 * (polycnt)];
-  for (size_t i = 0; i < polycnt; i++) {
-    float_2Dpt *pc = polyv + i;
-    // wxPoint2DDouble q(pc->y, pc->x);// = vp.GetDoublePixFromLL(pc->y, pc->x);
-    wxPoint2DDouble q = vp.GetDoublePixFromLL(pc->y, pc->x);
-
-    pvt[i * 2] = q.m_x;
-    pvt[(i * 2) + 1] = q.m_y;
-  }
+  vp.ProjectLLToPix(&polyv->y, &polyv->x, polycnt, pvt, 2);
 
   GLShaderProgram *shader = pcolor_tri_shader_program[pnt.m_canvasIndex];
   shader->Bind();
@@ -17,6 +17,7 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
  **************************************************************************/
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -57,9 +58,12 @@ const wxString kUtfRightArrow = wxString::FromUTF8(u8"\u2192");
 /** Return true if s matches ll's source interface or message. */
 static bool IsFilterMatch(const struct Logline& ll, const std::string& s) {
   if (ll.navmsg->source->iface.find(s) != std::string::npos) return true;
-  return ll.message.find(s) != std::string::npos;
+  return ll.GetText().find(s) != std::string::npos;
 }
 
+/** Interval between repaints with new lines. */
+static const int kRefreshIntervalMs = 100;
+
 static std::string Timestamp(const NavmsgTimePoint& when) {
   using namespace std;
   using namespace std::chrono;
@@ -108,7 +112,7 @@ wxColor StdColorsByState::operator()(NavmsgStatus ns) {
 /** Draw a single line in the log window. */
 void TtyScroll::DrawLine(wxDC& dc, const Logline& ll, int data_pos, int y) {
   wxString ws;
-  if (!ll.message.empty()) ws << Timestamp(ll.navmsg->created_at) << " ";
+  if (ll.navmsg) ws << Timestamp(ll.navmsg->created_at) << " ";
   if (ll.state.direction == NavmsgStatus::Direction::kOutput)
     ws << " " << kUtfRightArrow << " ";
   else if (ll.state.direction == NavmsgStatus::Direction::kInput)
@@ -139,37 +143,82 @@ void TtyScroll::DrawLine(wxDC& dc, const Logline& ll, int data_pos, int y) {
 
   dc.DrawText(ws, 0, y);
   ws = "";
-  ws << ll.message << error_msg.str();
+  ws << ll.GetText() << error_msg.str();
   dc.DrawText(ws, data_pos, y);
   m_text_width =
       std::max(m_text_width, GetTextExtent(ws).GetWidth() + data_pos);
 }
 
-TtyScroll::TtyScroll(wxWindow* parent, int n_lines)
-    : wxScrolledWindow(parent), m_n_lines(n_lines), m_is_paused(false) {
+TtyScroll::TtyScroll(wxWindow* parent, int n_lines, size_t history)
+    : wxScrolledWindow(parent),
+      m_n_lines(n_lines),
+      m_text_width(0),
+      m_lines(history),
+      m_is_paused(false),
+      m_is_dirty(false) {
   SetName("TtyScroll");
   wxClientDC dc(this);
   dc.GetTextExtent("Line Height", NULL, &m_line_height);
   SetScrollRate(m_line_height, m_line_height);
-  for (unsigned i = 0; i < m_n_lines; i++) m_lines.push_back(Logline());
   SetColors(std::make_unique<StdColorsByState>());
   Bind(wxEVT_SIZE, [&](wxSizeEvent& ev) { OnSize(ev); });
+  m_refresh_timer.Bind(wxEVT_TIMER, [&](wxTimerEvent&) { OnRefreshTimer(); });
+  m_refresh_timer.Start(kRefreshIntervalMs, wxTIMER_CONTINUOUS);
 }
 
 void TtyScroll::OnSize(wxSizeEvent& ev) {
   m_n_lines = ev.GetSize().y / GetCharHeight();
-  while (m_lines.size() < m_n_lines) m_lines.push_back(Logline());
   ev.Skip();
 }
 
 void TtyScroll::Add(const Logline& ll) {
-  if (m_is_paused || !m_filter.Pass(ll.state, ll.navmsg)) return;
-  if (!m_quick_filter.empty() && !IsFilterMatch(ll, m_quick_filter)) return;
-  while (m_lines.size() > m_n_lines - 1) m_lines.pop_front();
-  m_lines.push_back(ll);
+  if (m_is_paused) return;
+  m_lines.Add(ll);
+  m_is_dirty = true;
+}
+
+void TtyScroll::SetFilter(const NavmsgFilter& filter) {
+  m_filter = filter;
+  ApplyFilter();
+}
+
+void TtyScroll::SetQuickFilter(const std::string s) {
+  m_quick_filter = s;
+  ApplyFilter();
+}
+
+void TtyScroll::ApplyFilter() {
+  // The filter may run in a worker thread, so it captures copies.
+  NavmsgFilter filter = m_filter;
+  std::string quick_filter = m_quick_filter;
+  m_lines.SetFilter([filter, quick_filter](const Logline& ll) mutable {
+    if (!ll.navmsg || !filter.Pass(ll.state, ll.navmsg)) return false;
+    return quick_filter.empty() || IsFilterMatch(ll, quick_filter);
+  });
+  m_is_dirty = true;
+}
+
+void TtyScroll::OnRefreshTimer() {
+  if (!m_is_dirty && !m_lines.IsScanning()) return;
+  m_is_dirty = false;
+  if (!m_lines.Update()) return;
+  size_t rows = GetRowCount();
+  SetVirtualSize(m_text_width, (rows + 1) * m_line_height);
+  if (!m_is_paused) Scroll(0, static_cast<int>(rows - m_n_lines));
   Refresh(true);
 }
 
+size_t TtyScroll::GetRowCount() const {
+  return std::max(m_lines.GetMatchCount(), m_n_lines);
+}
+
+LoglineBuffer::LinePtr TtyScroll::GetRowLine(size_t row) const {
+  // Rows are bottom aligned, empty rows on top if there are few lines.
+  size_t first = GetRowCount() - m_lines.GetMatchCount();
+  if (row < first) return nullptr;
+  return m_lines.GetMatch(row - first);
+}
+
 void TtyScroll::SetColors(std::unique_ptr<ColorByState> color_by_state) {
   m_color_by_state = std::move(color_by_state);
 }
@@ -179,24 +228,33 @@ void TtyScroll::OnDraw(wxDC& dc) {
   wxRect rect_update = GetUpdateRegion().GetBox();
   CalcUnscrolledPosition(rect_update.x, rect_update.y, &rect_update.x,
                          &rect_update.y);
+  size_t rows = GetRowCount();
   size_t line_from = rect_update.y / m_line_height;
   size_t line_to = rect_update.GetBottom() / m_line_height;
-  if (line_to > m_n_lines - 1) line_to = m_n_lines - 1;
+  if (line_to > rows - 1) line_to = rows - 1;
 
+  // Only the visible rows are formatted.
   wxCoord y = line_from * m_line_height;
   m_text_width = 0;
   for (size_t line = line_from; line <= line_to; line++) {
-    wxString ws;
-    dc.SetTextForeground((*m_color_by_state)(m_lines[line].state));
-    DrawLine(dc, m_lines[line], 40 * GetCharWidth(), y);
+    auto ll = GetRowLine(line);
+    if (ll) {
+      dc.SetTextForeground((*m_color_by_state)(ll->state));
+      DrawLine(dc, *ll, 40 * GetCharWidth(), y);
+    }
     y += m_line_height;
   }
-  SetVirtualSize(m_text_width, (m_n_lines + 1) * m_line_height);
+  SetVirtualSize(m_text_width, (rows + 1) * m_line_height);
 }
 
 void TtyScroll::CopyToClipboard() const {
+  int x, first_row;
+  GetViewStart(&x, &first_row);
   std::stringstream ss;
-  for (auto& line : m_lines) ss << line.message << "\n";
+  for (size_t row = first_row; row < first_row + m_n_lines; row++) {
+    auto ll = GetRowLine(row);
+    if (ll) ss << ll->GetText() << "\n";
+  }
   if (wxTheClipboard->Open()) {
     wxTheClipboard->SetData(new wxTextDataObject(ss.str()));
     wxTheClipboard->Close();
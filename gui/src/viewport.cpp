@@ -23,6 +23,8 @@
  *   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301,  USA.         *
  **************************************************************************/
 
+#include <list>
+
 // For compilers that support precompilation, includes "wx.h".
 #include <wx/wxprec.h>
 
@@ -50,6 +52,7 @@
 #include "chcanv.h"
 #include "TCWin.h"
 #include "model/geodesic.h"
+#include "model/ll_projector.h"
 #include "styles.h"
 #include "model/routeman.h"
 #include "navutil.h"
@@ -267,6 +270,66 @@ wxPoint2DDouble ViewPort::GetDoublePixFromLL(double lat, double lon) {
   return wxPoint2DDouble(x, y);
 }
 
+template <typename T>
+static void ProjectPoints(ViewPort &vp, const T *lat, const T *lon, size_t n,
+                          float *out, size_t stride, double scale) {
+  LLProjector::Type type;
+  switch (vp.m_projection_type) {
+    case PROJECTION_MERCATOR:
+    case PROJECTION_WEB_MERCATOR:
+      type = LLProjector::Type::kMercator;
+      break;
+    case PROJECTION_TRANSVERSE_MERCATOR:
+      type = LLProjector::Type::kTransverseMercator;
+      break;
+    case PROJECTION_POLYCONIC:
+      type = LLProjector::Type::kPolyconic;
+      break;
+    case PROJECTION_ORTHOGRAPHIC:
+      type = LLProjector::Type::kOrthographic;
+      break;
+    case PROJECTION_POLAR:
+      type = LLProjector::Type::kPolar;
+      break;
+    case PROJECTION_STEREOGRAPHIC:
+      type = LLProjector::Type::kStereographic;
+      break;
+    case PROJECTION_GNOMONIC:
+      type = LLProjector::Type::kGnomonic;
+      break;
+    case PROJECTION_EQUIRECTANGULAR:
+      type = LLProjector::Type::kEquirectangular;
+      break;
+    default:
+      for (size_t i = 0; i < n; i++) {
+        wxPoint2DDouble p = vp.GetDoublePixFromLL(lat[i * stride],
+                                                  lon[i * stride]);
+        out[2 * i] = p.m_x;
+        out[2 * i + 1] = p.m_y;
+      }
+      return;
+  }
+
+  LLProjector projector(type, vp.clat, vp.clon);
+  projector.SetTransform(vp.view_scale_ppm, vp.rotation, vp.pix_width / 2.0,
+                         vp.pix_height / 2.0, scale);
+  projector.Project(lat, lon, n, out, stride);
+}
+
+void ViewPort::ProjectLLToPix(const double *lat, const double *lon, size_t n,
+                              float *out, size_t stride) {
+  // Logical pixels when not using OpenGL, as in GetDoublePixFromLL()
+  ProjectPoints(*this, lat, lon, n, out, stride,
+                g_bopengl ? 1. : 1. / m_displayScale);
+}
+
+void ViewPort::ProjectLLToPix(const float *lat, const float *lon, size_t n,
+                              float *out, size_t stride) {
+  // Logical pixels when not using OpenGL, as in GetDoublePixFromLL()
+  ProjectPoints(*this, lat, lon, n, out, stride,
+                g_bopengl ? 1. : 1. / m_displayScale);
+}
+
 void ViewPort::GetLLFromPix(const wxPoint2DDouble &p, double *lat,
                             double *lon) {
   // Calculate distance from the center of the viewport to the given point in
@@ -427,11 +490,11 @@ OCPNRegion ViewPort::GetVPRegionIntersect(const OCPNRegion &region,
   rotation = 0;
 
   std::list<ContourRegion> cregions;
-  for (std::list<poly_contour>::const_iterator i = llregion.contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = llregion.contours.begin();
        i != llregion.contours.end(); i++) {
     float *contour_points = new float[2 * i->size()];
     int idx = 0;
-    std::list<contour_pt>::const_iterator j;
+    poly_contour::const_iterator j;
     for (j = i->begin(); j != i->end(); j++) {
       contour_points[idx++] = j->y;
       contour_points[idx++] = j->x;
@@ -7274,4 +7274,27 @@ extern DECL_EXP void AisTargetCreateWpt(wxString ais_mmsi);
 extern DECL_EXP void AisShowAllTracks(bool show);
 extern DECL_EXP void AisToggleTrack(wxString ais_mmsi);
 
+// Batch land crossing support
+
+/** A leg to test for land crossing, coordinates in decimal degrees. */
+struct PI_GSHHS_Segment {
+  double lat1;
+  double lon1;
+  double lat2;
+  double lon2;
+};
+
+/**
+ * Checks if each of a list of legs crosses land.
+ *
+ * Same test as PlugIn_GSHHS_CrossesLand(), with the legs split across
+ * threads. Use for large workloads such as weather routing, where one
+ * call per leg is too slow.
+ *
+ * @param segments Legs to test
+ * @return One item per leg, true if the leg crosses land
+ */
+extern DECL_EXP std::vector<bool> PlugIn_GSHHS_CrossesLandBatch(
+    const std::vector<PI_GSHHS_Segment> &segments);
+
 #endif  //_PLUGIN_H_
@@ -49,6 +49,10 @@ int GetSource(n2k_rawData *v);
 int GetDestination(n2k_rawData *v);
 //time_t GetTime(n2k_rawData *v);
 
+// Copy raw data into a tN2kMsg. Returns false if v is too short or the
+// data length is invalid, Msg is then cleared.
+bool MakeN2kMsg(const n2k_rawData &v, tN2kMsg &Msg);
+
 
 //-----------------------------------------------------------------------------
 //  Basic navigation information parsing
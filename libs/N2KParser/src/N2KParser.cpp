@@ -36,11 +36,14 @@ uint32_t millis() {
   return 42;
 }
 
-static void MakeN2kMsg(std::vector<unsigned char> &v, tN2kMsg &Msg) {
+bool MakeN2kMsg(const std::vector<unsigned char> &v, tN2kMsg &Msg) {
 
   Msg.Clear();
 
-  unsigned char *Buf = v.data();
+  // Header up to and including the data length byte
+  if ( v.empty() || v.size()<(v[0]==0x93 ? 13u : 8u) ) return false;
+
+  const unsigned char *Buf = v.data();
 
   int i=2;
   Msg.Priority=Buf[i++];
@@ -57,9 +60,11 @@ static void MakeN2kMsg(std::vector<unsigned char> &v, tN2kMsg &Msg) {
 
   if ( Msg.DataLen>tN2kMsg::MaxDataLen ) {
     Msg.Clear();
+    return false;
   }
 
   for (int j=0; i<static_cast<int>(v.size())-1 && j<Msg.DataLen; i++, j++) Msg.Data[j]=Buf[i];
+  return true;
 }
 
 bool ParseN2kPGN128275(std::vector<unsigned char> &v, uint16_t &DaysSince1970,
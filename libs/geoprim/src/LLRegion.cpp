@@ -29,24 +29,8 @@
 #include <string.h>
 #include <math.h>
 
-#if defined(__OCPN__ANDROID__)
- //#include <GLES2/gl2.h>
- #include <qopengl.h>
- #include <GL/gl_private.h>  // this is a cut-down version of gl.h
- #include <GLES2/gl2.h>
-#elif defined(__MSVC__)
- #include "glew.h"
- #include <GL/glu.h>
- // typedef void (__stdcall * _GLUfuncptr)(void);
-#elif defined(__WXOSX__)
- #include <OpenGL/gl.h>
- #include <OpenGL/glu.h>
- typedef void (*  _GLUfuncptr)();
- #define GL_COMPRESSED_RGB_FXT1_3DFX       0x86B0
-#elif defined(__WXQT__) || defined(__WXGTK__)
- #include <GL/glew.h>
- #include <GL/glu.h>
-#endif
+#include <algorithm>
+#include <utility>
 
 #include "LLRegion.h"
 
@@ -95,7 +79,7 @@ bool LLRegion::PointsCCW(size_t n, const double *points) {
 }
 
 void LLRegion::Print() const {
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     printf("[");
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
@@ -108,7 +92,7 @@ void LLRegion::plot(const char *fn) const {
   char filename[100] = "/home/sean/";
   strcat(filename, fn);
   FILE *f = fopen(filename, "w");
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
       fprintf(f, "%f %f\n", j->x, j->y);
@@ -127,7 +111,7 @@ LLBBox LLRegion::GetBox() const {
   // there are 3 possible longitude bounds: -180 to 180, 0 to 360, -360 to 0
   double minlat = 90, minlon[3] = {180, 360, 0};
   double maxlat = -90, maxlon[3] = {-180, 0, -360};
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     bool neg = false, pos = false;
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
@@ -210,7 +194,7 @@ bool LLRegion::Contains(float lat, float lon) const {
   if (lon > 180) return Contains(lat, lon - 360);
 
   int cnt = 0;
-  for (std::list<poly_contour>::const_iterator i = contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = contours.begin();
        i != contours.end(); i++) {
     contour_pt l = *i->rbegin();
     for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++) {
@@ -238,77 +222,18 @@ bool LLRegion::Contains(float lat, float lon) const {
   return cnt & 1;
 }
 
-struct work {
-  work(LLRegion &r) : region(r) { tobj = gluNewTess(); }
-
-  ~work() {
-    gluDeleteTess(tobj);
-    for (std::list<double *>::iterator i = data.begin(); i != data.end(); i++)
-      delete[] * i;
-    data.clear();
-  }
-
-  double *NewData() {
-    double *d = new double[3];
-    data.push_back(d);
-    return d;
-  }
-
-  void PutVertex(const contour_pt &j) {
-    double *p = NewData();
-    p[0] = j.x, p[1] = j.y, p[2] = 0;
-    gluTessVertex(tobj, p, p);
-  }
-
-  std::list<double *> data;
-  poly_contour contour;
-  GLUtesselator *tobj;
-  LLRegion &region;
-};
-
-static void /*APIENTRY*/ LLvertexCallback(GLvoid *vertex, void *user_data) {
-  work *w = (work *)user_data;
-  const GLdouble *pointer = (GLdouble *)vertex;
-  contour_pt p;
-  p.x = pointer[0], p.y = pointer[1];
-  w->contour.push_back(p);
-}
-
-static void /*APIENTRY*/ LLbeginCallback(GLenum which) {}
-
-static void /*APIENTRY*/ LLendCallback(void *user_data) {
-  work *w = (work *)user_data;
-  if (w->contour.size()) {
-    w->region.contours.push_back(w->contour);
-    w->contour.clear();
-  }
-}
-
-static void /*APIENTRY*/ LLcombineCallback(GLdouble coords[3],
-                                           GLdouble *vertex_data[4],
-                                           GLfloat weight[4],
-                                           GLdouble **dataOut,
-                                           void *user_data) {
-  work *w = (work *)user_data;
-  GLdouble *vertex = w->NewData();
-  memcpy(vertex, coords, 3 * (sizeof *coords));
-  *dataOut = vertex;
-}
-
-static void /*APIENTRY*/ LLerrorCallback(GLenum errorCode) {
-  const GLubyte *estring;
-  estring = gluErrorString(errorCode);
-  //LOG_INFO("Tessellation Error: %s\n", estring);
-  // exit (0);
-}
-
 void LLRegion::Intersect(const LLRegion &region) {
   if (NoIntersection(region)) {
     Clear();
     return;
   }
+  if (region.BoxContains(*this)) return;
+  if (BoxContains(region)) {
+    *this = region;
+    return;
+  }
 
-  Put(region, GLU_TESS_WINDING_ABS_GEQ_TWO, false);
+  Put(region, WindingRule::kAbsGeqTwo, false);
 }
 
 void LLRegion::Union(const LLRegion &region) {
@@ -316,43 +241,48 @@ void LLRegion::Union(const LLRegion &region) {
     Combine(region);
     return;
   }
+  if (BoxContains(region)) return;
+  if (region.BoxContains(*this)) {
+    *this = region;
+    return;
+  }
 
-  Put(region, GLU_TESS_WINDING_POSITIVE, false);
+  Put(region, WindingRule::kPositive, false);
 }
 
 void LLRegion::Subtract(const LLRegion &region) {
   if (NoIntersection(region)) return;
+  if (region.BoxContains(*this)) {
+    Clear();
+    return;
+  }
 
-  Put(region, GLU_TESS_WINDING_POSITIVE, true);
+  Put(region, WindingRule::kPositive, true);
 }
 
 void LLRegion::Reduce(double factor) {
   double factor2 = factor * factor;
 
-  std::list<poly_contour>::iterator i = contours.begin();
+  std::vector<poly_contour>::iterator i = contours.begin();
   while (i != contours.end()) {
-    if (i->size() < 3) {
-      printf("invalid contour");
-      continue;
-    }
-
     // reduce segments
+    poly_contour reduced;
+    reduced.reserve(i->size());
     contour_pt l = *i->rbegin();
-    poly_contour::iterator j = i->begin(), k;
-    while (j != i->end()) {
-      k = j;
-      j++;
-      if (dist2(vector(*k, l)) < factor2)
-        i->erase(k);
-      else
-        l = *k;
+    for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++) {
+      if (dist2(vector(*j, l)) >= factor2) {
+        reduced.push_back(*j);
+        l = *j;
+      }
     }
 
     // erase zero contours
-    if (i->size() < 3)
+    if (reduced.size() < 3) {
       i = contours.erase(i);
-    else
+    } else {
+      i->swap(reduced);
       i++;
+    }
   }
 
   // Optimize();
@@ -368,7 +298,7 @@ bool LLRegion::NoIntersection(const LLBBox &box) const {
         return false;
 
     // test if any segment crosses the box
-    for(std::list<poly_contour>::const_iterator i = contours.begin(); i != contours.end(); i++) {
+    for(std::vector<poly_contour>::const_iterator i = contours.begin(); i != contours.end(); i++) {
         contour_pt l = *i->rbegin();
         int state = ComputeState(box, l), lstate = state;
         if(state == 4) return false;
@@ -452,42 +382,92 @@ bool LLRegion::NoIntersection(const LLRegion &region) const {
          region.NoIntersection(box);
 }
 
-void LLRegion::PutContours(work &w, const LLRegion &region, bool reverse) {
-  for (std::list<poly_contour>::const_iterator i = region.contours.begin();
-       i != region.contours.end(); i++) {
-    gluTessBeginContour(w.tobj);
-    if (reverse)
-      for (poly_contour::const_reverse_iterator j = i->rbegin(); j != i->rend();
-           j++)
-        w.PutVertex(*j);
-    else
-      for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
-        w.PutVertex(*j);
-    gluTessEndContour(w.tobj);
+// true if the region is a single counter clockwise, axis aligned rectangle
+bool LLRegion::IsBox() const {
+  if (contours.size() != 1 || contours.front().size() != 4) return false;
+  const poly_contour &c = contours.front();
+  double area = 0;
+  for (int i = 0; i < 4; i++) {
+    const contour_pt &p = c[i], &n = c[(i + 1) % 4];
+    if ((p.x == n.x) == (p.y == n.y)) return false;
+    area += cross(p, n);
   }
+  return area < 0;  // counter clockwise, cross() has x and y swapped
 }
 
-void LLRegion::Put(const LLRegion &region, int winding_rule, bool reverse) {
-  work w(*this);
+// true if the region is a box containing all of region
+bool LLRegion::BoxContains(const LLRegion &region) const {
+  if (!IsBox()) return false;
+  const poly_contour &c = contours.front();
+  double minx = c[0].x, maxx = c[0].x, miny = c[0].y, maxy = c[0].y;
+  for (int i = 1; i < 4; i++) {
+    minx = wxMin(minx, c[i].x), maxx = wxMax(maxx, c[i].x);
+    miny = wxMin(miny, c[i].y), maxy = wxMax(maxy, c[i].y);
+  }
+  for (std::vector<poly_contour>::const_iterator i = region.contours.begin();
+       i != region.contours.end(); i++)
+    for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++)
+      if (j->x < minx || j->x > maxx || j->y < miny || j->y > maxy)
+        return false;
+  return true;
+}
 
-  gluTessCallback(w.tobj, GLU_TESS_VERTEX_DATA, (_GLUfuncptr)&LLvertexCallback);
-  gluTessCallback(w.tobj, GLU_TESS_BEGIN, (_GLUfuncptr)&LLbeginCallback);
-  gluTessCallback(w.tobj, GLU_TESS_COMBINE_DATA,
-                  (_GLUfuncptr)&LLcombineCallback);
-  gluTessCallback(w.tobj, GLU_TESS_END_DATA, (_GLUfuncptr)&LLendCallback);
-  gluTessCallback(w.tobj, GLU_TESS_ERROR, (_GLUfuncptr)&LLerrorCallback);
-  gluTessProperty(w.tobj, GLU_TESS_WINDING_RULE, winding_rule);
-  gluTessProperty(w.tobj, GLU_TESS_BOUNDARY_ONLY, GL_TRUE);
-  //    gluTessProperty(w.tobj, GLU_TESS_TOLERANCE, 1e-5);
+struct contour_box {
+  double minx, miny, maxx, maxy;
+};
 
-  gluTessNormal(w.tobj, 0, 0, 1);
+static contour_box ContourBox(const poly_contour &c) {
+  contour_box box = {c[0].x, c[0].y, c[0].x, c[0].y};
+  for (poly_contour::const_iterator j = c.begin(); j != c.end(); j++) {
+    box.minx = wxMin(box.minx, j->x), box.maxx = wxMax(box.maxx, j->x);
+    box.miny = wxMin(box.miny, j->y), box.maxy = wxMax(box.maxy, j->y);
+  }
+  return box;
+}
 
-  gluTessBeginPolygon(w.tobj, &w);
+static contour_box ContoursBox(const std::vector<poly_contour> &contours) {
+  contour_box box = ContourBox(contours.front());
+  for (size_t i = 1; i < contours.size(); i++) {
+    contour_box b = ContourBox(contours[i]);
+    box.minx = wxMin(box.minx, b.minx), box.maxx = wxMax(box.maxx, b.maxx);
+    box.miny = wxMin(box.miny, b.miny), box.maxy = wxMax(box.maxy, b.maxy);
+  }
+  return box;
+}
 
-  PutContours(w, *this);
-  PutContours(w, region, reverse);
-  contours.clear();
-  gluTessEndPolygon(w.tobj);
+static inline bool BoxesOut(const contour_box &a, const contour_box &b) {
+  return a.maxx < b.minx || a.minx > b.maxx || a.maxy < b.miny ||
+         a.miny > b.maxy;
+}
+
+void LLRegion::Put(const LLRegion &region, WindingRule rule, bool reverse) {
+  // A contour outside the box of the other region does not change the
+  // winding number inside it and is not changed by the operation: keep it
+  // if its region alone is in the result (union, or this when subtracting),
+  // else drop it. Only the remaining contours are clipped.
+  contour_box box = ContoursBox(contours), rbox = ContoursBox(region.contours);
+  bool keep_this = rule == WindingRule::kPositive;
+  bool keep_region = keep_this && !reverse;
+  std::vector<poly_contour> clip_this, clip_region, kept;
+  for (std::vector<poly_contour>::iterator i = contours.begin();
+       i != contours.end(); i++) {
+    if (!BoxesOut(ContourBox(*i), rbox))
+      clip_this.push_back(std::move(*i));
+    else if (keep_this)
+      kept.push_back(std::move(*i));
+  }
+  for (std::vector<poly_contour>::const_iterator i = region.contours.begin();
+       i != region.contours.end(); i++) {
+    if (!BoxesOut(ContourBox(*i), box))
+      clip_region.push_back(*i);
+    else if (keep_region)
+      kept.push_back(*i);
+  }
+
+  contours = PolyClip(clip_this, clip_region, reverse, rule);
+  for (std::vector<poly_contour>::iterator i = kept.begin(); i != kept.end();
+       i++)
+    contours.push_back(std::move(*i));
 
   Optimize();
   m_box.Invalidate();
@@ -495,7 +475,7 @@ void LLRegion::Put(const LLRegion &region, int winding_rule, bool reverse) {
 
 // same result as union, but only allowed if there is no intersection
 void LLRegion::Combine(const LLRegion &region) {
-  for (std::list<poly_contour>::const_iterator i = region.contours.begin();
+  for (std::vector<poly_contour>::const_iterator i = region.contours.begin();
        i != region.contours.end(); i++)
     contours.push_back(*i);
   m_box.Invalidate();
@@ -522,7 +502,8 @@ void LLRegion::InitPoints(size_t n, const double *points) {
     return;
   }
 
-  std::list<contour_pt> pts;
+  poly_contour pts;
+  pts.reserve(n);
   bool adjust = false;
 
   bool ccw = PointsCCW(n, points);
@@ -531,11 +512,9 @@ void LLRegion::InitPoints(size_t n, const double *points) {
     p.y = points[i + 0];
     p.x = points[i + 1];
     if (p.x < -180 || p.x > 180) adjust = true;
-    if (ccw)
-      pts.push_back(p);
-    else
-      pts.push_front(p);
+    pts.push_back(p);
   }
+  if (!ccw) std::reverse(pts.begin(), pts.end());
 
   contours.push_back(pts);
 
@@ -551,7 +530,7 @@ void LLRegion::AdjustLongitude() {
   if (!resolved.Empty()) {
     Intersect(clip);
     // apply longitude offset
-    for (std::list<poly_contour>::iterator i = resolved.contours.begin();
+    for (std::vector<poly_contour>::iterator i = resolved.contours.begin();
          i != resolved.contours.end(); i++)
       for (poly_contour::iterator j = i->begin(); j != i->end(); j++)
         if (j->x > 0)
@@ -563,15 +542,16 @@ void LLRegion::AdjustLongitude() {
   Intersect(clip);
 }
 
+// true if the segments from j to l and from j to k are parallel
+static inline bool Parallel(const contour_pt &l, const contour_pt &j,
+                            const contour_pt &k) {
+  return fabs(cross(vector(j, l), vector(j, k))) < 1e-12;
+}
+
 void LLRegion::Optimize() {
   // merge parallel segments
-  std::list<poly_contour>::iterator i = contours.begin();
+  std::vector<poly_contour>::iterator i = contours.begin();
   while (i != contours.end()) {
-    if (i->size() < 3) {
-      printf("invalid contour");
-      continue;
-    }
-
     // Round coordinates to avoid numerical errors in region computations
     const double eps = 6e-6;  // about 1cm on earth's surface at equator
     for (poly_contour::iterator j = i->begin(); j != i->end(); j++) {
@@ -589,30 +569,30 @@ void LLRegion::Optimize() {
 #endif
 
     // eliminiate parallel segments
-    poly_contour::iterator j = i->begin();
-    int s = i->size();
-    for (int c = 0; c < s; c++) {
-      poly_contour::iterator l = j, k = j;
-
-      if (l == i->begin()) l = i->end();
-      l--;
-
-      k++;
-      if (k == i->end()) k = i->begin();
-
-      if (l == k) break;
-      if (fabs(cross(vector(*j, *l), vector(*j, *k))) < 1e-12) {
-        i->erase(j);
-        j = l;
-        c--;
-      } else
-        j = k;
+    poly_contour c;
+    c.reserve(i->size());
+    for (poly_contour::const_iterator j = i->begin(); j != i->end(); j++) {
+      while (c.size() >= 2 && Parallel(c[c.size() - 2], c.back(), *j))
+        c.pop_back();
+      c.push_back(*j);
+    }
+    // and where the contour closes
+    size_t first = 0;
+    while (c.size() - first >= 3) {
+      if (Parallel(c[c.size() - 2], c.back(), c[first]))
+        c.pop_back();
+      else if (Parallel(c.back(), c[first], c[first + 1]))
+        first++;
+      else
+        break;
     }
 
     // erase zero contours
-    if (i->size() < 3)
+    if (c.size() - first < 3) {
       i = contours.erase(i);
-    else
+    } else {
+      i->assign(c.begin() + first, c.end());
       i++;
+    }
   }
 }
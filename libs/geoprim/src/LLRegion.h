@@ -27,22 +27,17 @@
 #ifndef _LLREGION_H_
 #define _LLREGION_H_
 
-#include <list>
+#include <vector>
 
 #include "bbox.h"
-
-struct contour_pt {
-  double y, x;
-};
+#include "poly_clip.h"
 
 // ----------------------------------------------------------------------------
 // LLRegion
 // ----------------------------------------------------------------------------
 
-typedef std::list<contour_pt> poly_contour;
 class LLBBox;
 
-struct work;
 class LLRegion {
 public:
   LLRegion() {}
@@ -70,13 +65,14 @@ public:
 
   void Reduce(double factor);
 
-  std::list<poly_contour> contours;
+  std::vector<poly_contour> contours;
 
 private:
   bool NoIntersection(const LLBBox& box) const;
   bool NoIntersection(const LLRegion& region) const;
-  void PutContours(work& w, const LLRegion& region, bool reverse = false);
-  void Put(const LLRegion& region, int winding_rule, bool reverse = false);
+  bool IsBox() const;
+  bool BoxContains(const LLRegion& region) const;
+  void Put(const LLRegion& region, WindingRule rule, bool reverse = false);
   void Combine(const LLRegion& region);
   void InitBox(float minlat, float minlon, float maxlat, float maxlon);
   void InitPoints(size_t n, const double* points);
@@ -0,0 +1,376 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement poly_clip.h
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+#include "poly_clip.h"
+
+/**
+ * Points closer than this to a segment are considered to be on it, in
+ * degrees (about 0.1 mm). Shared chart borders are then split at the same
+ * vertices and merged even when not exactly collinear.
+ */
+static const double kTolerance = 1e-9;
+
+static const double kPi = 3.14159265358979323846;
+
+namespace {
+
+/** An edge, a < b. delta is the winding number change, see AddEdges(). */
+struct Edge {
+  contour_pt a;
+  contour_pt b;
+  int delta;
+};
+
+/** Edge of the planar graph between vertex indexes lo < hi. */
+struct GraphEdge {
+  int lo;
+  int hi;
+  int delta;
+};
+
+}  // namespace
+
+static inline bool Less(const contour_pt& p, const contour_pt& q) {
+  return p.x < q.x || (p.x == q.x && p.y < q.y);
+}
+
+static inline bool Equal(const contour_pt& p, const contour_pt& q) {
+  return p.x == q.x && p.y == q.y;
+}
+
+/** Twice the signed area of triangle a, b, c; positive if counter clockwise. */
+static inline double Orient(const contour_pt& a, const contour_pt& b,
+                            const contour_pt& c) {
+  return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+static inline double Length(const Edge& e) {
+  return std::hypot(e.b.x - e.a.x, e.b.y - e.a.y);
+}
+
+/** Return true if c is within tolerance of the inside of edge e. */
+static bool OnInterior(const Edge& e, double length, const contour_pt& c) {
+  if (Equal(c, e.a) || Equal(c, e.b)) return false;
+  double dx = e.b.x - e.a.x, dy = e.b.y - e.a.y;
+  double t = ((c.x - e.a.x) * dx + (c.y - e.a.y) * dy) / (length * length);
+  if (t <= 0 || t >= 1) return false;
+  return std::fabs(Orient(e.a, e.b, c)) <= kTolerance * length;
+}
+
+/**
+ * Append the edges of contours. The winding number of a point is the sum
+ * of the deltas of the edges above it: a counter clockwise contour goes
+ * right to left (delta 1) above its inside and left to right (delta -1)
+ * below, giving 1 inside.
+ */
+static void AddEdges(const std::vector<poly_contour>& contours, bool reverse,
+                     std::vector<Edge>& edges) {
+  for (const auto& contour : contours) {
+    if (contour.size() < 3) continue;
+    contour_pt last = contour.back();
+    for (const auto& p : contour) {
+      contour_pt from = reverse ? p : last, to = reverse ? last : p;
+      last = p;
+      if (Equal(from, to)) continue;
+      if (Less(from, to))
+        edges.push_back({from, to, -1});
+      else
+        edges.push_back({to, from, 1});
+    }
+  }
+}
+
+/** Record where edges i and j must be split to only meet at vertices. */
+static void Intersect(const std::vector<Edge>& edges, int i, int j,
+                      std::vector<std::pair<int, contour_pt>>& splits) {
+  const Edge &p = edges[i], &q = edges[j];
+  double lp = Length(p), lq = Length(q);
+  double d1 = Orient(q.a, q.b, p.a), d2 = Orient(q.a, q.b, p.b);
+  double d3 = Orient(p.a, p.b, q.a), d4 = Orient(p.a, p.b, q.b);
+  double tp = kTolerance * lq, tq = kTolerance * lp;
+  if (((d1 > tp && d2 < -tp) || (d1 < -tp && d2 > tp)) &&
+      ((d3 > tq && d4 < -tq) || (d3 < -tq && d4 > tq))) {
+    double t = d1 / (d1 - d2);
+    contour_pt x;
+    x.x = p.a.x + t * (p.b.x - p.a.x);
+    x.y = p.a.y + t * (p.b.y - p.a.y);
+    splits.push_back({i, x});
+    splits.push_back({j, x});
+    return;
+  }
+  // Touching or overlapping: split at the end points inside the other edge.
+  if (OnInterior(p, lp, q.a)) splits.push_back({i, q.a});
+  if (OnInterior(p, lp, q.b)) splits.push_back({i, q.b});
+  if (OnInterior(q, lq, p.a)) splits.push_back({j, p.a});
+  if (OnInterior(q, lq, p.b)) splits.push_back({j, p.b});
+}
+
+/** Split edges so that they only meet at their end points. */
+static void SplitEdges(std::vector<Edge>& edges) {
+  std::vector<int> order(edges.size());
+  for (size_t i = 0; i < order.size(); i++) order[i] = i;
+  std::sort(order.begin(), order.end(),
+            [&edges](int i, int j) { return edges[i].a.x < edges[j].a.x; });
+
+  // Sweep over x, testing each edge against the ones overlapping it in x.
+  std::vector<std::pair<int, contour_pt>> splits;
+  std::vector<int> active;
+  for (int i : order) {
+    const Edge& e = edges[i];
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&](int j) {
+                                  return edges[j].b.x < e.a.x - kTolerance;
+                                }),
+                 active.end());
+    double miny = std::min(e.a.y, e.b.y), maxy = std::max(e.a.y, e.b.y);
+    for (int j : active) {
+      const Edge& f = edges[j];
+      if (std::max(f.a.y, f.b.y) < miny - kTolerance) continue;
+      if (std::min(f.a.y, f.b.y) > maxy + kTolerance) continue;
+      Intersect(edges, i, j, splits);
+    }
+    active.push_back(i);
+  }
+  if (splits.empty()) return;
+
+  // Replace split edges by their pieces, in order along the edge.
+  std::sort(splits.begin(), splits.end(),
+            [](const std::pair<int, contour_pt>& s1,
+               const std::pair<int, contour_pt>& s2) {
+              if (s1.first != s2.first) return s1.first < s2.first;
+              return Less(s1.second, s2.second);
+            });
+  for (size_t s = 0; s < splits.size();) {
+    int i = splits[s].first;
+    Edge e = edges[i];
+    contour_pt from = e.a;
+    bool first = true;
+    for (; s < splits.size() && splits[s].first == i; s++) {
+      const contour_pt& p = splits[s].second;
+      if (!Less(from, p) || !Less(p, e.b)) continue;
+      Edge piece = {from, p, e.delta};
+      if (first)
+        edges[i] = piece;
+      else
+        edges.push_back(piece);
+      first = false;
+      from = p;
+    }
+    Edge last = {from, e.b, e.delta};
+    if (first)
+      edges[i] = last;
+    else
+      edges.push_back(last);
+  }
+}
+
+static inline bool Inside(int winding, WindingRule rule) {
+  return rule == WindingRule::kPositive ? winding > 0 : std::abs(winding) >= 2;
+}
+
+/** y of non-vertical edge at x, within its x range. */
+static inline double YAt(const std::vector<contour_pt>& vertices,
+                         const GraphEdge& e, double x) {
+  const contour_pt &a = vertices[e.lo], &b = vertices[e.hi];
+  if (x == a.x) return a.y;
+  if (x == b.x) return b.y;
+  return a.y + (b.y - a.y) * (x - a.x) / (b.x - a.x);
+}
+
+/**
+ * Link the directed edges (from, to) into contours. Where several contours
+ * meet at a vertex, take the sharpest turn to the left so that touching
+ * contours stay separate.
+ */
+static std::vector<poly_contour> LinkContours(
+    const std::vector<contour_pt>& vertices,
+    std::vector<std::pair<int, int>>& directed) {
+  std::sort(directed.begin(), directed.end());
+  std::vector<int> first_out(vertices.size() + 1, 0);
+  for (const auto& d : directed) first_out[d.first + 1]++;
+  for (size_t v = 0; v < vertices.size(); v++)
+    first_out[v + 1] += first_out[v];
+
+  std::vector<poly_contour> contours;
+  std::vector<bool> used(directed.size(), false);
+  for (size_t start = 0; start < directed.size(); start++) {
+    if (used[start]) continue;
+    poly_contour contour;
+    size_t cur = start;
+    while (true) {
+      used[cur] = true;
+      int from = directed[cur].first, v = directed[cur].second;
+      contour.push_back(vertices[from]);
+
+      size_t next = first_out[v];
+      if (first_out[v + 1] - first_out[v] > 1) {
+        // Smallest clockwise angle from the way back.
+        double bx = vertices[from].x - vertices[v].x;
+        double by = vertices[from].y - vertices[v].y;
+        double best = 10;
+        for (int k = first_out[v]; k < first_out[v + 1]; k++) {
+          double ox = vertices[directed[k].second].x - vertices[v].x;
+          double oy = vertices[directed[k].second].y - vertices[v].y;
+          double angle = -std::atan2(bx * oy - by * ox, bx * ox + by * oy);
+          if (angle <= 0) angle += 2 * kPi;
+          if (angle < best) best = angle, next = k;
+        }
+      }
+      if (next == start || used[next]) break;
+      cur = next;
+    }
+    if (contour.size() >= 3) contours.push_back(std::move(contour));
+  }
+  return contours;
+}
+
+std::vector<poly_contour> PolyClip(const std::vector<poly_contour>& a,
+                                   const std::vector<poly_contour>& b,
+                                   bool reverse_b, WindingRule rule) {
+  std::vector<Edge> edges;
+  AddEdges(a, false, edges);
+  AddEdges(b, reverse_b, edges);
+  SplitEdges(edges);
+
+  // Vertices in x, y order and the merged edges between them.
+  std::vector<contour_pt> vertices;
+  vertices.reserve(2 * edges.size());
+  for (const auto& e : edges) {
+    vertices.push_back(e.a);
+    vertices.push_back(e.b);
+  }
+  std::sort(vertices.begin(), vertices.end(), Less);
+  vertices.erase(std::unique(vertices.begin(), vertices.end(), Equal),
+                 vertices.end());
+  auto index = [&vertices](const contour_pt& p) {
+    return int(std::lower_bound(vertices.begin(), vertices.end(), p, Less) -
+               vertices.begin());
+  };
+  std::vector<GraphEdge> graph;
+  graph.reserve(edges.size());
+  for (const auto& e : edges) graph.push_back({index(e.a), index(e.b), e.delta});
+  std::sort(graph.begin(), graph.end(),
+            [](const GraphEdge& e1, const GraphEdge& e2) {
+              return e1.lo < e2.lo || (e1.lo == e2.lo && e1.hi < e2.hi);
+            });
+  size_t n = 0;
+  for (size_t i = 0; i < graph.size(); i++) {
+    if (n > 0 && graph[n - 1].lo == graph[i].lo &&
+        graph[n - 1].hi == graph[i].hi)
+      graph[n - 1].delta += graph[i].delta;
+    else
+      graph[n++] = graph[i];
+  }
+  graph.resize(n);
+  graph.erase(std::remove_if(graph.begin(), graph.end(),
+                             [](const GraphEdge& e) { return e.delta == 0; }),
+              graph.end());
+
+  // Sweep the slabs between consecutive vertex x coordinates, keeping the
+  // edges crossing the current slab ordered from top to bottom. Edges do
+  // not cross, so the winding number above an edge is the one below the
+  // edge over it when it enters. Vertical edges use the slabs on both sides.
+  std::vector<int> slab_of(vertices.size());
+  std::vector<double> xs;
+  for (size_t v = 0; v < vertices.size(); v++) {
+    if (xs.empty() || xs.back() != vertices[v].x) xs.push_back(vertices[v].x);
+    slab_of[v] = xs.size() - 1;
+  }
+  std::vector<int> above(graph.size(), 0), below(graph.size(), 0);
+  std::vector<int> active;
+  std::vector<std::pair<double, int>> entering;
+  auto winding_over = [&](double x, double y) {
+    // Edges are ordered by decreasing y, find the last one above y.
+    auto it = std::partition_point(active.begin(), active.end(), [&](int e) {
+      return YAt(vertices, graph[e], x) > y;
+    });
+    return it == active.begin() ? 0 : below[*(it - 1)];
+  };
+  size_t next = 0;  // graph is sorted by lo
+  for (size_t s = 0; s < xs.size(); s++) {
+    double x = xs[s];
+    size_t first = next;
+    while (next < graph.size() && slab_of[graph[next].lo] == int(s)) next++;
+
+    // Vertical edges at x: left winding in above, right winding in below.
+    for (size_t e = first; e < next; e++) {
+      const GraphEdge& g = graph[e];
+      if (vertices[g.hi].x != x) continue;
+      above[e] = winding_over(x, (vertices[g.lo].y + vertices[g.hi].y) / 2);
+    }
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [&](int e) {
+                                  return slab_of[graph[e].hi] == int(s);
+                                }),
+                 active.end());
+    // Enter the new edges from top to bottom, so that the edge over each
+    // one is already in place.
+    if (s + 1 < xs.size()) {
+      double xm = (x + xs[s + 1]) / 2;
+      entering.clear();
+      for (size_t e = first; e < next; e++) {
+        const GraphEdge& g = graph[e];
+        if (vertices[g.hi].x != x)
+          entering.push_back({YAt(vertices, g, xm), int(e)});
+      }
+      std::sort(entering.begin(), entering.end(),
+                [](const std::pair<double, int>& l,
+                   const std::pair<double, int>& r) {
+                  return l.first > r.first;
+                });
+      for (const auto& entry : entering) {
+        double y = entry.first;
+        int e = entry.second;
+        auto it = std::partition_point(
+            active.begin(), active.end(),
+            [&](int f) { return YAt(vertices, graph[f], xm) > y; });
+        above[e] = it == active.begin() ? 0 : below[*(it - 1)];
+        below[e] = above[e] + graph[e].delta;
+        active.insert(it, e);
+      }
+    }
+    for (size_t e = first; e < next; e++) {
+      const GraphEdge& g = graph[e];
+      if (vertices[g.hi].x != x) continue;
+      below[e] = winding_over(x, (vertices[g.lo].y + vertices[g.hi].y) / 2);
+    }
+  }
+
+  // Keep the edges on the border of the selected area, with it on the left.
+  // For vertical edges, above is the left side and below the right side.
+  std::vector<std::pair<int, int>> directed;
+  for (size_t e = 0; e < graph.size(); e++) {
+    bool in_above = Inside(above[e], rule), in_below = Inside(below[e], rule);
+    if (in_above == in_below) continue;
+    if (in_above)
+      directed.push_back({graph[e].lo, graph[e].hi});
+    else
+      directed.push_back({graph[e].hi, graph[e].lo});
+  }
+  return LinkContours(vertices, directed);
+}
@@ -0,0 +1,58 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+/**
+ * \file
+ *
+ * Boolean operations on polygons, the engine behind LLRegion.
+ *
+ * The contours of both operands are split at all their intersections,
+ * giving a planar graph where coincident edges are merged. A sweep over the
+ * x coordinates of the vertices computes the winding number on both sides
+ * of each edge. Edges separating an area selected by the winding rule from
+ * one which is not are linked into the result contours, with the area on
+ * their left: outer contours are counter clockwise and holes clockwise.
+ * This is the same boundary as returned by the GLU tessellator in boundary
+ * only mode.
+ */
+
+#ifndef POLY_CLIP_H_
+#define POLY_CLIP_H_
+
+#include <vector>
+
+struct contour_pt {
+  double y, x;
+};
+
+typedef std::vector<contour_pt> poly_contour;
+
+/** Select the area from the winding number of the combined contours. */
+enum class WindingRule {
+  kPositive,  ///< Winding number > 0, like GLU_TESS_WINDING_POSITIVE
+  kAbsGeqTwo  ///< |winding number| >= 2, like GLU_TESS_WINDING_ABS_GEQ_TWO
+};
+
+/**
+ * Return the boundary of the area selected by rule from the contours of
+ * a and b combined, with the contours of b reversed if reverse_b.
+ */
+std::vector<poly_contour> PolyClip(const std::vector<poly_contour>& a,
+                                   const std::vector<poly_contour>& b,
+                                   bool reverse_b, WindingRule rule);
+
+#endif  // POLY_CLIP_H_
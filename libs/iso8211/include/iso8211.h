@@ -32,6 +32,8 @@
 #ifndef _ISO8211_H_INCLUDED
 #define _ISO8211_H_INCLUDED
 
+#include <memory>
+
 #include "gdal/cpl_port.h"
 
 /**
@@ -66,6 +68,7 @@ class DDFFieldDefn;
 class DDFSubfieldDefn;
 class DDFRecord;
 class DDFField;
+class MappedFile;
 
 /************************************************************************/
 /*                              DDFModule                               */
@@ -84,7 +87,8 @@ class DDFModule
                 DDFModule();
                 ~DDFModule();
 
-    int         Open( const char * pszFilename, int bFailQuietly = FALSE );
+    int         Open( const char * pszFilename, int bFailQuietly = FALSE,
+                      int bMapFile = TRUE );
     int         Create( const char *pszFilename );
     void        Close();
 
@@ -119,9 +123,20 @@ class DDFModule
 
     // This is just for DDFRecord.
     FILE        *GetFP() { return fpDDF; }
+    size_t      ReadBytes( void *pBuffer, size_t nBytes );
+    char        *ViewBytes( size_t nBytes, size_t *pnBytesRead );
+    int         IsEof();
+    long        Tell();
+    void        Seek( long nOffset );
+    const std::shared_ptr<MappedFile> &GetMappedFile() { return poMappedFile; }
 
   private:
     FILE        *fpDDF;
+
+    // Copy on write mapping of the file when open for reading, NULL if
+    // it could not be mapped.  Records keep it alive while viewing it.
+    std::shared_ptr<MappedFile> poMappedFile;
+    size_t      nMapOffset;
     int         bReadOnly;
     long        nFirstRecordOffset;
 
@@ -319,6 +334,14 @@ public:
     /** Get the subfield width (zero for variable). */
     int         GetWidth() { return nFormatWidth; } // zero for variable.
 
+    /**
+     * Get the offset of this subfield within an instance of its field,
+     * or -1 if a variable width subfield precedes it.  This is set by
+     * DDFFieldDefn when it applies the formats.
+     */
+    int         GetFixedOffset() { return nFixedOffset; }
+    void        SetFixedOffset( int nOffset ) { nFixedOffset = nOffset; }
+
     int         GetDefaultValue( char *pachData, int nBytesAvailable,
                                  int *pnBytesUsed, bool b_UTF16 );
 
@@ -356,6 +379,7 @@ private:
 
   char       chFormatDelimeter;
   int        nFormatWidth;
+  int        nFixedOffset;
 
 /* -------------------------------------------------------------------- */
 /*      Fetched string cache.  This is where we hold the values         */
@@ -450,6 +474,8 @@ class DDFRecord
   private:
 
     int         ReadHeader();
+    void        DetachData();
+    void        CopyDataTo( DDFRecord *poNR );
 
     DDFModule   *poModule;
 
@@ -464,6 +490,9 @@ class DDFRecord
     int         nDataSize;      // Whole record except leader with header
     char        *pachData;
 
+    // Set if pachData is a view into the mapped module file.
+    std::shared_ptr<MappedFile> poMappedFile;
+
     int         nFieldCount;
     DDFField    *paoFields;
 
@@ -192,7 +192,8 @@ void DDFField::Dump( FILE * fp )
  * once before reading any records.  This method involves a series of
  * calls to DDFSubfield::GetDataLength() in order to track through the
  * DDFField data to that belonging to the requested subfield.  This can
- * be relatively expensive.<p>
+ * be relatively expensive, unless the subfield is preceded only by fixed
+ * width subfields.<p>
  *
  * @param poSFDefn The definition of the subfield for which the raw
  * data pointer is desired.
@@ -222,6 +223,20 @@ const char *DDFField::GetSubfieldData( DDFSubfieldDefn *poSFDefn,
         iSubfieldIndex = 0;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Use the offset of the subfield within the instance if known,    */
+/*      and if the previous subfields are not truncated.                */
+/* -------------------------------------------------------------------- */
+    if( iSubfieldIndex == 0 && poSFDefn->GetFixedOffset() >= 0
+        && iOffset + poSFDefn->GetFixedOffset() <= nDataSize )
+    {
+        iOffset += poSFDefn->GetFixedOffset();
+        if( pnMaxBytes != NULL )
+            *pnMaxBytes = nDataSize - iOffset;
+
+        return pachData + iOffset;
+    }
+
     while( iSubfieldIndex >= 0 )
     {
         for( int iSF = 0; iSF < poDefn->GetSubfieldCount(); iSF++ )
@@ -822,6 +822,21 @@ int DDFFieldDefn::ApplyFormats()
             nFixedWidth += papoSubfields[i]->GetWidth();
     }
 
+/* -------------------------------------------------------------------- */
+/*      Subfields preceded only by fixed width subfields are always at  */
+/*      the same offset in each instance, so their data can be found    */
+/*      without scanning the previous subfields.                        */
+/* -------------------------------------------------------------------- */
+    int nOffset = 0;
+    for( int i = 0; i < nSubfieldCount; i++ )
+    {
+        papoSubfields[i]->SetFixedOffset( nOffset );
+        if( nOffset >= 0 && papoSubfields[i]->GetWidth() > 0 )
+            nOffset += papoSubfields[i]->GetWidth();
+        else
+            nOffset = -1;
+    }
+
     return TRUE;
 }
 
@@ -841,6 +856,19 @@ int DDFFieldDefn::ApplyFormats()
 DDFSubfieldDefn *DDFFieldDefn::FindSubfieldDefn( const char * pszMnemonic )
 
 {
+/* -------------------------------------------------------------------- */
+/*      Try an exact match first, it is much cheaper.                   */
+/* -------------------------------------------------------------------- */
+    for( int i = 0; i < nSubfieldCount; i++ )
+    {
+        const char *pszThisName = papoSubfields[i]->GetName();
+
+        if( *pszThisName == *pszMnemonic
+            && (*pszMnemonic == '\0'
+                || strcmp( pszMnemonic+1, pszThisName+1 ) == 0) )
+            return papoSubfields[i];
+    }
+
     for( int i = 0; i < nSubfieldCount; i++ )
     {
         if( EQUAL(papoSubfields[i]->GetName(),pszMnemonic) )
@@ -81,6 +81,7 @@
 
 #include "gdal/cpl_conv.h"
 #include "iso8211.h"
+#include "model/mapped_file.h"
 
 /************************************************************************/
 /*                             DDFModule()                              */
@@ -101,6 +102,7 @@ DDFModule::DDFModule()
     nCloneCount = nMaxCloneCount = 0;
 
     fpDDF = NULL;
+    nMapOffset = 0;
     bReadOnly = TRUE;
 
     _interchangeLevel = '\0';
@@ -154,6 +156,8 @@ void DDFModule::Close()
         VSIFClose( fpDDF );
         fpDDF = NULL;
     }
+    poMappedFile.reset();
+    nMapOffset = 0;
 
 /* -------------------------------------------------------------------- */
 /*      Cleanup the working record.                                     */
@@ -203,12 +207,15 @@ void DDFModule::Close()
  * @param pszFilename   The name of the file to open.
  * @param bFailQuietly If FALSE a CPL Error is issued for non-8211 files,
  * otherwise quietly return NULL.
+ * @param bMapFile If TRUE records are read in place from a mapping of the
+ * file when possible, otherwise they are read into their own buffers.
  *
  * @return FALSE if the open fails or TRUE if it succeeds.  Errors messages
  * are issued internally with CPLError().
  */
 
-int DDFModule::Open( const char * pszFilename, int bFailQuietly )
+int DDFModule::Open( const char * pszFilename, int bFailQuietly,
+                     int bMapFile )
 
 {
     static const size_t nLeaderSize = 24;
@@ -384,6 +391,17 @@ int DDFModule::Open( const char * pszFilename, int bFailQuietly )
 /* -------------------------------------------------------------------- */
     nFirstRecordOffset = VSIFTell( fpDDF );
 
+/* -------------------------------------------------------------------- */
+/*      Map the file, so records are read in place rather than copied.  */
+/*      The mapping is copy on write, as S-57 updates patch records     */
+/*      in place.  Fall back to reading the file if it can't be mapped. */
+/* -------------------------------------------------------------------- */
+    if( bMapFile )
+        poMappedFile = std::make_shared<MappedFile>( pszFilename, true );
+    if( poMappedFile != NULL && !poMappedFile->IsOk() )
+        poMappedFile.reset();
+    nMapOffset = nFirstRecordOffset;
+
     return TRUE;
 }
 
@@ -748,9 +766,94 @@ void DDFModule::Rewind( long nOffset )
     if( fpDDF == NULL )
         return;
 
-    VSIFSeek( fpDDF, nOffset, SEEK_SET );
+    Seek( nOffset );
 
     if( nOffset == nFirstRecordOffset && poRecord != NULL )
         poRecord->Clear();
 
 }
+
+/************************************************************************/
+/*                             ReadBytes()                              */
+/*                                                                      */
+/*      Read from the current position, using the mapping if there is   */
+/*      one.  Returns the number of bytes read.                         */
+/************************************************************************/
+
+size_t DDFModule::ReadBytes( void *pBuffer, size_t nBytes )
+
+{
+    if( poMappedFile == NULL )
+        return VSIFRead( pBuffer, 1, nBytes, fpDDF );
+
+    size_t      nBytesRead;
+    const char *pachView = ViewBytes( nBytes, &nBytesRead );
+
+    memcpy( pBuffer, pachView, nBytesRead );
+    return nBytesRead;
+}
+
+/************************************************************************/
+/*                             ViewBytes()                              */
+/*                                                                      */
+/*      Advance over up to nBytes of the mapped file, returning a       */
+/*      pointer to them in the mapping.  The bytes may be modified,     */
+/*      which doesn't change the file.  Returns NULL if not mapped.     */
+/************************************************************************/
+
+char *DDFModule::ViewBytes( size_t nBytes, size_t *pnBytesRead )
+
+{
+    if( poMappedFile == NULL )
+    {
+        *pnBytesRead = 0;
+        return NULL;
+    }
+
+    size_t      nSize = poMappedFile->GetSize();
+    size_t      nOffset = MIN(nMapOffset, nSize);
+
+    *pnBytesRead = MIN(nBytes, nSize - nOffset);
+    nMapOffset = nOffset + *pnBytesRead;
+
+    return (char *) poMappedFile->GetWritableData() + nOffset;
+}
+
+/************************************************************************/
+/*                               IsEof()                                */
+/************************************************************************/
+
+int DDFModule::IsEof()
+
+{
+    if( poMappedFile == NULL )
+        return VSIFEof( fpDDF );
+
+    return nMapOffset >= poMappedFile->GetSize();
+}
+
+/************************************************************************/
+/*                                Tell()                                */
+/************************************************************************/
+
+long DDFModule::Tell()
+
+{
+    if( poMappedFile == NULL )
+        return VSIFTell( fpDDF );
+
+    return (long) nMapOffset;
+}
+
+/************************************************************************/
+/*                                Seek()                                */
+/************************************************************************/
+
+void DDFModule::Seek( long nOffset )
+
+{
+    if( poMappedFile == NULL )
+        VSIFSeek( fpDDF, nOffset, SEEK_SET );
+    else
+        nMapOffset = nOffset;
+}
@@ -121,6 +121,7 @@
 
 #include "gdal/cpl_conv.h"
 #include "iso8211.h"
+#include "model/mapped_file.h"
 
 static const size_t nLeaderSize = 24;
 
@@ -224,12 +225,11 @@ int DDFRecord::Read()
 /* -------------------------------------------------------------------- */
     size_t      nReadBytes;
 
-    nReadBytes = VSIFRead( pachData + nFieldOffset, 1,
-                           nDataSize - nFieldOffset,
-                           poModule->GetFP() );
+    nReadBytes = poModule->ReadBytes( pachData + nFieldOffset,
+                                      nDataSize - nFieldOffset );
     if( nReadBytes != (size_t) (nDataSize - nFieldOffset)
         && nReadBytes == 0
-        && VSIFEof( poModule->GetFP() ) )
+        && poModule->IsEof() )
     {
         return FALSE;
     }
@@ -320,10 +320,11 @@ void DDFRecord::Clear()
     paoFields = NULL;
     nFieldCount = 0;
 
-    if( pachData != NULL )
+    if( pachData != NULL && poMappedFile == NULL )
         CPLFree( pachData );
 
     pachData = NULL;
+    poMappedFile.reset();
     nDataSize = 0;
     nReuseHeader = FALSE;
 }
@@ -350,8 +351,8 @@ int DDFRecord::ReadHeader()
     char        achLeader[nLeaderSize];
     int         nReadBytes;
 
-    nReadBytes = VSIFRead(achLeader,1,nLeaderSize,poModule->GetFP());
-    if( nReadBytes == 0 && VSIFEof( poModule->GetFP() ) )
+    nReadBytes = poModule->ReadBytes( achLeader, nLeaderSize );
+    if( nReadBytes == 0 && poModule->IsEof() )
     {
         return FALSE;
     }
@@ -411,13 +412,22 @@ int DDFRecord::ReadHeader()
 /* ==================================================================== */
     if(_recLength != 0) {
 /* -------------------------------------------------------------------- */
-/*      Read the remainder of the record.                               */
+/*      Read the remainder of the record, in place if the file is       */
+/*      mapped.                                                         */
 /* -------------------------------------------------------------------- */
+        size_t      nDataRead;
+
         nDataSize = _recLength - nLeaderSize;
-        pachData = (char *) CPLMalloc(nDataSize);
+        pachData = poModule->ViewBytes( nDataSize, &nDataRead );
+        if( pachData != NULL )
+            poMappedFile = poModule->GetMappedFile();
+        else
+        {
+            pachData = (char *) CPLMalloc(nDataSize);
+            nDataRead = poModule->ReadBytes( pachData, nDataSize );
+        }
 
-        if( VSIFRead( pachData, 1, nDataSize, poModule->GetFP()) !=
-            (size_t) nDataSize )
+        if( nDataRead != (size_t) nDataSize )
         {
             CPLError( CE_Failure, CPLE_FileIO,
                       "Data record is short on DDF file." );
@@ -425,6 +435,13 @@ int DDFRecord::ReadHeader()
             return FALSE;
         }
 
+/* -------------------------------------------------------------------- */
+/*      The following records are read over this one if its header      */
+/*      is reused, so it can't stay a view.                             */
+/* -------------------------------------------------------------------- */
+        if( nReuseHeader )
+            DetachData();
+
 #if 0
 /* -------------------------------------------------------------------- */
 /*      If we don't find a field terminator at the end of the record    */
@@ -457,6 +474,7 @@ int DDFRecord::ReadHeader()
     {
         if( (pachData[nDataSize-2] == DDF_FIELD_TERMINATOR) && (pachData[nDataSize-1] == 0) )
         {
+            DetachData();
             nDataSize++;
             pachData = (char *) CPLRealloc(pachData,nDataSize);
             pachData[nDataSize-1] = DDF_FIELD_TERMINATOR;
@@ -559,7 +577,7 @@ int DDFRecord::ReadHeader()
         do {
             // read an Entry:
             if(nFieldEntryWidth !=
-               (int) VSIFRead(tmpBuf, 1, nFieldEntryWidth, poModule->GetFP())) {
+               (int) poModule->ReadBytes(tmpBuf, nFieldEntryWidth)) {
                 CPLError(CE_Failure, CPLE_FileIO,
                          "Data record is short on DDF file.");
                 CPLFree(tmpBuf);
@@ -584,9 +602,8 @@ int DDFRecord::ReadHeader()
 
         // Now, rewind a little.  Only the TERMINATOR should have been read:
         int rewindSize = nFieldEntryWidth - 1;
-        FILE *fp = poModule->GetFP();
-        long pos = ftell(fp) - rewindSize;
-        fseek(fp, pos, SEEK_SET);
+        long pos = poModule->Tell() - rewindSize;
+        poModule->Seek(pos);
         nDataSize -= rewindSize;
 
         // --------------------------------------------------------------------
@@ -600,7 +617,7 @@ int DDFRecord::ReadHeader()
 
             // read an Entry:
             if(nFieldLength !=
-               (int) VSIFRead(tmpBuf, 1, nFieldLength, poModule->GetFP())) {
+               (int) poModule->ReadBytes(tmpBuf, nFieldLength)) {
                 CPLError(CE_Failure, CPLE_FileIO,
                          "Data record is short on DDF file.");
                 CPLFree(tmpBuf);
@@ -688,6 +705,32 @@ int DDFRecord::ReadHeader()
 DDFField * DDFRecord::FindField( const char * pszName, int iFieldIndex )
 
 {
+/* -------------------------------------------------------------------- */
+/*      This pass tries to reduce the cost of comparing strings by      */
+/*      first checking the first character, and by using strcmp(),      */
+/*      as in DDFModule::FindFieldDefn().                               */
+/* -------------------------------------------------------------------- */
+    int         nMatches = 0;
+
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        const char *pszThisName = paoFields[i].GetFieldDefn()->GetName();
+
+        if( *pszThisName == *pszName
+            && (*pszName == '\0' || strcmp( pszName+1, pszThisName+1 ) == 0) )
+        {
+            if( nMatches++ == iFieldIndex )
+                return paoFields + i;
+        }
+    }
+
+    if( nMatches > 0 )
+        return NULL;
+
+/* -------------------------------------------------------------------- */
+/*      Now do a more general check.  Application code may not          */
+/*      always use the correct name case.                               */
+/* -------------------------------------------------------------------- */
     for( int i = 0; i < nFieldCount; i++ )
     {
         if( EQUAL(paoFields[i].GetFieldDefn()->GetName(),pszName) )
@@ -939,6 +982,10 @@ DDFRecord::GetStringSubfield( const char * pszField, int iFieldIndex,
  * invalidated, such as when reading a new record.  This allows an application
  * to cache whole DDFRecords.
  *
+ * If the record data is a view into the mapped file of the module, the
+ * copy views the same data rather than copying it.  Either record takes
+ * its own copy of the data before changing it.
+ *
  * @return A new copy of the DDFRecord.  This can be delete'd by the
  * application when no longer needed, otherwise it will be cleaned up when
  * the DDFModule it relates to is destroyed or closed.
@@ -951,24 +998,7 @@ DDFRecord * DDFRecord::Clone()
 
     poNR = new DDFRecord( poModule );
 
-    poNR->nReuseHeader = FALSE;
-    poNR->nFieldOffset = nFieldOffset;
-
-    poNR->nDataSize = nDataSize;
-    poNR->pachData = (char *) CPLMalloc(nDataSize);
-    memcpy( poNR->pachData, pachData, nDataSize );
-
-    poNR->nFieldCount = nFieldCount;
-    poNR->paoFields = new DDFField[nFieldCount];
-    for( int i = 0; i < nFieldCount; i++ )
-    {
-        int     nOffset;
-
-        nOffset = (paoFields[i].GetData() - pachData);
-        poNR->paoFields[i].Initialize( paoFields[i].GetFieldDefn(),
-                                       poNR->pachData + nOffset,
-                                       paoFields[i].GetDataSize() );
-    }
+    CopyDataTo( poNR );
 
     poNR->bIsClone = TRUE;
     poModule->AddCloneRecord( poNR );
@@ -1055,7 +1085,8 @@ DDFRecord *DDFRecord::CloneOn( DDFModule *poTargetModule )
  * Make a copy of a record.
  *
  * This method is used to make a copy of a record that will become
- * the properly of application.
+ * the properly of application.  Like Clone(), it views data in the mapped
+ * module file until it is changed, rather than copying it.
  *
  * @return A new copy of the DDFRecord.  This can be delete'd by the
  * application when no longer needed.
@@ -1068,12 +1099,37 @@ DDFRecord * DDFRecord::Copy()
 
     poNR = new DDFRecord( poModule );
 
+    CopyDataTo( poNR );
+
+    return poNR;
+}
+
+
+/************************************************************************/
+/*                             CopyDataTo()                             */
+/*                                                                      */
+/*      Give a new record the data and fields of this one.  Data        */
+/*      viewed in the mapped module file is shared, not copied; the     */
+/*      mutators call DetachData() before writing to it.                */
+/************************************************************************/
+
+void DDFRecord::CopyDataTo( DDFRecord *poNR )
+
+{
     poNR->nReuseHeader = FALSE;
     poNR->nFieldOffset = nFieldOffset;
 
     poNR->nDataSize = nDataSize;
-    poNR->pachData = (char *) CPLMalloc(nDataSize);
-    memcpy( poNR->pachData, pachData, nDataSize );
+    if( poMappedFile != NULL )
+    {
+        poNR->pachData = pachData;
+        poNR->poMappedFile = poMappedFile;
+    }
+    else
+    {
+        poNR->pachData = (char *) CPLMalloc(nDataSize);
+        memcpy( poNR->pachData, pachData, nDataSize );
+    }
 
     poNR->nFieldCount = nFieldCount;
     poNR->paoFields = new DDFField[nFieldCount];
@@ -1086,10 +1142,38 @@ DDFRecord * DDFRecord::Copy()
                                        poNR->pachData + nOffset,
                                        paoFields[i].GetDataSize() );
     }
-
-    return poNR;
 }
 
+/************************************************************************/
+/*                             DetachData()                             */
+/*                                                                      */
+/*      Give the record its own copy of data viewed in the mapped       */
+/*      module file, before the data is reallocated or read over.       */
+/************************************************************************/
+
+void DDFRecord::DetachData()
+
+{
+    if( poMappedFile == NULL )
+        return;
+
+    char        *pachNewData = (char *) CPLMalloc(nDataSize);
+
+    memcpy( pachNewData, pachData, nDataSize );
+
+    for( int i = 0; i < nFieldCount; i++ )
+    {
+        int     nOffset;
+
+        nOffset = (paoFields[i].GetData() - pachData);
+        paoFields[i].Initialize( paoFields[i].GetFieldDefn(),
+                                 pachNewData + nOffset,
+                                 paoFields[i].GetDataSize() );
+    }
+
+    pachData = pachNewData;
+    poMappedFile.reset();
+}
 
 /************************************************************************/
 /*                            DeleteField()                             */
@@ -1192,8 +1276,11 @@ int DDFRecord::ResizeField( DDFField *poField, int nNewDataSize )
     }
 
 /* -------------------------------------------------------------------- */
-/*      Reallocate the data buffer accordingly.                         */
+/*      Reallocate the data buffer accordingly.  Data shared with       */
+/*      other records in the mapped file must be copied first.          */
 /* -------------------------------------------------------------------- */
+    DetachData();
+
     int nBytesToAdd = nNewDataSize - poField->GetDataSize();
     const char *pachOldData = pachData;
 
@@ -1301,6 +1388,8 @@ DDFField *DDFRecord::AddField( DDFFieldDefn *poDefn )
 /* -------------------------------------------------------------------- */
     DDFField    *paoNewFields;
 
+    DetachData();
+
     paoNewFields = new DDFField[nFieldCount+1];
     if( nFieldCount > 0 )
     {
@@ -1370,6 +1459,12 @@ DDFRecord::SetFieldRaw( DDFField *poField, int iIndexWithinField,
     if( iTarget == nFieldCount )
         return FALSE;
 
+/* -------------------------------------------------------------------- */
+/*      Data shared with other records in the mapped file must be       */
+/*      copied before it is changed.                                    */
+/* -------------------------------------------------------------------- */
+    DetachData();
+
     nRepeatCount = poField->GetRepeatCount();
 
     if( iIndexWithinField < 0 || iIndexWithinField > nRepeatCount )
@@ -1531,6 +1626,12 @@ DDFRecord::UpdateFieldRaw( DDFField *poField, int iIndexWithinField,
     if( iTarget == nFieldCount )
         return FALSE;
 
+/* -------------------------------------------------------------------- */
+/*      Data shared with other records in the mapped file must be       */
+/*      copied before it is changed.                                    */
+/* -------------------------------------------------------------------- */
+    DetachData();
+
     nRepeatCount = poField->GetRepeatCount();
 
     if( iIndexWithinField < 0 || iIndexWithinField >= nRepeatCount )
@@ -1604,6 +1705,8 @@ int DDFRecord::ResetDirectory()
 {
     int iField;
 
+    DetachData();
+
 /* -------------------------------------------------------------------- */
 /*      Eventually we should try to optimize the size of offset and     */
 /*      field length.  For now we will use 5 for each which is          */
@@ -1749,6 +1852,8 @@ int DDFRecord::SetStringSubfield( const char *pszField, int iFieldIndex,
     if( poField == NULL )
         return FALSE;
 
+    DetachData();  // The subfield may be formatted in place.
+
 /* -------------------------------------------------------------------- */
 /*      Get the subfield definition                                     */
 /* -------------------------------------------------------------------- */
@@ -1861,6 +1966,8 @@ int DDFRecord::SetIntSubfield( const char *pszField, int iFieldIndex,
     if( poField == NULL )
         return FALSE;
 
+    DetachData();  // The subfield may be formatted in place.
+
 /* -------------------------------------------------------------------- */
 /*      Get the subfield definition                                     */
 /* -------------------------------------------------------------------- */
@@ -1972,6 +2079,8 @@ int DDFRecord::SetFloatSubfield( const char *pszField, int iFieldIndex,
     if( poField == NULL )
         return FALSE;
 
+    DetachData();  // The subfield may be formatted in place.
+
 /* -------------------------------------------------------------------- */
 /*      Get the subfield definition                                     */
 /* -------------------------------------------------------------------- */
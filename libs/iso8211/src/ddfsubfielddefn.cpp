@@ -88,6 +88,7 @@ DDFSubfieldDefn::DDFSubfieldDefn()
 
     bIsVariable = TRUE;
     nFormatWidth = 0;
+    nFixedOffset = -1;
     chFormatDelimeter = DDF_UNIT_TERMINATOR;
     eBinaryFormat = NotBinary;
     eType = DDFString;
@@ -0,0 +1,103 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+/**
+ * \file
+ *
+ * Raster chart pixel kernels: BSB run length decoding into 24 bit pixels
+ * and box filter downsampling.
+ *
+ * Like libs/mipmap, the inner loops are function pointers set to the
+ * generic C versions, and Raster_ResolveRoutines() switches them to the
+ * SSE2, AVX2 or NEON versions the CPU supports.
+ */
+
+#ifndef __RASTER_H__
+#define __RASTER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Max rows for Raster_SumRows_24(), so that sums fit in 16 bits. */
+#define RASTER_MAX_SUM_ROWS 257
+
+/** Fill count 24 bit pixels at target with the 3 low bytes of rgb. */
+extern void (*Raster_Fill_24)(unsigned char *target, uint32_t rgb, int count);
+
+/**
+ * Set sums[i] to the sum of byte i of rows lines of 24 bit pixels,
+ * width pixels long and stride bytes apart, for i < 3 * width.
+ * rows must not exceed RASTER_MAX_SUM_ROWS.
+ */
+extern void (*Raster_SumRows_24)(const unsigned char *source, int stride,
+                                 int rows, int width, uint16_t *sums);
+
+void Raster_ResolveRoutines(void);
+
+/**
+ * Expand a run length encoded BSB row into pixels xs to xl - 1.
+ * @param lp First run of the row, at pixel ix <= xs.
+ * @param end End of row data.
+ * @param color_size Bits per color index, from the BSB header.
+ * @param palette 24 bit colors, indexed by color index.
+ * @param target Receives (xl - xs) * 3 bytes.
+ */
+void Raster_ExpandBSB_24(const unsigned char *lp, const unsigned char *end,
+                         int ix, int xs, int xl, int color_size,
+                         const int *palette, unsigned char *target);
+
+/** Size of the work buffer of Raster_BoxFilter_24(), in uint32_t. */
+size_t Raster_BoxFilterWorkSize(int width);
+
+/**
+ * Downsample size lines of width 24 bit pixels into one line: target
+ * pixel x is the average of the size x size box starting at column
+ * (int)(x * factor), cut at the line end. Boxes starting at or past
+ * valid_width are black.
+ * @param work Buffer of Raster_BoxFilterWorkSize(width) items.
+ */
+void Raster_BoxFilter_24(const unsigned char *source, int width, int size,
+                         double factor, int valid_width, int target_width,
+                         unsigned char *target, uint32_t *work);
+
+void Raster_Fill_24_generic(unsigned char *target, uint32_t rgb, int count);
+/** Like Raster_SumRows_24_generic(), for count bytes. */
+void Raster_SumBytes_generic(const unsigned char *source, int stride,
+                             int rows, int count, uint16_t *sums);
+void Raster_SumRows_24_generic(const unsigned char *source, int stride,
+                               int rows, int width, uint16_t *sums);
+
+void Raster_Fill_24_sse2(unsigned char *target, uint32_t rgb, int count);
+void Raster_SumRows_24_sse2(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums);
+
+void Raster_Fill_24_avx2(unsigned char *target, uint32_t rgb, int count);
+void Raster_SumRows_24_avx2(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums);
+
+void Raster_Fill_24_neon(unsigned char *target, uint32_t rgb, int count);
+void Raster_SumRows_24_neon(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
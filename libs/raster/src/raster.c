@@ -0,0 +1,280 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+
+/**
+ * \file
+ *
+ * Generic raster kernels, BSB row decoding and CPU dispatch.
+ */
+
+#include <string.h>
+
+#include "raster.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+void Raster_Fill_24_generic(unsigned char *target, uint32_t rgb, int count) {
+  unsigned char r = rgb & 0xff, g = (rgb >> 8) & 0xff, b = (rgb >> 16) & 0xff;
+  if (r == g && g == b) {
+    memset(target, r, (size_t)count * 3);
+    return;
+  }
+  if (count < 8) {
+    while (count--) {
+      target[0] = r;
+      target[1] = g;
+      target[2] = b;
+      target += 3;
+    }
+    return;
+  }
+  // Copy blocks of 8 pixels, 24 bytes, from the first one.
+  unsigned char *first = target;
+  int i;
+  for (i = 0; i < 8; i++) {
+    target[0] = r;
+    target[1] = g;
+    target[2] = b;
+    target += 3;
+  }
+  count -= 8;
+  while (count >= 8) {
+    memcpy(target, first, 24);
+    target += 24;
+    count -= 8;
+  }
+  memcpy(target, first, (size_t)count * 3);
+}
+
+void Raster_SumBytes_generic(const unsigned char *source, int stride,
+                             int rows, int count, uint16_t *sums) {
+  int i, r;
+  if (count <= 0) return;
+  for (i = 0; i < count; i++) sums[i] = source[i];
+  for (r = 1; r < rows; r++) {
+    const unsigned char *line = source + (size_t)r * stride;
+    for (i = 0; i < count; i++) sums[i] += line[i];
+  }
+}
+
+void Raster_SumRows_24_generic(const unsigned char *source, int stride,
+                               int rows, int width, uint16_t *sums) {
+  Raster_SumBytes_generic(source, stride, rows, width * 3, sums);
+}
+
+void (*Raster_Fill_24)(unsigned char *target, uint32_t rgb,
+                       int count) = Raster_Fill_24_generic;
+void (*Raster_SumRows_24)(const unsigned char *source, int stride, int rows,
+                          int width,
+                          uint16_t *sums) = Raster_SumRows_24_generic;
+
+#if defined(RASTER_HAVE_SSE2)
+static int HaveSse2(void) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[3] & (1 << 26)) != 0;
+#else
+  return __builtin_cpu_supports("sse2");
+#endif
+}
+#endif
+
+#if defined(RASTER_HAVE_AVX2)
+static int HaveAvx2(void) {
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return 0;
+  __cpuid(info, 1);
+  // The OS must save the AVX registers.
+  if (!(info[2] & (1 << 27)) || (_xgetbv(0) & 6) != 6) return 0;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+void Raster_ResolveRoutines(void) {
+#if defined(RASTER_HAVE_SSE2)
+  if (HaveSse2()) {
+    Raster_Fill_24 = Raster_Fill_24_sse2;
+    Raster_SumRows_24 = Raster_SumRows_24_sse2;
+  }
+#endif
+#if defined(RASTER_HAVE_AVX2)
+  if (HaveAvx2()) {
+    Raster_Fill_24 = Raster_Fill_24_avx2;
+    Raster_SumRows_24 = Raster_SumRows_24_avx2;
+  }
+#endif
+#if defined(RASTER_HAVE_NEON)
+  Raster_Fill_24 = Raster_Fill_24_neon;
+  Raster_SumRows_24 = Raster_SumRows_24_neon;
+#endif
+}
+
+void Raster_ExpandBSB_24(const unsigned char *lp, const unsigned char *end,
+                         int ix, int xs, int xl, int color_size,
+                         const int *palette, unsigned char *target) {
+  int value_shift = 7 - color_size;
+  unsigned char value_mask = ((1 << color_size) - 1) << value_shift;
+  unsigned char count_mask = (1 << (7 - color_size)) - 1;
+  int value = 0;
+  int last_valid = 0;
+  unsigned char next;
+
+  while (ix < xl - 1) {
+    if (lp >= end) break;
+    next = *lp++;
+    value = (next & value_mask) >> value_shift;
+
+    unsigned int run;
+    if (next == 0) {
+      run = xl - ix;  // corrupted chart, just run to the end
+    } else {
+      run = next & count_mask;
+      while ((next & 0x80) != 0) {
+        if (lp >= end) {
+          run = xl - ix;  // corrupted chart, just run to the end
+          break;
+        }
+        next = *lp++;
+        run = run * 128 + (next & 0x7f);
+      }
+      run++;
+    }
+
+    if (ix < xs) {
+      if (ix + run <= (unsigned int)xs) {
+        ix += run;
+        continue;
+      }
+      run -= xs - ix;
+      ix = xs;
+    }
+
+    // The last pixel is written on its own, not to write past it.
+    if (ix + run >= (unsigned int)xl) {
+      run = xl - 1 - ix;
+      last_valid = 1;
+    }
+
+    if (run < 16) {
+      // Most runs are short, not worth a call. Store 4 bytes per pixel, the
+      // last one is overwritten by the next run or the last pixel.
+      int rgb = palette[value];
+      unsigned char pixel[4];
+      unsigned int i;
+      pixel[0] = rgb & 0xff;
+      pixel[1] = (rgb >> 8) & 0xff;
+      pixel[2] = (rgb >> 16) & 0xff;
+      pixel[3] = 0;
+      for (i = 0; i < run; i++) {
+        memcpy(target, pixel, 4);
+        target += 3;
+      }
+    } else {
+      Raster_Fill_24(target, (uint32_t)palette[value], (int)run);
+      target += run * 3;
+    }
+    ix += run;
+  }
+
+  if (ix < xl) {
+    if (!last_valid) {
+      next = lp < end ? *lp : 0;
+      value = (next & value_mask) >> value_shift;
+    }
+    int rgb = palette[value];
+    target[0] = rgb & 0xff;
+    target[1] = (rgb >> 8) & 0xff;
+    target[2] = (rgb >> 16) & 0xff;
+  }
+}
+
+size_t Raster_BoxFilterWorkSize(int width) {
+  // Column totals, then the 16 bit column sums.
+  return 3 * ((size_t)width + 1) + (3 * (size_t)width + 1) / 2;
+}
+
+void Raster_BoxFilter_24(const unsigned char *source, int width, int size,
+                         double factor, int valid_width, int target_width,
+                         unsigned char *target, uint32_t *work) {
+  int n = width * 3, i, x;
+  uint32_t *totals = work;
+  uint16_t *sums = (uint16_t *)(work + n + 3);
+
+  // Column sums, then running totals along the line, so that any box is
+  // the difference of two totals. totals[3 * x] is the sum of the columns
+  // left of x.
+  memset(totals, 0, (n + 3) * sizeof(uint32_t));
+  for (i = 0; i < size; i += RASTER_MAX_SUM_ROWS) {
+    int rows = size - i < RASTER_MAX_SUM_ROWS ? size - i : RASTER_MAX_SUM_ROWS;
+    Raster_SumRows_24(source + (size_t)i * n, n, rows, width, sums);
+    for (x = 0; x < n; x++) totals[x] += sums[x];
+  }
+  // Keep the running totals in registers, not to wait for the stores.
+  uint32_t r = 0, g = 0, b = 0;
+  for (x = 0; x < n; x += 3) {
+    uint32_t cr = totals[x], cg = totals[x + 1], cb = totals[x + 2];
+    totals[x] = r;
+    totals[x + 1] = g;
+    totals[x + 2] = b;
+    r += cr;
+    g += cg;
+    b += cb;
+  }
+  totals[n] = r;
+  totals[n + 1] = g;
+  totals[n + 2] = b;
+
+  // Divide by multiplying with the inverse, the same for all boxes but the
+  // last: sum * ceil(2^40 / count) >> 40 is exact as sum <= 255 * count,
+  // for count < 2^16.
+  uint32_t count = 0;
+  uint64_t inverse = 0;
+  for (x = 0; x < target_width; x++) {
+    int c0 = (int)(x * factor);
+    int c1 = c0 + size < width ? c0 + size : width;
+    if (c0 >= valid_width || c1 <= c0) {
+      target[0] = target[1] = target[2] = 0;
+    } else {
+      const uint32_t *p0 = totals + 3 * c0, *p1 = totals + 3 * c1;
+      if ((uint32_t)size * (c1 - c0) != count) {
+        count = (uint32_t)size * (c1 - c0);
+        inverse = ((UINT64_C(1) << 40) + count - 1) / count;
+      }
+      if (count < 0x10000) {
+        target[0] = (unsigned char)(((p1[0] - p0[0]) * inverse) >> 40);
+        target[1] = (unsigned char)(((p1[1] - p0[1]) * inverse) >> 40);
+        target[2] = (unsigned char)(((p1[2] - p0[2]) * inverse) >> 40);
+      } else {
+        target[0] = (unsigned char)((p1[0] - p0[0]) / count);
+        target[1] = (unsigned char)((p1[1] - p0[1]) / count);
+        target[2] = (unsigned char)((p1[2] - p0[2]) / count);
+      }
+    }
+    target += 3;
+  }
+}
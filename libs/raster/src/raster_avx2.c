@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <string.h>
+
+#include "raster.h"
+
+#if defined(RASTER_HAVE_AVX2)
+#include <immintrin.h>
+
+// Store 32 pixels, 96 bytes, per iteration.
+void Raster_Fill_24_avx2(unsigned char *target, uint32_t rgb, int count) {
+  if (count < 32) {
+    Raster_Fill_24_generic(target, rgb, count);
+    return;
+  }
+  unsigned char pattern[96];
+  Raster_Fill_24_generic(pattern, rgb, 32);
+  __m256i p0 = _mm256_loadu_si256((const __m256i *)pattern);
+  __m256i p1 = _mm256_loadu_si256((const __m256i *)(pattern + 32));
+  __m256i p2 = _mm256_loadu_si256((const __m256i *)(pattern + 64));
+  while (count >= 32) {
+    _mm256_storeu_si256((__m256i *)target, p0);
+    _mm256_storeu_si256((__m256i *)(target + 32), p1);
+    _mm256_storeu_si256((__m256i *)(target + 64), p2);
+    target += 96;
+    count -= 32;
+  }
+  memcpy(target, pattern, (size_t)count * 3);
+}
+
+void Raster_SumRows_24_avx2(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums) {
+  int n = width * 3, i, r;
+  for (i = 0; i + 32 <= n; i += 32) {
+    __m256i lo = _mm256_setzero_si256(), hi = _mm256_setzero_si256();
+    const unsigned char *s = source + i;
+    for (r = 0; r < rows; r++, s += stride) {
+      __m128i v0 = _mm_loadu_si128((const __m128i *)s);
+      __m128i v1 = _mm_loadu_si128((const __m128i *)(s + 16));
+      lo = _mm256_add_epi16(lo, _mm256_cvtepu8_epi16(v0));
+      hi = _mm256_add_epi16(hi, _mm256_cvtepu8_epi16(v1));
+    }
+    _mm256_storeu_si256((__m256i *)(sums + i), lo);
+    _mm256_storeu_si256((__m256i *)(sums + i + 16), hi);
+  }
+  // Remaining bytes, not always whole pixels.
+  Raster_SumBytes_generic(source + i, stride, rows, n - i, sums + i);
+}
+#endif
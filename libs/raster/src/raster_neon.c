@@ -0,0 +1,56 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <string.h>
+
+#include "raster.h"
+
+#if defined(RASTER_HAVE_NEON)
+#include <arm_neon.h>
+
+// Store 16 interleaved pixels per iteration.
+void Raster_Fill_24_neon(unsigned char *target, uint32_t rgb, int count) {
+  uint8x16x3_t pixels;
+  pixels.val[0] = vdupq_n_u8(rgb & 0xff);
+  pixels.val[1] = vdupq_n_u8((rgb >> 8) & 0xff);
+  pixels.val[2] = vdupq_n_u8((rgb >> 16) & 0xff);
+  while (count >= 16) {
+    vst3q_u8(target, pixels);
+    target += 48;
+    count -= 16;
+  }
+  Raster_Fill_24_generic(target, rgb, count);
+}
+
+void Raster_SumRows_24_neon(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums) {
+  int n = width * 3, i, r;
+  for (i = 0; i + 16 <= n; i += 16) {
+    uint16x8_t lo = vdupq_n_u16(0), hi = vdupq_n_u16(0);
+    const unsigned char *s = source + i;
+    for (r = 0; r < rows; r++, s += stride) {
+      uint8x16_t v = vld1q_u8(s);
+      lo = vaddw_u8(lo, vget_low_u8(v));
+      hi = vaddw_u8(hi, vget_high_u8(v));
+    }
+    vst1q_u16(sums + i, lo);
+    vst1q_u16(sums + i + 8, hi);
+  }
+  // Remaining bytes, not always whole pixels.
+  Raster_SumBytes_generic(source + i, stride, rows, n - i, sums + i);
+}
+#endif
@@ -0,0 +1,64 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <string.h>
+
+#include "raster.h"
+
+#if defined(RASTER_HAVE_SSE2)
+#include <emmintrin.h>
+
+// Store 16 pixels, 48 bytes, per iteration.
+void Raster_Fill_24_sse2(unsigned char *target, uint32_t rgb, int count) {
+  if (count < 16) {
+    Raster_Fill_24_generic(target, rgb, count);
+    return;
+  }
+  unsigned char pattern[48];
+  Raster_Fill_24_generic(pattern, rgb, 16);
+  __m128i p0 = _mm_loadu_si128((const __m128i *)pattern);
+  __m128i p1 = _mm_loadu_si128((const __m128i *)(pattern + 16));
+  __m128i p2 = _mm_loadu_si128((const __m128i *)(pattern + 32));
+  while (count >= 16) {
+    _mm_storeu_si128((__m128i *)target, p0);
+    _mm_storeu_si128((__m128i *)(target + 16), p1);
+    _mm_storeu_si128((__m128i *)(target + 32), p2);
+    target += 48;
+    count -= 16;
+  }
+  memcpy(target, pattern, (size_t)count * 3);
+}
+
+void Raster_SumRows_24_sse2(const unsigned char *source, int stride, int rows,
+                            int width, uint16_t *sums) {
+  int n = width * 3, i, r;
+  const __m128i zero = _mm_setzero_si128();
+  for (i = 0; i + 16 <= n; i += 16) {
+    __m128i lo = zero, hi = zero;
+    const unsigned char *s = source + i;
+    for (r = 0; r < rows; r++, s += stride) {
+      __m128i v = _mm_loadu_si128((const __m128i *)s);
+      lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+      hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+    }
+    _mm_storeu_si128((__m128i *)(sums + i), lo);
+    _mm_storeu_si128((__m128i *)(sums + i + 8), hi);
+  }
+  // Remaining bytes, not always whole pixels.
+  Raster_SumBytes_generic(source + i, stride, rows, n - i, sums + i);
+}
+#endif
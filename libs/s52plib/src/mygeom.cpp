@@ -69,6 +69,10 @@
 #include <string.h>
 #include <math.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
 #include "tesselator.h"
 #include "Striper.h"
 
@@ -370,6 +374,55 @@ int PolyTessGeo::BuildDeferredTess(void) {
     return 0;
 }
 
+//  Below this many polygons per worker, thread startup costs more than
+//  it saves.
+#define TESS_BATCH_MIN_PER_THREAD 16
+
+int PolyTessGeo::BuildDeferredTessBatch(
+    const std::vector<PolyTessGeo *> &polys) {
+  std::vector<std::pair<int, PolyTessGeo *>> sized;
+  sized.reserve(polys.size());
+  for (PolyTessGeo *ptg : polys) {
+    if (!ptg || !ptg->IsDeferred()) continue;
+    int npt = 0;
+    for (int i = 0; i < ptg->m_pxgeom->n_contours; i++)
+      npt += ptg->m_pxgeom->contour_array[i];
+    sized.push_back(std::make_pair(npt, ptg));
+  }
+  if (sized.empty()) return 0;
+
+  //  Hand out the largest polygons first, so one big coastline
+  //  does not end up as the tail of the batch.
+  std::stable_sort(sized.begin(), sized.end(),
+                   [](const std::pair<int, PolyTessGeo *> &a,
+                      const std::pair<int, PolyTessGeo *> &b) {
+                     return a.first > b.first;
+                   });
+  std::vector<PolyTessGeo *> work;
+  work.reserve(sized.size());
+  for (auto &entry : sized) work.push_back(entry.second);
+
+  size_t n_threads = std::thread::hardware_concurrency();
+  n_threads = std::min(n_threads, work.size() / TESS_BATCH_MIN_PER_THREAD);
+
+  //  Without spare cores there is nothing to gain over the lazy
+  //  tesselation on first render, so leave the polygons deferred.
+  if (n_threads < 2) return 0;
+
+  std::atomic<size_t> next(0);
+  auto worker = [&work, &next]() {
+    size_t i;
+    while ((i = next++) < work.size()) work[i]->BuildDeferredTess();
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t i = 1; i < n_threads; i++) pool.emplace_back(worker);
+  worker();
+  for (std::thread &t : pool) t.join();
+
+  return work.size();
+}
+
 void beginCallback(GLenum which, void *polyData);
 void errorCallback(GLenum errorCode, void *polyData);
 void endCallback(void *polyData);
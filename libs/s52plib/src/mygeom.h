@@ -73,6 +73,8 @@ typedef void (*  _GLUfuncptr)();
 #endif
 
 
+#include <vector>
+
 #include "bbox.h"
 
 class OGRGeometry;
@@ -228,6 +230,14 @@ public:
   bool IsOk() { return m_bOK; }
 
   int BuildDeferredTess(void);
+  bool IsDeferred() { return m_pxgeom != NULL; }
+
+  //  Tesselate a set of deferred polygons, spreading the work over a pool
+  //  of worker threads.  All tesselator state lives in each PolyTessGeo,
+  //  so the result is the same as calling BuildDeferredTess() on each.
+  //  Does nothing unless the batch is large enough for several workers,
+  //  the polygons then stay deferred.  Returns the number tesselated.
+  static int BuildDeferredTessBatch(const std::vector<PolyTessGeo *> &polys);
 
   double Get_xmin() { return xmin; }
   double Get_xmax() { return xmax; }
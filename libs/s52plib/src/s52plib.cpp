@@ -292,6 +292,8 @@ s52plib::s52plib(const wxString &PLib, bool b_forceLegacy) {
   pOBJLArray = new wxArrayPtrVoid;
 
   condSymbolLUPArray = NULL;  // Dynamic Conditional Symbology
+  m_cnsy_generation = 0;
+  m_cs_state_hash = 0;
 
   _symb_sym = NULL;
 
@@ -392,6 +394,13 @@ s52plib::s52plib(const wxString &PLib, bool b_forceLegacy) {
   m_nTextFactor = 0;
   m_isSoundingFontSet = false;
 
+  m_bSymbolBatch = false;
+  m_symbol_run_shader = NULL;
+  m_symbol_run_texture = 0;
+  memset(m_symbol_run_color, 0, sizeof(m_symbol_run_color));
+  m_symbol_draw_calls = 0;
+  m_symbol_quads = 0;
+
   s_color = "color";
   s_uTex = "uTex";
   s_position = "position";
@@ -741,7 +750,29 @@ void s52plib::GenerateStateHash() {
     offset += sizeof(int);
   }
 
+  if (offset + sizeof(int) < sizeof(state_buffer)) {
+    memcpy(&state_buffer[offset], &m_cnsy_generation, sizeof(int));
+    offset += sizeof(int);
+  }
+
   m_state_hash = crc32buf(state_buffer, offset);
+
+  //  The conditional symbology inputs: mariner parameters, symbol and
+  //  boundary styles, units, and the dynamic LUP table generation.
+  //  Text, noshow and display category changes leave the CS output alone.
+  unsigned char cs_buffer[S52_MAR_NUM * sizeof(double) + 5 * sizeof(int)];
+  offset = 0;
+  for (int i = 0; i < S52_MAR_NUM; i++) {
+    double t = S52_getMarinerParam((S52_MAR_param_t)i);
+    memcpy(&cs_buffer[offset], &t, sizeof(double));
+    offset += sizeof(double);
+  }
+  int cs_state[5] = {m_nSymbolStyle, m_nBoundaryStyle, m_nDepthUnitDisplay,
+                     m_nHeightUnitDisplay, m_cnsy_generation};
+  memcpy(&cs_buffer[offset], cs_state, sizeof(cs_state));
+  offset += sizeof(cs_state);
+
+  m_cs_state_hash = crc32buf(cs_buffer, offset);
 }
 
 wxArrayOfLUPrec *s52plib::SelectLUPARRAY(LUPname TNAM) {
@@ -1337,6 +1368,11 @@ void s52plib::ClearCNSYLUPArray(void) {
 
     condSymbolLUPArray->Clear();
   }
+  m_cs_lup_index.clear();
+
+  //  Objects still reference rules of the destroyed LUPs,
+  //  make sure the next state hash forces them to be rebuilt.
+  m_cnsy_generation++;
 }
 
 bool s52plib::S52_flush_Plib() {
@@ -1354,6 +1390,7 @@ bool s52plib::S52_flush_Plib() {
 #endif
 
   DestroyLUPArray(condSymbolLUPArray);
+  m_cs_lup_index.clear();
 
   //      Destroy Rules
   DestroyRules(_line_sym);
@@ -2587,6 +2624,8 @@ int s52plib::RenderTE(ObjRazRules *rzRules, Rules *rules) {
 
 bool s52plib::RenderHPGL(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
                          float rot_angle, double uScale) {
+  if (!m_pdc) FlushSymbolBatch();
+
   float fsf = 100 / canvas_pix_per_mm;
 
   float xscale = 1.0;
@@ -3351,13 +3390,7 @@ bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
   if (!m_pdc)  // opengl
   {
 #ifdef ocpnUSE_GL
-    glEnable(GL_BLEND);
-
     if (texture) {
-
-      glEnable(GL_TEXTURE_2D);
-      glBindTexture(GL_TEXTURE_2D, texture);
-
       int w = texrect.width, h = texrect.height;
 
       float tx1 = texrect.x, ty1 = texrect.y;
@@ -3376,86 +3409,13 @@ bool s52plib::RenderRasterSymbol(ObjRazRules *rzRules, Rule *prule, wxPoint &r,
         ty1 /= rb_y, ty2 /= rb_y;
       }
 
-      float uv[8];
-      float coords[8];
-
-      // Note swizzle of points to allow TRIANGLE_STRIP drawing
-      // normal uv
-      uv[0] = tx1;
-      uv[1] = ty1;
-      uv[2] = tx2;
-      uv[3] = ty1;
-      uv[6] = tx2;
-      uv[7] = ty2;
-      uv[4] = tx1;
-      uv[5] = ty2;
-
-      w *= scale_factor;
-      h *= scale_factor;
-
-      // pixels
-      coords[0] = 0;
-      coords[1] = 0;
-      coords[2] = w;
-      coords[3] = 0;
-      coords[6] = w;
-      coords[7] = h;
-      coords[4] = 0;
-      coords[5] = h;
-
-      if (pCtexture_2D_shader_program[0]){
-        pCtexture_2D_shader_program[0]->Bind();
-
-        // Select the active texture unit.
-        glActiveTexture(GL_TEXTURE0);
-
-        pCtexture_2D_shader_program[0]->SetUniform1i( "uTex", 0);
-
-        // Disable VBO's (vertex buffer objects) for attributes.
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-        pCtexture_2D_shader_program[0]->SetAttributePointerf( "position", coords);
-        pCtexture_2D_shader_program[0]->SetAttributePointerf( "aUV", uv);
-
-        // Rotate
-        mat4x4 I, Q;
-        mat4x4_identity(I);
-
-        mat4x4_translate_in_place(I, r.x, r.y, 0);
-        if (abs(vp_plib.rotation) > 0)
-          mat4x4_rotate_Z(Q, I, -vp_plib.rotation);
-        else
-          mat4x4_dup(Q, I);
-        mat4x4_translate_in_place(Q, -pivot_x, -pivot_y, 0);
-
-        pCtexture_2D_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)Q);
-
-        // Perform the actual drawing.
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-        // Restore the per-object transform to Identity Matrix
-        mat4x4 IM;
-        mat4x4_identity(IM);
-        pCtexture_2D_shader_program[0]->SetUniformMatrix4fv( "TransformMatrix", (GLfloat *)IM);
-
-        // Clean up the GL state
-        pCtexture_2D_shader_program[0]->UnBind();
-      }
+      if (pCtexture_2D_shader_program[0])
+        QueueSymbolQuad(pCtexture_2D_shader_program[0], texture, NULL, r,
+                        pivot_x, pivot_y, w * scale_factor, h * scale_factor,
+                        tx1, ty1, tx2, ty2);
 
 #endif  // GLES2
-      glDisable(m_TextureFormat);
-    } else { /* this is only for legacy mode, or systems without NPOT textures
-              */
-      float cr = cosf(vp_plib.rotation);
-      float sr = sinf(vp_plib.rotation);
-      float ddx = pivot_x * cr + pivot_y * sr;
-      float ddy = pivot_y * cr - pivot_x * sr;
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
-#endif
     }
-
-    glDisable(GL_BLEND);
 #endif
   } else {
     if (!(prule->pixelPtr))  // This symbol requires manual alpha blending
@@ -3598,6 +3558,8 @@ bool s52plib::RenderCachedVectorSymbol(ObjRazRules *rzRules, Rule *rule_in, wxPo
   //  Only handle ATONs for now
   if (!rzRules->obj->bIsAton) return false;
 
+  FlushSymbolBatch();
+
   int symbol_texture = 0;
   // Build the hash key
   std::string key;
@@ -3944,13 +3906,7 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
   if (!m_pdc)  // opengl
   {
 #ifdef ocpnUSE_GL
-    glEnable(GL_BLEND);
-
-    if (texture) {
-      glEnable(GL_TEXTURE_2D);
-      glEnable(GL_BLEND);
-      glBindTexture(GL_TEXTURE_2D, texture);
-
+    if (texture && pCtexture_2D_Color_shader_program[0]) {
       int w = texrect.width, h = texrect.height;
 
       float tx1 = texrect.x, ty1 = texrect.y;
@@ -3967,85 +3923,15 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
         ty1 /= rb_y, ty2 /= rb_y;
       }
 
-      float uv[8];
-      float coords[8];
-
-      // Note swizzle of points to allow TRIANGLE_STRIP drawing
-      // normal uv
-      uv[0] = tx1;
-      uv[1] = ty1;
-      uv[2] = tx2;
-      uv[3] = ty1;
-      uv[6] = tx2;
-      uv[7] = ty2;
-      uv[4] = tx1;
-      uv[5] = ty2;
-
-      // pixels
-      coords[0] = 0;
-      coords[1] = 0;
-      coords[2] = w;
-      coords[3] = 0;
-      coords[6] = w;
-      coords[7] = h;
-      coords[4] = 0;
-      coords[5] = h;
-
       float colorv[4];
       colorv[0] = symColor.Red() / float(256);
       colorv[1] = symColor.Green() / float(256);
       colorv[2] = symColor.Blue() / float(256);
       colorv[3] = 1.0;
 
-      pCtexture_2D_Color_shader_program[0]->Bind();
-        // Select the active texture unit.
-      glActiveTexture(GL_TEXTURE0);
-      glUniform4fv(m_sounding_shader_uni_color, 1, colorv);
-      glUniform1i( m_sounding_shader_uni_uTex, 0);
-
-        // Disable VBO's (vertex buffer objects) for attributes.
-      glBindBuffer(GL_ARRAY_BUFFER, 0);
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-      glVertexAttribPointer(m_sounding_shader_attr_position, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), coords);
-      glEnableVertexAttribArray(m_sounding_shader_attr_position);
-
-      glVertexAttribPointer(m_sounding_shader_attr_aUV, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), uv);
-      glEnableVertexAttribArray(m_sounding_shader_attr_aUV);
-
-      // Rotate
-       mat4x4 I, Q;
-       mat4x4_identity(I);
-       mat4x4_identity(Q);
-
-      mat4x4_translate_in_place(I, r.x, r.y, 0);
-      mat4x4_rotate_Z(Q, I, -vp_plib.rotation);
-      mat4x4_translate_in_place(Q, -pivot_x, -pivot_y, 0);
-
-      glUniformMatrix4fv(m_sounding_shader_uni_transform, 1, GL_FALSE, (GLfloat *)Q);
-
-      // Perform the actual drawing.
-      glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-      // Restore the per-object transform to Identity Matrix
-      mat4x4 IM;
-      mat4x4_identity(IM);
-
-      glUniformMatrix4fv(m_sounding_shader_uni_transform, 1, GL_FALSE, (GLfloat *)IM);
-
-      pCtexture_2D_Color_shader_program[0]->UnBind();
-      glDisable(m_TextureFormat);
-    } else { /* this is only for legacy mode, or systems without NPOT textures
-              */
-      float cr = cosf(vp_plib.rotation);
-      float sr = sinf(vp_plib.rotation);
-      float ddx = pivot_x * cr + pivot_y * sr;
-      float ddy = pivot_y * cr - pivot_x * sr;
-#if !defined(USE_ANDROID_GLES2) && !defined(ocpnUSE_GLSL)
-#endif
+      QueueSymbolQuad(pCtexture_2D_Color_shader_program[0], texture, colorv, r,
+                      pivot_x, pivot_y, w, h, tx1, ty1, tx2, ty2);
     }
-
-    glDisable(GL_BLEND);
 #endif
   } else {
     wxString text;
@@ -4058,6 +3944,110 @@ bool s52plib::RenderSoundingSymbol(ObjRazRules *rzRules, Rule *prule,
   return true;
 }
 
+void s52plib::BeginSymbolBatch() {
+  FlushSymbolBatch();
+  m_bSymbolBatch = true;
+}
+
+void s52plib::EndSymbolBatch() {
+  FlushSymbolBatch();
+  m_bSymbolBatch = false;
+}
+
+void s52plib::QueueSymbolQuad(CGLShaderProgram *shader, unsigned int texture,
+                              const float *color, const wxPoint &r,
+                              int pivot_x, int pivot_y, float w, float h,
+                              float tx1, float ty1, float tx2, float ty2) {
+#ifdef ocpnUSE_GL
+  //  A new run is needed whenever the GL state differs
+  bool same_run = (shader == m_symbol_run_shader) &&
+                  (texture == m_symbol_run_texture);
+  if (same_run && color)
+    same_run = !memcmp(color, m_symbol_run_color, sizeof(m_symbol_run_color));
+  if (!same_run) {
+    FlushSymbolBatch();
+    m_symbol_run_shader = shader;
+    m_symbol_run_texture = texture;
+    if (color)
+      memcpy(m_symbol_run_color, color, sizeof(m_symbol_run_color));
+  }
+
+  //  Apply the per-symbol transform on the CPU, so that all quads of the
+  //  run share an identity TransformMatrix.  This is the same
+  //  translate(r) * rotate(-rotation) * translate(-pivot) sequence
+  //  formerly uploaded for each symbol.
+  float angle = -vp_plib.rotation;
+  float c = cosf(angle);
+  float s = sinf(angle);
+
+  const float px[4] = {0, w, 0, w};
+  const float py[4] = {0, 0, h, h};
+  const float pu[4] = {tx1, tx2, tx1, tx2};
+  const float pv[4] = {ty1, ty1, ty2, ty2};
+  float qx[4], qy[4];
+  for (int i = 0; i < 4; i++) {
+    float x = px[i] - pivot_x;
+    float y = py[i] - pivot_y;
+    qx[i] = r.x + c * x - s * y;
+    qy[i] = r.y + s * x + c * y;
+  }
+
+  //  Two triangles per quad, same winding as the former TRIANGLE_STRIP
+  static const int order[6] = {0, 1, 2, 1, 3, 2};
+  for (int k : order) {
+    m_symbol_run_coords.push_back(qx[k]);
+    m_symbol_run_coords.push_back(qy[k]);
+    m_symbol_run_uv.push_back(pu[k]);
+    m_symbol_run_uv.push_back(pv[k]);
+  }
+  m_symbol_quads++;
+
+  if (!m_bSymbolBatch) FlushSymbolBatch();
+#endif
+}
+
+void s52plib::FlushSymbolBatch() {
+#ifdef ocpnUSE_GL
+  if (m_symbol_run_coords.empty()) return;
+
+  CGLShaderProgram *shader = m_symbol_run_shader;
+
+  glEnable(GL_BLEND);
+  glEnable(GL_TEXTURE_2D);
+  glBindTexture(GL_TEXTURE_2D, m_symbol_run_texture);
+
+  shader->Bind();
+
+  // Select the active texture unit.
+  glActiveTexture(GL_TEXTURE0);
+  shader->SetUniform1i("uTex", 0);
+  if (shader == pCtexture_2D_Color_shader_program[0])
+    shader->SetUniform4fv("color", m_symbol_run_color);
+
+  mat4x4 IM;
+  mat4x4_identity(IM);
+  shader->SetUniformMatrix4fv("TransformMatrix", (GLfloat *)IM);
+
+  // Disable VBO's (vertex buffer objects) for attributes.
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+  shader->SetAttributePointerf("position", m_symbol_run_coords.data());
+  shader->SetAttributePointerf("aUV", m_symbol_run_uv.data());
+
+  glDrawArrays(GL_TRIANGLES, 0, m_symbol_run_coords.size() / 2);
+  m_symbol_draw_calls++;
+
+  // Clean up the GL state
+  shader->UnBind();
+  glDisable(m_TextureFormat);
+  glDisable(GL_BLEND);
+
+  m_symbol_run_coords.clear();
+  m_symbol_run_uv.clear();
+#endif
+}
+
 // Line Simple Style, OpenGL
 int s52plib::RenderGLLS(ObjRazRules *rzRules, Rules *rules) {
   // for now don't use vbo model in non-mercator
@@ -6861,9 +6851,16 @@ int s52plib::RenderObjectToDCText(wxDC *pdcin, ObjRazRules *rzRules) {
 
 int s52plib::RenderObjectToGLText(const wxGLContext &glcc, ObjRazRules *rzRules) {
   m_glcc = (wxGLContext *)&glcc;
+  FlushSymbolBatch();
   return DoRenderObjectTextOnly(NULL, rzRules);
 }
 
+//  Rules whose GL output may be merged into the pending symbol batch.
+//  Vector symbols within them flush the batch themselves, in RenderHPGL().
+static inline bool IsSymbolBatchRule(Rules_t type) {
+  return type == RUL_SYM_PT || type == RUL_MUL_SG || type == RUL_CND_SY;
+}
+
 int s52plib::DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules) {
 #ifdef __OCPN__ANDROID__
   // Catch a difficult to trap SIGSEGV, avoiding app crash
@@ -6898,6 +6895,9 @@ int s52plib::DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules) {
     Rules *rules = rzRules->LUP->ruleList;
 
     while (rules != NULL) {
+      //  Keep batched symbols below anything drawn by this rule
+      if (!m_pdc && !IsSymbolBatchRule(rules->ruleType)) FlushSymbolBatch();
+
       switch (rules->ruleType) {
         case RUL_TXT_TX:
           RenderTX(rzRules, rules);
@@ -6936,6 +6936,9 @@ int s52plib::DoRenderObject(wxDC *pdcin, ObjRazRules *rzRules) {
           rules = rzRules->obj->CSrules;
 
           while (NULL != rules) {
+            if (!m_pdc && !IsSymbolBatchRule(rules->ruleType))
+              FlushSymbolBatch();
+
             switch (rules->ruleType) {
               case RUL_TXT_TX:
                 RenderTX(rzRules, rules);
@@ -9163,6 +9166,8 @@ int s52plib::RenderToGLAP_GLSL(ObjRazRules *rzRules, Rules *rules) {
 int s52plib::RenderAreaToGL(const wxGLContext &glcc, ObjRazRules *rzRules) {
   if (!ObjectRenderCheckRules(rzRules, true)) return 0;
 
+  FlushSymbolBatch();
+
 #ifdef __OCPN__ANDROID__
   // Catch a difficult to trap SIGSEGV, avoiding app crash
   sigaction(SIGSEGV, NULL,
@@ -9709,43 +9714,32 @@ int s52plib::RenderAreaToDC(wxDC *pdcin, ObjRazRules *rzRules,
 void s52plib::GetAndAddCSRules(ObjRazRules *rzRules, Rules *rules) {
   LUPrec *NewLUP;
   LUPrec *LUP;
-  LUPrec *LUPCandidate;
-  wxString cs_string;
 
   char *rule_str1 = RenderCS(rzRules, rules);
-  if (rule_str1)
-    cs_string = wxString(rule_str1, wxConvUTF8);
-  free(rule_str1);  // delete rule_str1;
 
   //  Try to find a match for this object/attribute set in dynamic CS LUP Table
+  //  A LUP matches if
+  //  a) the Object Name is the same and
+  //  b) the LUP was created earlier by exactly the same INSTruction string and
+  //  c) the LUP has same Display Category.
+  //  All objects of a class sharing an attribute signature produce the same
+  //  instruction string, so the hashed lookup resolves the rule chain once
+  //  per signature instead of scanning every dynamic LUP for every object.
+
+  std::string key(rzRules->LUP->OBCL);
+  key += '\x1f';
+  key += std::to_string(rzRules->LUP->DISC);
+  key += '\x1f';
+  if (rule_str1) key += rule_str1;
+
+  auto found = m_cs_lup_index.find(key);
+  if (found != m_cs_lup_index.end()) {
+    LUP = found->second;
+  } else {
+    //  Not found, need to create a dynamic LUP and add to CS LUP Table
+    wxString cs_string;
+    if (rule_str1) cs_string = wxString(rule_str1, wxConvUTF8);
 
-  //  Do this by checking each LUP in the CS LUPARRAY and checking....
-  //  a) is Object Name the same? and
-  //  b) was LUP created earlier by exactly the same INSTruction string?
-  //  c) does LUP have same Display Category and Priority?
-
-  wxArrayOfLUPrec *la = condSymbolLUPArray;
-  int index = 0;
-  int index_max = la->GetCount();
-  LUP = NULL;
-
-  while ((index < index_max)) {
-    LUPCandidate = la->Item(index);
-    if (!strcmp(rzRules->LUP->OBCL, LUPCandidate->OBCL)) {
-      if (LUPCandidate->INST.IsSameAs(cs_string)) {
-        if (LUPCandidate->DISC == rzRules->LUP->DISC) {
-          LUP = LUPCandidate;
-          break;
-        }
-      }
-    }
-    index++;
-  }
-
-  //  If not found, need to create a dynamic LUP and add to CS LUP Table
-
-  if (NULL == LUP)  // Not found
-  {
     NewLUP = new LUPrec();
     NewLUP->DISC = rzRules->LUP->DISC;  // as a default
 
@@ -9761,10 +9755,12 @@ void s52plib::GetAndAddCSRules(ObjRazRules *rzRules, Rules *rules) {
     wxArrayOfLUPrec *pLUPARRAYtyped = condSymbolLUPArray;
 
     pLUPARRAYtyped->Add(NewLUP);
+    m_cs_lup_index[key] = NewLUP;
 
     LUP = NewLUP;
+  }
 
-  }  // if (LUP = NULL)
+  free(rule_str1);  // delete rule_str1;
 
   Rules *top = LUP->ruleList;
 
@@ -30,6 +30,7 @@
 #include "s52s57.h"  //types
 
 class wxGLContext;
+class CGLShaderProgram;
 
 #include "LLRegion.h"
 #include "DepthFont.h"
@@ -215,6 +216,12 @@ public:
 
   void GenerateStateHash();
   long GetStateHash() { return m_state_hash; }
+  /**
+   * Hash of the subset of the state consumed by conditional symbology
+   * procedures.  Charts only need to re-evaluate their CS rules when
+   * this changes, not on every GetStateHash() change.
+   */
+  long GetCSStateHash() { return m_cs_state_hash; }
 
   void SetPLIBColorScheme(wxString scheme, const ChartCtx& ctx);
   void SetPLIBColorScheme(ColorScheme cs, const ChartCtx& ctx);
@@ -254,6 +261,23 @@ public:
   int SetLineFeaturePriority(ObjRazRules *rzRules, int npriority);
   void FlushSymbolCaches(const ChartCtx& ctx);
 
+  /**
+   * Collect raster symbol and sounding quads across objects and submit
+   * each run of quads sharing texture, shader and color with a single
+   * draw call.  Rendering order is preserved: any other primitive drawn
+   * through the library flushes the pending run first.  GL only, DC
+   * rendering is unaffected.  Must be balanced by EndSymbolBatch().
+   */
+  void BeginSymbolBatch();
+  void EndSymbolBatch();
+  void FlushSymbolBatch();
+  /** Draw calls and quads submitted through the symbol batch. */
+  void GetSymbolBatchStats(unsigned &draw_calls, unsigned &quads) {
+    draw_calls = m_symbol_draw_calls;
+    quads = m_symbol_quads;
+  }
+  void ResetSymbolBatchStats() { m_symbol_draw_calls = m_symbol_quads = 0; }
+
   //    For DC's
   int RenderObjectToDC(wxDC *pdc, ObjRazRules *rzRules);
   int RenderObjectToDCText(wxDC *pdc, ObjRazRules *rzRules);
@@ -400,6 +424,9 @@ public:
   LUPArrayContainer *pointPaper_LAC;
 
   wxArrayOfLUPrec *condSymbolLUPArray;  // Dynamic Conditional Symbology
+  //  Index into condSymbolLUPArray, keyed on object class, display
+  //  category and CS instruction string
+  std::unordered_map<std::string, LUPrec *> m_cs_lup_index;
 
   wxArrayPtrVoid *pOBJLArray;  // Used for Display Filtering
   std::vector<wxString> OBJLDescriptions;
@@ -504,6 +531,10 @@ private:
                             wxColor symColor,
                             float rot_angle = 0.);
   wxImage RuleXBMToImage(Rule *prule);
+  void QueueSymbolQuad(CGLShaderProgram *shader, unsigned int texture,
+                       const float *color, const wxPoint &r, int pivot_x,
+                       int pivot_y, float w, float h, float tx1, float ty1,
+                       float tx2, float ty2);
 
   bool RenderText(wxDC *pdc, S52_TextC *ptext, int x, int y, wxRect *pRectDrawn,
                   S57Obj *pobj, bool bCheckOverlap);
@@ -593,6 +624,9 @@ private:
   bool m_qualityOfDataOn;
 
   long m_state_hash;
+  long m_cs_state_hash;
+  //  Bumped when the dynamic CS LUPs are destroyed, forcing re-evaluation
+  int m_cnsy_generation;
 
   bool m_txf_ready;
   int m_txf_avg_char_width;
@@ -636,6 +670,16 @@ private:
   LLBBox reducedBBox;
   std::unordered_map<std::string, int>vector_symbol_cache;
 
+  //  Pending run of symbol quads, see BeginSymbolBatch()
+  bool m_bSymbolBatch;
+  CGLShaderProgram *m_symbol_run_shader;
+  unsigned int m_symbol_run_texture;
+  float m_symbol_run_color[4];
+  std::vector<float> m_symbol_run_coords;
+  std::vector<float> m_symbol_run_uv;
+  unsigned m_symbol_draw_calls;
+  unsigned m_symbol_quads;
+
 };
 
 #define HPGL_FILLED true
@@ -980,6 +980,23 @@ void S57Reader::GenerateFSPTAttributes(DDFRecord *poRecord,
   CPLFree(panMASK);
 }
 
+/************************************************************************/
+/*                         GetIntSubfieldData()                         */
+/*                                                                      */
+/*      Fetch an instance of an integer subfield whose definition was   */
+/*      looked up once, rather than by name for each coordinate.        */
+/************************************************************************/
+
+static int GetIntSubfieldData(DDFField *poField, DDFSubfieldDefn *poSFDefn,
+                              int iSubfieldIndex) {
+  if (poSFDefn == NULL) return 0;
+
+  int nBytesRemaining;
+  const char *pachData =
+      poField->GetSubfieldData(poSFDefn, &nBytesRemaining, iSubfieldIndex);
+  return poSFDefn->ExtractIntData(pachData, nBytesRemaining, NULL);
+}
+
 /************************************************************************/
 /*                             ReadVector()                             */
 /*                                                                      */
@@ -1077,11 +1094,16 @@ OGRFeature *S57Reader::ReadVector(int nFeatureId, int nRCNM)
         poFeature->SetGeometryDirectly(new OGRPoint(dfX, dfY, dfZ));
       } else {
         OGRMultiPoint *poMP = new OGRMultiPoint();
+        DDFField *poSG3D = poRecord->FindField("SG3D");
+        DDFFieldDefn *poDefn = poSG3D->GetFieldDefn();
+        DDFSubfieldDefn *poXCOO = poDefn->FindSubfieldDefn("XCOO");
+        DDFSubfieldDefn *poYCOO = poDefn->FindSubfieldDefn("YCOO");
+        DDFSubfieldDefn *poVE3D = poDefn->FindSubfieldDefn("VE3D");
 
         for (i = 0; i < nVCount; i++) {
-          dfX = poRecord->GetIntSubfield("SG3D", 0, "XCOO", i) / (double)nCOMF;
-          dfY = poRecord->GetIntSubfield("SG3D", 0, "YCOO", i) / (double)nCOMF;
-          dfZ = poRecord->GetIntSubfield("SG3D", 0, "VE3D", i) / (double)nSOMF;
+          dfX = GetIntSubfieldData(poSG3D, poXCOO, i) / (double)nCOMF;
+          dfY = GetIntSubfieldData(poSG3D, poYCOO, i) / (double)nCOMF;
+          dfZ = GetIntSubfieldData(poSG3D, poVE3D, i) / (double)nSOMF;
 
           poMP->addGeometryDirectly(new OGRPoint(dfX, dfY, dfZ));
         }
@@ -1126,10 +1148,15 @@ OGRFeature *S57Reader::ReadVector(int nFeatureId, int nRCNM)
 
       poLine->setNumPoints(nVCount);
 
+      DDFField *poSG2D = poRecord->FindField("SG2D");
+      DDFFieldDefn *poDefn = poSG2D->GetFieldDefn();
+      DDFSubfieldDefn *poXCOO = poDefn->FindSubfieldDefn("XCOO");
+      DDFSubfieldDefn *poYCOO = poDefn->FindSubfieldDefn("YCOO");
+
       for (i = 0; i < nVCount; i++) {
-        poLine->setPoint(
-            i, poRecord->GetIntSubfield("SG2D", 0, "XCOO", i) / (double)nCOMF,
-            poRecord->GetIntSubfield("SG2D", 0, "YCOO", i) / (double)nCOMF);
+        poLine->setPoint(i,
+                         GetIntSubfieldData(poSG2D, poXCOO, i) / (double)nCOMF,
+                         GetIntSubfieldData(poSG2D, poYCOO, i) / (double)nCOMF);
       }
       poFeature->SetGeometryDirectly(poLine);
     }
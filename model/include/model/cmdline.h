@@ -32,6 +32,7 @@ extern int g_unit_test_1;
 extern int g_unit_test_2;
 extern bool g_start_fullscreen;
 extern bool g_rebuild_gl_cache;
+extern bool g_build_gl_cache_headless;
 extern bool g_parse_all_enc;
 extern bool g_bportable;
 extern bool g_config_wizard;
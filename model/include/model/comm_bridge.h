@@ -26,9 +26,12 @@
 #ifndef COMM_BRIDGE_H
 #define COMM_BRIDGE_H
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <wx/event.h>
 #include <wx/timer.h>
@@ -44,16 +47,34 @@ using NavMsgPtr = std::shared_ptr<const NavMsg>;
 
 using PriorityMap = std::unordered_map<std::string, int>;
 
+/**
+ * Priority identity of a message. Resolved once for each combination of
+ * source and message type, then reused for every message.
+ */
+struct PriorityKey {
+  std::string key;         ///< Priority map key, as stored in config
+  std::string source;      ///< Source part of key
+  std::string identifier;  ///< Message type part of key
+  int source_id;           ///< Interned source
+  int identifier_id;       ///< Interned identifier
+  int source_address;
+};
+
 struct PriorityContainer {
   std::string prio_class;
   int active_priority;
   std::string active_source;
   std::string active_identifier;
+  int active_source_id;      ///< Interned active_source, -1 if none
+  int active_identifier_id;  ///< Interned active_identifier, -1 if none
   int active_source_address;
+  /** Monotonic clock seconds when last accepted, -1 after timeout. */
   time_t recent_active_time;
   PriorityContainer(const std::string& cls, int prio = 0)
       : prio_class(cls),
         active_priority(prio),
+        active_source_id(-1),
+        active_identifier_id(-1),
         active_source_address(-1),
         recent_active_time(0) {}
 };
@@ -143,6 +164,27 @@ private:
   PriorityMap priority_map_variation;
   PriorityMap priority_map_satellites;
 
+  /** Resolved keys by compact (bus, source, address, type) tuple. */
+  std::unordered_map<uint64_t, PriorityKey> m_priority_keys;
+  /** Interned source and identifier strings. */
+  std::unordered_map<std::string, int> m_priority_ids;
+  /** A seen source address and its interned to_string(). */
+  struct PrioritySource {
+    NavAddr::Bus bus;
+    std::string iface;
+    int id;
+  };
+  /** Recently seen source addresses, few enough for a linear search. */
+  std::vector<PrioritySource> m_priority_sources;
+
+  /** Return priority identity for message, resolving it if new. */
+  const PriorityKey& GetPriorityKey(const NavMsgPtr& msg);
+  int InternPriorityId(const std::string& s);
+  void PresetPriorityContainer(PriorityContainer& pc,
+                               const PriorityMap& priority_map);
+  /** Update pipeline statistics for a message accepted by EvalPriority. */
+  void RecordAccepted(const NavMsgPtr& msg, const PriorityContainer& pc);
+
   //  comm event listeners
   ObsListener m_n2k_129029_lstnr;
   ObsListener m_n2k_129025_lstnr;
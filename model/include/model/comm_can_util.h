@@ -26,11 +26,11 @@
 #ifndef _COMMCANUTIL_H
 #define _COMMCANUTIL_H
 
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
 
-#include <wx/datetime.h>
-
 #if !defined(__WXMSW__) && !defined(__WXMAC__)
 #include <linux/can.h>
 #include <linux/can/raw.h>
@@ -75,18 +75,30 @@ public:
   int pgn;
 };
 
-/** Track fast message fragments eventually forming complete messages. */
+/**
+ * Track fast message fragments eventually forming complete messages.
+ * Entries are fixed slots, so reassembly does not allocate. Fragments are
+ * matched on source, destination, PGN and sequence id; when all slots are
+ * in use the least recently updated entry is dropped.
+ */
 class FastMessageMap {
 public:
+  /** Max number of messages assembled concurrently. */
+  static const int kMaxEntries = 64;
+
+  /** Max data length, 6 bytes in first frame and 7 in 31 more frames. */
+  static const unsigned kMaxDataLen = 223;
+
   class Entry {
   public:
     Entry()
-        : time_arrived(wxDateTime::Now()),
+        : time_arrived(0),
           sid(0),
           expected_length(0),
-          cursor(0) {}
+          cursor(0),
+          in_use(false) {}
 
-    wxDateTime time_arrived;  ///< time of last fragment.
+    int64_t time_arrived;  ///< Monotonic time of last fragment, ms.
 
     /// Can header, used to "map" the incoming fast message fragments
     CanHeader header;
@@ -97,40 +109,46 @@ public:
 
     unsigned int expected_length;  ///< total data length from first frame
     unsigned int cursor;  ///< cursor into the current position in data.
-    std::vector<unsigned char> data;  ///< Received data
+    bool in_use;          ///< Slot holds a message being assembled.
+
+    /// Received data, room for padding in last frame.
+    std::array<unsigned char, kMaxDataLen + 7> data;
   };
 
-  FastMessageMap() : dropped_frames(0), last_gc_run(wxDateTime::Now()) {}
+  FastMessageMap();
 
-  Entry operator[](int i) const { return entries[i]; }  /// Getter
-  Entry& operator[](int i) { return entries[i]; }       /// Setter
+  const Entry& operator[](int i) const { return entries[i]; }  /// Getter
+  Entry& operator[](int i) { return entries[i]; }              /// Setter
 
   /** Return index to entry matching header and sid or -1 if not found. */
-  int FindMatchingEntry(const CanHeader header, const unsigned char sid);
+  int FindMatchingEntry(const CanHeader& header, const unsigned char sid);
 
   /** Allocate a new, fresh entry and return index to it. */
   int AddNewEntry(void);
 
-  /** Insert a new entry, first part of a multipart message. */
-  bool InsertEntry(const CanHeader header, const unsigned char* data,
+  /**
+   * Insert a new entry, first part of a multipart message. The entry is
+   * removed if data is not a valid first frame.
+   */
+  bool InsertEntry(const CanHeader& header, const unsigned char* data,
                    int index);
 
   /** Append fragment to existing multipart message. */
-  bool AppendEntry(const CanHeader hdr, const unsigned char* data, int index);
+  bool AppendEntry(const CanHeader& hdr, const unsigned char* data, int index);
 
   /** Remove entry at pos. */
   void Remove(int pos);
 
-  std::vector<Entry> entries;
+  std::array<Entry, kMaxEntries> entries;
 
 private:
-  bool IsEntryExpired(unsigned int i);
-  int GarbageCollector(void);
-  void CheckGc();
+  bool IsEntryExpired(unsigned int i, int64_t now);
+  int GarbageCollector(int64_t now);
+  void CheckGc(int64_t now);
 
+  int in_use_count;
   int dropped_frames;
-  wxDateTime last_gc_run;
-  wxDateTime dropped_frame_time;
+  int64_t last_gc_run;
 };
 
 #endif  // guard
@@ -54,30 +54,26 @@ typedef struct {
 
 class CommDecoder {
 public:
-  CommDecoder() : m_NMEA0183(NmeaCtxFactory()) {};
+  CommDecoder() {};
   ~CommDecoder() {};
 
-  // NMEA0183 decoding, by sentence.
-  bool DecodeRMC(std::string s, NavData& temp_data);
-  bool DecodeHDM(std::string s, NavData& temp_data);
-  bool DecodeTHS(std::string s, NavData& temp_data);
-  bool DecodeHDT(std::string s, NavData& temp_data);
-  bool DecodeHDG(std::string s, NavData& temp_data);
-  bool DecodeVTG(std::string s, NavData& temp_data);
-  bool DecodeGSV(std::string s, NavData& temp_data);
-  bool DecodeGGA(std::string s, NavData& temp_data);
-  bool DecodeGLL(std::string s, NavData& temp_data);
+  // NMEA0183 decoding, by sentence. See nmea0183_parser.h
+  bool DecodeRMC(const std::string& s, NavData& temp_data);
+  bool DecodeHDM(const std::string& s, NavData& temp_data);
+  bool DecodeTHS(const std::string& s, NavData& temp_data);
+  bool DecodeHDT(const std::string& s, NavData& temp_data);
+  bool DecodeHDG(const std::string& s, NavData& temp_data);
+  bool DecodeVTG(const std::string& s, NavData& temp_data);
+  bool DecodeGSV(const std::string& s, NavData& temp_data);
+  bool DecodeGGA(const std::string& s, NavData& temp_data);
+  bool DecodeGLL(const std::string& s, NavData& temp_data);
 
-  bool ParsePosition(const LATLONG& Position, double& lat, double& lon);
-
-  NMEA0183 m_NMEA0183;  // Used to parse messages from NMEA threads
-
-  // NMEA2000 decoding, by PGN
-  bool DecodePGN129025(std::vector<unsigned char> v, NavData& temp_data);
-  bool DecodePGN129026(std::vector<unsigned char> v, NavData& temp_data);
-  bool DecodePGN129029(std::vector<unsigned char> v, NavData& temp_data);
-  bool DecodePGN127250(std::vector<unsigned char> v, NavData& temp_data);
-  bool DecodePGN129540(std::vector<unsigned char> v, NavData& temp_data);
+  // NMEA2000 decoding, by PGN. See Nmea2000Msg::GetN2kMsg()
+  bool DecodePGN129025(const tN2kMsg& msg, NavData& temp_data);
+  bool DecodePGN129026(const tN2kMsg& msg, NavData& temp_data);
+  bool DecodePGN129029(const tN2kMsg& msg, NavData& temp_data);
+  bool DecodePGN127250(const tN2kMsg& msg, NavData& temp_data);
+  bool DecodePGN129540(const tN2kMsg& msg, NavData& temp_data);
 
   // SignalK
   bool DecodeSignalK(std::string s, NavData& temp_data);
@@ -0,0 +1,92 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Replay driver for binary capture files, see navmsg_capture.h
+ */
+
+#ifndef _COMM_DRV_CAPTURE_H
+#define _COMM_DRV_CAPTURE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "model/comm_driver.h"
+#include "model/navmsg_capture.h"
+
+/**
+ * Replay a capture file to a listener in a separate thread, preserving
+ * the original message timing scaled by a speed factor or as fast as
+ * possible.
+ */
+class CaptureReplayDriver : public AbstractCommDriver {
+public:
+  /**
+   * @param path Capture file created by CaptureWriter.
+   * @param listener Receives the replayed messages.
+   * @param speed Replay speed relative to capture time, e.g. 10 for
+   *   10x. 0 replays as fast as possible.
+   */
+  CaptureReplayDriver(const std::string& path, DriverListener& listener,
+                      double speed = 1.0);
+
+  ~CaptureReplayDriver() override;
+
+  /**
+   * Open the file and start replay from first message with timestamp >=
+   * start_us (microseconds since epoch), or from the beginning if 0.
+   * @return false if the file cannot be opened, is not a capture file or
+   *   replay is running.
+   */
+  bool Start(uint64_t start_us = 0);
+
+  /** Stop a running replay and wait for the thread to exit. */
+  void Stop();
+
+  bool IsRunning() const { return m_running; }
+
+  /** Number of messages delivered to listener since Start(). */
+  uint64_t GetReplayed() const { return m_replayed; }
+
+  /** A replay source does not accept output. */
+  bool SendMessage(std::shared_ptr<const NavMsg> msg,
+                   std::shared_ptr<const NavAddr> addr) override {
+    return false;
+  }
+
+private:
+  void Worker();
+
+  const std::string m_path;
+  DriverListener& m_listener;
+  const double m_speed;
+  std::unique_ptr<CaptureReader> m_reader;  ///< Worker thread only
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_stop;
+  std::atomic<bool> m_running;
+  std::atomic<uint64_t> m_replayed;
+};
+
+#endif  // _COMM_DRV_CAPTURE_H
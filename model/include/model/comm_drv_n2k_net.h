@@ -170,7 +170,7 @@ private:
                                              int position,
                                              const can_frame frame);
 
-  void HandleCanFrameInput(can_frame frame);
+  void HandleCanFrameInput(const can_frame& frame);
 
   ConnectionType GetConnectionType() const { return m_connection_type; }
 
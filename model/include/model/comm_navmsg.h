@@ -39,6 +39,8 @@
 
 #include "observable.h"
 
+class tN2kMsg;
+
 using NavmsgClock = std::chrono::system_clock;
 using NavmsgTimePoint = std::chrono::time_point<NavmsgClock>;
 
@@ -282,15 +284,17 @@ public:
   Nmea2000Msg(const uint64_t _pgn, std::shared_ptr<const NavAddr2000> src)
       : NavMsg(NavAddr::Bus::N2000, src), PGN(_pgn) {}
 
-  Nmea2000Msg(const uint64_t _pgn, const std::vector<unsigned char>& _payload,
+  Nmea2000Msg(const uint64_t _pgn, std::vector<unsigned char> _payload,
               std::shared_ptr<const NavAddr2000> src)
-      : NavMsg(NavAddr::Bus::N2000, src), PGN(_pgn), payload(_payload) {}
+      : NavMsg(NavAddr::Bus::N2000, src),
+        PGN(_pgn),
+        payload(std::move(_payload)) {}
 
-  Nmea2000Msg(const uint64_t _pgn, const std::vector<unsigned char>& _payload,
+  Nmea2000Msg(const uint64_t _pgn, std::vector<unsigned char> _payload,
               std::shared_ptr<const NavAddr2000> src, int _priority)
       : NavMsg(NavAddr::Bus::N2000, src),
         PGN(_pgn),
-        payload(_payload),
+        payload(std::move(_payload)),
         priority(_priority) {}
 
   virtual ~Nmea2000Msg() = default;
@@ -304,9 +308,20 @@ public:
 
   std::string to_vdr() const override;
 
+  /**
+   * Return payload as a tN2kMsg for the N2kMessages ParseN2kPGN* functions.
+   * It is built on first use and then shared by all listeners, which thus
+   * avoid copying and unpacking the payload each. Invalid payloads yield
+   * a cleared message with DataLen 0.
+   */
+  const tN2kMsg& GetN2kMsg() const;
+
   N2kPGN PGN;  // For TX message, unparsed
   std::vector<unsigned char> payload;
   int priority;
+
+private:
+  mutable std::shared_ptr<const tN2kMsg> m_n2k_msg;
 };
 
 /** A regular Nmea0183 message. */
@@ -30,7 +30,7 @@ public:
     auto t1 = std::chrono::steady_clock::now();
     std::chrono::duration<double, std::micro> us_time = t1 - last_in;
     bps_in = 0.95 * bps_in + 0.05 * bytes * 1000000 / us_time.count();
-    mps_in = 0.95 * bps_in + 0.05 * 1000000 / us_time.count();
+    mps_in = 0.95 * mps_in + 0.05 * 1000000 / us_time.count();
     msgs_in++;
     bytes_in += bytes;
     last_in = t1;
@@ -43,9 +43,9 @@ public:
   void out(const size_t bytes,
            std::chrono::time_point<std::chrono::steady_clock> in_ts) {
     auto t1 = std::chrono::steady_clock::now();
-    std::chrono::duration<double, std::micro> us_time = t1 - last_in;
+    std::chrono::duration<double, std::micro> us_time = t1 - last_out;
     bps_out = 0.95 * bps_out + 0.05 * bytes * 1000000 / us_time.count();
-    mps_out = 0.95 * bps_out + 0.05 * 1000000 / us_time.count();
+    mps_out = 0.95 * mps_out + 0.05 * 1000000 / us_time.count();
     us_time = t1 - in_ts;
     in_out_delay_us = 0.95 * in_out_delay_us + 0.05 * us_time.count();
     msgs_out++;
@@ -691,7 +691,26 @@ extern "C" void MolodenskyTransform(double lat, double lon, double *to_lat,
 extern "C" void DistanceBearingMercator(double lat1, double lon1, double lat0,
                                         double lon0, double *brg, double *dist);
 
+/**
+ * Fits the polynomial coefficients between chart pixels and lat/lon.
+ *
+ * Solves cp->pwx, cp->pwy (pixel to lon/lat) and cp->wpx, cp->wpy (lon/lat to
+ * pixel) from the cp->count reference points, with a polynomial of cp->order.
+ * The solver keeps no state between calls, charts may be solved concurrently.
+ *
+ * @param cp Reference points and helper extents, receives the coefficients
+ * @param nlin_lon If not 0, force a linear fit for longitude
+ * @return 0 on success, 1 if any of the fits did not converge
+ */
 extern "C" int Georef_Calculate_Coefficients(struct GeoRef *cp, int nlin_lon);
+/**
+ * Fits linear coefficients between chart pixels and projected easting and
+ * northing, stored in cp->lon and cp->lat. Reentrant, like
+ * Georef_Calculate_Coefficients().
+ *
+ * @param cp Reference points and helper extents, receives the coefficients
+ * @return 0 on success, 1 if any of the fits did not converge
+ */
 extern "C" int Georef_Calculate_Coefficients_Proj(struct GeoRef *cp);
 /**
  * Calculates the latitude where a great circle route crosses a specified
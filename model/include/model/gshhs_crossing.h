@@ -0,0 +1,97 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Land crossing tests against a GSHHS polygon file (poly-?-1.dat).
+ *
+ * The file is memory mapped. Each 1 degree cell is split in 16 x 16
+ * sub-cells; the first time a cell is used, its coastline segments are
+ * sorted into a compact per sub-cell index (structure of arrays). A test
+ * visits only the sub-cells the segment passes through.
+ *
+ * All methods are thread safe: cell indexes are built without locks and
+ * published atomically, so concurrent tests never block each other.
+ */
+
+#ifndef GSHHS_CROSSING_H_
+#define GSHHS_CROSSING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "model/mapped_file.h"
+
+class GshhsCrossing {
+public:
+  /** A segment to test, coordinates in degrees. */
+  struct Segment {
+    double lat1;
+    double lon1;
+    double lat2;
+    double lon2;
+  };
+
+  /** Number of sub-cells along each side of a 1 degree cell. */
+  static const int kSubCells = 16;
+
+  /** Open polygon file at path. Use IsOk() to check the result. */
+  explicit GshhsCrossing(const std::string& path);
+  ~GshhsCrossing();
+
+  GshhsCrossing(const GshhsCrossing&) = delete;
+  GshhsCrossing& operator=(const GshhsCrossing&) = delete;
+
+  /** Return true if the polygon file is mapped and valid. */
+  bool IsOk() const { return m_file.IsOk(); }
+
+  /** Return file format version, 0 if not ok. */
+  int GetVersion() const;
+
+  /**
+   * Return true if the segment crosses a coastline, taking the shortest
+   * way around the world. Longitudes may be given in [-180, 360).
+   */
+  bool CrossesLand(double lat1, double lon1, double lat2, double lon2) const;
+
+  /**
+   * Test all segments, splitting the work across threads.
+   * @param crosses Set to one item per segment, non-zero if crossing land.
+   * @param threads Number of threads, 0 for one per hardware thread.
+   */
+  void CrossesLand(const std::vector<Segment>& segments,
+                   std::vector<char>& crosses, unsigned threads = 0) const;
+
+private:
+  struct Cell;
+
+  /** Return index for cell at lon [0, 360), lat [-90, 90), built on use. */
+  const Cell& GetCell(int lon, int lat) const;
+  Cell* BuildCell(int lon, int lat) const;
+
+  /** Test segment in degrees, already on the short way, see CrossesLand(). */
+  bool CrossesGrid(double x1, double y1, double x2, double y2) const;
+
+  MappedFile m_file;
+  std::unique_ptr<std::atomic<Cell*>[]> m_cells;
+};
+
+#endif  // GSHHS_CROSSING_H_
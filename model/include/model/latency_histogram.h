@@ -0,0 +1,66 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Fixed size, lock free histogram of latencies.
+ */
+
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Log-linear (HDR style) histogram of latencies in nanoseconds. Each power
+ * of two is split into 8 sub-buckets, giving a relative error below 12.5%
+ * in a fixed size table. Recording is two relaxed atomic increments; the
+ * count is summed from the buckets when reporting.
+ */
+class LatencyHistogram {
+public:
+  static constexpr int kSubBits = 3;
+  static constexpr int kMaxExp = 40;  ///< 2^40 ns, about 18 minutes
+  static constexpr int kBuckets = (kMaxExp - kSubBits + 1) << kSubBits;
+
+  LatencyHistogram() { Reset(); }
+
+  void Record(uint64_t ns);
+
+  /** Approximate latency at quantile q, 0 <= q <= 1, 0 if empty. */
+  uint64_t Percentile(double q) const;
+
+  uint64_t GetCount() const;
+  uint64_t GetMax() const { return m_max.load(std::memory_order_relaxed); }
+  uint64_t GetMean() const;
+
+  void Reset();
+
+  static int BucketIndex(uint64_t ns);
+
+  /** Smallest value mapped to bucket index. */
+  static uint64_t BucketLow(int index);
+
+private:
+  std::atomic<uint64_t> m_buckets[kBuckets];
+  std::atomic<uint64_t> m_sum;
+  std::atomic<uint64_t> m_max;
+};
+
+#endif  // LATENCY_HISTOGRAM_H_
@@ -0,0 +1,86 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Projection of lat/lon point arrays to pixels.
+ */
+
+#ifndef LL_PROJECTOR_H_
+#define LL_PROJECTOR_H_
+
+#include <cstddef>
+
+/**
+ * Projects arrays of points with the same result as
+ * ViewPort::GetDoublePixFromLL(), using the georef.h projection functions.
+ * Everything depending only on the view, like the trigonometry of the
+ * projection center and of the rotation, is computed once per projector
+ * instead of once per point.
+ */
+class LLProjector {
+public:
+  enum class Type {
+    kMercator,
+    kTransverseMercator,
+    kPolyconic,
+    kOrthographic,
+    kPolar,
+    kStereographic,
+    kGnomonic,
+    kEquirectangular
+  };
+
+  /** Projection of type centered at clat, clon, in meters. */
+  LLProjector(Type type, double clat, double clon);
+
+  /**
+   * Map projected meters to pixels: scale by ppm, rotate by rotation
+   * radians, offset to x0, y0 with y down, then multiply by scale.
+   */
+  void SetTransform(double ppm, double rotation, double x0, double y0,
+                    double scale);
+
+  /**
+   * Project n points, storing x, y pairs in out. Point i is at lat[i *
+   * stride], lon[i * stride]. Points which cannot be projected, like the
+   * far side of the earth in orthographic projection, are not finite.
+   */
+  void Project(const double* lat, const double* lon, size_t n, float* out,
+               size_t stride = 1) const;
+  void Project(const float* lat, const float* lon, size_t n, float* out,
+               size_t stride = 1) const;
+
+private:
+  template <typename T>
+  void ProjectPoints(const T* lat, const T* lon, size_t n, float* out,
+                     size_t stride) const;
+
+  Type m_type;
+  double m_clat;
+  double m_clon;
+  double m_cache0;
+  double m_cache1;
+  double m_center_easting;
+  double m_center_northing;
+  //  x = m_xe * easting + m_xn * northing + m_x0, same for y
+  double m_xe, m_xn, m_x0;
+  double m_ye, m_yn, m_y0;
+};
+
+#endif  // LL_PROJECTOR_H_
@@ -0,0 +1,127 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Bounded history of Data Monitor log lines.
+ *
+ * Lines are stored unformatted in a ring buffer and the oldest ones are
+ * overwritten when full. An index of the lines passing the current filter
+ * is updated incrementally with new lines. When the filter changes, the
+ * retained history is rescanned, optionally in a worker thread so a large
+ * history does not block the GUI.
+ */
+
+#ifndef LOGLINE_BUFFER_H_
+#define LOGLINE_BUFFER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "model/nmea_log.h"
+
+class LoglineBuffer {
+public:
+  using LinePtr = std::shared_ptr<const Logline>;
+
+  /** Return true if line should be visible. */
+  using Filter = std::function<bool(const Logline&)>;
+
+  /**
+   * @param capacity Max number of retained lines.
+   * @param background If true, rescan history in a worker thread.
+   */
+  explicit LoglineBuffer(size_t capacity, bool background = true);
+  ~LoglineBuffer();
+
+  LoglineBuffer(const LoglineBuffer&) = delete;
+  LoglineBuffer& operator=(const LoglineBuffer&) = delete;
+
+  /**
+   * Add line, possibly overwriting the oldest one. Not filtered until
+   * next Update(). Like all methods, must be called from the same thread,
+   * normally the GUI thread.
+   */
+  void Add(const Logline& line);
+
+  /** Remove all lines. */
+  void Clear();
+
+  size_t GetCapacity() const { return m_capacity; }
+
+  /** Number of retained lines. */
+  size_t Size() const { return m_lines.size(); }
+
+  /** Set filter and rebuild the index of matching lines. */
+  void SetFilter(Filter filter);
+
+  /**
+   * Filter lines added since last call and merge results of a completed
+   * rescan. Cost is proportional to the number of new lines.
+   * @return true if the index changed.
+   */
+  bool Update();
+
+  /** Return true while a history rescan is not yet merged by Update(). */
+  bool IsScanning() const { return m_worker.joinable(); }
+
+  /** Number of retained lines passing the filter. */
+  size_t GetMatchCount() const { return m_matches.size(); }
+
+  /** Return i-th matching line, 0 is the oldest. */
+  LinePtr GetMatch(size_t i) const;
+
+private:
+  uint64_t Tail() const {
+    return m_head > m_capacity ? m_head - m_capacity : 0;
+  }
+
+  /** Worker thread: index lines [from, to) passing filter. */
+  void Scan(uint64_t from, uint64_t to, Filter filter);
+
+  /** Cancel running rescan, if any, and wait for it. */
+  void StopScan();
+
+  const size_t m_capacity;
+  const bool m_background;
+
+  /**
+   * Serializes writes of m_lines and m_head with worker reads. Reads on
+   * the owner thread need no lock since it is the only writer.
+   */
+  std::mutex m_mutex;
+  std::vector<LinePtr> m_lines;  ///< Ring buffer, indexed by seq % capacity
+  uint64_t m_head;               ///< Sequence number of next line
+
+  Filter m_filter;
+  std::deque<uint64_t> m_matches;  ///< Sequence numbers, oldest first
+  uint64_t m_scanned;              ///< Next line to be indexed by Update()
+
+  std::thread m_worker;
+  std::atomic<bool> m_cancel;
+  std::atomic<bool> m_scan_done;
+  std::vector<uint64_t> m_scan_result;  ///< Owned by worker until done
+};
+
+#endif  // LOGLINE_BUFFER_H_
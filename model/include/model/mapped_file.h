@@ -0,0 +1,74 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Memory mapping of a whole file, read only or copy on write.
+ */
+
+#ifndef MAPPED_FILE_H_
+#define MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+  MappedFile();
+  /** Map file at path. Use IsOk() to check the result. */
+  explicit MappedFile(const std::string& path, bool copy_on_write = false);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /**
+   * Map file at path, replacing any current mapping. Empty files cannot
+   * be mapped. The file may still be written by others: writes inside the
+   * mapped size are seen once flushed, data appended needs a new Open().
+   * @param copy_on_write If true, the mapping is writable. Written pages
+   *        become private copies and the file itself is never changed.
+   * @return true if mapped.
+   */
+  bool Open(const std::string& path, bool copy_on_write = false);
+
+  /** Release the mapping, if any. */
+  void Close();
+
+  bool IsOk() const { return m_data != nullptr; }
+
+  /** Return the file contents, nullptr if not mapped. */
+  const unsigned char* GetData() const { return m_data; }
+  size_t GetSize() const { return m_size; }
+
+  /** Return the writable contents, nullptr unless mapped copy on write. */
+  unsigned char* GetWritableData() const {
+    return m_writable ? const_cast<unsigned char*>(m_data) : nullptr;
+  }
+
+private:
+  const unsigned char* m_data;
+  size_t m_size;
+  bool m_writable;
+#ifdef _WIN32
+  void* m_file;
+  void* m_mapping;
+#endif
+};
+
+#endif  // MAPPED_FILE_H_
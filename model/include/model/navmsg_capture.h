@@ -0,0 +1,180 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Compact, indexed binary capture of raw navigation messages.
+ *
+ * A capture file is a fixed header followed by variable size records,
+ * each holding the original wall clock time, bus, interface and raw
+ * payload of one message. A cleanly closed file ends with a time index
+ * and a trailer pointing to it, allowing fast seeks in multi-day
+ * captures. Files lacking the index, e.g. after a crash, are still
+ * readable; the index is then rebuilt by a sequential scan.
+ *
+ * Records are in arrival order. Their times, from NavMsg::created_at,
+ * may go back when messages from several drivers interleave or the wall
+ * clock is stepped.
+ *
+ * All integers are stored little-endian.
+ */
+
+#ifndef NAVMSG_CAPTURE_H_
+#define NAVMSG_CAPTURE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "model/comm_navmsg.h"
+
+/** One captured message. */
+struct CaptureRecord {
+  /** Wall clock time when received, microseconds since the epoch. */
+  uint64_t timestamp_us;
+  NavAddr::Bus bus;
+  /** Source interface, as in NavAddr::iface */
+  std::string iface;
+  /**
+   * Message id: talker + type for N0183, PGN for N2000, context_self
+   * for SignalK.
+   */
+  std::string id;
+  /** Source NAME for N2000, else 0 */
+  uint64_t source_name;
+  /** Raw message: sentence, N2000 payload or SignalK json. */
+  std::vector<uint8_t> payload;
+
+  CaptureRecord() : timestamp_us(0), bus(NavAddr::Bus::Undef), source_name(0) {}
+
+  /** Build record from message, stamped with its creation time. */
+  static CaptureRecord FromNavMsg(const NavMsg& msg);
+
+  /** Recreate the message, or nullptr if bus is not supported. */
+  std::shared_ptr<const NavMsg> ToNavMsg() const;
+};
+
+/**
+ * Write capture files. Add() only queues the record; a worker thread
+ * does the formatting and file I/O so that callers on the bus are never
+ * blocked by the disk.
+ */
+class CaptureWriter {
+public:
+  CaptureWriter();
+  ~CaptureWriter();
+
+  /** Create or truncate path and start the writer thread. */
+  bool Open(const std::string& path);
+
+  /** Flush queued records, write index and trailer, close file. */
+  void Close();
+
+  bool IsOpen() const { return m_open; }
+
+  /** Queue message for writing. Never blocks on I/O. */
+  void Add(const NavMsg& msg);
+
+  /** Queue a prepared record for writing, ignored unless open. */
+  void Add(CaptureRecord record);
+
+  /** Number of records dropped because the queue was full. */
+  uint64_t GetDropped() const { return m_dropped; }
+
+private:
+  struct IndexEntry {
+    uint64_t timestamp_us;
+    uint64_t offset;
+  };
+
+  void Worker();
+  void WriteRecord(const CaptureRecord& record);
+
+  std::ofstream m_stream;
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<CaptureRecord> m_queue;
+  bool m_stop;
+  /** Set while the writer thread runs, read by Add() on any thread. */
+  std::atomic<bool> m_open;
+  std::atomic<uint64_t> m_dropped;
+
+  // Worker thread only
+  std::vector<IndexEntry> m_index;
+  uint64_t m_offset;
+  uint64_t m_records;
+  uint64_t m_last_indexed_us;
+  uint64_t m_last_us;  ///< Latest record time so far
+};
+
+/** Read capture files, sequentially or from a seek position. */
+class CaptureReader {
+public:
+  CaptureReader() : m_data_end(0), m_records(0), m_end_us(0) {}
+
+  /**
+   * Open an existing capture file and load or rebuild its index.
+   * @return false if file cannot be opened or is not a capture file.
+   */
+  bool Open(const std::string& path);
+
+  /**
+   * Retrieve next record.
+   * @return false at end of file or on a truncated record.
+   */
+  bool Next(CaptureRecord& record);
+
+  /**
+   * Position at the first record, in file order, with timestamp >= given
+   * time.
+   */
+  bool Seek(uint64_t timestamp_us);
+
+  /** Timestamp of first record, 0 if empty. */
+  uint64_t GetStartTime() const;
+
+  /** Latest record timestamp, 0 if empty. */
+  uint64_t GetEndTime() const;
+
+  uint64_t GetRecordCount() const { return m_records; }
+
+private:
+  struct IndexEntry {
+    uint64_t timestamp_us;
+    uint64_t offset;
+  };
+
+  bool LoadIndex();
+  void RebuildIndex();
+
+  std::ifstream m_stream;
+  std::vector<IndexEntry> m_index;
+  uint64_t m_data_end;
+  uint64_t m_records;
+  uint64_t m_end_us;
+};
+
+#endif  // NAVMSG_CAPTURE_H_
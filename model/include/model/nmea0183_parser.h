@@ -0,0 +1,258 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Allocation free NMEA 0183 parser.
+ *
+ * N0183Sentence splits a raw sentence into std::string_view fields
+ * referring to the original buffer, which must outlive it. The typed
+ * decoders convert the fields of the common sentences into plain structs
+ * with NAN for missing values. Nothing here allocates, and each sentence
+ * is tokenized once regardless of how many values are decoded from it.
+ *
+ * This is the core's parser for the hot paths; libs/nmea0183 remains
+ * available for sentence types not handled here and for plugins.
+ */
+
+#ifndef NMEA0183_PARSER_H_
+#define NMEA0183_PARSER_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/** Sentence types known by the typed decoders. */
+enum class N0183Id {
+  kUnknown,
+  kProprietary,
+  kApb,
+  kDbt,
+  kDpt,
+  kGga,
+  kGll,
+  kGsv,
+  kHdg,
+  kHdm,
+  kHdt,
+  kMwv,
+  kRmb,
+  kRmc,
+  kThs,
+  kVtg,
+  kXdr
+};
+
+/**
+ * Map a three letter sentence type like "RMC" to its id. The letters are
+ * packed into a 24 bit integer, a collision free hash for all possible ids
+ * which the compiler turns into a jump table or binary search.
+ */
+N0183Id N0183IdFromType(std::string_view type);
+
+/** A tokenized sentence. Fields are views into the parsed buffer. */
+class N0183Sentence {
+public:
+  static constexpr size_t kMaxFields = 64;
+
+  N0183Sentence() : m_id(N0183Id::kUnknown), m_size(0) {}
+
+  /**
+   * Tokenize a sentence starting with '$' or '!', optionally preceded by
+   * a NMEA 4 tag block and followed by *hh checksum and line endings.
+   * @return false if malformed or the checksum is present and bad.
+   */
+  bool Parse(std::string_view raw);
+
+  N0183Id GetId() const { return m_id; }
+
+  /** Two character talker id, empty for proprietary sentences. */
+  std::string_view GetTalker() const { return m_talker; }
+
+  /** Sentence type, e.g. "RMC", or complete address if proprietary. */
+  std::string_view GetType() const { return m_type; }
+
+  /** Number of data fields, excluding the address field. */
+  size_t Size() const { return m_size > 0 ? m_size - 1 : 0; }
+
+  /** Data field i, 1-based as in the standard. Empty if missing. */
+  std::string_view Field(size_t i) const {
+    return i < m_size ? m_fields[i] : std::string_view();
+  }
+
+  /** Field i as a double, NAN if missing or not numeric. */
+  double Double(size_t i) const;
+
+  /** Field i as an int, 0 if missing or not numeric. */
+  int Integer(size_t i) const;
+
+  /** First character of field i, '\0' if missing. */
+  char Char(size_t i) const {
+    auto f = Field(i);
+    return f.empty() ? '\0' : f[0];
+  }
+
+  /**
+   * Latitude or longitude in degrees from a ddmm.mmm field and its
+   * N/S/E/W hemisphere field, NAN if missing.
+   */
+  double Coordinate(size_t value_field, size_t hemisphere_field) const;
+
+private:
+  N0183Id m_id;
+  std::string_view m_talker;
+  std::string_view m_type;
+  std::array<std::string_view, kMaxFields> m_fields;
+  size_t m_size;
+};
+
+/** RMC: Recommended minimum GNSS data. */
+struct N0183Rmc {
+  std::string_view utc_time;
+  std::string_view date;
+  bool is_valid;  ///< Status 'A' and mode not 'N' or 'S'
+  double lat;
+  double lon;
+  double sog;  ///< knots
+  double cog;  ///< degrees true
+  double variation;  ///< degrees, east positive
+};
+
+/** GGA: GNSS fix data. */
+struct N0183Gga {
+  std::string_view utc_time;
+  double lat;
+  double lon;
+  int quality;
+  int n_satellites;
+  double hdop;
+  double altitude;
+};
+
+/** GLL: Geographic position. */
+struct N0183Gll {
+  double lat;
+  double lon;
+  bool is_valid;
+};
+
+/** GSV: Satellites in view, only the header fields. */
+struct N0183Gsv {
+  int n_messages;
+  int message_number;
+  int n_satellites;
+};
+
+/** VTG: Course and speed over ground. */
+struct N0183Vtg {
+  double cog_true;
+  double cog_magnetic;
+  double sog_knots;
+  double sog_kmh;
+};
+
+/** HDG: Heading, deviation and variation. */
+struct N0183Hdg {
+  double heading_magnetic;
+  double deviation;  ///< degrees, east positive
+  double variation;  ///< degrees, east positive
+};
+
+/** HDT, HDM and THS: Heading. */
+struct N0183Heading {
+  double heading;
+  char mode;  ///< THS mode indicator, 'A' for HDT/HDM
+};
+
+/** MWV: Wind speed and angle. */
+struct N0183Mwv {
+  double angle;
+  char reference;  ///< 'R' relative or 'T' true
+  double speed;
+  char speed_unit;  ///< 'K', 'M' or 'N'
+  bool is_valid;
+};
+
+/** DBT: Depth below transducer. DPT: Depth. */
+struct N0183Depth {
+  double depth_m;
+  double offset_m;  ///< DPT transducer offset, NAN for DBT
+};
+
+/** XDR: Transducer measurements, at most kMaxMeasurements. */
+struct N0183Xdr {
+  static constexpr int kMaxMeasurements = 8;
+  struct Measurement {
+    char type;
+    double value;
+    char unit;
+    std::string_view name;
+  };
+  int count;
+  Measurement measurements[kMaxMeasurements];
+};
+
+/** APB: Autopilot sentence "B". */
+struct N0183Apb {
+  double xte;
+  char steer;  ///< 'L' or 'R'
+  char xte_unit;
+  bool arrival_circle;
+  bool perpendicular_passed;
+  double bearing_origin_to_dest;
+  char bearing_origin_ref;  ///< 'M' or 'T'
+  std::string_view dest_id;
+  double bearing_present_to_dest;
+  char bearing_present_ref;
+  double heading_to_steer;
+  char heading_to_steer_ref;
+};
+
+/** RMB: Recommended minimum navigation information. */
+struct N0183Rmb {
+  bool is_valid;
+  double xte;  ///< nautical miles
+  char steer;
+  std::string_view origin_id;
+  std::string_view dest_id;
+  double dest_lat;
+  double dest_lon;
+  double range;  ///< nautical miles
+  double bearing;  ///< degrees true
+  double closing_speed;  ///< knots
+  bool arrived;
+};
+
+/**
+ * Typed decoders. Return false if the sentence is of another type or
+ * lacks mandatory fields; the struct is then undefined.
+ */
+bool DecodeN0183(const N0183Sentence& s, N0183Rmc& rmc);
+bool DecodeN0183(const N0183Sentence& s, N0183Gga& gga);
+bool DecodeN0183(const N0183Sentence& s, N0183Gll& gll);
+bool DecodeN0183(const N0183Sentence& s, N0183Gsv& gsv);
+bool DecodeN0183(const N0183Sentence& s, N0183Vtg& vtg);
+bool DecodeN0183(const N0183Sentence& s, N0183Hdg& hdg);
+bool DecodeN0183(const N0183Sentence& s, N0183Heading& heading);
+bool DecodeN0183(const N0183Sentence& s, N0183Mwv& mwv);
+bool DecodeN0183(const N0183Sentence& s, N0183Depth& depth);
+bool DecodeN0183(const N0183Sentence& s, N0183Xdr& xdr);
+bool DecodeN0183(const N0183Sentence& s, N0183Apb& apb);
+bool DecodeN0183(const N0183Sentence& s, N0183Rmb& rmb);
+
+#endif  // NMEA0183_PARSER_H_
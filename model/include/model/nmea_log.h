@@ -34,17 +34,13 @@
 struct Logline {
   const std::shared_ptr<const NavMsg> navmsg;
   const NavmsgStatus state;
-  const std::string message;
   std::string error_msg;
   std::string prefix;
 
   Logline() = default;
 
   Logline(const std::shared_ptr<const NavMsg>& navmsg, NavmsgStatus sts)
-      : navmsg(navmsg),
-        state(sts),
-        message(navmsg ? navmsg->to_string() : ""),
-        error_msg("Unknown error") {}
+      : navmsg(navmsg), state(sts), error_msg("Unknown error") {}
 
   explicit Logline(const std::shared_ptr<const NavMsg>& navmsg)
       : Logline(navmsg, [navmsg] {
@@ -59,6 +55,12 @@ struct Logline {
             navmsg_status.accepted = NavmsgStatus::Accepted::kFilteredDropped;
           return navmsg_status;
         }()) {}
+
+  /**
+   * Return the formatted message. Not cached, formatting is deferred
+   * until the line is actually displayed or logged.
+   */
+  std::string GetText() const { return navmsg ? navmsg->to_string() : ""; }
 };
 
 /**
@@ -0,0 +1,147 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Latency and throughput statistics for the navigation data pipeline.
+ *
+ * Each message carries the time it was created by the receiving driver
+ * (NavMsg::created_at). When a message passes a pipeline stage, the time
+ * elapsed since then is recorded in a histogram for the stage, both
+ * globally and for the source driver. Recording is lock free and cheap
+ * enough for every message; the report is available as json from the
+ * REST server and opencpn-cmd.
+ */
+
+#ifndef PIPELINE_STATS_H_
+#define PIPELINE_STATS_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "model/comm_navmsg.h"
+#include "model/latency_histogram.h"
+
+/** Points in the pipeline where messages are timestamped. */
+enum class PipelineStage {
+  kBusNotify,       ///< NavMsgBus::Notify()
+  kBridgeAccept,    ///< Accepted by CommBridge priority arbitration
+  kAisDecode,       ///< AIS sentence decoded
+  kPluginDispatch,  ///< Forwarded to plugins
+  kCanvasRefresh,   ///< Accepted position fix drawn on chart canvas
+  kCount
+};
+
+/** Execution times of chart display operations, reported with the stages. */
+enum class PipelineTiming {
+  kQuiltPan,       ///< Quilt::Compose() after a pan
+  kQuiltZoom,      ///< Quilt::Compose() after a scale or rotation change
+  kQuiltChartSet,  ///< Quilt::Compose() after a chart set change
+  kCount
+};
+
+/** Latency and throughput of one stage. */
+struct StageStats {
+  LatencyHistogram latency;
+  std::atomic<int64_t> first_ns;  ///< System clock time of first record
+  std::atomic<int64_t> last_ns;   ///< System clock time of last record
+
+  StageStats() : first_ns(0), last_ns(0) {}
+  void Record(int64_t now_ns, uint64_t latency_ns);
+  /** Messages per second between first and last record. */
+  double GetRate() const;
+  void Reset();
+};
+
+/** Process-wide pipeline statistics singleton. */
+class PipelineStats {
+public:
+  static constexpr int kMaxDrivers = 32;
+
+  static PipelineStats& GetInstance();
+
+  PipelineStats(const PipelineStats&) = delete;
+  PipelineStats& operator=(const PipelineStats&) = delete;
+
+  /** Record msg passing stage, latency counted from msg.created_at. */
+  void Record(PipelineStage stage, const NavMsg& msg);
+
+  /**
+   * Note that msg updated the position. The next RecordCanvasRefresh()
+   * records its latency as kCanvasRefresh.
+   */
+  void MarkFix(const NavMsg& msg);
+
+  /** Chart canvas redrawn, record age of pending fix if any. */
+  void RecordCanvasRefresh();
+
+  /** Record execution time ns of a timed operation. */
+  void RecordTiming(PipelineTiming timing, uint64_t ns) {
+    m_timings[static_cast<int>(timing)].Record(ns);
+  }
+  const LatencyHistogram& GetTiming(PipelineTiming timing) const {
+    return m_timings[static_cast<int>(timing)];
+  }
+
+  /** Return statistics for stage, globally or for driver iface. */
+  const StageStats& GetStage(PipelineStage stage) const {
+    return m_global[static_cast<int>(stage)];
+  }
+  const StageStats* GetStage(PipelineStage stage,
+                             const std::string& iface) const;
+
+  /**
+   * Report all non-empty stages and timings as json, latencies in
+   * microseconds.
+   */
+  std::string ToJson() const;
+
+  void Reset();
+
+  static const char* StageName(PipelineStage stage);
+  static const char* TimingName(PipelineTiming timing);
+
+private:
+  struct Driver {
+    /** Hash of iface, 0 if unused. Published after iface is set. */
+    std::atomic<size_t> hash;
+    std::string iface;
+    StageStats stages[static_cast<int>(PipelineStage::kCount)];
+    Driver() : hash(0) {}
+  };
+
+  PipelineStats();
+
+  /** Return index of iface slot, or -1 if not found. */
+  int FindDriver(const std::string& iface, size_t hash) const;
+
+  /** Return index of iface slot, claiming a free one if needed, or -1. */
+  int ClaimDriver(const std::string& iface);
+
+  StageStats m_global[static_cast<int>(PipelineStage::kCount)];
+  LatencyHistogram m_timings[static_cast<int>(PipelineTiming::kCount)];
+  Driver m_drivers[kMaxDrivers];
+  std::mutex m_drivers_mutex;  ///< Serializes claiming Driver slots
+  std::atomic<int64_t> m_pending_fix_ns;   ///< created_at of fix, 0 if none
+  std::atomic<int> m_pending_fix_driver;  ///< m_drivers index or -1
+};
+
+#endif  // PIPELINE_STATS_H_
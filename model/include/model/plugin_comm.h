@@ -25,12 +25,65 @@
 #ifndef PLUGIN__COMM_H
 #define PLUGIN__COMM_H
 
+#include <functional>
+#include <memory>
+#include <vector>
+
 #include <wx/event.h>
 #include <wx/jsonval.h>
 #include <wx/string.h>
 
 #include "model/ocpn_types.h"
 
+class ArrayOfPlugIns;
+class opencpn_plugin;
+class opencpn_plugin_18;
+class opencpn_plugin_112;
+class opencpn_plugin_113;
+class opencpn_plugin_117;
+class opencpn_plugin_119;
+
+/**
+ * Per capability lists of subscribing plugins with their interfaces
+ * resolved to the applicable API version. Built from the enabled and
+ * initialized plugins so that sending a message does not need to scan
+ * and cast the complete plugin array. Tables are immutable; a new one
+ * is built when PluginLoader reports that the plugin set has changed.
+ */
+class PluginDispatchTable {
+public:
+  /** Build tables from the active plugins in given array. */
+  explicit PluginDispatchTable(const ArrayOfPlugIns& plugins);
+
+  /**
+   * Return table for the current PluginLoader plugin set, rebuilt if
+   * the set has changed since last call. Main thread only.
+   */
+  static std::shared_ptr<const PluginDispatchTable> GetCurrent();
+
+  /**
+   * Send count sentences to all WANTS_NMEA_SENTENCES plugins. The SIGSEGV
+   * guard is installed once for the whole batch; a faulting plugin drops
+   * the remainder of it.
+   */
+  void SendNmeaSentences(const wxString* sentences, size_t count) const;
+
+  std::vector<opencpn_plugin*> nmea_sentences;
+  std::vector<opencpn_plugin*> ais_sentences;
+  std::vector<opencpn_plugin*> position_fix;
+  std::vector<opencpn_plugin_18*> position_fix_ex;
+  std::vector<opencpn_plugin_117*> active_leg;
+  std::vector<std::function<void(wxString&, wxString&)>> plugin_messages;
+  std::vector<opencpn_plugin_112*> mouse_events;
+  std::vector<opencpn_plugin_113*> keyboard_events;
+  std::vector<opencpn_plugin_119*> preshutdown_hook;
+  std::vector<opencpn_plugin*> cursor_latlon;
+  std::vector<opencpn_plugin_112*> chart_object_info;
+
+  /** Plugins with WANTS_PLUGIN_MESSAGING, regardless of API version. */
+  int json_message_targets;
+};
+
 void SendMessageToAllPlugins(const wxString& message_id,
                              const wxString& message_body);
 
@@ -69,6 +122,13 @@ void SendCursorLatLonToAllPlugIns(double lat, double lon);
  */
 void SendNMEASentenceToAllPlugIns(const wxString& sentence);
 
+/**
+ * Distribute a batch of NMEA 0183 sentences like
+ * SendNMEASentenceToAllPlugIns(), setting up the plugin fault handling
+ * once for the complete batch.
+ */
+void SendNMEASentencesToAllPlugIns(const std::vector<wxString>& sentences);
+
 int GetJSONMessageTargetCount();
 
 void SendVectorChartObjectInfo(const wxString& chart, const wxString& feature,
@@ -272,6 +272,13 @@ public:
   /** Return list of currently loaded plugins. */
   const ArrayOfPlugIns* GetPlugInArray() { return &plugin_array; }
 
+  /**
+   * Return counter bumped each time a plugin is added, removed, reordered,
+   * enabled, disabled, activated or deactivated. Used by the message
+   * dispatch code to detect when its subscriber tables are stale.
+   */
+  unsigned GetPluginGeneration() const { return m_plugin_generation; }
+
   /** Return true if a plugin with given name exists in GetPlugInArray() */
   bool IsPlugInAvailable(const wxString& commonName);
 
@@ -310,6 +317,7 @@ private:
   std::function<void(const PlugInContainer*)> m_on_deactivate_cb;
 
   std::vector<LoadError> load_errors;
+  unsigned m_plugin_generation;
 };
 
 #endif  // PLUGIN_LOADER_H_GUARD
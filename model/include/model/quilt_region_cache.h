@@ -0,0 +1,119 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Quilt patch regions kept across quilt compositions.
+ */
+
+#ifndef QUILT_REGION_CACHE_H_
+#define QUILT_REGION_CACHE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "LLRegion.h"
+
+/**
+ * Regions of the quilt patches in the last composition, before clipping to
+ * the viewport. The region of a patch less the larger scale patches only
+ * depends on that patch and the ones before it, so it is reused while the
+ * patch list, largest scale first, starts the same way. A pan then costs
+ * one intersection per patch instead of subtract, union and intersect.
+ */
+class QuiltRegionCache {
+public:
+  /** A quilt patch, as seen by the cache. */
+  struct Patch {
+    int db_index;
+    unsigned generation;  ///< Chart database generation of db_index
+    const void* entry;    ///< Chart table entry, identity only
+    int scale;
+    int proj;
+    bool used;     ///< Valid, and not handled ahead as cm93 reference
+    bool overlay;  ///< Not counted in the quilt coverage
+    const LLRegion* region;  ///< Full region of the patch
+  };
+
+  QuiltRegionCache()
+      : m_subtract(false),
+        m_base_index(-1),
+        m_reuse(false),
+        m_n_cached(0),
+        m_next(0),
+        m_reused(0),
+        m_covered(nullptr),
+        m_reused_covered(nullptr) {}
+
+  /**
+   * Start a composition.
+   * @param subtract Subtract the larger scale patches from each patch.
+   * @param base_index dbIndex of a patch handled ahead of the list, or -1.
+   * @param covered Quilt coverage ahead of the patches, updated as the
+   *   patches are added.
+   */
+  void Begin(bool subtract, int base_index, LLRegion* covered);
+
+  /**
+   * Add the next patch, largest scale first.
+   * @return Patch region less the larger scale ones when subtracting, the
+   *   full patch region otherwise; null if the patch is not used.
+   */
+  const LLRegion* Add(const Patch& patch);
+
+  /** End a composition, once all patches are added. */
+  void End();
+
+  /** Drop all kept regions, when the charts or their regions change. */
+  void Clear();
+
+  /** Number of leading patches reused in the last composition. */
+  size_t GetReusedCount() const { return m_reused; }
+
+private:
+  struct Entry {
+    Patch patch;
+    LLRegion exclusive;  ///< Patch region less the larger scale patches
+    LLRegion covered;    ///< Quilt coverage down to this patch, if subtracting
+
+    bool Matches(const Patch& other) const {
+      return patch.db_index == other.db_index &&
+             patch.generation == other.generation &&
+             patch.entry == other.entry && patch.scale == other.scale &&
+             patch.proj == other.proj && patch.used == other.used;
+    }
+  };
+
+  /** Bring the coverage up to date with the first n reused patches. */
+  void RestoreCovered(size_t n);
+
+  std::vector<Entry> m_entries;  ///< Largest scale first
+  /** Coverage of all the patches, when not subtracting. */
+  LLRegion m_all_covered;
+  bool m_subtract;
+  int m_base_index;
+
+  bool m_reuse;
+  size_t m_n_cached;
+  size_t m_next;
+  size_t m_reused;
+  LLRegion* m_covered;
+  const LLRegion* m_reused_covered;
+};
+
+#endif  // QUILT_REGION_CACHE_H_
@@ -171,6 +171,19 @@ public:
  *    - Returns (example):
  *        {"version": "5.8.9" }
  *
+ *  GET /api/pipeline-stats  <br>
+ *  Return navigation data pipeline latency and throughput statistics, see
+ *  PipelineStats. Does not require api_key or source.
+ *    - Parameters: None
+ *    - Returns json data, latencies in microseconds, rate in messages/sec:
+ *      {
+ *        "stages": [ {"stage": "bus_notify", "count": 1234, "rate": 9.8,
+ *                     "mean_us": 41.2, "p50_us": 38.0, "p90_us": 60.5,
+ *                     "p99_us": 120.0, "p999_us": 310.0, "max_us": 420.1},
+ *                    ... ],
+ *        "drivers": [ {"iface": "/dev/ttyUSB0", "stages": [ ... ]}, ... ]
+ *      }
+ *
  *  GET /api/list-routes  <br>
  *  Return list of available routes
  *    - source=`<ip>` Mandatory, origin ip address or hostname.
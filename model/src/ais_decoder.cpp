@@ -66,6 +66,7 @@
 #include "model/multiplexer.h"
 #include "model/navutil_base.h"
 #include "model/own_ship.h"
+#include "model/pipeline_stats.h"
 #include "model/route_point.h"
 #include "model/select.h"
 #include "model/track.h"
@@ -1480,12 +1481,13 @@ bool AisDecoder::HandleN0183_AIS(const N0183MsgPtr &n0183_msg) {
   std::string str = n0183_msg->payload;
   wxString sentence(str.c_str());
   DecodeN0183(sentence);
+  PipelineStats::GetInstance().Record(PipelineStage::kAisDecode, *n0183_msg);
   touch_state.Notify();
   return true;
 }
 
 bool AisDecoder::HandleN2K_129038(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -1502,7 +1504,7 @@ bool AisDecoder::HandleN2K_129038(const N2000MsgPtr &n2k_msg) {
   tN2kAISNavStatus NavStat = N2kaisns_Under_Way_Motoring;
   tN2kAISTransceiverInformation AISTransceiverInformation;
 
-  if (ParseN2kPGN129038(v, MessageID, Repeat, UserID, Latitude, Longitude,
+  if (ParseN2kPGN129038(msg, MessageID, Repeat, UserID, Latitude, Longitude,
                         Accuracy, RAIM, Seconds, COG, SOG, Heading, ROT,
                         NavStat, AISTransceiverInformation)) {
     unsigned mmsi = UserID;
@@ -1577,7 +1579,7 @@ bool AisDecoder::HandleN2K_129038(const N2000MsgPtr &n2k_msg) {
 
 // AIS position reports for Class B
 bool AisDecoder::HandleN2K_129039(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   // Input:
   //  - N2kMsg                NMEA2000 message to decode
@@ -1607,7 +1609,7 @@ bool AisDecoder::HandleN2K_129039(const N2000MsgPtr &n2k_msg) {
   bool DSC, Band, Msg22, State, Display;
   tN2kAISMode Mode;
 
-  if (ParseN2kPGN129039(v, MessageID, Repeat, UserID, Latitude, Longitude,
+  if (ParseN2kPGN129039(msg, MessageID, Repeat, UserID, Latitude, Longitude,
                         Accuracy, RAIM, Seconds, COG, SOG,
                         AISTransceiverInformation, Heading, Unit, Display, DSC,
                         Band, Msg22, Mode, State)) {
@@ -1669,7 +1671,7 @@ bool AisDecoder::HandleN2K_129039(const N2000MsgPtr &n2k_msg) {
 }
 
 bool AisDecoder::HandleN2K_129041(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   tN2kAISAtoNReportData data;
 
@@ -1697,7 +1699,7 @@ bool AisDecoder::HandleN2K_129041(const N2000MsgPtr &n2k_msg) {
   char AtoNName[34 + 1];
 #endif
 
-  if (ParseN2kPGN129041(v, data)) {
+  if (ParseN2kPGN129041(msg, data)) {
     uint32_t mmsi = data.UserID;
     // Stop here if the target shall be ignored
     if (mmsi == g_OwnShipmmsi || IsTargetOnTheIgnoreList(mmsi)) return false;
@@ -1767,7 +1769,7 @@ bool AisDecoder::HandleN2K_129041(const N2000MsgPtr &n2k_msg) {
 
 // AIS static data class A
 bool AisDecoder::HandleN2K_129794(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -1789,7 +1791,7 @@ bool AisDecoder::HandleN2K_129794(const N2000MsgPtr &n2k_msg) {
   tN2kAISDTE DTE;
   tN2kAISTranceiverInfo AISinfo;
 
-  if (ParseN2kPGN129794(v, MessageID, Repeat, UserID, IMOnumber, Callsign, Name,
+  if (ParseN2kPGN129794(msg, MessageID, Repeat, UserID, IMOnumber, Callsign, Name,
                         VesselType, Length, Beam, PosRefStbd, PosRefBow,
                         ETAdate, ETAtime, Draught, Destination, AISversion,
                         GNSStype, DTE, AISinfo)) {
@@ -1859,14 +1861,14 @@ bool AisDecoder::HandleN2K_129794(const N2000MsgPtr &n2k_msg) {
 }
 // AIS static data class B part A
 bool AisDecoder::HandleN2K_129809(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
   uint32_t UserID;
   char Name[21];
 
-  if (ParseN2kPGN129809(v, MessageID, Repeat, UserID, Name)) {
+  if (ParseN2kPGN129809(msg, MessageID, Repeat, UserID, Name)) {
     unsigned mmsi = UserID;
     // Stop here if the target shall be ignored
     if (mmsi == g_OwnShipmmsi || IsTargetOnTheIgnoreList(mmsi)) return false;
@@ -1905,7 +1907,7 @@ bool AisDecoder::HandleN2K_129809(const N2000MsgPtr &n2k_msg) {
 
 // AIS static data class B part B
 bool AisDecoder::HandleN2K_129810(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -1919,7 +1921,7 @@ bool AisDecoder::HandleN2K_129810(const N2000MsgPtr &n2k_msg) {
   double PosRefBow;
   uint32_t MothershipID;
 
-  if (ParseN2kPGN129810(v, MessageID, Repeat, UserID, VesselType, Vendor,
+  if (ParseN2kPGN129810(msg, MessageID, Repeat, UserID, VesselType, Vendor,
                         Callsign, Length, Beam, PosRefStbd, PosRefBow,
                         MothershipID)) {
     unsigned mmsi = UserID;
@@ -1962,7 +1964,7 @@ bool AisDecoder::HandleN2K_129810(const N2000MsgPtr &n2k_msg) {
 
 // AIS Base Station Report
 bool AisDecoder::HandleN2K_129793(const N2000MsgPtr &n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   uint8_t MessageID;
   tN2kAISRepeat Repeat;
@@ -1972,7 +1974,7 @@ bool AisDecoder::HandleN2K_129793(const N2000MsgPtr &n2k_msg) {
   unsigned int SecondsSinceMidnight;
   unsigned int DaysSinceEpoch;
 
-  if (ParseN2kPGN129793(v, MessageID, Repeat, UserID, Longitude, Latitude,
+  if (ParseN2kPGN129793(msg, MessageID, Repeat, UserID, Longitude, Latitude,
                         SecondsSinceMidnight, DaysSinceEpoch)) {
     wxDateTime now = wxDateTime::Now();
     now.MakeUTC();
@@ -23,6 +23,7 @@ int g_unit_test_1 = 0;
 int g_unit_test_2 = 0;
 bool g_start_fullscreen = false;
 bool g_rebuild_gl_cache = false;
+bool g_build_gl_cache_headless = false;
 bool g_parse_all_enc = false;
 bool g_bportable = false;
 bool g_bdisable_opengl = false;
@@ -26,6 +26,9 @@
 
 // For compilers that support precompilation, includes "wx.h".
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <sstream>
 #include <string>
 
@@ -54,6 +57,7 @@
 #include "model/own_ship.h"
 #include "model/multiplexer.h"
 #include "model/notification_manager.h"
+#include "model/pipeline_stats.h"
 
 #define N_ACTIVE_LOG_WATCHDOG 300
 
@@ -133,63 +137,18 @@ static inline double GeodesicRadToDeg(double rads) {
 
 static inline double MS2KNOTS(double ms) { return ms * 1.9438444924406; }
 
-static string GetPriorityKey(const NavMsgPtr& msg) {
-  string key;
-
-  string this_identifier;
-  string this_address("0");
-  if (msg->bus == NavAddr::Bus::N0183) {
-    auto msg_0183 = std::dynamic_pointer_cast<const Nmea0183Msg>(msg);
-    if (msg_0183) {
-      string source = msg->source->to_string();
-      this_identifier = msg_0183->talker;
-      this_identifier += msg_0183->type;
-      key = source + ":" + this_address + ";" + this_identifier;
-    }
-  } else if (msg->bus == NavAddr::Bus::N2000) {
-    auto msg_n2k = std::dynamic_pointer_cast<const Nmea2000Msg>(msg);
-    if (msg_n2k) {
-      this_identifier = msg_n2k->PGN.to_string();
-      unsigned char n_source = msg_n2k->payload.at(7);
-      wxString km = wxString::Format("N2k device address: %d", n_source);
-      key = km.ToStdString() + " ; " + "PGN: " + this_identifier;
-    }
-  } else if (msg->bus == NavAddr::Bus::Signalk) {
-    auto msg_sk = std::dynamic_pointer_cast<const SignalkMsg>(msg);
-    if (msg_sk) {
-      auto addr_sk =
-          std::static_pointer_cast<const NavAddrSignalK>(msg->source);
-      string source = addr_sk->to_string();
-      key = source;  // Simplified, parsing sK for more info is expensive
-    }
-  }
-
-  return key;
+/** Seconds from a monotonic clock, immune to wall clock adjustments. */
+static time_t MonotonicSeconds() {
+  using namespace std::chrono;
+  return duration_cast<seconds>(steady_clock::now().time_since_epoch())
+      .count();
 }
 
-static void PresetPriorityContainer(PriorityContainer& pc,
-                                    const PriorityMap& priority_map) {
-  // Extract some info from the preloaded map
-  // Find the key corresponding to priority 0, the highest
-  string key0;
-  for (const auto& it : priority_map) {
-    if (it.second == 0) key0 = it.first;
-  }
-
-  wxString this_key(key0.c_str());
-  wxStringTokenizer tkz(this_key, _T(";"));
-  string source = tkz.GetNextToken().ToStdString();
-  string this_identifier = tkz.GetNextToken().ToStdString();
-
-  wxStringTokenizer tka(source, ":");
-  tka.GetNextToken();
-  std::stringstream ss;
-  ss << tka.GetNextToken();
-  ss >> pc.active_source_address;
-  pc.active_priority = 0;
-  pc.active_source = source;
-  pc.active_identifier = this_identifier;
-  pc.recent_active_time = -1;
+/** Numeric address following the first ':' in key source part, or 0. */
+static int ParseSourceAddress(const string& source) {
+  auto pos = source.find(':');
+  if (pos == string::npos) return 0;
+  return static_cast<int>(strtol(source.c_str() + pos + 1, nullptr, 10));
 }
 
 static void ApplyPriorityMap(PriorityMap& priority_map,
@@ -247,6 +206,8 @@ static void SelectNextLowerPriority(const PriorityMap& map,
   pc.active_priority = best_prio;
   pc.active_source.clear();
   pc.active_identifier.clear();
+  pc.active_source_id = -1;
+  pc.active_identifier_id = -1;
 }
 
 // CommBridge implementation
@@ -512,6 +473,8 @@ void CommBridge::InitCommListeners() {
 void CommBridge::OnDriverStateChange() {
   // Reset all active priority states
   PresetPriorityContainers();
+  // Don't keep addresses of removed drivers alive.
+  m_priority_sources.clear();
 }
 
 std::vector<string> CommBridge::GetPriorityMaps() const {
@@ -541,6 +504,127 @@ void CommBridge::ApplyPriorityMaps(const std::vector<string>& new_maps) {
   ApplyPriorityMap(priority_map_satellites, new_prio_string, 4);
 }
 
+int CommBridge::InternPriorityId(const string& s) {
+  auto it = m_priority_ids.find(s);
+  if (it != m_priority_ids.end()) return it->second;
+  int id = static_cast<int>(m_priority_ids.size());
+  m_priority_ids[s] = id;
+  return id;
+}
+
+const PriorityKey& CommBridge::GetPriorityKey(const NavMsgPtr& msg) {
+  static const size_t kMaxCachedSources = 32;
+
+  // N0183 and SignalK keys depend on the source string, which follows
+  // from the address bus and interface. Drivers create a new address for
+  // each message, so look it up by value.
+  int source_ix = 0;
+  if (msg->source && msg->bus != NavAddr::Bus::N2000) {
+    const NavAddr& source = *msg->source;
+    auto it = std::find_if(
+        m_priority_sources.begin(), m_priority_sources.end(),
+        [&](const PrioritySource& entry) {
+          return entry.bus == source.bus && entry.iface == source.iface;
+        });
+    if (it != m_priority_sources.end()) {
+      source_ix = it->id;
+    } else {
+      if (m_priority_sources.size() >= kMaxCachedSources)
+        m_priority_sources.clear();
+      source_ix = InternPriorityId(source.to_string());
+      m_priority_sources.push_back({source.bus, source.iface, source_ix});
+    }
+  }
+
+  // Compact tuple: bus in the top byte, interned source or N2000 device
+  // address in the next 16 bits, packed sentence id or PGN in the rest.
+  uint64_t tuple = static_cast<uint64_t>(msg->bus) << 56;
+  std::shared_ptr<const Nmea0183Msg> msg_0183;
+  std::shared_ptr<const Nmea2000Msg> msg_n2k;
+  int n2k_address = 0;
+  if (msg->bus == NavAddr::Bus::N0183 && msg->source) {
+    msg_0183 = std::dynamic_pointer_cast<const Nmea0183Msg>(msg);
+    if (msg_0183) {
+      tuple |= static_cast<uint64_t>(source_ix & 0xffff) << 40;
+      // Up to five ASCII characters fit in 35 bits, else use bit 39 to
+      // flag an interned identifier.
+      uint64_t id = 0;
+      bool packed = msg_0183->talker.size() + msg_0183->type.size() <= 5;
+      for (const string* part : {&msg_0183->talker, &msg_0183->type}) {
+        for (unsigned char c : *part) {
+          if (c & 0x80) packed = false;
+          id = (id << 7) | (c & 0x7f);
+        }
+      }
+      if (!packed)
+        id = (1ULL << 39) | InternPriorityId(msg_0183->talker + msg_0183->type);
+      tuple |= id;
+    }
+  } else if (msg->bus == NavAddr::Bus::N2000) {
+    msg_n2k = std::dynamic_pointer_cast<const Nmea2000Msg>(msg);
+    if (msg_n2k) {
+      if (msg_n2k->payload.size() > 7) n2k_address = msg_n2k->payload[7];
+      tuple |= static_cast<uint64_t>(n2k_address) << 40;
+      tuple |= msg_n2k->PGN.pgn & 0xffffffffff;
+    }
+  } else if (msg->bus == NavAddr::Bus::Signalk) {
+    tuple |= static_cast<uint64_t>(source_ix & 0xffff) << 40;
+  }
+
+  auto found = m_priority_keys.find(tuple);
+  if (found != m_priority_keys.end()) return found->second;
+
+  // First message of this kind: build the string key used by the
+  // priority maps, config and GUI.
+  PriorityKey pk;
+  if (msg_0183) {
+    pk.source = msg->source->to_string() + ":0";
+    pk.identifier = msg_0183->talker + msg_0183->type;
+    pk.key = pk.source + ";" + pk.identifier;
+  } else if (msg_n2k) {
+    wxString km = wxString::Format("N2k device address: %d", n2k_address);
+    pk.key = km.ToStdString() + " ; " + "PGN: " + msg_n2k->PGN.to_string();
+    auto pos = pk.key.find(';');
+    pk.source = pk.key.substr(0, pos);
+    pk.identifier = pk.key.substr(pos + 1);
+  } else if (msg->bus == NavAddr::Bus::Signalk && msg->source) {
+    // Simplified, parsing sK for more info is expensive
+    pk.key = msg->source->to_string();
+    pk.source = pk.key;
+  }
+  pk.source_address = ParseSourceAddress(pk.source);
+  pk.source_id = InternPriorityId(pk.source);
+  pk.identifier_id = InternPriorityId(pk.identifier);
+  return m_priority_keys.emplace(tuple, std::move(pk)).first->second;
+}
+
+void CommBridge::PresetPriorityContainer(PriorityContainer& pc,
+                                         const PriorityMap& priority_map) {
+  // Extract some info from the preloaded map
+  // Find the key corresponding to priority 0, the highest
+  string key0;
+  for (const auto& it : priority_map) {
+    if (it.second == 0) key0 = it.first;
+  }
+
+  wxString this_key(key0.c_str());
+  wxStringTokenizer tkz(this_key, _T(";"));
+  string source = tkz.GetNextToken().ToStdString();
+  string this_identifier = tkz.GetNextToken().ToStdString();
+
+  wxStringTokenizer tka(source, ":");
+  tka.GetNextToken();
+  std::stringstream ss;
+  ss << tka.GetNextToken();
+  ss >> pc.active_source_address;
+  pc.active_priority = 0;
+  pc.active_source = source;
+  pc.active_identifier = this_identifier;
+  pc.active_source_id = InternPriorityId(source);
+  pc.active_identifier_id = InternPriorityId(this_identifier);
+  pc.recent_active_time = -1;
+}
+
 void CommBridge::PresetPriorityContainers() {
   PresetPriorityContainer(active_priority_position, priority_map_position);
   PresetPriorityContainer(active_priority_velocity, priority_map_velocity);
@@ -550,13 +634,13 @@ void CommBridge::PresetPriorityContainers() {
 }
 
 bool CommBridge::HandleN2K_129029(const N2000MsgPtr& n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   // extract and verify PGN
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodePGN129029(v, temp_data)) return false;
+  if (!m_decoder.DecodePGN129029(msg, temp_data)) return false;
 
   int valid_flag = 0;
   if (!N2kIsNA(temp_data.gLat) && !N2kIsNA(temp_data.gLon)) {
@@ -585,12 +669,12 @@ bool CommBridge::HandleN2K_129029(const N2000MsgPtr& n2k_msg) {
 }
 
 bool CommBridge::HandleN2K_129025(const N2000MsgPtr& n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodePGN129025(v, temp_data)) return false;
+  if (!m_decoder.DecodePGN129025(msg, temp_data)) return false;
 
   int valid_flag = 0;
   if (!N2kIsNA(temp_data.gLat) && !N2kIsNA(temp_data.gLon)) {
@@ -613,12 +697,12 @@ bool CommBridge::HandleN2K_129025(const N2000MsgPtr& n2k_msg) {
 }
 
 bool CommBridge::HandleN2K_129026(const N2000MsgPtr& n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodePGN129026(v, temp_data)) return false;
+  if (!m_decoder.DecodePGN129026(msg, temp_data)) return false;
 
   int valid_flag = 0;
   if (!N2kIsNA(temp_data.gSog)) {  // gCog as reported by net may be NaN, but OK
@@ -642,12 +726,12 @@ bool CommBridge::HandleN2K_129026(const N2000MsgPtr& n2k_msg) {
 }
 
 bool CommBridge::HandleN2K_127250(const N2000MsgPtr& n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodePGN127250(v, temp_data)) return false;
+  if (!m_decoder.DecodePGN127250(msg, temp_data)) return false;
 
   int valid_flag = 0;
   if (!N2kIsNA(temp_data.gVar)) {
@@ -682,12 +766,12 @@ bool CommBridge::HandleN2K_127250(const N2000MsgPtr& n2k_msg) {
 }
 
 bool CommBridge::HandleN2K_129540(const N2000MsgPtr& n2k_msg) {
-  std::vector<unsigned char> v = n2k_msg->payload;
+  const tN2kMsg& msg = n2k_msg->GetN2kMsg();
 
   NavData temp_data;
   ClearNavData(temp_data);
 
-  if (!m_decoder.DecodePGN129540(v, temp_data)) return false;
+  if (!m_decoder.DecodePGN129540(msg, temp_data)) return false;
 
   if (temp_data.n_satellites >= 0) {
     if (EvalPriority(n2k_msg, active_priority_satellites,
@@ -702,7 +786,7 @@ bool CommBridge::HandleN2K_129540(const N2000MsgPtr& n2k_msg) {
 }
 
 bool CommBridge::HandleN0183_RMC(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
 
   NavData temp_data;
   ClearNavData(temp_data);
@@ -766,7 +850,7 @@ bool CommBridge::HandleN0183_RMC(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_THS(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -784,7 +868,7 @@ bool CommBridge::HandleN0183_THS(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDT(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -802,7 +886,7 @@ bool CommBridge::HandleN0183_HDT(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDG(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -833,7 +917,7 @@ bool CommBridge::HandleN0183_HDG(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_HDM(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -852,7 +936,7 @@ bool CommBridge::HandleN0183_HDM(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_VTG(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -873,7 +957,7 @@ bool CommBridge::HandleN0183_VTG(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GSV(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -895,7 +979,7 @@ bool CommBridge::HandleN0183_GSV(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GGA(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -934,7 +1018,7 @@ bool CommBridge::HandleN0183_GGA(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_GLL(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
   NavData temp_data;
   ClearNavData(temp_data);
 
@@ -961,7 +1045,7 @@ bool CommBridge::HandleN0183_GLL(const N0183MsgPtr& n0183_msg) {
 }
 
 bool CommBridge::HandleN0183_AIVDO(const N0183MsgPtr& n0183_msg) {
-  string str = n0183_msg->payload;
+  const string& str = n0183_msg->payload;
 
   GenericPosDatEx gpd;
   wxString sentence(str.c_str());
@@ -1173,26 +1257,22 @@ bool CommBridge::SaveConfig() const {
   return true;
 }
 
+void CommBridge::RecordAccepted(const NavMsgPtr& msg,
+                                const PriorityContainer& pc) {
+  auto& stats = PipelineStats::GetInstance();
+  stats.Record(PipelineStage::kBridgeAccept, *msg);
+  if (&pc == &active_priority_position) stats.MarkFix(*msg);
+}
+
 bool CommBridge::EvalPriority(const NavMsgPtr& msg,
                               PriorityContainer& active_priority,
                               PriorityMap& priority_map) {
-  string this_key = GetPriorityKey(msg);
+  const PriorityKey& k = GetPriorityKey(msg);
+  const string& this_key = k.key;
+  const string& source = k.source;
+  const string& this_identifier = k.identifier;
   if (debug_priority) printf("This Key: %s\n", this_key.c_str());
 
-  // Pull some identifiers from the unique key
-  wxStringTokenizer tkz(this_key, _T(";"));
-  wxString wxs_this_source = tkz.GetNextToken();
-  string source = wxs_this_source.ToStdString();
-  wxString wxs_this_identifier = tkz.GetNextToken();
-  string this_identifier = wxs_this_identifier.ToStdString();
-
-  wxStringTokenizer tka(wxs_this_source, _T(":"));
-  tka.GetNextToken();
-  std::stringstream ss;
-  ss << tka.GetNextToken();
-  int source_address;
-  ss >> source_address;
-
   // Special case priority value linkage for N0183 messages:
   // If this is a "velocity" record, ensure that a "position"
   // report has been accepted from the same source before accepting the
@@ -1200,10 +1280,9 @@ bool CommBridge::EvalPriority(const NavMsgPtr& msg,
   // This ensures that the data source is fully initialized, and is reporting
   // valid, sensible velocity data.
   if (msg->bus == NavAddr::Bus::N0183) {
-    if (!strncmp(active_priority.prio_class.c_str(), "velocity", 8)) {
+    if (&active_priority == &active_priority_velocity) {
       bool pos_ok = false;
-      if (!strcmp(active_priority_position.active_source.c_str(),
-                  source.c_str())) {
+      if (active_priority_position.active_source_id == k.source_id) {
         if (active_priority_position.recent_active_time != -1) {
           pos_ok = true;
         }
@@ -1212,17 +1291,12 @@ bool CommBridge::EvalPriority(const NavMsgPtr& msg,
     }
   }
 
-  // Fetch the established priority for the message
-  int this_priority;
-
-  auto it = priority_map.find(this_key);
-  if (it == priority_map.end()) {
-    // Not found, so make it default the lowest priority
-    size_t n = priority_map.size();
-    priority_map[this_key] = static_cast<int>(n);
-  }
-
-  this_priority = priority_map[this_key];
+  // Fetch the established priority for the message. If not found, make it
+  // default the lowest priority
+  auto emplaced =
+      priority_map.emplace(this_key, static_cast<int>(priority_map.size()));
+  int& map_priority = emplaced.first->second;
+  int this_priority = map_priority;
 
   if (debug_priority) {
     for (const auto& jt : priority_map) {
@@ -1245,9 +1319,11 @@ bool CommBridge::EvalPriority(const NavMsgPtr& msg,
     active_priority.active_priority = this_priority;
     active_priority.active_source = source;
     active_priority.active_identifier = this_identifier;
-    active_priority.active_source_address = source_address;
-    wxDateTime now = wxDateTime::Now();
-    active_priority.recent_active_time = now.GetTicks();
+    active_priority.active_source_id = k.source_id;
+    active_priority.active_identifier_id = k.identifier_id;
+    active_priority.active_source_address = k.source_address;
+    active_priority.recent_active_time = MonotonicSeconds();
+    RecordAccepted(msg, active_priority);
 
     if (debug_priority)
       printf("  Restoring high priority: %s %d\n", source.c_str(),
@@ -1263,7 +1339,7 @@ bool CommBridge::EvalPriority(const NavMsgPtr& msg,
     if (debug_priority)
       printf("active_source: %s\n", active_priority.active_source.c_str());
 
-    if (source != active_priority.active_source) {
+    if (k.source_id != active_priority.active_source_id) {
       // Auto adjust the priority of these this message down
       // First, find the lowest priority in use in this map
       int lowest_priority = -10;  // safe enough
@@ -1271,85 +1347,62 @@ bool CommBridge::EvalPriority(const NavMsgPtr& msg,
         if (jt.second > lowest_priority) lowest_priority = jt.second;
       }
 
-      priority_map[this_key] = lowest_priority + 1;
+      map_priority = lowest_priority + 1;
       if (debug_priority)
         printf("          Lowering priority A: %s :%d\n", source.c_str(),
-               priority_map[this_key]);
+               map_priority);
       return false;
     }
   }
 
   //  For N0183 message, has the Mnemonic (id) changed?
   //  Example:  RMC and AIVDO from same source.
-
-  if (msg->bus == NavAddr::Bus::N0183) {
-    auto msg_0183 = std::dynamic_pointer_cast<const Nmea0183Msg>(msg);
-    if (msg_0183) {
-      if (!active_priority.active_identifier.empty()) {
-        if (debug_priority)
-          printf("this_identifier: %s\n", this_identifier.c_str());
-        if (debug_priority)
-          printf("active_priority.active_identifier: %s\n",
-                 active_priority.active_identifier.c_str());
-
-        if (this_identifier != active_priority.active_identifier) {
-          // if necessary, auto adjust the priority of this message down
-          // and drop it
-          if (priority_map[this_key] == active_priority.active_priority) {
-            int lowest_priority = -10;  // safe enough
-            for (const auto& jt : priority_map) {
-              if (jt.second > lowest_priority) lowest_priority = jt.second;
-            }
-
-            priority_map[this_key] = lowest_priority + 1;
-            if (debug_priority)
-              printf("          Lowering priority B: %s :%d\n", source.c_str(),
-                     priority_map[this_key]);
-          }
-
-          return false;
-        }
-      }
-    }
-  }
-
   //  Similar for n2k PGN...
 
-  else if (msg->bus == NavAddr::Bus::N2000) {
-    auto msg_n2k = std::dynamic_pointer_cast<const Nmea2000Msg>(msg);
-    if (msg_n2k) {
-      if (!active_priority.active_identifier.empty()) {
-        if (this_identifier != active_priority.active_identifier) {
-          // if necessary, auto adjust the priority of this message down
-          // and drop it
-          if (priority_map[this_key] == active_priority.active_priority) {
-            int lowest_priority = -10;  // safe enough
-            for (const auto& jt : priority_map) {
-              if (jt.second > lowest_priority) lowest_priority = jt.second;
-            }
-
-            priority_map[this_key] = lowest_priority + 1;
-            if (debug_priority)
-              printf("          Lowering priority: %s :%d\n", source.c_str(),
-                     priority_map[this_key]);
+  if (msg->bus == NavAddr::Bus::N0183 || msg->bus == NavAddr::Bus::N2000) {
+    if (!active_priority.active_identifier.empty()) {
+      if (debug_priority)
+        printf("this_identifier: %s\n", this_identifier.c_str());
+      if (debug_priority)
+        printf("active_priority.active_identifier: %s\n",
+               active_priority.active_identifier.c_str());
+
+      if (k.identifier_id != active_priority.active_identifier_id) {
+        // if necessary, auto adjust the priority of this message down
+        // and drop it
+        if (map_priority == active_priority.active_priority) {
+          int lowest_priority = -10;  // safe enough
+          for (const auto& jt : priority_map) {
+            if (jt.second > lowest_priority) lowest_priority = jt.second;
           }
 
-          return false;
+          map_priority = lowest_priority + 1;
+          if (debug_priority)
+            printf("          Lowering priority B: %s :%d\n", source.c_str(),
+                   map_priority);
         }
+
+        return false;
       }
     }
   }
 
   // Update the records
-  active_priority.active_source = source;
-  active_priority.active_identifier = this_identifier;
-  active_priority.active_source_address = source_address;
-  wxDateTime now = wxDateTime::Now();
-  active_priority.recent_active_time = now.GetTicks();
+  if (active_priority.active_source_id != k.source_id) {
+    active_priority.active_source = source;
+    active_priority.active_source_id = k.source_id;
+  }
+  if (active_priority.active_identifier_id != k.identifier_id) {
+    active_priority.active_identifier = this_identifier;
+    active_priority.active_identifier_id = k.identifier_id;
+  }
+  active_priority.active_source_address = k.source_address;
+  active_priority.recent_active_time = MonotonicSeconds();
+  RecordAccepted(msg, active_priority);
   if (debug_priority)
     printf("  Accepting high priority: %s %d\n", source.c_str(), this_priority);
 
-  if (active_priority.prio_class == "position") {
+  if (&active_priority == &active_priority_position) {
     if (this_priority != m_last_position_priority) {
       m_last_position_priority = this_priority;
 
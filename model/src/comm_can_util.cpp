@@ -24,15 +24,14 @@
  **************************************************************************/
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 #include <vector>
 
 #include "model/comm_can_util.h"
 
 static const int kNotFound = -1;
 
-/// Number of fast messsages stored triggering Garbage Collection.
-static const int kGcThreshold = 100;
-
 /// Max time between garbage collection runs.
 static const int kGcIntervalSecs = 10;
 
@@ -41,19 +40,22 @@ static const int kEntryMaxAgeSecs = 100;
 
 typedef struct can_frame CanFrame;
 
+static int64_t NowMs() {
+  using namespace std::chrono;
+  return duration_cast<milliseconds>(steady_clock::now().time_since_epoch())
+      .count();
+}
+
 bool IsFastMessagePGN(unsigned pgn) {
-  static const std::vector<unsigned> haystack = {
-      // All known multiframe fast messages
+  static const unsigned haystack[] = {
+      // All known multiframe fast messages, sorted
       65240u,  126208u, 126464u, 126996u, 126998u, 127233u, 127237u, 127489u,
       127496u, 127506u, 128275u, 129029u, 129038u, 129039u, 129040u, 129041u,
       129284u, 129285u, 129540u, 129793u, 129794u, 129795u, 129797u, 129798u,
       129801u, 129802u, 129808u, 129809u, 129810u, 130065u, 130074u, 130323u,
       130577u, 130820u, 130822u, 130824u};
 
-  unsigned needle = static_cast<unsigned>(pgn);
-  auto found = std::find_if(haystack.begin(), haystack.end(),
-                            [needle](unsigned i) { return i == needle; });
-  return found != haystack.end();
+  return std::binary_search(std::begin(haystack), std::end(haystack), pgn);
 }
 
 unsigned long BuildCanID(int priority, int source, int destination, int pgn) {
@@ -105,27 +107,29 @@ bool CanHeader::IsFastMessage() const {
 
 //  FastMessage implementation
 
-bool FastMessageMap::IsEntryExpired(unsigned int i) {
-  return (wxDateTime::Now() - entries[i].time_arrived >
-          wxTimeSpan(0, 0, kEntryMaxAgeSecs));
+FastMessageMap::FastMessageMap()
+    : in_use_count(0), dropped_frames(0), last_gc_run(NowMs()) {}
+
+bool FastMessageMap::IsEntryExpired(unsigned int i, int64_t now) {
+  return now - entries[i].time_arrived > kEntryMaxAgeSecs * 1000;
 }
 
-void FastMessageMap::CheckGc() {
-  bool last_run_over_age =
-      (wxDateTime::Now() - last_gc_run) > wxTimeSpan(0, 0, kGcIntervalSecs);
-  if (last_run_over_age || entries.size() > kGcThreshold) {
-    GarbageCollector();
-    last_gc_run = wxDateTime::Now();
+void FastMessageMap::CheckGc(int64_t now) {
+  if (now - last_gc_run > kGcIntervalSecs * 1000) {
+    GarbageCollector(now);
+    last_gc_run = now;
   }
 }
 
-int FastMessageMap::FindMatchingEntry(const CanHeader header,
+int FastMessageMap::FindMatchingEntry(const CanHeader& header,
                                       const unsigned char sid) {
-  for (unsigned i = 0; i < entries.size(); i++) {
-    if (((sid & 0xE0) == (entries[i].sid & 0xE0)) &&
-        (entries[i].header.pgn == header.pgn) &&
-        (entries[i].header.source == header.source) &&
-        (entries[i].header.destination == header.destination)) {
+  if (in_use_count == 0) return kNotFound;
+  for (int i = 0; i < kMaxEntries; i++) {
+    const Entry& entry = entries[i];
+    if (entry.in_use && ((sid & 0xE0) == (entry.sid & 0xE0)) &&
+        (entry.header.pgn == header.pgn) &&
+        (entry.header.source == header.source) &&
+        (entry.header.destination == header.destination)) {
       return i;
     }
   }
@@ -133,112 +137,103 @@ int FastMessageMap::FindMatchingEntry(const CanHeader header,
 }
 
 int FastMessageMap::AddNewEntry(void) {
-  entries.push_back(Entry());
-  return entries.size() - 1;
+  // Use a free slot, else drop the entry least recently updated.
+  int oldest = 0;
+  for (int i = 0; i < kMaxEntries; i++) {
+    if (!entries[i].in_use) {
+      oldest = i;
+      break;
+    }
+    if (entries[i].time_arrived < entries[oldest].time_arrived) oldest = i;
+  }
+  if (entries[oldest].in_use) {
+    dropped_frames += 1;
+  } else {
+    in_use_count += 1;
+  }
+  entries[oldest] = Entry();
+  entries[oldest].in_use = true;
+  entries[oldest].time_arrived = NowMs();
+  return oldest;
 }
 
-int FastMessageMap::GarbageCollector(void) {
-  std::vector<unsigned> stale_entries;
-  bool bremoved;
+int FastMessageMap::GarbageCollector(int64_t now) {
   int nremoved = 0;
-  do {
-    bremoved = false;
-    for (unsigned i = 0; i < entries.size(); i++) {
-      if (IsEntryExpired(i)) {
-        Remove(i);
-        nremoved++;
-        bremoved = true;
-        break;
-      }
+  for (int i = 0; i < kMaxEntries; i++) {
+    if (entries[i].in_use && IsEntryExpired(i, now)) {
+      Remove(i);
+      nremoved++;
     }
-  } while (bremoved);
-
+  }
   return nremoved;
 }
 
-bool FastMessageMap::InsertEntry(const CanHeader header,
+bool FastMessageMap::InsertEntry(const CanHeader& header,
                                  const unsigned char* data, int index) {
   // first message of fast packet
   // data[0] Sequence Identifier (sid)
   // data[1] Length of data bytes
   // data[2..7] 6 data bytes
 
-  CheckGc();
+  int64_t now = NowMs();
+  CheckGc(now);
   // Ensure that this is indeed the first frame of a fast message
-  if ((data[0] & 0x1F) == 0) {
-    int total_data_len;  // will also include padding as we memcpy all of the
-                         // frame, because I'm lazy
-    total_data_len = static_cast<unsigned int>(data[1]);
-    total_data_len += 7 - ((total_data_len - 6) % 7);
-
-    entries[index].sid = static_cast<unsigned int>(data[0]);
-    entries[index].expected_length = static_cast<unsigned int>(data[1]);
-    entries[index].header = header;
-    entries[index].time_arrived = wxDateTime::Now();
-
-    entries[index].data.resize(total_data_len);
-    memcpy(&entries[index].data[0], &data[2], 6);
+  if ((data[0] & 0x1F) == 0 && data[1] <= kMaxDataLen) {
+    Entry& entry = entries[index];
+    entry.sid = static_cast<unsigned int>(data[0]);
+    entry.expected_length = static_cast<unsigned int>(data[1]);
+    entry.header = header;
+    entry.time_arrived = now;
+    entry.in_use = true;
+
+    memcpy(&entry.data[0], &data[2], 6);
     // First frame of a multi-frame Fast Message contains six data bytes.
     // Position the cursor ready for next message
-    entries[index].cursor = 6;
+    entry.cursor = 6;
 
     // Fusion, using fast messages to sends frames less than eight bytes
-    return entries[index].expected_length <= 6;
+    return entry.expected_length <= 6;
   }
-  return false;
   // No further processing is performed if this is not a start frame.
   // A start frame may have been dropped and we received a subsequent frame
+  Remove(index);
+  return false;
 }
 
-bool FastMessageMap::AppendEntry(const CanHeader header,
+bool FastMessageMap::AppendEntry(const CanHeader& header,
                                  const unsigned char* data, int position) {
+  Entry& entry = entries[position];
   // Check that this is the next message in the sequence
-  if ((entries[position].sid + 1) == data[0]) {
-    memcpy(&entries[position].data[entries[position].cursor], &data[1], 7);
-    entries[position].sid = data[0];
+  if ((entry.sid + 1) == data[0]) {
+    memcpy(&entry.data[entry.cursor], &data[1], 7);
+    entry.sid = data[0];
+    entry.time_arrived = NowMs();
     // Subsequent messages contains seven data bytes (last message may be padded
     // with 0xFF)
-    entries[position].cursor += 7;
+    entry.cursor += 7;
     // Is this the last message ?
-    return entries[position].cursor >= entries[position].expected_length;
+    return entry.cursor >= entry.expected_length;
   } else if ((data[0] & 0x1F) == 0) {
     // We've found a matching entry, however this is a start frame, therefore
     // we've missed an end frame, and now we have a start frame with the same id
-    // (top 3 bits). The id has obviously rolled over. Should really double
-    // check that (data[0] & 0xE0) Clear the entry as we don't want to leak
-    // memory, prior to inserting a start frame
-    entries.erase(entries.begin() + position);
-    position = AddNewEntry();
-    // And now insert it
+    // (top 3 bits). The id has obviously rolled over. Reuse the slot for the
+    // new message.
     InsertEntry(header, data, position);
-    // FIXME (dave) Should update the dropped frame stats
+    dropped_frames += 1;
     return false;
   } else {
     // This is not the next frame in the sequence and not a start frame
     // We've dropped an intermedite frame, so free the slot and do no further
     // processing
-    entries.erase(entries.begin() + position);
-    // Dropped Frame Statistics
-    if (dropped_frames == 0) {
-      dropped_frame_time = wxDateTime::Now();
-      dropped_frames += 1;
-    } else {
-      dropped_frames += 1;
-    }
-    // FIXME (dave)
-    //     if ((dropped_frames > CONST_DROPPEDFRAME_THRESHOLD) &&
-    //     (wxDateTime::Now() < (dropped_frame_time +
-    //     wxTimeSpan::Seconds(CONST_DROPPEDFRAME_PERIOD) ) ) ) {
-    //       wxLogError(_T("TwoCan Device, Dropped Frames rate exceeded"));
-    //       wxLogError(wxString::Format(_T("Frame: Source: %d Destination: %d
-    //       Priority: %d PGN: %d"),header.source, header.destination,
-    //       header.priority, header.pgn)); dropped_frames = 0;
-    //     }
+    Remove(position);
+    dropped_frames += 1;
     return false;
   }
 }
 
 void FastMessageMap::Remove(int pos) {
-  if ((unsigned int)(pos + 1) <= entries.size())
-    entries.erase(entries.begin() + pos);
+  if (pos >= 0 && pos < kMaxEntries && entries[pos].in_use) {
+    entries[pos].in_use = false;
+    in_use_count -= 1;
+  }
 }
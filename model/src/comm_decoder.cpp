@@ -39,178 +39,105 @@
 #include "model/comm_util.h"
 #include "model/comm_vars.h"
 #include "model/geodesic.h"
+#include "model/nmea0183_parser.h"
 #include "model/own_ship.h"
 
-bool CommDecoder::ParsePosition(const LATLONG& Position, double& lat,
-                                double& lon) {
-  bool ll_valid = true;
-  double llt = Position.Latitude.Latitude;
-
-  if (!std::isnan(llt)) {
-    int lat_deg_int = (int)(llt / 100);
-    double lat_deg = lat_deg_int;
-    double lat_min = llt - (lat_deg * 100);
-
-    lat = lat_deg + (lat_min / 60.);
-    if (Position.Latitude.Northing == South) lat = -lat;
-  } else
-    ll_valid = false;
-
-  double lln = Position.Longitude.Longitude;
-  if (!std::isnan(lln)) {
-    int lon_deg_int = (int)(lln / 100);
-    double lon_deg = lon_deg_int;
-    double lon_min = lln - (lon_deg * 100);
-
-    lon = lon_deg + (lon_min / 60.);
-    if (Position.Longitude.Easting == West) lon = -lon;
-  } else
-    ll_valid = false;
-
-  return ll_valid;
-}
-
-bool CommDecoder::DecodeRMC(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  if (m_NMEA0183.Rmc.IsDataValid == NTrue) {
-    double tlat, tlon;
-    if (ParsePosition(m_NMEA0183.Rmc.Position, tlat, tlon)) {
-      temp_data.gLat = tlat;
-      temp_data.gLon = tlon;
-    } else
-      return false;
-
-    // FIXME (dave) if (!g_own_ship_sog_cog_calc )
-    {
-      if (!std::isnan(m_NMEA0183.Rmc.SpeedOverGroundKnots)) {
-        temp_data.gSog = m_NMEA0183.Rmc.SpeedOverGroundKnots;
-      }
-      if (!std::isnan(temp_data.gSog) && (temp_data.gSog > 0.05)) {
-        temp_data.gCog = m_NMEA0183.Rmc.TrackMadeGoodDegreesTrue;
-      } else {
-        temp_data.gCog = NAN;
-      }
-    }
-    // Any device sending VAR=0.0 can be assumed to not really know
-    // what the actual variation is, so in this case we use WMM if
-    // available
-    if ((!std::isnan(m_NMEA0183.Rmc.MagneticVariation)) &&
-        0.0 != m_NMEA0183.Rmc.MagneticVariation) {
-      if (m_NMEA0183.Rmc.MagneticVariationDirection == East)
-        temp_data.gVar = m_NMEA0183.Rmc.MagneticVariation;
-      else if (m_NMEA0183.Rmc.MagneticVariationDirection == West)
-        temp_data.gVar = -m_NMEA0183.Rmc.MagneticVariation;
-
-      g_bVAR_Rx = true;
+bool CommDecoder::DecodeRMC(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Rmc rmc;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, rmc)) return false;
+  if (!rmc.is_valid) return false;
+
+  if (std::isnan(rmc.lat) || std::isnan(rmc.lon)) return false;
+  temp_data.gLat = rmc.lat;
+  temp_data.gLon = rmc.lon;
+
+  // FIXME (dave) if (!g_own_ship_sog_cog_calc )
+  {
+    if (!std::isnan(rmc.sog)) temp_data.gSog = rmc.sog;
+    if (!std::isnan(temp_data.gSog) && (temp_data.gSog > 0.05)) {
+      temp_data.gCog = rmc.cog;
+    } else {
+      temp_data.gCog = NAN;
     }
+  }
+  // Any device sending VAR=0.0 can be assumed to not really know
+  // what the actual variation is, so in this case we use WMM if
+  // available
+  if (!std::isnan(rmc.variation) && 0.0 != rmc.variation) {
+    temp_data.gVar = rmc.variation;
+    g_bVAR_Rx = true;
+  }
 
-    gRmcTime = m_NMEA0183.Rmc.UTCTime;
-    gRmcDate = m_NMEA0183.Rmc.Date;
-  } else
-    return false;
-
+  gRmcTime = wxString(rmc.utc_time.data(), rmc.utc_time.size());
+  gRmcDate = wxString(rmc.date.data(), rmc.date.size());
   return true;
 }
 
-bool CommDecoder::DecodeHDM(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  temp_data.gHdm = m_NMEA0183.Hdm.DegreesMagnetic;
-
+bool CommDecoder::DecodeHDM(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Heading hdm;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, hdm)) return false;
+  temp_data.gHdm = hdm.heading;
   return true;
 }
 
-bool CommDecoder::DecodeTHS(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeTHS(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Heading ths;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, ths)) return false;
 
   // Handle only valid data A = Autonomous
-  if (!(m_NMEA0183.Ths.ModeInd == "A")) return false;
-  temp_data.gHdt = m_NMEA0183.Ths.TrueHeading;
-
+  if (sentence.Field(2) != "A") return false;
+  temp_data.gHdt = ths.heading;
   return true;
 }
 
-bool CommDecoder::DecodeHDT(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  temp_data.gHdt = m_NMEA0183.Hdt.DegreesTrue;
-
+bool CommDecoder::DecodeHDT(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Heading hdt;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, hdt)) return false;
+  temp_data.gHdt = hdt.heading;
   return true;
 }
 
-bool CommDecoder::DecodeHDG(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeHDG(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Hdg hdg;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, hdg)) return false;
 
-  temp_data.gHdm = m_NMEA0183.Hdg.MagneticSensorHeadingDegrees;
+  temp_data.gHdm = hdg.heading_magnetic;
 
   // Any device sending VAR=0.0 can be assumed to not really know
   // what the actual variation is, so in this case we use WMM if
   // available
-  if ((!std::isnan(m_NMEA0183.Hdg.MagneticVariationDegrees)) &&
-      0.0 != m_NMEA0183.Hdg.MagneticVariationDegrees) {
-    if (m_NMEA0183.Hdg.MagneticVariationDirection == East)
-      temp_data.gVar = m_NMEA0183.Hdg.MagneticVariationDegrees;
-    else if (m_NMEA0183.Hdg.MagneticVariationDirection == West)
-      temp_data.gVar = -m_NMEA0183.Hdg.MagneticVariationDegrees;
-
+  if (!std::isnan(hdg.variation) && 0.0 != hdg.variation) {
+    temp_data.gVar = hdg.variation;
     g_bVAR_Rx = true;
   }
-
   return true;
 }
 
-bool CommDecoder::DecodeVTG(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
+bool CommDecoder::DecodeVTG(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Vtg vtg;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, vtg)) return false;
 
   // FIXME (dave)if (g_own_ship_sog_cog_calc) return false;
 
-  if (!std::isnan(m_NMEA0183.Vtg.SpeedKnots))
-    temp_data.gSog = m_NMEA0183.Vtg.SpeedKnots;
+  if (!std::isnan(vtg.sog_knots)) temp_data.gSog = vtg.sog_knots;
 
-  if (!std::isnan(m_NMEA0183.Vtg.SpeedKnots) &&
-      !std::isnan(m_NMEA0183.Vtg.TrackDegreesTrue)) {
-    temp_data.gCog = m_NMEA0183.Vtg.TrackDegreesTrue;
+  if (!std::isnan(vtg.sog_knots) && !std::isnan(vtg.cog_true)) {
+    temp_data.gCog = vtg.cog_true;
   }
 
   // If COG-T is not available but COG-M is, then
   //  create COG-T from COG-M and gVar
-  if (!std::isnan(m_NMEA0183.Vtg.SpeedKnots) &&
-      !std::isnan(m_NMEA0183.Vtg.TrackDegreesMagnetic)) {
+  if (!std::isnan(vtg.sog_knots) && !std::isnan(vtg.cog_magnetic)) {
     // establish gVar, if not already set
     if (std::isnan(gVar) && (g_UserVar != 0.0)) gVar = g_UserVar;
 
-    double cogt = m_NMEA0183.Vtg.TrackDegreesMagnetic + gVar;
+    double cogt = vtg.cog_magnetic + gVar;
     if (!std::isnan(cogt)) {
       if (cogt < 0)
         cogt += 360.0;
@@ -222,62 +149,37 @@ bool CommDecoder::DecodeVTG(std::string s, NavData& temp_data) {
   return true;
 }
 
-bool CommDecoder::DecodeGLL(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  if (m_NMEA0183.Gll.IsDataValid == NTrue) {
-    double tlat, tlon;
-    if (ParsePosition(m_NMEA0183.Gll.Position, tlat, tlon)) {
-      temp_data.gLat = tlat;
-      temp_data.gLon = tlon;
-    } else
-      return false;
-  } else
-    return false;
+bool CommDecoder::DecodeGLL(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Gll gll;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, gll)) return false;
+  if (!gll.is_valid) return false;
 
+  if (std::isnan(gll.lat) || std::isnan(gll.lon)) return false;
+  temp_data.gLat = gll.lat;
+  temp_data.gLon = gll.lon;
   return true;
 }
 
-bool CommDecoder::DecodeGSV(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  if (m_NMEA0183.Gsv.MessageNumber == 1)
-    temp_data.n_satellites = m_NMEA0183.Gsv.SatsInView;
+bool CommDecoder::DecodeGSV(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Gsv gsv;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, gsv)) return false;
 
+  if (gsv.message_number == 1) temp_data.n_satellites = gsv.n_satellites;
   return true;
 }
 
-bool CommDecoder::DecodeGGA(std::string s, NavData& temp_data) {
-  wxString sentence(s.c_str());
-  wxString sentence3 = ProcessNMEA4Tags(sentence);
-  m_NMEA0183 << sentence3;
-
-  if (!m_NMEA0183.PreParse()) return false;
-  if (!m_NMEA0183.Parse()) return false;
-
-  if (m_NMEA0183.Gga.GPSQuality > 0) {
-    double tlat, tlon;
-    if (ParsePosition(m_NMEA0183.Gga.Position, tlat, tlon)) {
-      temp_data.gLat = tlat;
-      temp_data.gLon = tlon;
-    } else
-      return false;
-
-    temp_data.n_satellites = m_NMEA0183.Gga.NumberOfSatellitesInUse;
-
-  } else
-    return false;
+bool CommDecoder::DecodeGGA(const std::string& s, NavData& temp_data) {
+  N0183Sentence sentence;
+  N0183Gga gga;
+  if (!sentence.Parse(s) || !DecodeN0183(sentence, gga)) return false;
+  if (gga.quality <= 0) return false;
 
+  if (std::isnan(gga.lat) || std::isnan(gga.lon)) return false;
+  temp_data.gLat = gga.lat;
+  temp_data.gLon = gga.lon;
+  temp_data.n_satellites = gga.n_satellites;
   return true;
 }
 
@@ -285,13 +187,13 @@ bool CommDecoder::DecodeGGA(std::string s, NavData& temp_data) {
 // NMEA2000 PGN Decode
 //---------------------------------------------------------------------
 
-bool CommDecoder::DecodePGN129026(std::vector<unsigned char> v,
+bool CommDecoder::DecodePGN129026(const tN2kMsg& msg,
                                   NavData& temp_data) {
   unsigned char SID;
   tN2kHeadingReference ref;
   double COG, SOG;
 
-  if (ParseN2kPGN129026(v, SID, ref, COG, SOG)) {
+  if (ParseN2kPGN129026(msg, SID, ref, COG, SOG)) {
     temp_data.gCog = COG;
     temp_data.gSog = SOG;
     temp_data.SID = SID;
@@ -301,7 +203,7 @@ bool CommDecoder::DecodePGN129026(std::vector<unsigned char> v,
   return false;
 }
 
-bool CommDecoder::DecodePGN129029(std::vector<unsigned char> v,
+bool CommDecoder::DecodePGN129029(const tN2kMsg& msg,
                                   NavData& temp_data) {
   unsigned char SID;
   uint16_t DaysSince1970;
@@ -316,7 +218,7 @@ bool CommDecoder::DecodePGN129029(std::vector<unsigned char> v,
   uint16_t ReferenceSationID;
   double AgeOfCorrection;
 
-  if (ParseN2kPGN129029(v, SID, DaysSince1970, SecondsSinceMidnight, Latitude,
+  if (ParseN2kPGN129029(msg, SID, DaysSince1970, SecondsSinceMidnight, Latitude,
                         Longitude, Altitude, GNSStype, GNSSmethod, nSatellites,
                         HDOP, PDOP, GeoidalSeparation, nReferenceStations,
                         ReferenceStationType, ReferenceSationID,
@@ -340,13 +242,13 @@ bool CommDecoder::DecodePGN129029(std::vector<unsigned char> v,
   return false;
 }
 
-bool CommDecoder::DecodePGN127250(std::vector<unsigned char> v,
+bool CommDecoder::DecodePGN127250(const tN2kMsg& msg,
                                   NavData& temp_data) {
   unsigned char SID;
   double Heading, Deviation, Variation;
   tN2kHeadingReference ref;
 
-  if (ParseN2kPGN127250(v, SID, Heading, Deviation, Variation, ref)) {
+  if (ParseN2kPGN127250(msg, SID, Heading, Deviation, Variation, ref)) {
     temp_data.gHdt = N2kDoubleNA;
     temp_data.gHdm = N2kDoubleNA;
     if (ref == tN2kHeadingReference::N2khr_true)
@@ -362,11 +264,11 @@ bool CommDecoder::DecodePGN127250(std::vector<unsigned char> v,
   return false;
 }
 
-bool CommDecoder::DecodePGN129025(std::vector<unsigned char> v,
+bool CommDecoder::DecodePGN129025(const tN2kMsg& msg,
                                   NavData& temp_data) {
   double Latitude, Longitude;
 
-  if (ParseN2kPGN129025(v, Latitude, Longitude)) {
+  if (ParseN2kPGN129025(msg, Latitude, Longitude)) {
     temp_data.gLat = Latitude;
     temp_data.gLon = Longitude;
     return true;
@@ -375,14 +277,14 @@ bool CommDecoder::DecodePGN129025(std::vector<unsigned char> v,
   return false;
 }
 
-bool CommDecoder::DecodePGN129540(std::vector<unsigned char> v,
+bool CommDecoder::DecodePGN129540(const tN2kMsg& msg,
                                   NavData& temp_data) {
   unsigned char SID;
   uint8_t NumberOfSVs;
   ;
   tN2kRangeResidualMode Mode;
 
-  if (ParseN2kPGN129540(v, SID, Mode, NumberOfSVs)) {
+  if (ParseN2kPGN129540(msg, SID, Mode, NumberOfSVs)) {
     temp_data.n_satellites = NumberOfSVs;
     temp_data.SID = SID;
     return true;
@@ -0,0 +1,106 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ *  \file
+ *  Implement comm_drv_capture.h
+ */
+
+#include <chrono>
+
+#include "model/comm_drv_capture.h"
+#include "model/logger.h"
+
+CaptureReplayDriver::CaptureReplayDriver(const std::string& path,
+                                         DriverListener& listener,
+                                         double speed)
+    : AbstractCommDriver(NavAddr::Bus::TestBus, path),
+      m_path(path),
+      m_listener(listener),
+      m_speed(speed < 0 ? 0 : speed),
+      m_stop(false),
+      m_running(false),
+      m_replayed(0) {
+  attributes["protocol"] = "capture";
+}
+
+CaptureReplayDriver::~CaptureReplayDriver() { Stop(); }
+
+bool CaptureReplayDriver::Start(uint64_t start_us) {
+  if (m_running) return false;
+  if (m_thread.joinable()) m_thread.join();
+  auto reader = std::make_unique<CaptureReader>();
+  if (!reader->Open(m_path)) {
+    WARNING_LOG << "Cannot open capture file " << m_path;
+    return false;
+  }
+  if (start_us) reader->Seek(start_us);
+  m_reader = std::move(reader);
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = false;
+  }
+  m_replayed = 0;
+  m_running = true;
+  m_thread = std::thread([this] { Worker(); });
+  return true;
+}
+
+void CaptureReplayDriver::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_all();
+  if (m_thread.joinable()) m_thread.join();
+}
+
+void CaptureReplayDriver::Worker() {
+  using namespace std::chrono;
+
+  CaptureReader& reader = *m_reader;
+  CaptureRecord record;
+  bool first = true;
+  uint64_t capture_base = 0;
+  steady_clock::time_point wall_base;
+  while (reader.Next(record)) {
+    if (m_speed > 0) {
+      if (first) {
+        capture_base = record.timestamp_us;
+        wall_base = steady_clock::now();
+        first = false;
+      }
+      uint64_t delta_us = record.timestamp_us > capture_base
+                              ? record.timestamp_us - capture_base
+                              : 0;
+      auto when = wall_base + microseconds(static_cast<int64_t>(
+                                  static_cast<double>(delta_us) / m_speed));
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_cv.wait_until(lock, when, [&] { return m_stop; })) break;
+    } else {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      if (m_stop) break;
+    }
+    auto msg = record.ToNavMsg();
+    if (msg) {
+      m_listener.Notify(std::move(msg));
+      m_replayed++;
+    }
+  }
+  m_running = false;
+  m_listener.Notify(*this);
+}
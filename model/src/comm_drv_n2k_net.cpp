@@ -166,7 +166,7 @@ private:
   std::shared_ptr<std::vector<unsigned char>> m_payload;
 };
 
-static uint64_t PayloadToName(const std::vector<unsigned char> payload) {
+static uint64_t PayloadToName(const std::vector<unsigned char>& payload) {
   uint64_t name;
   memcpy(&name, reinterpret_cast<const void*>(payload.data()), sizeof(name));
   return name;
@@ -264,10 +264,6 @@ std::unordered_map<uint8_t, product_info> prod_info_map;
 bool CommDriverN2KNet::HandleMgntMsg(uint64_t pgn,
                                      std::vector<unsigned char>& payload) {
   // Process a few N2K network management messages
-  auto name = PayloadToName(payload);
-  auto msg =
-      std::make_shared<const Nmea2000Msg>(pgn, payload, GetAddress(name));
-
   bool b_handled = false;
   switch (pgn) {
     case 126996: {  // Product information
@@ -325,9 +321,10 @@ void CommDriverN2KNet::handle_N2K_MSG(CommDriverN2KNetEvent& event) {
   // printf("          %ld\n", pgn);
 
   auto name = PayloadToName(*payload);
-  auto msg =
-      std::make_shared<const Nmea2000Msg>(pgn, *payload, GetAddress(name));
   m_driver_stats.rx_count += payload->size();
+  // The event payload is not used after this, hand it over to the message.
+  auto msg = std::make_shared<const Nmea2000Msg>(pgn, std::move(*payload),
+                                                 GetAddress(name));
   m_listener.Notify(std::move(msg));
 }
 
@@ -527,6 +524,7 @@ std::vector<unsigned char> CommDriverN2KNet::PrepareLogPayload(
 std::vector<unsigned char> CommDriverN2KNet::PushCompleteMsg(
     const CanHeader header, int position, const can_frame frame) {
   std::vector<unsigned char> data;
+  data.reserve(CAN_MAX_DLEN + 14);
   data.push_back(0x93);
   data.push_back(0x13);
   data.push_back(header.priority);
@@ -547,9 +545,11 @@ std::vector<unsigned char> CommDriverN2KNet::PushCompleteMsg(
 
 std::vector<unsigned char> CommDriverN2KNet::PushFastMsgFragment(
     const CanHeader& header, int position) {
+  const FastMessageMap::Entry& entry = (*fast_messages)[position];
   std::vector<unsigned char> data;
+  data.reserve(entry.expected_length + 14);
   data.push_back(0x93);
-  data.push_back(fast_messages->entries[position].expected_length + 11);
+  data.push_back(entry.expected_length + 11);
   data.push_back(header.priority);
   data.push_back(header.pgn & 0xFF);
   data.push_back((header.pgn >> 8) & 0xFF);
@@ -560,9 +560,9 @@ std::vector<unsigned char> CommDriverN2KNet::PushFastMsgFragment(
   data.push_back(0xFF);
   data.push_back(0xFF);
   data.push_back(0xFF);
-  data.push_back(fast_messages->entries[position].expected_length);
-  for (size_t n = 0; n < fast_messages->entries[position].expected_length; n++)
-    data.push_back(fast_messages->entries[position].data[n]);
+  data.push_back(entry.expected_length);
+  data.insert(data.end(), entry.data.begin(),
+              entry.data.begin() + entry.expected_length);
   data.push_back(0x55);  // CRC dummy
   fast_messages->Remove(position);
   return data;
@@ -574,7 +574,7 @@ std::vector<unsigned char> CommDriverN2KNet::PushFastMsgFragment(
  * layers. Otherwise, the fast message fragment is stored waiting for
  * next fragment.
  */
-void CommDriverN2KNet::HandleCanFrameInput(can_frame frame) {
+void CommDriverN2KNet::HandleCanFrameInput(const can_frame& frame) {
   int position = -1;
   bool ready = true;
 
@@ -613,7 +613,7 @@ void CommDriverN2KNet::HandleCanFrameInput(can_frame frame) {
 
     // Message is ready
     CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
-    auto payload = std::make_shared<std::vector<uint8_t>>(vec);
+    auto payload = std::make_shared<std::vector<uint8_t>>(std::move(vec));
     Nevent.SetPayload(payload);
     AddPendingEvent(Nevent);
   }
@@ -721,7 +721,7 @@ bool CommDriverN2KNet::ProcessActisense_N2K(std::vector<unsigned char> packet) {
             // Message is ready
             CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
             auto n2k_payload =
-                std::make_shared<std::vector<uint8_t>>(o_payload);
+                std::make_shared<std::vector<uint8_t>>(std::move(o_payload));
             Nevent.SetPayload(n2k_payload);
             AddPendingEvent(Nevent);
           }
@@ -864,7 +864,8 @@ bool CommDriverN2KNet::ProcessActisense_NGT(std::vector<unsigned char> packet) {
         } else if (next_byte == ENDOFTEXT) {
           // Process packet
           CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
-          auto n2k_payload = std::make_shared<std::vector<uint8_t>>(data);
+          auto n2k_payload =
+              std::make_shared<std::vector<uint8_t>>(std::move(data));
           Nevent.SetPayload(n2k_payload);
           AddPendingEvent(Nevent);
 
@@ -1026,7 +1027,8 @@ bool CommDriverN2KNet::ProcessActisense_ASCII_N2K(
 
       // Message is ready
       CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
-      auto n2k_payload = std::make_shared<std::vector<uint8_t>>(o_payload);
+      auto n2k_payload =
+          std::make_shared<std::vector<uint8_t>>(std::move(o_payload));
       Nevent.SetPayload(n2k_payload);
       AddPendingEvent(Nevent);
     }
@@ -1097,7 +1099,8 @@ bool CommDriverN2KNet::ProcessSeaSmart(std::vector<unsigned char> packet) {
 
       // Message is ready
       CommDriverN2KNetEvent Nevent(wxEVT_COMMDRIVER_N2K_NET, 0);
-      auto n2k_payload = std::make_shared<std::vector<uint8_t>>(o_payload);
+      auto n2k_payload =
+          std::make_shared<std::vector<uint8_t>>(std::move(o_payload));
       Nevent.SetPayload(n2k_payload);
       AddPendingEvent(Nevent);
     }
@@ -107,7 +107,7 @@ private:
 
   int InitSocket(const std::string port_name);
   void SocketMessage(const std::string& msg, const std::string& device);
-  void HandleInput(CanFrame frame);
+  void HandleInput(const CanFrame& frame);
   void ProcessRxMessages(std::shared_ptr<const Nmea2000Msg> n2k_msg);
 
   std::vector<unsigned char> PushCompleteMsg(const CanHeader header,
@@ -409,6 +409,7 @@ std::vector<unsigned char> Worker::PushCompleteMsg(const CanHeader header,
                                                    int position,
                                                    const CanFrame frame) {
   std::vector<unsigned char> data;
+  data.reserve(CAN_MAX_DLEN + 14);
   data.push_back(0x93);
   data.push_back(0x13);
   data.push_back(header.priority);
@@ -429,9 +430,11 @@ std::vector<unsigned char> Worker::PushCompleteMsg(const CanHeader header,
 
 std::vector<unsigned char> Worker::PushFastMsgFragment(const CanHeader& header,
                                                        int position) {
+  const FastMessageMap::Entry& entry = fast_messages[position];
   std::vector<unsigned char> data;
+  data.reserve(entry.expected_length + 14);
   data.push_back(0x93);
-  data.push_back(fast_messages[position].expected_length + 11);
+  data.push_back(entry.expected_length + 11);
   data.push_back(header.priority);
   data.push_back(header.pgn & 0xFF);
   data.push_back((header.pgn >> 8) & 0xFF);
@@ -442,9 +445,9 @@ std::vector<unsigned char> Worker::PushFastMsgFragment(const CanHeader& header,
   data.push_back(0xFF);
   data.push_back(0xFF);
   data.push_back(0xFF);
-  data.push_back(fast_messages[position].expected_length);
-  for (size_t n = 0; n < fast_messages[position].expected_length; n++)
-    data.push_back(fast_messages[position].data[n]);
+  data.push_back(entry.expected_length);
+  data.insert(data.end(), entry.data.begin(),
+              entry.data.begin() + entry.expected_length);
   data.push_back(0x55);  // CRC dummy
   fast_messages.Remove(position);
   return data;
@@ -527,7 +530,7 @@ int Worker::InitSocket(const std::string port_name) {
  * layers. Otherwise, the fast message fragment is stored waiting for
  * next fragment.
  */
-void Worker::HandleInput(CanFrame frame) {
+void Worker::HandleInput(const CanFrame& frame) {
   int position = -1;
   bool ready = true;
 
@@ -554,13 +557,15 @@ void Worker::HandleInput(CanFrame frame) {
     }
     // auto name = N2kName(static_cast<uint64_t>(header.pgn));
     auto src_addr = m_parent_driver->GetAddress(m_parent_driver->node_name);
-    auto msg = std::make_shared<const Nmea2000Msg>(header.pgn, vec, src_addr);
+    size_t rx_bytes = vec.size();
+    auto msg = std::make_shared<const Nmea2000Msg>(header.pgn, std::move(vec),
+                                                   src_addr);
 
     ProcessRxMessages(msg);
     m_parent_driver->m_listener.Notify(std::move(msg));
 
     DriverStats stats = m_parent_driver->GetDriverStats();
-    stats.rx_count += vec.size();
+    stats.rx_count += rx_bytes;
     m_parent_driver->SetDriverStats(stats);
   }
 }
@@ -37,6 +37,8 @@
 #include "model/comm_driver.h"
 #include "model/ocpn_utils.h"
 
+#include "N2KParser.h"
+
 std::string NavAddr::BusToString(NavAddr::Bus b) {
   switch (b) {
     case NavAddr::Bus::N0183:
@@ -131,6 +133,20 @@ std::string Nmea2000Msg::to_vdr() const {
   return s;
 }
 
+const tN2kMsg& Nmea2000Msg::GetN2kMsg() const {
+  auto n2k_msg = std::atomic_load(&m_n2k_msg);
+  if (!n2k_msg) {
+    auto decoded = std::make_shared<tN2kMsg>();
+    MakeN2kMsg(payload, *decoded);
+    // If another thread got here first, use its copy and drop ours.
+    std::shared_ptr<const tN2kMsg> expected;
+    n2k_msg = decoded;
+    if (!std::atomic_compare_exchange_strong(&m_n2k_msg, &expected, n2k_msg))
+      n2k_msg = expected;
+  }
+  return *n2k_msg;
+}
+
 std::string Nmea0183Msg::to_string() const {
   std::stringstream ss;
   ss << key() << " " << talker << type << " " << ocpn::printable(payload);
@@ -24,8 +24,10 @@
  */
 
 #include "model/comm_navmsg_bus.h"
+#include "model/pipeline_stats.h"
 
 void NavMsgBus::Notify(std::shared_ptr<const NavMsg> msg) {
+  PipelineStats::GetInstance().Record(PipelineStage::kBusNotify, *msg);
   std::string key = NavAddr::BusToString(msg->bus) + "::" + msg->GetKey();
   RegisterKey(key);
   Observable(*msg).Notify(msg);
@@ -101,8 +101,10 @@ void DataMonitorSrc::OnNewMessage() {
 
 void DataMonitorSrc::OnMessage(ObservedEvt& ev) {
   auto ptr = UnpackEvtPointer<NavMsg>(ev);
-  if (ptr && ptr->to_string() != m_last_payload) {
-    m_last_payload = ptr->to_string();
+  if (!ptr) return;
+  std::string payload = ptr->to_string();
+  if (payload != m_last_payload) {
+    m_last_payload = std::move(payload);
     m_sink_func(ptr);
   }
 }
@@ -587,10 +587,20 @@ void toTM(float lat, float lon, float lat0, float lon0, double *x, double *y) {
   const double LongOriginRad = lon0 * DEGREE;
   const double LongRad = lon * DEGREE;
 
-  const double N = a / sqrt(1 - eccSquared * sin(LatRad) * sin(LatRad));
-  const double T = tan(LatRad) * tan(LatRad);
-  const double C = eccPrimeSquared * cos(LatRad) * cos(LatRad);
-  const double A = cos(LatRad) * (LongRad - LongOriginRad);
+  //  The multiple angle sines follow from sin and cos of the latitude
+  const double sinLat = sin(LatRad);
+  const double cosLat = cos(LatRad);
+  const double tanLat = sinLat / cosLat;
+  const double sin2Lat = 2 * sinLat * cosLat;
+  const double cos2Lat = 1 - 2 * sinLat * sinLat;
+  const double sin4Lat = 2 * sin2Lat * cos2Lat;
+  const double cos4Lat = 1 - 2 * sin2Lat * sin2Lat;
+  const double sin6Lat = sin4Lat * cos2Lat + cos4Lat * sin2Lat;
+
+  const double N = a / sqrt(1 - eccSquared * sinLat * sinLat);
+  const double T = tanLat * tanLat;
+  const double C = eccPrimeSquared * cosLat * cosLat;
+  const double A = cosLat * (LongRad - LongOriginRad);
 
   const double MM =
       a *
@@ -599,11 +609,11 @@ void toTM(float lat, float lon, float lat0, float lon0, double *x, double *y) {
            LatRad -
        (3 * eccSquared / 8 + 3 * eccSquared * eccSquared / 32 +
         45 * eccSquared * eccSquared * eccSquared / 1024) *
-           sin(2 * LatRad) +
+           sin2Lat +
        (15 * eccSquared * eccSquared / 256 +
         45 * eccSquared * eccSquared * eccSquared / 1024) *
-           sin(4 * LatRad) -
-       (35 * eccSquared * eccSquared * eccSquared / 3072) * sin(6 * LatRad));
+           sin4Lat -
+       (35 * eccSquared * eccSquared * eccSquared / 3072) * sin6Lat);
 
   *x = (k0 * N *
         (A + (1 - T + C) * A * A * A / 6 +
@@ -612,7 +622,7 @@ void toTM(float lat, float lon, float lat0, float lon0, double *x, double *y) {
 
   *y =
       (k0 *
-       (MM + N * tan(LatRad) *
+       (MM + N * tanLat *
                  (A * A / 2 + (5 - T + 9 * C + 4 * C * C) * A * A * A * A / 24 +
                   (61 - 58 * T + T * T + 600 * C - 330 * eccPrimeSquared) * A *
                       A * A * A * A * A / 720)));
@@ -0,0 +1,315 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement gshhs_crossing.h
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include "model/gshhs_crossing.h"
+
+/** File header, 12 ints, see PolygonFileHeader in gshhs.h */
+static const size_t kHeaderSize = 12 * sizeof(int32_t);
+
+static const int kLonCells = 360;
+static const int kLatCells = 180;
+static const int kSubs = GshhsCrossing::kSubCells;
+
+/** Convert micro-degrees to degrees. */
+static const double kScale = 1.0e-6;
+
+/** Margin in sub-cell units when selecting the sub-cells to visit. */
+static const double kGridEps = 1e-3;
+
+/** Min number of segments per thread in batch tests. */
+static const size_t kMinBatch = 256;
+
+/**
+ * Coastline segments in the 16 x 16 sub-cells of a 1 degree cell. The
+ * segments of sub-cell i are at [offsets[i], offsets[i + 1]) in the
+ * coordinate arrays.
+ */
+struct GshhsCrossing::Cell {
+  uint32_t offsets[kSubs * kSubs + 1];
+  std::vector<double> x1;
+  std::vector<double> y1;
+  std::vector<double> x2;
+  std::vector<double> y2;
+
+  Cell() { std::fill(std::begin(offsets), std::end(offsets), 0); }
+};
+
+static inline int FloorDiv(int a, int b) {
+  return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+/**
+ * Segment intersection, based on Graphics Gems III's "Faster Line Segment
+ * Intersection". Kept identical to the test formerly in gshhs.cpp.
+ */
+static inline bool Intersects(double x1, double y1, double x2, double y2,
+                              double x3, double y3, double x4, double y4) {
+  const double kInterLimit = 1e-7;
+  double ax = x2 - x1, ay = y2 - y1;
+  double bx = x3 - x4, by = y3 - y4;
+  double cx = x1 - x3, cy = y1 - y3;
+
+  double denominator = ay * bx - ax * by;
+  if (denominator < 1e-10) {
+    if (std::fabs((y1 * ax - ay * x1) * bx - (y3 * bx - by * x3) * ax) >
+        kInterLimit)
+      return false; /* different intercepts, no intersection */
+    if (std::fabs((x1 * ay - ax * y1) * by - (x3 * by - bx * y3) * ay) >
+        kInterLimit)
+      return false; /* different intercepts, no intersection */
+    return true;
+  }
+
+  const double reciprocal = 1 / denominator;
+  const double na = (by * cx - bx * cy) * reciprocal;
+  if (na < -kInterLimit || na > 1 + kInterLimit) return false;
+
+  const double nb = (ax * cy - ay * cx) * reciprocal;
+  if (nb < -kInterLimit || nb > 1 + kInterLimit) return false;
+  return true;
+}
+
+/** Bounds checked reader of the mapped file. */
+class MappedReader {
+public:
+  MappedReader(const unsigned char* data, size_t size, size_t pos)
+      : m_data(data), m_size(size), m_pos(pos), m_ok(pos <= size) {}
+
+  template <typename T>
+  T Read() {
+    T value = T();
+    if (!m_ok || m_size - m_pos < sizeof(T)) {
+      m_ok = false;
+      return value;
+    }
+    memcpy(&value, m_data + m_pos, sizeof(T));
+    m_pos += sizeof(T);
+    return value;
+  }
+
+  bool IsOk() const { return m_ok; }
+
+private:
+  const unsigned char* m_data;
+  size_t m_size;
+  size_t m_pos;
+  bool m_ok;
+};
+
+GshhsCrossing::GshhsCrossing(const std::string& path)
+    : m_file(path), m_cells(new std::atomic<Cell*>[kLonCells * kLatCells]) {
+  for (int i = 0; i < kLonCells * kLatCells; i++) m_cells[i] = nullptr;
+  if (m_file.GetSize() < kHeaderSize + kLonCells * kLatCells * 4)
+    m_file.Close();
+}
+
+GshhsCrossing::~GshhsCrossing() {
+  for (int i = 0; i < kLonCells * kLatCells; i++) delete m_cells[i].load();
+}
+
+int GshhsCrossing::GetVersion() const {
+  if (!m_file.IsOk()) return 0;
+  return MappedReader(m_file.GetData(), m_file.GetSize(), 0).Read<int32_t>();
+}
+
+GshhsCrossing::Cell* GshhsCrossing::BuildCell(int lon, int lat) const {
+  struct Edge {
+    double x1, y1, x2, y2;
+    int imin, imax, jmin, jmax;
+  };
+  auto cell = new Cell();
+
+  // Offset table follows the header, one int per cell. Only the first
+  // polygon list (land) is used.
+  size_t tab = lon * kLatCells + (lat + 90);
+  MappedReader table(m_file.GetData(), m_file.GetSize(),
+                     kHeaderSize + tab * sizeof(int32_t));
+  auto pos = table.Read<int32_t>();
+  if (!table.IsOk() || pos < 0) return cell;
+  MappedReader reader(m_file.GetData(), m_file.GetSize(),
+                      static_cast<size_t>(pos));
+
+  std::vector<Edge> edges;
+  std::vector<double> xs, ys;
+  auto num_contours = reader.Read<int32_t>();
+  for (int c = 0; c < num_contours && reader.IsOk(); c++) {
+    reader.Read<int32_t>();  // hole flag, unused
+    auto num_vertices = reader.Read<int32_t>();
+    xs.clear();
+    ys.clear();
+    for (int v = 0; v < num_vertices && reader.IsOk(); v++) {
+      xs.push_back(reader.Read<double>() * kScale);
+      ys.push_back(reader.Read<double>() * kScale);
+    }
+    if (!reader.IsOk() || xs.empty()) break;
+
+    double lx = xs.back(), ly = ys.back();
+    for (size_t v = 0; v < xs.size(); v++) {
+      double x = xs[v], y = ys[v];
+      // Zero length segments confuse the intersection test, skip.
+      if (lx == x && ly == y) continue;
+      // Sub-cells whose closed bounds overlap the segment bounding box.
+      Edge e = {lx, ly, x, y, 0, 0, 0, 0};
+      e.imin = static_cast<int>(std::ceil((std::min(lx, x) - lon) * kSubs)) - 1;
+      e.imax = static_cast<int>(std::floor((std::max(lx, x) - lon) * kSubs));
+      e.jmin = static_cast<int>(std::ceil((std::min(ly, y) - lat) * kSubs)) - 1;
+      e.jmax = static_cast<int>(std::floor((std::max(ly, y) - lat) * kSubs));
+      e.imin = std::max(e.imin, 0);
+      e.jmin = std::max(e.jmin, 0);
+      e.imax = std::min(e.imax, kSubs - 1);
+      e.jmax = std::min(e.jmax, kSubs - 1);
+      if (e.imin <= e.imax && e.jmin <= e.jmax) edges.push_back(e);
+      lx = x;
+      ly = y;
+    }
+  }
+
+  // Count, then fill the sub-cell ranges.
+  uint32_t counts[kSubs * kSubs] = {0};
+  for (const auto& e : edges) {
+    for (int j = e.jmin; j <= e.jmax; j++)
+      for (int i = e.imin; i <= e.imax; i++) counts[j * kSubs + i]++;
+  }
+  for (int s = 0; s < kSubs * kSubs; s++)
+    cell->offsets[s + 1] = cell->offsets[s] + counts[s];
+  size_t total = cell->offsets[kSubs * kSubs];
+  cell->x1.resize(total);
+  cell->y1.resize(total);
+  cell->x2.resize(total);
+  cell->y2.resize(total);
+  std::copy(cell->offsets, cell->offsets + kSubs * kSubs, counts);
+  for (const auto& e : edges) {
+    for (int j = e.jmin; j <= e.jmax; j++) {
+      for (int i = e.imin; i <= e.imax; i++) {
+        uint32_t k = counts[j * kSubs + i]++;
+        cell->x1[k] = e.x1;
+        cell->y1[k] = e.y1;
+        cell->x2[k] = e.x2;
+        cell->y2[k] = e.y2;
+      }
+    }
+  }
+  return cell;
+}
+
+const GshhsCrossing::Cell& GshhsCrossing::GetCell(int lon, int lat) const {
+  std::atomic<Cell*>& slot = m_cells[lon * kLatCells + (lat + 90)];
+  Cell* cell = slot.load(std::memory_order_acquire);
+  if (cell) return *cell;
+  // Racing threads may both build the cell; the first one published wins.
+  Cell* built = BuildCell(lon, lat);
+  if (slot.compare_exchange_strong(cell, built, std::memory_order_acq_rel))
+    return *built;
+  delete built;
+  return *cell;
+}
+
+bool GshhsCrossing::CrossesGrid(double x1, double y1, double x2,
+                                double y2) const {
+  // Sweep the sub-cell columns covered by the segment, visiting in each
+  // the rows between the segment's entry and exit.
+  const double u1 = x1 * kSubs, v1 = y1 * kSubs;
+  const double u2 = x2 * kSubs, v2 = y2 * kSubs;
+  const int cmin = static_cast<int>(std::floor(std::min(u1, u2) - kGridEps));
+  const int cmax = static_cast<int>(std::floor(std::max(u1, u2) + kGridEps));
+  const int rlimit = kLatCells / 2 * kSubs;
+
+  for (int c = cmin; c <= cmax; c++) {
+    double vlo = std::min(v1, v2), vhi = std::max(v1, v2);
+    if (u1 != u2) {
+      double ta = (c - kGridEps - u1) / (u2 - u1);
+      double tb = (c + 1 + kGridEps - u1) / (u2 - u1);
+      ta = std::min(std::max(ta, 0.0), 1.0);
+      tb = std::min(std::max(tb, 0.0), 1.0);
+      double va = v1 + ta * (v2 - v1), vb = v1 + tb * (v2 - v1);
+      vlo = std::min(va, vb);
+      vhi = std::max(va, vb);
+    }
+    int rmin = std::max(static_cast<int>(std::floor(vlo - kGridEps)), -rlimit);
+    int rmax =
+        std::min(static_cast<int>(std::floor(vhi + kGridEps)), rlimit - 1);
+
+    // Cell polygons use longitudes around the cell, shift the segment.
+    int cell_x = FloorDiv(c, kSubs);
+    int lon = ((cell_x % kLonCells) + kLonCells) % kLonCells;
+    double shift = lon - cell_x;
+    double sx1 = x1 + shift, sx2 = x2 + shift;
+    int i = c - cell_x * kSubs;
+
+    for (int r = rmin; r <= rmax; r++) {
+      int lat = FloorDiv(r, kSubs);
+      int sub = (r - lat * kSubs) * kSubs + i;
+      const Cell& cell = GetCell(lon, lat);
+      for (uint32_t k = cell.offsets[sub]; k < cell.offsets[sub + 1]; k++) {
+        if (Intersects(sx1, y1, sx2, y2, cell.x1[k], cell.y1[k], cell.x2[k],
+                       cell.y2[k]))
+          return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool GshhsCrossing::CrossesLand(double lat1, double lon1, double lat2,
+                                double lon2) const {
+  if (!m_file.IsOk()) return false;
+  if (lon1 < 0) lon1 += 360;
+  if (lon2 < 0) lon2 += 360;
+  // Don't go the long way around the world.
+  if (lon2 - lon1 > 180)
+    lon2 -= 360;
+  else if (lon1 - lon2 > 180)
+    lon2 += 360;
+  return CrossesGrid(lon1, lat1, lon2, lat2);
+}
+
+void GshhsCrossing::CrossesLand(const std::vector<Segment>& segments,
+                                std::vector<char>& crosses,
+                                unsigned threads) const {
+  crosses.assign(segments.size(), 0);
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t max_threads = std::max<size_t>(1, segments.size() / kMinBatch);
+  threads = static_cast<unsigned>(std::min<size_t>(threads, max_threads));
+
+  auto run = [&](size_t first, size_t last) {
+    for (size_t i = first; i < last; i++) {
+      const Segment& s = segments[i];
+      crosses[i] = CrossesLand(s.lat1, s.lon1, s.lat2, s.lon2) ? 1 : 0;
+    }
+  };
+  std::vector<std::thread> workers;
+  size_t chunk = (segments.size() + threads - 1) / threads;
+  for (unsigned t = 1; t < threads; t++) {
+    size_t first = t * chunk;
+    size_t last = std::min(segments.size(), first + chunk);
+    if (first < last) workers.emplace_back(run, first, last);
+  }
+  run(0, std::min(segments.size(), chunk));
+  for (auto& worker : workers) worker.join();
+}
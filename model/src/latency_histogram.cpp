@@ -0,0 +1,88 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement latency_histogram.h
+ */
+
+#include "model/latency_histogram.h"
+
+static const auto kRelaxed = std::memory_order_relaxed;
+
+int LatencyHistogram::BucketIndex(uint64_t ns) {
+  if (ns < (1u << kSubBits)) return static_cast<int>(ns);
+  if (ns >= (1ULL << kMaxExp)) return kBuckets - 1;
+  int msb = 0;
+  for (int shift = 32; shift > 0; shift /= 2) {
+    if (ns >> (msb + shift)) msb += shift;
+  }
+  int sub = static_cast<int>(ns >> (msb - kSubBits)) & ((1 << kSubBits) - 1);
+  return ((msb - kSubBits + 1) << kSubBits) + sub;
+}
+
+uint64_t LatencyHistogram::BucketLow(int index) {
+  if (index < (1 << kSubBits)) return index;
+  int msb = (index >> kSubBits) + kSubBits - 1;
+  uint64_t sub = index & ((1 << kSubBits) - 1);
+  return ((1ULL << kSubBits) + sub) << (msb - kSubBits);
+}
+
+void LatencyHistogram::Record(uint64_t ns) {
+  m_buckets[BucketIndex(ns)].fetch_add(1, kRelaxed);
+  m_sum.fetch_add(ns, kRelaxed);
+  uint64_t max = m_max.load(kRelaxed);
+  while (ns > max && !m_max.compare_exchange_weak(max, ns, kRelaxed)) {
+  }
+}
+
+uint64_t LatencyHistogram::Percentile(double q) const {
+  uint64_t count = GetCount();
+  if (count == 0) return 0;
+  auto rank = static_cast<uint64_t>(q * count);
+  if (rank >= count) rank = count - 1;
+  uint64_t seen = 0;
+  for (int i = 0; i < kBuckets; i++) {
+    seen += m_buckets[i].load(kRelaxed);
+    if (seen > rank) {
+      // Report bucket midpoint, but never more than the recorded max.
+      uint64_t low = BucketLow(i);
+      uint64_t high = i + 1 < kBuckets ? BucketLow(i + 1) : low;
+      uint64_t value = low + (high - low) / 2;
+      return value < GetMax() ? value : GetMax();
+    }
+  }
+  return GetMax();
+}
+
+uint64_t LatencyHistogram::GetCount() const {
+  uint64_t count = 0;
+  for (const auto& bucket : m_buckets) count += bucket.load(kRelaxed);
+  return count;
+}
+
+uint64_t LatencyHistogram::GetMean() const {
+  uint64_t count = GetCount();
+  return count ? m_sum.load(kRelaxed) / count : 0;
+}
+
+void LatencyHistogram::Reset() {
+  for (auto& bucket : m_buckets) bucket.store(0, kRelaxed);
+  m_sum.store(0, kRelaxed);
+  m_max.store(0, kRelaxed);
+}
@@ -0,0 +1,162 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement ll_projector.h
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "model/georef.h"
+#include "model/ll_projector.h"
+
+//  Points are projected to meters a block at a time, then all transformed
+//  to pixels in a loop the compiler vectorizes.
+static const size_t kBlock = 128;
+
+/** Make lon the same phase as lon0, like ViewPort::GetDoublePixFromLL(). */
+static inline double SamePhase(double lon, double lon0) {
+  if (lon * lon0 < 0.) lon += lon < 0. ? 360. : -360.;
+  if (fabs(lon - lon0) > 180.) lon += lon > lon0 ? -360. : 360.;
+  return lon;
+}
+
+LLProjector::LLProjector(Type type, double clat, double clon)
+    : m_type(type),
+      m_clat(clat),
+      m_clon(clon),
+      m_cache0(0),
+      m_cache1(0),
+      m_center_easting(0),
+      m_center_northing(0) {
+  switch (type) {
+    case Type::kMercator:
+      m_cache0 = toSMcache_y30(clat);
+      break;
+    case Type::kTransverseMercator:
+      //  Northings referenced to the equator, eastings as though the
+      //  projection point is midscreen
+      toTM(clat, clon, 0., clon, &m_center_easting, &m_center_northing);
+      break;
+    case Type::kPolyconic: {
+      //  Only northings are referenced to the projection point
+      double easting;
+      toPOLY(clat, clon, 0., clon, &easting, &m_center_northing);
+      break;
+    }
+    case Type::kPolar:
+      m_cache0 = toPOLARcache_e(clat);
+      break;
+    case Type::kOrthographic:
+    case Type::kStereographic:
+    case Type::kGnomonic:
+      cache_phi0(clat, &m_cache0, &m_cache1);
+      break;
+    case Type::kEquirectangular:
+      break;
+  }
+  SetTransform(1., 0., 0., 0., 1.);
+}
+
+void LLProjector::SetTransform(double ppm, double rotation, double x0,
+                               double y0, double scale) {
+  double c = rotation ? cos(rotation) : 1.;
+  double s = rotation ? sin(rotation) : 0.;
+  m_xe = c * ppm * scale;
+  m_xn = s * ppm * scale;
+  m_x0 = x0 * scale;
+  m_ye = s * ppm * scale;
+  m_yn = -c * ppm * scale;
+  m_y0 = y0 * scale;
+}
+
+void LLProjector::Project(const double* lat, const double* lon, size_t n,
+                          float* out, size_t stride) const {
+  ProjectPoints(lat, lon, n, out, stride);
+}
+
+void LLProjector::Project(const float* lat, const float* lon, size_t n,
+                          float* out, size_t stride) const {
+  ProjectPoints(lat, lon, n, out, stride);
+}
+
+template <typename T>
+void LLProjector::ProjectPoints(const T* lat, const T* lon, size_t n,
+                                float* out, size_t stride) const {
+  double easting[kBlock];
+  double northing[kBlock];
+  for (size_t first = 0; first < n; first += kBlock) {
+    const size_t count = std::min(kBlock, n - first);
+    const T* plat = lat + first * stride;
+    const T* plon = lon + first * stride;
+
+    //  One loop per projection, no per point dispatch
+    switch (m_type) {
+      case Type::kMercator:
+        for (size_t i = 0; i < count; i++)
+          toSMcache(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                    m_cache0, m_clon, easting + i, northing + i);
+        break;
+      case Type::kTransverseMercator:
+        for (size_t i = 0; i < count; i++)
+          toTM(plat[i * stride], SamePhase(plon[i * stride], m_clon), 0.,
+               m_clon, easting + i, northing + i);
+        break;
+      case Type::kPolyconic:
+        for (size_t i = 0; i < count; i++)
+          toPOLY(plat[i * stride], SamePhase(plon[i * stride], m_clon), 0.,
+                 m_clon, easting + i, northing + i);
+        break;
+      case Type::kOrthographic:
+        for (size_t i = 0; i < count; i++)
+          toORTHO(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                  m_cache0, m_cache1, m_clon, easting + i, northing + i);
+        break;
+      case Type::kPolar:
+        for (size_t i = 0; i < count; i++)
+          toPOLAR(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                  m_cache0, m_clat, m_clon, easting + i, northing + i);
+        break;
+      case Type::kStereographic:
+        for (size_t i = 0; i < count; i++)
+          toSTEREO(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                   m_cache0, m_cache1, m_clon, easting + i, northing + i);
+        break;
+      case Type::kGnomonic:
+        for (size_t i = 0; i < count; i++)
+          toGNO(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                m_cache0, m_cache1, m_clon, easting + i, northing + i);
+        break;
+      case Type::kEquirectangular:
+        for (size_t i = 0; i < count; i++)
+          toEQUIRECT(plat[i * stride], SamePhase(plon[i * stride], m_clon),
+                     m_clat, m_clon, easting + i, northing + i);
+        break;
+    }
+
+    float* pout = out + 2 * first;
+    for (size_t i = 0; i < count; i++) {
+      const double e = easting[i] - m_center_easting;
+      const double nn = northing[i] - m_center_northing;
+      pout[2 * i] = float(m_xe * e + m_xn * nn + m_x0);
+      pout[2 * i + 1] = float(m_ye * e + m_yn * nn + m_y0);
+    }
+  }
+}
@@ -0,0 +1,138 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement logline_buffer.h
+ */
+
+#include <algorithm>
+
+#include "model/logline_buffer.h"
+
+/** Lines copied from the ring per worker lock. */
+static const size_t kScanChunk = 4096;
+
+/** Smaller histories are rescanned by the next Update(). */
+static const size_t kInlineScanLimit = 20000;
+
+LoglineBuffer::LoglineBuffer(size_t capacity, bool background)
+    : m_capacity(std::max(capacity, size_t(1))),
+      m_background(background),
+      m_head(0),
+      m_scanned(0),
+      m_cancel(false),
+      m_scan_done(false) {}
+
+LoglineBuffer::~LoglineBuffer() { StopScan(); }
+
+void LoglineBuffer::Add(const Logline& line) {
+  auto ptr = std::make_shared<const Logline>(line);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_lines.size() < m_capacity)
+    m_lines.push_back(std::move(ptr));
+  else
+    m_lines[m_head % m_capacity] = std::move(ptr);
+  m_head++;
+}
+
+void LoglineBuffer::Clear() {
+  StopScan();
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lines.clear();
+    m_head = 0;
+  }
+  m_matches.clear();
+  m_scanned = 0;
+}
+
+void LoglineBuffer::SetFilter(Filter filter) {
+  StopScan();
+  m_filter = std::move(filter);
+  m_matches.clear();
+  m_scanned = Tail();
+  if (m_background && m_head - m_scanned > kInlineScanLimit) {
+    m_cancel = false;
+    m_scan_done = false;
+    m_worker = std::thread(&LoglineBuffer::Scan, this, m_scanned, m_head,
+                           m_filter);
+    m_scanned = m_head;
+  }
+}
+
+void LoglineBuffer::Scan(uint64_t from, uint64_t to, Filter filter) {
+  std::vector<LinePtr> chunk;
+  chunk.reserve(kScanChunk);
+  uint64_t seq = from;
+  while (seq < to && !m_cancel.load(std::memory_order_relaxed)) {
+    uint64_t end = std::min<uint64_t>(to, seq + kScanChunk);
+    chunk.clear();
+    {
+      // Skip lines overwritten since the scan started.
+      std::lock_guard<std::mutex> lock(m_mutex);
+      seq = std::max(seq, Tail());
+      for (uint64_t s = seq; s < end; s++)
+        chunk.push_back(m_lines[s % m_capacity]);
+    }
+    for (size_t i = 0; i < chunk.size(); i++) {
+      if (!filter || filter(*chunk[i])) m_scan_result.push_back(seq + i);
+    }
+    seq = end;
+  }
+  m_scan_done.store(true, std::memory_order_release);
+}
+
+void LoglineBuffer::StopScan() {
+  if (!m_worker.joinable()) return;
+  m_cancel = true;
+  m_worker.join();
+  m_scan_result.clear();
+}
+
+bool LoglineBuffer::Update() {
+  bool changed = false;
+  if (m_worker.joinable() && m_scan_done.load(std::memory_order_acquire)) {
+    m_worker.join();
+    m_matches.insert(m_matches.begin(), m_scan_result.begin(),
+                     m_scan_result.end());
+    m_scan_result.clear();
+    changed = true;
+  }
+  uint64_t tail = Tail();
+  m_scanned = std::max(m_scanned, tail);
+  for (; m_scanned < m_head; m_scanned++) {
+    const Logline& line = *m_lines[m_scanned % m_capacity];
+    if (!m_filter || m_filter(line)) {
+      m_matches.push_back(m_scanned);
+      changed = true;
+    }
+  }
+  while (!m_matches.empty() && m_matches.front() < tail) {
+    m_matches.pop_front();
+    changed = true;
+  }
+  return changed;
+}
+
+LoglineBuffer::LinePtr LoglineBuffer::GetMatch(size_t i) const {
+  if (i >= m_matches.size()) return nullptr;
+  uint64_t seq = m_matches[i];
+  if (seq < Tail()) return nullptr;
+  return m_lines[seq % m_capacity];
+}
@@ -0,0 +1,118 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement mapped_file.h
+ */
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "model/mapped_file.h"
+
+#ifdef _WIN32
+MappedFile::MappedFile()
+    : m_data(nullptr),
+      m_size(0),
+      m_writable(false),
+      m_file(nullptr),
+      m_mapping(nullptr) {}
+#else
+MappedFile::MappedFile() : m_data(nullptr), m_size(0), m_writable(false) {}
+#endif
+
+MappedFile::MappedFile(const std::string& path, bool copy_on_write)
+    : MappedFile() {
+  Open(path, copy_on_write);
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+bool MappedFile::Open(const std::string& path, bool copy_on_write) {
+  Close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) return false;
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  const void* data = nullptr;
+  DWORD protect = copy_on_write ? PAGE_WRITECOPY : PAGE_READONLY;
+  DWORD access = copy_on_write ? FILE_MAP_COPY : FILE_MAP_READ;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    mapping = CreateFileMappingA(file, nullptr, protect, 0, 0, nullptr);
+  if (mapping) data = MapViewOfFile(mapping, access, 0, 0, 0);
+  if (!data) {
+    if (mapping) CloseHandle(mapping);
+    CloseHandle(file);
+    return false;
+  }
+  m_file = file;
+  m_mapping = mapping;
+  m_data = static_cast<const unsigned char*>(data);
+  m_size = static_cast<size_t>(size.QuadPart);
+  m_writable = copy_on_write;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_data) UnmapViewOfFile(m_data);
+  if (m_mapping) CloseHandle(m_mapping);
+  if (m_file) CloseHandle(m_file);
+  m_data = nullptr;
+  m_mapping = nullptr;
+  m_file = nullptr;
+  m_size = 0;
+  m_writable = false;
+}
+
+#else
+bool MappedFile::Open(const std::string& path, bool copy_on_write) {
+  Close();
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  void* data = MAP_FAILED;
+  int prot = copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ;
+  int flags = copy_on_write ? MAP_PRIVATE : MAP_SHARED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    data = mmap(nullptr, st.st_size, prot, flags, fd, 0);
+  close(fd);  // The mapping stays valid.
+  if (data == MAP_FAILED) return false;
+  m_data = static_cast<const unsigned char*>(data);
+  m_size = static_cast<size_t>(st.st_size);
+  m_writable = copy_on_write;
+  return true;
+}
+
+void MappedFile::Close() {
+  if (m_data) munmap(const_cast<unsigned char*>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+  m_writable = false;
+}
+#endif
@@ -0,0 +1,405 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ *  \file
+ *  Implement navmsg_capture.h
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "model/logger.h"
+#include "model/navmsg_capture.h"
+
+static const char kFileMagic[8] = {'O', 'C', 'P', 'N', 'C', 'A', 'P', '1'};
+static const char kIndexMagic[8] = {'O', 'C', 'P', 'N', 'C', 'I', 'D', 'X'};
+static const uint32_t kFormatVersion = 1;
+
+static const size_t kHeaderSize = 16;  // magic, version, reserved
+static const size_t kRecordFixedSize = 24;
+static const size_t kIndexEntrySize = 16;
+static const size_t kTrailerSize = 40;  // offset, entries, records, end, magic
+
+/** Add an index entry at least this often in capture time... */
+static const uint64_t kIndexIntervalUs = 1000000;
+/** ...and at least this often in records. */
+static const uint64_t kIndexIntervalRecords = 4096;
+
+/** Records queued beyond this are dropped rather than growing unbounded. */
+static const size_t kMaxQueuedRecords = 100000;
+
+static void PutU16(std::string& buf, uint16_t v) {
+  for (int i = 0; i < 2; i++) buf += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+static void PutU32(std::string& buf, uint32_t v) {
+  for (int i = 0; i < 4; i++) buf += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+static void PutU64(std::string& buf, uint64_t v) {
+  for (int i = 0; i < 8; i++) buf += static_cast<char>((v >> (8 * i)) & 0xff);
+}
+
+static uint64_t GetLE(const uint8_t* p, int nbytes) {
+  uint64_t v = 0;
+  for (int i = nbytes - 1; i >= 0; i--) v = (v << 8) | p[i];
+  return v;
+}
+
+static uint64_t ToMicros(NavmsgTimePoint tp) {
+  using namespace std::chrono;
+  auto us = duration_cast<microseconds>(tp.time_since_epoch()).count();
+  return us > 0 ? us : 0;
+}
+
+CaptureRecord CaptureRecord::FromNavMsg(const NavMsg& msg) {
+  CaptureRecord record;
+  record.timestamp_us = ToMicros(msg.created_at);
+  record.bus = msg.bus;
+  if (msg.source) record.iface = msg.source->iface;
+
+  std::string raw;
+  switch (msg.bus) {
+    case NavAddr::Bus::N0183: {
+      auto msg0183 = dynamic_cast<const Nmea0183Msg*>(&msg);
+      if (!msg0183) break;
+      record.id = msg0183->talker + msg0183->type;
+      raw = msg0183->payload;
+    } break;
+    case NavAddr::Bus::N2000: {
+      auto msg2000 = dynamic_cast<const Nmea2000Msg*>(&msg);
+      if (!msg2000) break;
+      record.id = msg2000->PGN.to_string();
+      record.payload = msg2000->payload;
+      auto addr2000 =
+          std::dynamic_pointer_cast<const NavAddr2000>(msg2000->source);
+      if (addr2000) record.source_name = addr2000->name.value.Name;
+    } break;
+    case NavAddr::Bus::Signalk: {
+      auto msg_sk = dynamic_cast<const SignalkMsg*>(&msg);
+      if (!msg_sk) break;
+      record.id = msg_sk->context_self;
+      raw = msg_sk->raw_message;
+    } break;
+    default:
+      break;
+  }
+  if (!raw.empty()) record.payload.assign(raw.begin(), raw.end());
+  return record;
+}
+
+std::shared_ptr<const NavMsg> CaptureRecord::ToNavMsg() const {
+  const std::string raw(payload.begin(), payload.end());
+  switch (bus) {
+    case NavAddr::Bus::N0183:
+      if (id.size() < 2) return nullptr;
+      return std::make_shared<const Nmea0183Msg>(
+          id, raw, std::make_shared<const NavAddr0183>(iface));
+    case NavAddr::Bus::N2000:
+      return std::make_shared<const Nmea2000Msg>(
+          N2kName::Parse(id), payload,
+          std::make_shared<const NavAddr2000>(iface, N2kName(source_name)));
+    case NavAddr::Bus::Signalk:
+      return std::make_shared<const SignalkMsg>(id, "", raw, iface);
+    default:
+      return nullptr;
+  }
+}
+
+//
+// CaptureWriter
+//
+
+CaptureWriter::CaptureWriter()
+    : m_stop(true),
+      m_open(false),
+      m_dropped(0),
+      m_offset(0),
+      m_records(0),
+      m_last_indexed_us(0),
+      m_last_us(0) {}
+
+CaptureWriter::~CaptureWriter() { Close(); }
+
+bool CaptureWriter::Open(const std::string& path) {
+  Close();
+  m_stream.open(path, std::ios::binary | std::ios::trunc);
+  if (!m_stream.is_open()) {
+    WARNING_LOG << "Cannot open capture file " << path;
+    return false;
+  }
+  std::string header(kFileMagic, sizeof(kFileMagic));
+  PutU32(header, kFormatVersion);
+  PutU32(header, 0);
+  m_stream.write(header.data(), header.size());
+
+  m_offset = kHeaderSize;
+  m_records = 0;
+  m_last_indexed_us = 0;
+  m_last_us = 0;
+  m_index.clear();
+  m_dropped = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = false;
+  }
+  m_thread = std::thread([&] { Worker(); });
+  m_open = true;
+  return true;
+}
+
+void CaptureWriter::Close() {
+  if (!m_thread.joinable()) return;
+  m_open = false;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cv.notify_one();
+  m_thread.join();
+
+  std::string index;
+  for (const auto& entry : m_index) {
+    PutU64(index, entry.timestamp_us);
+    PutU64(index, entry.offset);
+  }
+  PutU64(index, m_offset);
+  PutU64(index, m_index.size());
+  PutU64(index, m_records);
+  PutU64(index, m_last_us);
+  index.append(kIndexMagic, sizeof(kIndexMagic));
+  m_stream.write(index.data(), index.size());
+  m_stream.close();
+}
+
+void CaptureWriter::Add(const NavMsg& msg) {
+  if (!m_open) return;
+  Add(CaptureRecord::FromNavMsg(msg));
+}
+
+void CaptureWriter::Add(CaptureRecord record) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_stop) return;
+    if (m_queue.size() >= kMaxQueuedRecords) {
+      m_dropped++;
+      return;
+    }
+    m_queue.push_back(std::move(record));
+  }
+  m_cv.notify_one();
+}
+
+void CaptureWriter::Worker() {
+  std::deque<CaptureRecord> batch;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+      if (m_queue.empty() && m_stop) break;
+      batch.swap(m_queue);
+    }
+    for (const auto& record : batch) WriteRecord(record);
+    batch.clear();
+    m_stream.flush();
+  }
+}
+
+void CaptureWriter::WriteRecord(const CaptureRecord& record) {
+  const size_t iface_len = std::min<size_t>(record.iface.size(), 0xff);
+  const size_t id_len = std::min<size_t>(record.id.size(), 0xffff);
+
+  std::string buf;
+  buf.reserve(4 + kRecordFixedSize + iface_len + id_len +
+              record.payload.size());
+  PutU32(buf, kRecordFixedSize + iface_len + id_len + record.payload.size());
+  PutU64(buf, record.timestamp_us);
+  buf += static_cast<char>(record.bus);
+  buf += static_cast<char>(iface_len);
+  PutU16(buf, id_len);
+  PutU64(buf, record.source_name);
+  PutU32(buf, record.payload.size());
+  buf.append(record.iface, 0, iface_len);
+  buf.append(record.id, 0, id_len);
+  buf.append(record.payload.begin(), record.payload.end());
+
+  // Index the latest time so far rather than the record time: messages
+  // from several drivers and wall clock steps make record times go back.
+  m_last_us = std::max(m_last_us, record.timestamp_us);
+  if (m_index.empty() || m_last_us >= m_last_indexed_us + kIndexIntervalUs ||
+      m_records % kIndexIntervalRecords == 0) {
+    m_index.push_back({m_last_us, m_offset});
+    m_last_indexed_us = m_last_us;
+  }
+  m_stream.write(buf.data(), buf.size());
+  m_offset += buf.size();
+  m_records++;
+}
+
+//
+// CaptureReader
+//
+
+bool CaptureReader::Open(const std::string& path) {
+  m_stream.close();
+  m_stream.clear();
+  m_index.clear();
+  m_records = 0;
+  m_end_us = 0;
+  m_data_end = 0;
+
+  m_stream.open(path, std::ios::binary);
+  if (!m_stream.is_open()) return false;
+
+  char header[kHeaderSize];
+  if (!m_stream.read(header, sizeof(header))) return false;
+  if (memcmp(header, kFileMagic, sizeof(kFileMagic)) != 0) return false;
+  if (GetLE(reinterpret_cast<uint8_t*>(header) + 8, 4) != kFormatVersion)
+    return false;
+
+  if (!LoadIndex()) RebuildIndex();
+  m_stream.clear();
+  m_stream.seekg(kHeaderSize);
+  return true;
+}
+
+bool CaptureReader::LoadIndex() {
+  m_stream.seekg(0, std::ios::end);
+  const uint64_t file_size = m_stream.tellg();
+  if (file_size < kHeaderSize + kTrailerSize) return false;
+
+  uint8_t trailer[kTrailerSize];
+  m_stream.seekg(file_size - kTrailerSize);
+  if (!m_stream.read(reinterpret_cast<char*>(trailer), sizeof(trailer)))
+    return false;
+  if (memcmp(trailer + 32, kIndexMagic, sizeof(kIndexMagic)) != 0)
+    return false;
+
+  const uint64_t index_offset = GetLE(trailer, 8);
+  const uint64_t n_entries = GetLE(trailer + 8, 8);
+  const uint64_t n_records = GetLE(trailer + 16, 8);
+  const uint64_t end_us = GetLE(trailer + 24, 8);
+  if (index_offset < kHeaderSize ||
+      n_entries > (file_size - kTrailerSize) / kIndexEntrySize ||
+      index_offset + n_entries * kIndexEntrySize + kTrailerSize != file_size)
+    return false;
+
+  std::vector<uint8_t> buf(n_entries * kIndexEntrySize);
+  m_stream.seekg(index_offset);
+  if (!buf.empty() &&
+      !m_stream.read(reinterpret_cast<char*>(buf.data()), buf.size()))
+    return false;
+  for (uint64_t i = 0; i < n_entries; i++) {
+    const uint8_t* p = &buf[i * kIndexEntrySize];
+    m_index.push_back({GetLE(p, 8), GetLE(p + 8, 8)});
+  }
+  m_data_end = index_offset;
+  m_records = n_records;
+  m_end_us = end_us;
+  return true;
+}
+
+void CaptureReader::RebuildIndex() {
+  DEBUG_LOG << "Capture file lacks index, rebuilding";
+  m_index.clear();
+  m_records = 0;
+  m_stream.clear();
+  m_stream.seekg(0, std::ios::end);
+  const uint64_t file_size = m_stream.tellg();
+  m_stream.seekg(kHeaderSize);
+
+  //  A truncated tail record, e.g. after a crash while writing, ends
+  //  the readable data.
+  m_data_end = kHeaderSize;
+  uint64_t last_indexed_us = 0;
+  m_end_us = 0;
+  uint8_t fixed[4 + kRecordFixedSize];
+  while (true) {
+    const uint64_t offset = m_stream.tellg();
+    if (!m_stream.read(reinterpret_cast<char*>(fixed), sizeof(fixed))) break;
+    const uint64_t len = GetLE(fixed, 4);
+    if (len < kRecordFixedSize || offset + 4 + len > file_size) break;
+    m_end_us = std::max(m_end_us, GetLE(fixed + 4, 8));
+    if (m_index.empty() || m_end_us >= last_indexed_us + kIndexIntervalUs ||
+        m_records % kIndexIntervalRecords == 0) {
+      m_index.push_back({m_end_us, offset});
+      last_indexed_us = m_end_us;
+    }
+    m_records++;
+    m_data_end = offset + 4 + len;
+    m_stream.seekg(m_data_end);
+  }
+  m_stream.clear();
+}
+
+bool CaptureReader::Next(CaptureRecord& record) {
+  if (!m_stream) return false;
+  const uint64_t offset = m_stream.tellg();
+  uint8_t fixed[4 + kRecordFixedSize];
+  if (offset + sizeof(fixed) > m_data_end) return false;
+  if (!m_stream.read(reinterpret_cast<char*>(fixed), sizeof(fixed)))
+    return false;
+
+  const uint64_t len = GetLE(fixed, 4);
+  const size_t iface_len = fixed[4 + 9];
+  const size_t id_len = GetLE(fixed + 4 + 10, 2);
+  const size_t payload_len = GetLE(fixed + 4 + 20, 4);
+  if (len != kRecordFixedSize + iface_len + id_len + payload_len ||
+      offset + 4 + len > m_data_end)
+    return false;
+
+  record.timestamp_us = GetLE(fixed + 4, 8);
+  record.bus = static_cast<NavAddr::Bus>(fixed[4 + 8]);
+  record.source_name = GetLE(fixed + 4 + 12, 8);
+
+  std::string var(iface_len + id_len + payload_len, '\0');
+  if (!var.empty() && !m_stream.read(&var[0], var.size())) return false;
+  record.iface = var.substr(0, iface_len);
+  record.id = var.substr(iface_len, id_len);
+  record.payload.assign(var.begin() + iface_len + id_len, var.end());
+  return true;
+}
+
+bool CaptureReader::Seek(uint64_t timestamp_us) {
+  if (m_index.empty()) return false;
+  // Index times are the latest time up to the entry. All records before
+  // the last entry below timestamp_us are earlier than timestamp_us.
+  auto it = std::lower_bound(
+      m_index.begin(), m_index.end(), timestamp_us,
+      [](const IndexEntry& e, uint64_t t) { return e.timestamp_us < t; });
+  if (it != m_index.begin()) --it;
+
+  m_stream.clear();
+  m_stream.seekg(it->offset);
+  CaptureRecord record;
+  while (true) {
+    const uint64_t offset = m_stream.tellg();
+    if (!Next(record)) return false;
+    if (record.timestamp_us >= timestamp_us) {
+      m_stream.seekg(offset);
+      return true;
+    }
+  }
+}
+
+uint64_t CaptureReader::GetStartTime() const {
+  return m_index.empty() ? 0 : m_index.front().timestamp_us;
+}
+
+uint64_t CaptureReader::GetEndTime() const { return m_end_us; }
@@ -0,0 +1,333 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ *  \file
+ *  Implement nmea0183_parser.h
+ */
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "model/nmea0183_parser.h"
+
+static constexpr uint32_t PackId(char c0, char c1, char c2) {
+  return (static_cast<uint32_t>(static_cast<unsigned char>(c0)) << 16) |
+         (static_cast<uint32_t>(static_cast<unsigned char>(c1)) << 8) |
+         static_cast<uint32_t>(static_cast<unsigned char>(c2));
+}
+
+N0183Id N0183IdFromType(std::string_view type) {
+  if (type.size() != 3) return N0183Id::kUnknown;
+  switch (PackId(type[0], type[1], type[2])) {
+    case PackId('A', 'P', 'B'):
+      return N0183Id::kApb;
+    case PackId('D', 'B', 'T'):
+      return N0183Id::kDbt;
+    case PackId('D', 'P', 'T'):
+      return N0183Id::kDpt;
+    case PackId('G', 'G', 'A'):
+      return N0183Id::kGga;
+    case PackId('G', 'L', 'L'):
+      return N0183Id::kGll;
+    case PackId('G', 'S', 'V'):
+      return N0183Id::kGsv;
+    case PackId('H', 'D', 'G'):
+      return N0183Id::kHdg;
+    case PackId('H', 'D', 'M'):
+      return N0183Id::kHdm;
+    case PackId('H', 'D', 'T'):
+      return N0183Id::kHdt;
+    case PackId('M', 'W', 'V'):
+      return N0183Id::kMwv;
+    case PackId('R', 'M', 'B'):
+      return N0183Id::kRmb;
+    case PackId('R', 'M', 'C'):
+      return N0183Id::kRmc;
+    case PackId('T', 'H', 'S'):
+      return N0183Id::kThs;
+    case PackId('V', 'T', 'G'):
+      return N0183Id::kVtg;
+    case PackId('X', 'D', 'R'):
+      return N0183Id::kXdr;
+    default:
+      return N0183Id::kUnknown;
+  }
+}
+
+static int HexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+bool N0183Sentence::Parse(std::string_view raw) {
+  m_id = N0183Id::kUnknown;
+  m_talker = m_type = std::string_view();
+  m_size = 0;
+
+  // Drop NMEA 4 tag block and line endings.
+  if (!raw.empty() && raw[0] == '\\') {
+    auto end = raw.find('\\', 1);
+    if (end == std::string_view::npos) return false;
+    raw.remove_prefix(end + 1);
+  }
+  while (!raw.empty() && (raw.back() == '\n' || raw.back() == '\r' ||
+                          raw.back() == ' ' || raw.back() == '\0'))
+    raw.remove_suffix(1);
+  if (raw.size() < 2 || (raw[0] != '$' && raw[0] != '!')) return false;
+
+  std::string_view body = raw.substr(1);
+  auto star = body.find('*');
+  if (star != std::string_view::npos) {
+    if (body.size() - star != 3) return false;
+    int hi = HexDigit(body[star + 1]);
+    int lo = HexDigit(body[star + 2]);
+    if (hi < 0 || lo < 0) return false;
+    body = body.substr(0, star);
+    unsigned char sum = 0;
+    for (char c : body) sum ^= static_cast<unsigned char>(c);
+    if (sum != ((hi << 4) | lo)) return false;
+  }
+
+  size_t start = 0;
+  while (true) {
+    if (m_size == kMaxFields) return false;
+    auto comma = body.find(',', start);
+    if (comma == std::string_view::npos) {
+      m_fields[m_size++] = body.substr(start);
+      break;
+    }
+    m_fields[m_size++] = body.substr(start, comma - start);
+    start = comma + 1;
+  }
+
+  std::string_view address = m_fields[0];
+  if (!address.empty() && address[0] == 'P') {
+    m_id = N0183Id::kProprietary;
+    m_type = address;
+  } else if (address.size() == 5) {
+    m_talker = address.substr(0, 2);
+    m_type = address.substr(2);
+    m_id = N0183IdFromType(m_type);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+double N0183Sentence::Double(size_t i) const {
+  auto f = Field(i);
+  char buf[32];
+  if (f.empty() || f.size() >= sizeof(buf)) return NAN;
+  memcpy(buf, f.data(), f.size());
+  buf[f.size()] = '\0';
+  char* end;
+  double value = strtod(buf, &end);
+  return end == buf ? NAN : value;
+}
+
+int N0183Sentence::Integer(size_t i) const {
+  auto f = Field(i);
+  char buf[16];
+  if (f.empty() || f.size() >= sizeof(buf)) return 0;
+  memcpy(buf, f.data(), f.size());
+  buf[f.size()] = '\0';
+  return static_cast<int>(strtol(buf, nullptr, 10));
+}
+
+double N0183Sentence::Coordinate(size_t value_field,
+                                 size_t hemisphere_field) const {
+  double value = Double(value_field);
+  if (std::isnan(value)) return NAN;
+  double degrees = static_cast<int>(value / 100);
+  double coordinate = degrees + (value - degrees * 100) / 60.0;
+  char hemisphere = Char(hemisphere_field);
+  return hemisphere == 'S' || hemisphere == 'W' ? -coordinate : coordinate;
+}
+
+/** Value with E/W direction as signed, east positive; NAN if no direction. */
+static double EastPositive(const N0183Sentence& s, size_t value_field,
+                           size_t dir_field) {
+  double value = s.Double(value_field);
+  switch (s.Char(dir_field)) {
+    case 'E':
+      return value;
+    case 'W':
+      return -value;
+    default:
+      return NAN;
+  }
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Rmc& rmc) {
+  if (s.GetId() != N0183Id::kRmc || s.Size() < 11) return false;
+  rmc.utc_time = s.Field(1);
+  const char mode = s.Char(12);
+  rmc.is_valid = s.Char(2) == 'A' && mode != 'N' && mode != 'S';
+  rmc.lat = s.Coordinate(3, 4);
+  rmc.lon = s.Coordinate(5, 6);
+  rmc.sog = s.Double(7);
+  rmc.cog = s.Double(8);
+  rmc.date = s.Field(9);
+  rmc.variation = EastPositive(s, 10, 11);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Gga& gga) {
+  if (s.GetId() != N0183Id::kGga || s.Size() < 9) return false;
+  gga.utc_time = s.Field(1);
+  gga.lat = s.Coordinate(2, 3);
+  gga.lon = s.Coordinate(4, 5);
+  gga.quality = s.Integer(6);
+  gga.n_satellites = s.Integer(7);
+  gga.hdop = s.Double(8);
+  gga.altitude = s.Double(9);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Gll& gll) {
+  if (s.GetId() != N0183Id::kGll) return false;
+  if (s.Size() == 4)  // Pre NMEA 2.0, no status
+    gll.is_valid = true;
+  else if (s.Size() == 6 || s.Size() == 7)
+    gll.is_valid = s.Char(6) == 'A';
+  else
+    return false;
+  gll.lat = s.Coordinate(1, 2);
+  gll.lon = s.Coordinate(3, 4);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Gsv& gsv) {
+  if (s.GetId() != N0183Id::kGsv || s.Size() < 3) return false;
+  gsv.n_messages = s.Integer(1);
+  gsv.message_number = s.Integer(2);
+  gsv.n_satellites = s.Integer(3);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Vtg& vtg) {
+  // 8 fields, 9 with NMEA 2.3 mode indicator.
+  if (s.GetId() != N0183Id::kVtg || s.Size() < 8 || s.Size() > 9)
+    return false;
+  vtg.cog_true = s.Double(1);
+  vtg.cog_magnetic = s.Double(3);
+  vtg.sog_knots = s.Double(5);
+  vtg.sog_kmh = s.Double(7);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Hdg& hdg) {
+  if (s.GetId() != N0183Id::kHdg || s.Size() < 5) return false;
+  hdg.heading_magnetic = s.Double(1);
+  hdg.deviation = EastPositive(s, 2, 3);
+  hdg.variation = EastPositive(s, 4, 5);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Heading& heading) {
+  switch (s.GetId()) {
+    case N0183Id::kHdt:
+    case N0183Id::kHdm:
+      if (s.Size() < 1) return false;
+      heading.heading = s.Double(1);
+      heading.mode = 'A';
+      return true;
+    case N0183Id::kThs:
+      if (s.Size() < 2) return false;
+      heading.heading = s.Double(1);
+      heading.mode = s.Char(2);
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Mwv& mwv) {
+  if (s.GetId() != N0183Id::kMwv || s.Size() < 5) return false;
+  mwv.angle = s.Double(1);
+  mwv.reference = s.Char(2);
+  mwv.speed = s.Double(3);
+  mwv.speed_unit = s.Char(4);
+  mwv.is_valid = s.Char(5) == 'A';
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Depth& depth) {
+  if (s.GetId() == N0183Id::kDpt) {
+    if (s.Size() < 2) return false;
+    depth.depth_m = s.Double(1);
+    depth.offset_m = s.Double(2);
+    return true;
+  }
+  if (s.GetId() != N0183Id::kDbt || s.Size() < 6) return false;
+  depth.offset_m = NAN;
+  depth.depth_m = s.Double(3);
+  if (std::isnan(depth.depth_m)) depth.depth_m = s.Double(1) * 0.3048;
+  if (std::isnan(depth.depth_m)) depth.depth_m = s.Double(5) * 1.8288;
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Xdr& xdr) {
+  if (s.GetId() != N0183Id::kXdr || s.Size() < 4) return false;
+  xdr.count = 0;
+  for (size_t i = 1; i + 3 <= s.Size(); i += 4) {
+    if (xdr.count == N0183Xdr::kMaxMeasurements) break;
+    auto& m = xdr.measurements[xdr.count++];
+    m.type = s.Char(i);
+    m.value = s.Double(i + 1);
+    m.unit = s.Char(i + 2);
+    m.name = s.Field(i + 3);
+  }
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Apb& apb) {
+  if (s.GetId() != N0183Id::kApb || s.Size() < 14) return false;
+  apb.xte = s.Double(3);
+  apb.steer = s.Char(4);
+  apb.xte_unit = s.Char(5);
+  apb.arrival_circle = s.Char(6) == 'A';
+  apb.perpendicular_passed = s.Char(7) == 'A';
+  apb.bearing_origin_to_dest = s.Double(8);
+  apb.bearing_origin_ref = s.Char(9);
+  apb.dest_id = s.Field(10);
+  apb.bearing_present_to_dest = s.Double(11);
+  apb.bearing_present_ref = s.Char(12);
+  apb.heading_to_steer = s.Double(13);
+  apb.heading_to_steer_ref = s.Char(14);
+  return true;
+}
+
+bool DecodeN0183(const N0183Sentence& s, N0183Rmb& rmb) {
+  if (s.GetId() != N0183Id::kRmb || s.Size() < 13) return false;
+  rmb.is_valid = s.Char(1) == 'A';
+  rmb.xte = s.Double(2);
+  rmb.steer = s.Char(3);
+  rmb.origin_id = s.Field(4);
+  rmb.dest_id = s.Field(5);
+  rmb.dest_lat = s.Coordinate(6, 7);
+  rmb.dest_lon = s.Coordinate(8, 9);
+  rmb.range = s.Double(10);
+  rmb.bearing = s.Double(11);
+  rmb.closing_speed = s.Double(12);
+  rmb.arrived = s.Char(13) == 'A';
+  return true;
+}
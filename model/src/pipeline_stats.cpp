@@ -0,0 +1,259 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement pipeline_stats.h
+ */
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+#include "model/pipeline_stats.h"
+
+static const auto kRelaxed = std::memory_order_relaxed;
+
+static int64_t NowNs() {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(NavmsgClock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t ToNs(NavmsgTimePoint tp) {
+  using namespace std::chrono;
+  return duration_cast<nanoseconds>(tp.time_since_epoch()).count();
+}
+
+static size_t HashIface(const std::string& iface) {
+  size_t hash = std::hash<std::string>()(iface);
+  return hash ? hash : 1;
+}
+
+static std::string JsonEscape(const std::string& s) {
+  std::string escaped;
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+static void StageToJson(std::ostream& os, const char* name,
+                        const StageStats& stats) {
+  const LatencyHistogram& h = stats.latency;
+  os << "{\"stage\": \"" << name << "\", \"count\": " << h.GetCount()
+     << ", \"rate\": " << stats.GetRate()
+     << ", \"mean_us\": " << h.GetMean() / 1000.0
+     << ", \"p50_us\": " << h.Percentile(0.5) / 1000.0
+     << ", \"p90_us\": " << h.Percentile(0.9) / 1000.0
+     << ", \"p99_us\": " << h.Percentile(0.99) / 1000.0
+     << ", \"p999_us\": " << h.Percentile(0.999) / 1000.0
+     << ", \"max_us\": " << h.GetMax() / 1000.0 << "}";
+}
+
+static void TimingToJson(std::ostream& os, const char* name,
+                         const LatencyHistogram& h) {
+  os << "{\"name\": \"" << name << "\", \"count\": " << h.GetCount()
+     << ", \"mean_us\": " << h.GetMean() / 1000.0
+     << ", \"p50_us\": " << h.Percentile(0.5) / 1000.0
+     << ", \"p90_us\": " << h.Percentile(0.9) / 1000.0
+     << ", \"p99_us\": " << h.Percentile(0.99) / 1000.0
+     << ", \"max_us\": " << h.GetMax() / 1000.0 << "}";
+}
+
+void StageStats::Record(int64_t now_ns, uint64_t latency_ns) {
+  latency.Record(latency_ns);
+  if (first_ns.load(kRelaxed) == 0) {
+    int64_t zero = 0;
+    first_ns.compare_exchange_strong(zero, now_ns, kRelaxed);
+  }
+  last_ns.store(now_ns, kRelaxed);
+}
+
+double StageStats::GetRate() const {
+  int64_t span = last_ns.load(kRelaxed) - first_ns.load(kRelaxed);
+  if (span <= 0) return 0;
+  return (latency.GetCount() - 1) * 1e9 / span;
+}
+
+void StageStats::Reset() {
+  latency.Reset();
+  first_ns.store(0, kRelaxed);
+  last_ns.store(0, kRelaxed);
+}
+
+PipelineStats& PipelineStats::GetInstance() {
+  static PipelineStats instance;
+  return instance;
+}
+
+PipelineStats::PipelineStats()
+    : m_pending_fix_ns(0), m_pending_fix_driver(-1) {}
+
+int PipelineStats::FindDriver(const std::string& iface, size_t hash) const {
+  for (int i = 0; i < kMaxDrivers; i++) {
+    size_t slot_hash = m_drivers[i].hash.load(std::memory_order_acquire);
+    if (slot_hash == 0) return -1;
+    if (slot_hash == hash && m_drivers[i].iface == iface) return i;
+  }
+  return -1;
+}
+
+int PipelineStats::ClaimDriver(const std::string& iface) {
+  size_t hash = HashIface(iface);
+  int ix = FindDriver(iface, hash);
+  if (ix >= 0) return ix;
+
+  // First message from this driver: claim the first free slot.
+  std::lock_guard<std::mutex> lock(m_drivers_mutex);
+  for (int i = 0; i < kMaxDrivers; i++) {
+    Driver& driver = m_drivers[i];
+    size_t slot_hash = driver.hash.load(std::memory_order_acquire);
+    if (slot_hash == hash && driver.iface == iface) return i;
+    if (slot_hash == 0) {
+      driver.iface = iface;
+      driver.hash.store(hash, std::memory_order_release);
+      return i;
+    }
+  }
+  return -1;
+}
+
+void PipelineStats::Record(PipelineStage stage, const NavMsg& msg) {
+  int64_t now = NowNs();
+  int64_t latency = now - ToNs(msg.created_at);
+  if (latency < 0) latency = 0;  // Wall clock stepped back
+  int s = static_cast<int>(stage);
+  m_global[s].Record(now, latency);
+  if (msg.source) {
+    int ix = ClaimDriver(msg.source->iface);
+    if (ix >= 0) m_drivers[ix].stages[s].Record(now, latency);
+  }
+}
+
+void PipelineStats::MarkFix(const NavMsg& msg) {
+  int ix = msg.source ? ClaimDriver(msg.source->iface) : -1;
+  m_pending_fix_driver.store(ix, kRelaxed);
+  m_pending_fix_ns.store(ToNs(msg.created_at), std::memory_order_release);
+}
+
+void PipelineStats::RecordCanvasRefresh() {
+  if (m_pending_fix_ns.load(kRelaxed) == 0) return;
+  int64_t fix_ns = m_pending_fix_ns.exchange(0, std::memory_order_acquire);
+  if (fix_ns == 0) return;
+  int ix = m_pending_fix_driver.load(kRelaxed);
+  int64_t now = NowNs();
+  int64_t latency = now > fix_ns ? now - fix_ns : 0;
+  int s = static_cast<int>(PipelineStage::kCanvasRefresh);
+  m_global[s].Record(now, latency);
+  if (ix >= 0) m_drivers[ix].stages[s].Record(now, latency);
+}
+
+const StageStats* PipelineStats::GetStage(PipelineStage stage,
+                                          const std::string& iface) const {
+  int ix = FindDriver(iface, HashIface(iface));
+  if (ix < 0) return nullptr;
+  return &m_drivers[ix].stages[static_cast<int>(stage)];
+}
+
+std::string PipelineStats::ToJson() const {
+  const int stage_count = static_cast<int>(PipelineStage::kCount);
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(1);
+  os << "{\"stages\": [";
+  const char* sep = "";
+  for (int s = 0; s < stage_count; s++) {
+    if (m_global[s].latency.GetCount() == 0) continue;
+    os << sep;
+    StageToJson(os, StageName(static_cast<PipelineStage>(s)), m_global[s]);
+    sep = ", ";
+  }
+  os << "], \"drivers\": [";
+  sep = "";
+  for (const auto& driver : m_drivers) {
+    if (driver.hash.load(std::memory_order_acquire) == 0) break;
+    os << sep << "{\"iface\": \"" << JsonEscape(driver.iface)
+       << "\", \"stages\": [";
+    const char* stage_sep = "";
+    for (int s = 0; s < stage_count; s++) {
+      if (driver.stages[s].latency.GetCount() == 0) continue;
+      os << stage_sep;
+      StageToJson(os, StageName(static_cast<PipelineStage>(s)),
+                  driver.stages[s]);
+      stage_sep = ", ";
+    }
+    os << "]}";
+    sep = ", ";
+  }
+  os << "], \"timings\": [";
+  sep = "";
+  for (int t = 0; t < static_cast<int>(PipelineTiming::kCount); t++) {
+    if (m_timings[t].GetCount() == 0) continue;
+    os << sep;
+    TimingToJson(os, TimingName(static_cast<PipelineTiming>(t)), m_timings[t]);
+    sep = ", ";
+  }
+  os << "]}\n";
+  return os.str();
+}
+
+void PipelineStats::Reset() {
+  for (auto& stage : m_global) stage.Reset();
+  for (auto& driver : m_drivers) {
+    for (auto& stage : driver.stages) stage.Reset();
+  }
+  for (auto& timing : m_timings) timing.Reset();
+  m_pending_fix_ns.store(0, kRelaxed);
+}
+
+const char* PipelineStats::StageName(PipelineStage stage) {
+  switch (stage) {
+    case PipelineStage::kBusNotify:
+      return "bus_notify";
+    case PipelineStage::kBridgeAccept:
+      return "bridge_accept";
+    case PipelineStage::kAisDecode:
+      return "ais_decode";
+    case PipelineStage::kPluginDispatch:
+      return "plugin_dispatch";
+    case PipelineStage::kCanvasRefresh:
+      return "canvas_refresh";
+    default:
+      return "unknown";
+  }
+}
+
+const char* PipelineStats::TimingName(PipelineTiming timing) {
+  switch (timing) {
+    case PipelineTiming::kQuiltPan:
+      return "quilt_pan";
+    case PipelineTiming::kQuiltZoom:
+      return "quilt_zoom";
+    case PipelineTiming::kQuiltChartSet:
+      return "quilt_chart_set";
+    default:
+      return "unknown";
+  }
+}
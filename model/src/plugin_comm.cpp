@@ -92,6 +92,118 @@ static void LogMessage(const std::shared_ptr<const NavMsg>& message,
   }
 }
 
+/** Add plugin to table if it implements the table's interface. */
+template <typename T>
+static void AddSubscriber(std::vector<T*>& table, opencpn_plugin* plugin) {
+  auto* ppi = dynamic_cast<T*>(plugin);
+  if (ppi) table.push_back(ppi);
+}
+
+/** Return true if api is in [min_api, highest supported API]. */
+static bool HasApi(int api, int min_api) {
+  return api >= min_api && api <= 121;
+}
+
+PluginDispatchTable::PluginDispatchTable(const ArrayOfPlugIns& plugins)
+    : json_message_targets(0) {
+  for (unsigned int i = 0; i < plugins.GetCount(); i++) {
+    PlugInContainer* pic = plugins.Item(i);
+    if (!pic->m_enabled || !pic->m_init_state) continue;
+    const int caps = pic->m_cap_flag;
+    const int api = pic->m_api_version;
+    if (caps & WANTS_PLUGIN_MESSAGING) json_message_targets++;
+
+    opencpn_plugin* plugin = pic->m_pplugin;
+    if (!plugin) continue;
+    if (caps & WANTS_NMEA_SENTENCES) nmea_sentences.push_back(plugin);
+    if (caps & WANTS_AIS_SENTENCES) ais_sentences.push_back(plugin);
+    if (caps & WANTS_CURSOR_LATLON) cursor_latlon.push_back(plugin);
+    if (caps & WANTS_NMEA_EVENTS) {
+      position_fix.push_back(plugin);
+      if (HasApi(api, 108)) AddSubscriber(position_fix_ex, plugin);
+      if (HasApi(api, 117)) AddSubscriber(active_leg, plugin);
+    }
+    if (caps & WANTS_PLUGIN_MESSAGING) {
+      // SetPluginMessage() is declared separately in three unrelated
+      // interfaces, bind the applicable one.
+      if (api == 106) {
+        auto* ppi = dynamic_cast<opencpn_plugin_16*>(plugin);
+        if (ppi)
+          plugin_messages.push_back([ppi](wxString& id, wxString& body) {
+            ppi->SetPluginMessage(id, body);
+          });
+      } else if (api == 107) {
+        auto* ppi = dynamic_cast<opencpn_plugin_17*>(plugin);
+        if (ppi)
+          plugin_messages.push_back([ppi](wxString& id, wxString& body) {
+            ppi->SetPluginMessage(id, body);
+          });
+      } else if (HasApi(api, 108)) {
+        auto* ppi = dynamic_cast<opencpn_plugin_18*>(plugin);
+        if (ppi)
+          plugin_messages.push_back([ppi](wxString& id, wxString& body) {
+            ppi->SetPluginMessage(id, body);
+          });
+      }
+    }
+    if ((caps & WANTS_MOUSE_EVENTS) && HasApi(api, 112))
+      AddSubscriber(mouse_events, plugin);
+    if ((caps & WANTS_KEYBOARD_EVENTS) && HasApi(api, 113))
+      AddSubscriber(keyboard_events, plugin);
+    if ((caps & WANTS_PRESHUTDOWN_HOOK) && HasApi(api, 119))
+      AddSubscriber(preshutdown_hook, plugin);
+    if ((caps & WANTS_VECTOR_CHART_OBJECT_INFO) && HasApi(api, 112))
+      AddSubscriber(chart_object_info, plugin);
+  }
+}
+
+std::shared_ptr<const PluginDispatchTable> PluginDispatchTable::GetCurrent() {
+  static std::shared_ptr<const PluginDispatchTable> table;
+  static unsigned generation = 0;
+
+  auto loader = PluginLoader::GetInstance();
+  if (!table || generation != loader->GetPluginGeneration()) {
+    table = std::make_shared<const PluginDispatchTable>(
+        *loader->GetPlugInArray());
+    generation = loader->GetPluginGeneration();
+  }
+  return table;
+}
+
+void PluginDispatchTable::SendNmeaSentences(const wxString* sentences,
+                                            size_t count) const {
+  if (nmea_sentences.empty() || count == 0) return;
+#ifndef __WXMSW__
+  // Set up a framework to catch (some) sigsegv faults from plugins,
+  // saving the existing action for this signal.
+  struct sigaction temp;
+  temp.sa_handler = catch_signals_PIM;  // point to my handler
+  sigemptyset(&temp.sa_mask);           // make the blocking set
+                                        // empty, so that all
+                                        // other signals will be
+                                        // unblocked during my handler
+  temp.sa_flags = 0;
+  sigaction(SIGSEGV, &temp, &sa_all_PIM_previous);
+
+  if (sigsetjmp(env_PIM, 1)) {
+    //  Something in the dispatch loop faulted.
+    // Probably safest to assume that all variables in this method are
+    // trash... So, simply clean up and return.
+    sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);
+    return;
+  }
+#endif
+  for (size_t i = 0; i < count; i++) {
+    // decouple 'const wxString &' to keep plugin interface.
+    wxString decouple_sentence(sentences[i]);
+    for (auto* plugin : nmea_sentences)
+      plugin->SetNMEASentence(decouple_sentence);
+  }
+#ifndef __WXMSW__
+  sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);  // reset signal handler
+#endif
+}
+
 void SendMessageToAllPlugins(const wxString& message_id,
                              const wxString& message_body) {
   auto msg = std::make_shared<PluginMsg>(
@@ -105,44 +217,8 @@ void SendMessageToAllPlugins(const wxString& message_id,
   LogMessage(msg);
   // LogMessage(std::string("internal ALL ") + msg->to_string());  FIXME/leamas
 
-  for (auto pic : *PluginLoader::GetInstance()->GetPlugInArray()) {
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_PLUGIN_MESSAGING) {
-        switch (pic->m_api_version) {
-          case 106: {
-            auto* ppi = dynamic_cast<opencpn_plugin_16*>(pic->m_pplugin);
-            if (ppi) ppi->SetPluginMessage(id, body);
-            break;
-          }
-          case 107: {
-            auto* ppi = dynamic_cast<opencpn_plugin_17*>(pic->m_pplugin);
-            if (ppi) ppi->SetPluginMessage(id, body);
-            break;
-          }
-          case 108:
-          case 109:
-          case 110:
-          case 111:
-          case 112:
-          case 113:
-          case 114:
-          case 115:
-          case 116:
-          case 117:
-          case 118:
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
-            if (ppi) ppi->SetPluginMessage(id, body);
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (const auto& set_message : table->plugin_messages) set_message(id, body);
 }
 
 void SendJSONMessageToAllPlugins(const wxString& message_id, wxJSONValue v) {
@@ -160,14 +236,9 @@ void SendJSONMessageToAllPlugins(const wxString& message_id, wxJSONValue v) {
 void SendAISSentenceToAllPlugIns(const wxString& sentence) {
   // decouple 'const wxString &' to keep interface.
   wxString decouple_sentence(sentence);
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_AIS_SENTENCES)
-        pic->m_pplugin->SetAISSentence(decouple_sentence);
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* plugin : table->ais_sentences)
+    plugin->SetAISSentence(decouple_sentence);
   auto msg =
       std::make_shared<PluginMsg>("AIS", JoinLines(sentence.ToStdString()));
   LogMessage(msg, "AIS data ");
@@ -184,14 +255,8 @@ void SendPositionFixToAllPlugIns(GenericPosDatEx* ppos) {
   pfix.FixTime = ppos->FixTime;
   pfix.nSats = ppos->nSats;
 
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_NMEA_EVENTS)
-        if (pic->m_pplugin) pic->m_pplugin->SetPositionFix(pfix);
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* plugin : table->position_fix) plugin->SetPositionFix(pfix);
 
   //    Send extended position fix to PlugIns at API 108 and later
   PlugIn_Position_Fix_Ex pfix_ex;
@@ -208,35 +273,7 @@ void SendPositionFixToAllPlugIns(GenericPosDatEx* ppos) {
   auto msg = std::make_shared<PluginMsg>("position-fix", MsgToString(pfix));
   LogMessage(msg, "application ALL gnss-fix ");
 
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_NMEA_EVENTS) {
-        switch (pic->m_api_version) {
-          case 108:
-          case 109:
-          case 110:
-          case 111:
-          case 112:
-          case 113:
-          case 114:
-          case 115:
-          case 116:
-          case 117:
-          case 118:
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_18*>(pic->m_pplugin);
-            if (ppi) ppi->SetPositionFixEx(pfix_ex);
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
-  }
+  for (auto* ppi : table->position_fix_ex) ppi->SetPositionFixEx(pfix_ex);
 }
 
 void SendActiveLegInfoToAllPlugIns(const ActiveLegDat* leg_info) {
@@ -246,198 +283,62 @@ void SendActiveLegInfoToAllPlugIns(const ActiveLegDat* leg_info) {
   leg.wp_name = leg_info->wp_name;
   leg.Xte = leg_info->Xte;
   leg.arrival = leg_info->arrival;
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_NMEA_EVENTS) {
-        switch (pic->m_api_version) {
-          case 108:
-          case 109:
-          case 110:
-          case 111:
-          case 112:
-          case 113:
-          case 114:
-          case 115:
-          case 116:
-            break;
-          case 117:
-          case 118:
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_117*>(pic->m_pplugin);
-            if (ppi) ppi->SetActiveLegInfo(leg);
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* ppi : table->active_leg) ppi->SetActiveLegInfo(leg);
 }
 
 bool SendMouseEventToPlugins(wxMouseEvent& event) {
   bool bret = false;
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_MOUSE_EVENTS) {
-        switch (pic->m_api_version) {
-          case 112:
-          case 113:
-          case 114:
-          case 115:
-          case 116:
-          case 117:
-          case 118:
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_112*>(pic->m_pplugin);
-            if (ppi && ppi->MouseEventHook(event)) bret = true;
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* ppi : table->mouse_events) {
+    if (ppi->MouseEventHook(event)) bret = true;
   }
   return bret;
 }
 
 bool SendKeyEventToPlugins(wxKeyEvent& event) {
   bool bret = false;
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_KEYBOARD_EVENTS) {
-        {
-          switch (pic->m_api_version) {
-            case 113:
-            case 114:
-            case 115:
-            case 116:
-            case 117:
-            case 118:
-            case 119:
-            case 120:
-            case 121: {
-              auto* ppi = dynamic_cast<opencpn_plugin_113*>(pic->m_pplugin);
-              if (ppi && ppi->KeyboardEventHook(event)) bret = true;
-              break;
-            }
-            default:
-              break;
-          }
-        }
-      }
-    }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* ppi : table->keyboard_events) {
+    if (ppi->KeyboardEventHook(event)) bret = true;
   }
-
   return bret;
 }
 
 void SendPreShutdownHookToPlugins() {
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_PRESHUTDOWN_HOOK) {
-        switch (pic->m_api_version) {
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_119*>(pic->m_pplugin);
-            if (ppi) ppi->PreShutdownHook();
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* ppi : table->preshutdown_hook) ppi->PreShutdownHook();
 }
 
 void SendCursorLatLonToAllPlugIns(double lat, double lon) {
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_CURSOR_LATLON)
-        if (pic->m_pplugin) pic->m_pplugin->SetCursorLatLon(lat, lon);
-    }
-  }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* plugin : table->cursor_latlon) plugin->SetCursorLatLon(lat, lon);
   auto msg = std::make_shared<PluginMsg>(
       PluginMsg("Cursor-pos", Position(lat, lon).to_string()));
   LogMessage(msg, "application ALL cursor-pos  ");
 }
 
-void SendNMEASentenceToAllPlugIns(const wxString& sentence) {
-  // decouple 'const wxString &' to keep plugin interface.
-  wxString decouple_sentence(sentence);
-#ifndef __WXMSW__
-  // Set up a framework to catch (some) sigsegv faults from plugins.
-  sigaction(SIGSEGV, NULL, &sa_all_PIM_previous);  // save existing
-                                                   // action for this signal
-  struct sigaction temp;
-  sigaction(SIGSEGV, NULL, &temp);  // inspect existing action for this signal
-
-  temp.sa_handler = catch_signals_PIM;  // point to my handler
-  sigemptyset(&temp.sa_mask);           // make the blocking set
-                                        // empty, so that all
-                                        // other signals will be
-                                        // unblocked during my handler
-  temp.sa_flags = 0;
-  sigaction(SIGSEGV, &temp, NULL);
-#endif
+/** Log sentence sent to plugins, only building the message if logging. */
+static void LogNmeaSentence(const wxString& sentence) {
+  if (!wxWindow::FindWindowByName(kDataMonitorWindowName)) return;
   auto msg = std::make_shared<PluginMsg>("NMEA-msg", sentence.ToStdString());
   LogMessage(msg, "internal ALL nmea-msg ");
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_NMEA_SENTENCES) {
-#ifndef __WXMSW__
-        if (sigsetjmp(env_PIM, 1)) {
-          //  Something in the "else" code block faulted.
-          // Probably safest to assume that all variables in this method are
-          // trash... So, simply clean up and return.
-          sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);
-          // reset signal handler
-          return;
-        } else
-#endif
-        {
-          // volatile int *x = 0;
-          //*x = 0;
-          if (pic->m_pplugin)
-            pic->m_pplugin->SetNMEASentence(decouple_sentence);
-        }
-      }
-    }
-  }
-#ifndef __WXMSW__
-  sigaction(SIGSEGV, &sa_all_PIM_previous, NULL);  // reset signal handler
-#endif
+}
+
+void SendNMEASentenceToAllPlugIns(const wxString& sentence) {
+  LogNmeaSentence(sentence);
+  PluginDispatchTable::GetCurrent()->SendNmeaSentences(&sentence, 1);
+}
+
+void SendNMEASentencesToAllPlugIns(const std::vector<wxString>& sentences) {
+  if (sentences.empty()) return;
+  for (const auto& sentence : sentences) LogNmeaSentence(sentence);
+  PluginDispatchTable::GetCurrent()->SendNmeaSentences(&sentences[0],
+                                                       sentences.size());
 }
 
 int GetJSONMessageTargetCount() {
-  int rv = 0;
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = plugin_array->Item(i);
-    if (pic->m_enabled && pic->m_init_state &&
-        (pic->m_cap_flag & WANTS_PLUGIN_MESSAGING))
-      rv++;
-  }
-  return rv;
+  return PluginDispatchTable::GetCurrent()->json_message_targets;
 }
 
 void SendVectorChartObjectInfo(const wxString& chart, const wxString& feature,
@@ -446,33 +347,10 @@ void SendVectorChartObjectInfo(const wxString& chart, const wxString& feature,
   wxString decouple_chart(chart);
   wxString decouple_feature(feature);
   wxString decouple_objname(objname);
-  auto plugin_array = PluginLoader::GetInstance()->GetPlugInArray();
-  for (unsigned int i = 0; i < plugin_array->GetCount(); i++) {
-    PlugInContainer* pic = (*plugin_array)[i];
-    if (pic->m_enabled && pic->m_init_state) {
-      if (pic->m_cap_flag & WANTS_VECTOR_CHART_OBJECT_INFO) {
-        switch (pic->m_api_version) {
-          case 112:
-          case 113:
-          case 114:
-          case 115:
-          case 116:
-          case 117:
-          case 118:
-          case 119:
-          case 120:
-          case 121: {
-            auto* ppi = dynamic_cast<opencpn_plugin_112*>(pic->m_pplugin);
-            if (ppi)
-              ppi->SendVectorChartObjectInfo(decouple_chart, decouple_feature,
-                                             decouple_objname, lat, lon, scale,
-                                             nativescale);
-            break;
-          }
-          default:
-            break;
-        }
-      }
-    }
+  auto table = PluginDispatchTable::GetCurrent();
+  for (auto* ppi : table->chart_object_info) {
+    ppi->SendVectorChartObjectInfo(decouple_chart, decouple_feature,
+                                   decouple_objname, lat, lon, scale,
+                                   nativescale);
   }
 }
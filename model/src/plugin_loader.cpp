@@ -350,7 +350,8 @@ PluginLoader::PluginLoader()
 #ifdef __WXMSW__
       m_found_wxwidgets(false),
 #endif
-      m_on_deactivate_cb([](const PlugInContainer* pic) {}) {
+      m_on_deactivate_cb([](const PlugInContainer* pic) {}),
+      m_plugin_generation(0) {
 }
 
 bool PluginLoader::IsPlugInAvailable(const wxString& commonName) {
@@ -407,6 +408,7 @@ void PluginLoader::SetEnabled(const wxString& common_name, bool enabled) {
   for (auto* pic : plugin_array) {
     if (pic->m_common_name == common_name) {
       pic->m_enabled = enabled;
+      m_plugin_generation++;
       return;
     }
   }
@@ -452,6 +454,7 @@ void PluginLoader::RemovePlugin(const PlugInData& pd) {
     return;
   }
   plugin_array.Remove(pic);
+  m_plugin_generation++;
 }
 
 static int ComparePlugins(PlugInContainer** p1, PlugInContainer** p2) {
@@ -461,6 +464,7 @@ static int ComparePlugins(PlugInContainer** p1, PlugInContainer** p2) {
 void PluginLoader::SortPlugins(int (*cmp_func)(PlugInContainer**,
                                                PlugInContainer**)) {
   plugin_array.Sort(ComparePlugins);
+  m_plugin_generation++;
 }
 
 bool PluginLoader::LoadAllPlugIns(bool load_enabled, bool keep_orphans) {
@@ -634,6 +638,7 @@ bool PluginLoader::LoadPluginCandidate(const wxString& file_name,
           pic->m_init_state = true;
         }
       }
+      m_plugin_generation++;
       evt_load_plugin.Notify(pic);
       wxLog::FlushActive();
 
@@ -663,6 +668,7 @@ bool PluginLoader::LoadPluginCandidate(const wxString& file_name,
         pic->m_destroy_fn = nullptr;
         pic->m_pplugin = nullptr;
         pic->m_init_state = false;
+        m_plugin_generation++;
         if (pic->m_library.IsLoaded()) pic->m_library.Unload();
       }
 
@@ -785,6 +791,7 @@ bool PluginLoader::LoadPlugInDirectory(const wxString& plugin_dir,
     PlugInContainer* pict = plugin_array.Item(i);
     if (pict->m_status == PluginStatus::PendingListRemoval) {
       plugin_array.RemoveAt(i);
+      m_plugin_generation++;
       i = 0;
     } else
       i++;
@@ -804,6 +811,7 @@ bool PluginLoader::UpdatePlugIns() {
       if (!ppl) {
         pic->m_pplugin = nullptr;
         pic->m_init_state = false;
+        m_plugin_generation++;
       }
     }
 
@@ -829,6 +837,7 @@ bool PluginLoader::UpdatePlugIns() {
       pic->m_cap_flag = pic->m_pplugin->Init();
       pic->m_pplugin->SetDefaults();
       pic->m_init_state = true;
+      m_plugin_generation++;
       ProcessLateInit(pic);
       pic->m_short_description = pic->m_pplugin->GetShortDescription();
       pic->m_long_description = pic->m_pplugin->GetLongDescription();
@@ -851,6 +860,7 @@ bool PluginLoader::UpdatePlugIns() {
       pic->m_pplugin = nullptr;
       pic->m_init_state = false;
       pic->m_has_setup_options = false;
+      m_plugin_generation++;
     }
   }
   evt_update_chart_types.Notify();
@@ -864,6 +874,7 @@ bool PluginLoader::DeactivatePlugIn(PlugInContainer* pic) {
     wxLogMessage(msg + pic->m_plugin_file);
     m_on_deactivate_cb(pic);
     pic->m_init_state = false;
+    m_plugin_generation++;
     pic->m_pplugin->DeInit();
   }
   return true;
@@ -894,6 +905,7 @@ bool PluginLoader::UnLoadPlugIn(size_t ix) {
 
   delete pic;  // This will unload the PlugIn via DTOR of pic->m_library
   plugin_array.RemoveAt(ix);
+  m_plugin_generation++;
   return true;
 }
 
@@ -1049,6 +1061,7 @@ void PluginLoader::UpdateManagedPlugins(bool keep_orphans) {
 
   plugin_array.Clear();
   for (const auto& p : loaded_plugins) plugin_array.Add(p);
+  m_plugin_generation++;
   evt_pluglist_change.Notify();
 }
 
@@ -0,0 +1,95 @@
+/**************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ **************************************************************************/
+
+/**
+ * \file
+ *
+ * Implement quilt_region_cache.h
+ */
+
+#include "model/quilt_region_cache.h"
+
+void QuiltRegionCache::Begin(bool subtract, int base_index,
+                             LLRegion* covered) {
+  m_reuse = subtract == m_subtract && base_index == m_base_index;
+  m_subtract = subtract;
+  m_base_index = base_index;
+  if (!m_reuse) m_entries.clear();
+  m_n_cached = m_entries.size();
+  m_next = 0;
+  m_reused = 0;
+  m_covered = covered;
+  m_reused_covered = nullptr;
+}
+
+void QuiltRegionCache::Clear() {
+  m_entries.clear();
+  m_all_covered = LLRegion();
+  m_n_cached = 0;
+  m_next = 0;
+  m_reused = 0;
+}
+
+void QuiltRegionCache::RestoreCovered(size_t n) {
+  if (m_subtract) {
+    if (m_reused_covered) *m_covered = *m_reused_covered;
+  } else if (n == m_n_cached) {
+    if (n) *m_covered = m_all_covered;
+  } else {
+    for (size_t k = 0; k < n; k++) {
+      const Patch& patch = m_entries[k].patch;
+      if (patch.used && !patch.overlay) m_covered->Union(*patch.region);
+    }
+  }
+}
+
+const LLRegion* QuiltRegionCache::Add(const Patch& patch) {
+  size_t ip = m_next++;
+  if (m_reuse) {
+    m_reuse = ip < m_n_cached && m_entries[ip].Matches(patch);
+    if (m_reuse) {
+      m_reused = ip + 1;
+    } else {
+      RestoreCovered(ip);
+      m_entries.resize(ip);
+    }
+  }
+  if (!m_reuse) m_entries.emplace_back();
+  Entry& entry = m_entries[ip];
+  // The regions of this composition, the rest of the key is the same.
+  entry.patch = patch;
+  if (!patch.used) return nullptr;
+
+  if (m_reuse) {
+    if (m_subtract) m_reused_covered = &entry.covered;
+  } else {
+    entry.exclusive = *patch.region;
+    if (m_subtract) entry.exclusive.Subtract(*m_covered);
+    if (!patch.overlay) m_covered->Union(*patch.region);
+    if (m_subtract) entry.covered = *m_covered;
+  }
+  return &entry.exclusive;
+}
+
+void QuiltRegionCache::End() {
+  if (m_reuse) {
+    RestoreCovered(m_next);
+    m_entries.resize(m_next);
+  }
+  if (!m_subtract) m_all_covered = *m_covered;
+  m_covered = nullptr;
+}
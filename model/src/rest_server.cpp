@@ -42,6 +42,7 @@
 #include "model/nav_object_database.h"
 #include "model/ocpn_utils.h"
 #include "model/pincode.h"
+#include "model/pipeline_stats.h"
 #include "model/rest_server.h"
 #include "model/routeman.h"
 
@@ -347,6 +348,10 @@ static void fn(struct mg_connection* c, int ev, void* ev_data, void* fn_data) {
       std::string reply(kVersionReply);
       ocpn::replace(reply, "@version@", PACKAGE_VERSION);
       mg_http_reply(c, 200, "", reply.c_str());
+    } else if (mg_http_match_uri(hm, "/api/pipeline-stats")) {
+      // Statistics are lock free, read them directly in the io thread.
+      std::string reply = PipelineStats::GetInstance().ToJson();
+      mg_http_reply(c, 200, "", "%s", reply.c_str());
     } else if (mg_http_match_uri(hm, "/api/list-routes")) {
       HandleListRoutes(c, hm, parent);
     } else if (mg_http_match_uri(hm, "/api/activate-route")) {
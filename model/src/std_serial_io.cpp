@@ -34,6 +34,10 @@
 #include <wx/wx.h>
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>  // std::mutex
 #include <queue>  // std::queue
 #include <thread>
@@ -61,16 +65,45 @@ public:
 
 private:
   serial::Serial m_serial;
-  OutputBuffer m_out_que;
+
+  /** Guards opening, closing and writing the port. */
+  std::mutex m_port_mutex;
+
+  /** Pending output, coalesced into a single write. */
+  std::string m_out_msgs;
+  std::mutex m_out_mutex;
+  std::condition_variable m_out_cv;
+
+  /** Set by the writer when the port needs reopening, see Entry(). */
+  std::atomic<bool> m_write_failed{false};
+
   void* Entry();
+  void WriterEntry();
   void Reconnect();
 
   bool OpenComPortPhysical(const wxString& com_name, unsigned baud_rate);
   void CloseComPortPhysical();
   ssize_t WriteComPortPhysical(const char* msg);
-  void RequestStop() override { ThreadCtrl::RequestStop(); }
+  size_t ReadComPortPhysical(uint8_t* buf, size_t size);
+  void RequestStop() override;
 };
 
+/**
+ * Max time the reader and writer sleep while the port is idle. Input and
+ * output wake them up at once, this only bounds the time to notice a stop
+ * request. Must stay below the 500 ms overlapped read wait of the Windows
+ * serial implementation.
+ */
+static const uint32_t kIdleWaitMs = 400;
+
+/** Fixed part of the write timeout, on top of the time per byte. */
+static const uint32_t kWriteTimeoutMs = 250;
+
+/** Time to send one byte, 10 bits with start and stop bits, rounded up. */
+static uint32_t WriteMsPerByte(unsigned baud) {
+  return baud == 0 ? 1 : (10000 + baud - 1) / baud;
+}
+
 std::unique_ptr<SerialIo> SerialIo::Create(SendMsgFunc send_msg_func,
                                            const std::string& port,
                                            unsigned baud) {
@@ -87,6 +120,8 @@ void* StdSerialIo::Entry() {
     CommDriverRegistry::GetInstance().evt_driver_msg.Notify(msg);
   }
 
+  std::thread writer([&] { WriterEntry(); });
+
   //    The main loop
   unsigned retries = 0;
   m_stats.driver_bus = NavAddr::Bus::N0183;
@@ -95,9 +130,15 @@ void* StdSerialIo::Entry() {
     unsigned newdata = 0;
     uint8_t rdata[2000];
 
+    if (m_write_failed.exchange(false)) {
+      // We failed to write the port 10 times, let's close the port so that
+      // the reconnection logic kicks in and tries to fix our connection.
+      CloseComPortPhysical();
+      retries = 0;
+    }
     if (m_serial.isOpen()) {
       try {
-        newdata = m_serial.read(rdata, sizeof(rdata));
+        newdata = ReadComPortPhysical(rdata, sizeof(rdata));
       } catch (std::exception& e) {
         DEBUG_LOG << "Serial read exception: " << e.what();
         if (10 < retries++) {
@@ -130,29 +171,39 @@ void* StdSerialIo::Entry() {
       }
       m_send_msg_func(line);
     }
-
-    //  Handle pending output messages
-    std::string qmsg;
-    while (KeepGoing() && m_out_que.Get(qmsg)) {
-      qmsg += "\r\n";
-      bool failed_write = WriteComPortPhysical(qmsg.c_str()) == -1;
-      if (!failed_write) {
-        std::lock_guard lock(m_stats_mutex);
-        m_stats.tx_count += qmsg.size();
-      }
-      if (failed_write && 10 < retries++) {
-        // We failed to write the port 10 times, let's close the port so that
-        // the reconnection logic kicks in and tries to fix our connection.
-        retries = 0;
-        CloseComPortPhysical();
-      }
-    }
   }
+  m_out_cv.notify_all();
+  writer.join();
   CloseComPortPhysical();
   SignalExit();
   return nullptr;
 }
 
+/** Write pending output as soon as it is queued by SetOutMsg(). */
+void StdSerialIo::WriterEntry() {
+  unsigned failures = 0;
+  while (KeepGoing()) {
+    std::string out_msgs;
+    {
+      std::unique_lock lock(m_out_mutex);
+      m_out_cv.wait_for(lock, std::chrono::milliseconds(kIdleWaitMs), [&] {
+        return !m_out_msgs.empty() || !KeepGoing();
+      });
+      out_msgs.swap(m_out_msgs);
+    }
+    if (!KeepGoing() || out_msgs.empty()) continue;
+    if (WriteComPortPhysical(out_msgs.c_str()) == -1) {
+      if (10 < failures++) {
+        failures = 0;
+        m_write_failed = true;
+      }
+    } else {
+      std::lock_guard lock(m_stats_mutex);
+      m_stats.tx_count += out_msgs.size();
+    }
+  }
+}
+
 void StdSerialIo::Start() {
   std::thread t([&] { Entry(); });
   t.detach();
@@ -160,10 +211,22 @@ void StdSerialIo::Start() {
 
 bool StdSerialIo::SetOutMsg(const wxString& msg) {
   if (msg.size() < 6 || (msg[0] != '$' && msg[0] != '!')) return false;
-  m_out_que.Put(msg.ToStdString());
+  {
+    std::lock_guard lock(m_out_mutex);
+    m_out_msgs += msg.ToStdString();
+    m_out_msgs += "\r\n";
+  }
+  m_out_cv.notify_one();
   return true;
 }
 
+void StdSerialIo::RequestStop() {
+  ThreadCtrl::RequestStop();
+  // Taking the lock orders the stop before the writer's next wait.
+  { std::lock_guard lock(m_out_mutex); }
+  m_out_cv.notify_all();
+}
+
 DriverStats StdSerialIo::GetStats() const {
   std::lock_guard lock(m_stats_mutex);
   return m_stats;
@@ -171,11 +234,21 @@ DriverStats StdSerialIo::GetStats() const {
 
 bool StdSerialIo::OpenComPortPhysical(const wxString& com_name,
                                       unsigned baud_rate) {
+  std::lock_guard port_lock(m_port_mutex);
   try {
     m_serial.setPort(com_name.ToStdString());
     m_serial.setBaudrate(baud_rate);
     m_serial.open();
-    m_serial.setTimeout(250, 250, 0, 250, 0);
+#ifdef _WIN32
+    // With these timeouts the driver completes a read as soon as one
+    // byte arrives, or after kIdleWaitMs without input.
+    m_serial.setTimeout(serial::Timeout::max(), kIdleWaitMs,
+                        serial::Timeout::max(), kWriteTimeoutMs,
+                        WriteMsPerByte(baud_rate));
+#else
+    m_serial.setTimeout(serial::Timeout::max(), kIdleWaitMs, 0,
+                        kWriteTimeoutMs, WriteMsPerByte(baud_rate));
+#endif
   } catch (std::exception& e) {
     auto msg = std::string("Unhandled Exception while opening serial port: ");
     m_open_log_filter.Log(msg + e.what());
@@ -188,6 +261,7 @@ bool StdSerialIo::OpenComPortPhysical(const wxString& com_name,
 }
 
 void StdSerialIo::CloseComPortPhysical() {
+  std::lock_guard lock(m_port_mutex);
   try {
     m_serial.close();
   } catch (std::exception& e) {
@@ -197,6 +271,7 @@ void StdSerialIo::CloseComPortPhysical() {
 }
 
 ssize_t StdSerialIo::WriteComPortPhysical(const char* msg) {
+  std::lock_guard lock(m_port_mutex);
   if (m_serial.isOpen()) {
     try {
       return static_cast<ssize_t>(m_serial.write((uint8_t*)msg, strlen(msg)));
@@ -210,4 +285,21 @@ ssize_t StdSerialIo::WriteComPortPhysical(const char* msg) {
   }
 }
 
+/**
+ * Block until input arrives or kIdleWaitMs passes, then return what is
+ * available without waiting for more. Only the reader thread opens and
+ * closes the port, so no lock is needed here.
+ */
+size_t StdSerialIo::ReadComPortPhysical(uint8_t* buf, size_t size) {
+#ifdef _WIN32
+  return m_serial.read(buf, size);
+#else
+  if (!m_serial.waitReadable()) return 0;
+  // A disconnected device is readable but has no data: read one byte
+  // so that read() reports it.
+  size_t available = std::max<size_t>(1, m_serial.available());
+  return m_serial.read(buf, std::min(size, available));
+#endif
+}
+
 void SerialIo::RequestStop() { ThreadCtrl::RequestStop(); }
@@ -44,7 +44,9 @@
 DashboardInstrument_BaroHistory::DashboardInstrument_BaroHistory(
     wxWindow* parent, wxWindowID id, wxString title,
     InstrumentProperties* Properties)
-    : DashboardInstrument(parent, id, title, OCPN_DBP_STC_MDA, Properties) {
+    : DashboardInstrument(parent, id, title, OCPN_DBP_STC_MDA, Properties),
+      m_PressHistory(BARO_HISTORY_RETENTION),
+      m_VisibleCount(BARO_RECORD_COUNT) {
   SetDrawSoloInPane(true);
 
   m_MaxPress = 0;
@@ -65,21 +67,15 @@ DashboardInstrument_BaroHistory::DashboardInstrument_BaroHistory(
   m_SpdRecCnt = 0;
   m_SpdStartVal = -1;
   m_IsRunning = false;
-  m_SampleCount = 0;
   m_SetNewData = 0;
   m_LeftLegend = 3;
   m_RightLegend = 20;
-  for (int idx = 0; idx < BARO_RECORD_COUNT; idx++) {
-    m_ArrayPressHistory[idx] = -1;
-    m_ExpSmoothArrayPressure[idx] = -1;
-    m_ArrayRecTime[idx] = wxDateTime::Now().GetTm();
-    m_ArrayRecTime[idx].year = 999;
-  }
-  alpha = 0.01;  // smoothing constant
   m_WindowRect = GetClientRect();
   m_DrawAreaRect = GetClientRect();
   m_DrawAreaRect.SetHeight(m_WindowRect.height - m_TopLineHeight -
                            m_TitleHeight);
+  Bind(wxEVT_MOUSEWHEEL, &DashboardInstrument_BaroHistory::OnMouseWheel,
+       this);
 }
 
 wxSize DashboardInstrument_BaroHistory::GetSize(int orient, wxSize hint) {
@@ -112,34 +108,8 @@ void DashboardInstrument_BaroHistory::SetData(DASH_CAP st, double data,
       // the smoothed curves
       if (m_SpdRecCnt > 5) {
         m_IsRunning = true;
-        m_SampleCount = m_SampleCount < BARO_RECORD_COUNT ? m_SampleCount + 1
-                                                          : BARO_RECORD_COUNT;
-        m_MaxPress = 0;
-        ;
-        // data shifting
-        for (int idx = 1; idx < BARO_RECORD_COUNT; idx++) {
-          if (BARO_RECORD_COUNT - m_SampleCount <= idx)
-            m_MaxPress = wxMax(m_ArrayPressHistory[idx - 1], m_MaxPress);
-          m_MinPress = wxMin(m_ArrayPressHistory[idx - 1], m_MinPress);
-          m_ArrayPressHistory[idx - 1] = m_ArrayPressHistory[idx];
-          m_ExpSmoothArrayPressure[idx - 1] = m_ExpSmoothArrayPressure[idx];
-          m_ArrayRecTime[idx - 1] = m_ArrayRecTime[idx];
-        }
-        m_ArrayPressHistory[BARO_RECORD_COUNT - 1] = m_Press;
-        if (m_SampleCount < 2) {
-          m_ArrayPressHistory[BARO_RECORD_COUNT - 2] = m_Press;
-          m_ExpSmoothArrayPressure[BARO_RECORD_COUNT - 2] = m_Press;
-        }
-        m_ExpSmoothArrayPressure[BARO_RECORD_COUNT - 1] =
-            alpha * m_ArrayPressHistory[BARO_RECORD_COUNT - 2] +
-            (1 - alpha) * m_ExpSmoothArrayPressure[BARO_RECORD_COUNT - 2];
-        m_ArrayRecTime[BARO_RECORD_COUNT - 1] = wxDateTime::Now().GetTm();
-        m_MaxPress = wxMax(m_Press, m_MaxPress);
-
-        m_MinPress = wxMin(m_MinPress, m_Press);
-        if (wxMin(m_Press, m_MinPress) == -1) {
-          m_MinPress = wxMin(m_Press, 1200);  // to make a OK inital value
-        }
+        m_PressHistory.Append(m_Press, wxDateTime::Now().GetTicks());
+        UpdateMinMax();
         // get the overall max min pressure
         m_TotalMaxPress = wxMax(m_Press, m_TotalMaxPress);
         m_TotalMinPress = wxMin(m_Press, m_TotalMinPress);
@@ -154,6 +124,32 @@ void DashboardInstrument_BaroHistory::SetData(DASH_CAP st, double data,
   }
 }
 
+//*********************************************************************************
+// min and max values of the visible samples
+//*********************************************************************************
+void DashboardInstrument_BaroHistory::UpdateMinMax() {
+  double min, max;
+  if (m_PressHistory.GetMinMax(m_VisibleCount, min, max)) {
+    m_MinPress = min;
+    m_MaxPress = max;
+  }
+}
+
+//*********************************************************************************
+// zoom the time axis between the default span and the retained history
+//*********************************************************************************
+void DashboardInstrument_BaroHistory::OnMouseWheel(wxMouseEvent& event) {
+  size_t visible = m_VisibleCount;
+  if (event.GetWheelRotation() < 0)
+    visible = wxMin(visible * 2, (size_t)BARO_HISTORY_RETENTION);
+  else
+    visible = wxMax(visible / 2, (size_t)BARO_RECORD_COUNT);
+  if (visible == m_VisibleCount) return;
+  m_VisibleCount = visible;
+  UpdateMinMax();
+  Refresh();
+}
+
 void DashboardInstrument_BaroHistory::Draw(wxGCDC* dc) {
   m_WindowRect = GetClientRect();
   m_DrawAreaRect = GetClientRect();
@@ -355,20 +351,19 @@ void DashboardInstrument_BaroHistory::DrawForeground(wxGCDC* dc) {
     f = g_pFontLabel->GetChosenFont();
   dc->GetTextExtent(WindSpeed, &labelw, &labelh, 0, 0, &f);
   // determine the time range of the available data (=oldest data value)
-  int i = 0;
-  while (m_ArrayRecTime[i].year == 999 && i < BARO_RECORD_COUNT - 1) i++;
-  if (i == BARO_RECORD_COUNT - 1) {
+  time_t oldest = m_PressHistory.GetOldestTime(m_VisibleCount);
+  if (oldest == 0) {
     min = 0;
     hour = 0;
 
   } else {
-    wxDateTime localTime(m_ArrayRecTime[i]);
+    wxDateTime localTime(oldest);
     min = localTime.GetMinute();
     hour = localTime.GetHour();
   }
   m_DrawAreaRect.SetWidth(m_WindowRect.width - 3 - m_LeftLegend -
                           m_RightLegend);
-  m_ratioW = double(m_DrawAreaRect.width) / (BARO_RECORD_COUNT - 1);
+  m_ratioW = double(m_DrawAreaRect.width) / (m_VisibleCount - 1);
 
   dc->DrawText(wxString::Format(
                    _(" Max %.1f since %02d:%02d  Overall Max %.1f Min %.1f "),
@@ -380,32 +375,24 @@ void DashboardInstrument_BaroHistory::DrawForeground(wxGCDC* dc) {
   dc->SetPen(pen);
   ratioH = (double)m_DrawAreaRect.height / (double)m_MaxPressScale;
 
-  wxPoint pointsSpd[BARO_RECORD_COUNT + 2];
-  wxPoint bdDraw[BARO_RECORD_COUNT + 2];
-  int ls = 0;
-  bdDraw[ls].x = 1 * m_ratioW + 3 + m_LeftLegend;
-  bdDraw[ls].y =
-      m_TopLineHeight + m_DrawAreaRect.height -
-      ((m_ArrayPressHistory[1] - (double)m_TotalMinPress + 18) * ratioH);
+  // One column per pixel, regardless of the number of visible samples
+  std::vector<HistorySeries::Column> columns;
+  m_PressHistory.Decimate(m_VisibleCount, wxMax(m_DrawAreaRect.width, 1),
+                          columns);
 
   //---------------------------------------------------------------------------------
   // live pressure data
   //---------------------------------------------------------------------------------
-
-  for (int idx = 1; idx < BARO_RECORD_COUNT; idx++) {
-    pointsSpd[idx].x = idx * m_ratioW + 3 + m_LeftLegend;
+  std::vector<wxPoint> bdDraw;
+  int bottom = m_TopLineHeight + m_DrawAreaRect.height;
+  for (const auto& column : columns) {
+    wxPoint point;
+    point.x = column.slot * m_ratioW + 3 + m_LeftLegend;
     // Print the smoothed value to avoid jumps in the single line.
-    pointsSpd[idx].y =
-        m_TopLineHeight + m_DrawAreaRect.height -
-        ((m_ExpSmoothArrayPressure[idx] - m_TotalMinPress + 18.0) * ratioH);
-    if (BARO_RECORD_COUNT - m_SampleCount <= idx &&
-        pointsSpd[idx].y > m_TopLineHeight &&
-        pointsSpd[idx].y <= m_TopLineHeight + m_DrawAreaRect.height) {
-      bdDraw[ls] = pointsSpd[idx];
-      ls++;
-    }
+    point.y = bottom - ((column.smoothed - m_TotalMinPress + 18.0) * ratioH);
+    if (point.y > m_TopLineHeight && point.y <= bottom) bdDraw.push_back(point);
   }
-  if (ls > 1) dc->DrawLines(ls, bdDraw);
+  if (bdDraw.size() > 1) dc->DrawLines(bdDraw.size(), &bdDraw[0]);
 
   //---------------------------------------------------------------------------------
   // exponential smoothing of barometric pressure
@@ -432,7 +419,7 @@ void DashboardInstrument_BaroHistory::DrawForeground(wxGCDC* dc) {
 
   */
   //---------------------------------------------------------------------------------
-  // Draw vertical timelines every 60 minutes
+  // Draw vertical timelines every 60 minutes, wider apart when zoomed out
   //---------------------------------------------------------------------------------
   GetGlobalColor("DASHL", &col);
   pen.SetColour(col);
@@ -440,24 +427,34 @@ void DashboardInstrument_BaroHistory::DrawForeground(wxGCDC* dc) {
   dc->SetPen(pen);
   dc->SetTextForeground(col);
   dc->SetFont((g_pFontSmall->GetChosenFont()));
+  if (columns.empty()) return;
+  static const int kIntervals[] = {60, 120, 180, 360, 720};
+  time_t span = columns.back().time - columns.front().time;
+  int interval = 0;
+  for (int minutes : kIntervals) {
+    interval = minutes;
+    if (span / 60 / minutes < 8) break;
+  }
   int done = -1;
   wxPoint pointTime;
-  for (int idx = 0; idx < BARO_RECORD_COUNT; idx++) {
-    if (m_ArrayRecTime[idx].year != 999) {
-      wxDateTime localTime(m_ArrayRecTime[idx]);
-      hour = localTime.GetHour();
-      min = localTime.GetMinute();
-      if ((hour * 100 + min) != done && (min == 0)) {
-        pointTime.x = idx * m_ratioW + 3 + m_LeftLegend;
-        dc->DrawLine(pointTime.x, m_TopLineHeight + 1, pointTime.x,
-                     (m_TopLineHeight + m_DrawAreaRect.height + 1));
-        label.Printf(_T("%02d:%02d"), hour, min);
-        f = g_pFontSmall->GetChosenFont();
-        dc->GetTextExtent(label, &width, &height, 0, 0, &f);
-        dc->DrawText(label, pointTime.x - width / 2,
-                     m_WindowRect.height - height);
-        done = hour * 100 + min;
-      }
+  for (const auto& column : columns) {
+    wxDateTime localTime(column.time);
+    int line = (localTime.GetHour() * 60 + localTime.GetMinute()) / interval;
+    // Draw where a new interval starts, on the first column only if exact
+    bool is_start = done == -1 ? localTime.GetMinute() % interval == 0
+                               : line != done;
+    if (is_start) {
+      hour = line * interval / 60;
+      min = line * interval % 60;
+      pointTime.x = column.slot * m_ratioW + 3 + m_LeftLegend;
+      dc->DrawLine(pointTime.x, m_TopLineHeight + 1, pointTime.x,
+                   (m_TopLineHeight + m_DrawAreaRect.height + 1));
+      label.Printf(_T("%02d:%02d"), hour, min);
+      f = g_pFontSmall->GetChosenFont();
+      dc->GetTextExtent(label, &width, &height, 0, 0, &f);
+      dc->DrawText(label, pointTime.x - width / 2,
+                   m_WindowRect.height - height);
     }
+    done = line;
   }
 }
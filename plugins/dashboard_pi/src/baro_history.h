@@ -41,11 +41,16 @@
 #include <wx/wx.h>
 #endif
 
-// Warn: div by 0 if count == 1
+#include <vector>
+
+// Default number of samples shown. Warn: div by 0 if count == 1
 #define BARO_RECORD_COUNT 2000
+// Samples retained, 24 hours at one sample per second
+#define BARO_HISTORY_RETENTION (24 * 3600)
 
 #include "instrument.h"
 #include "dial.h"
+#include "history_series.h"
 
 class DashboardInstrument_BaroHistory : public DashboardInstrument {
 public:
@@ -65,12 +70,8 @@ private:
   int m_WindDirShift;
 
 protected:
-  double alpha;
-  double m_ArrayBaroHistory[BARO_RECORD_COUNT];
-  double m_ArrayPressHistory[BARO_RECORD_COUNT];
-  double m_ExpSmoothArrayPressure[BARO_RECORD_COUNT];
-
-  wxDateTime::Tm m_ArrayRecTime[BARO_RECORD_COUNT];
+  HistorySeries m_PressHistory;
+  size_t m_VisibleCount;  // Number of newest samples shown
 
   double m_MaxPress;       //...in array
   double m_MinPress;       //...in array
@@ -81,7 +82,6 @@ protected:
   double m_ratioW;
 
   bool m_IsRunning;
-  int m_SampleCount;
   int m_SetNewData;
   wxRect m_WindowRect;
   wxRect m_DrawAreaRect;  // the coordinates of the real darwing area
@@ -95,6 +95,8 @@ protected:
   void DrawBackground(wxGCDC* dc);
   void DrawForeground(wxGCDC* dc);
   void SetMinMaxWindScale();
+  void UpdateMinMax();
+  void OnMouseWheel(wxMouseEvent& event);
 
   void DrawWindSpeedScale(wxGCDC* dc);
   // wxString GetWindDirStr(wxString WindDir);
@@ -0,0 +1,170 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+#include <algorithm>
+
+#include "history_series.h"
+
+int HistorySeries::Column::Trace(double values[4]) const {
+  if (count == 1) {
+    values[0] = close;
+    return 1;
+  }
+  bool rising = close >= open;
+  values[0] = open;
+  values[1] = rising ? min : max;
+  values[2] = rising ? max : min;
+  values[3] = close;
+  return 4;
+}
+
+HistorySeries::HistorySeries(size_t capacity, double alpha)
+    : m_capacity(std::max(capacity, size_t(2))),
+      m_alpha(alpha),
+      m_smoothed(0),
+      m_total(0) {
+  size_t levels = 0;
+  while ((size_t(2) << levels) <= m_capacity) levels++;
+  m_levels.resize(levels);
+}
+
+void HistorySeries::Clear() {
+  m_total = 0;
+  m_smoothed = 0;
+  m_samples.clear();
+  for (auto& level : m_levels) level.clear();
+}
+
+const HistorySeries::MinMax& HistorySeries::Node(size_t level,
+                                                  uint64_t index) const {
+  const std::vector<MinMax>& nodes = m_levels[level - 1];
+  return nodes[index % ((m_capacity >> level) + 1)];
+}
+
+void HistorySeries::SetNode(size_t level, uint64_t index, MinMax node) {
+  // Enough nodes to cover the retained samples at any alignment.
+  std::vector<MinMax>& nodes = m_levels[level - 1];
+  size_t node_capacity = (m_capacity >> level) + 1;
+  if (nodes.size() < node_capacity)
+    nodes.push_back(node);
+  else
+    nodes[index % node_capacity] = node;
+}
+
+void HistorySeries::Append(double value, time_t time) {
+  if (m_total == 0)
+    m_smoothed = value;
+  else
+    m_smoothed = m_alpha * value + (1 - m_alpha) * m_smoothed;
+
+  Sample sample = {float(value), float(m_smoothed), time};
+  uint64_t seq = m_total++;
+  if (m_samples.size() < m_capacity)
+    m_samples.push_back(sample);
+  else
+    m_samples[seq % m_capacity] = sample;
+
+  // Complete the nodes ending with this sample, merging each with its left
+  // sibling. Level k is only reached every 2^k samples.
+  MinMax node = {sample.value, sample.value};
+  for (size_t level = 1; level <= m_levels.size(); level++) {
+    if (((seq + 1) & ((uint64_t(1) << level) - 1)) != 0) break;
+    MinMax left;
+    if (level == 1) {
+      float v = At(seq - 1).value;
+      left = {v, v};
+    } else {
+      left = Node(level - 1, (seq >> (level - 1)) - 1);
+    }
+    node.min = std::min(node.min, left.min);
+    node.max = std::max(node.max, left.max);
+    SetNode(level, seq >> level, node);
+  }
+}
+
+double HistorySeries::GetLast() const { return At(m_total - 1).value; }
+
+double HistorySeries::GetLastSmoothed() const {
+  return At(m_total - 1).smoothed;
+}
+
+HistorySeries::MinMax HistorySeries::GetRange(uint64_t first,
+                                              uint64_t last) const {
+  MinMax range = {At(first).value, At(first).value};
+  while (first < last) {
+    // Largest aligned, complete block starting at first and inside range.
+    size_t level = 0;
+    while (level < m_levels.size()) {
+      uint64_t size = uint64_t(2) << level;
+      if ((first & (size - 1)) != 0 || first + size > last) break;
+      level++;
+    }
+    MinMax block;
+    if (level == 0) {
+      float v = At(first).value;
+      block = {v, v};
+    } else {
+      block = Node(level, first >> level);
+    }
+    range.min = std::min(range.min, block.min);
+    range.max = std::max(range.max, block.max);
+    first += uint64_t(1) << level;
+  }
+  return range;
+}
+
+bool HistorySeries::GetMinMax(size_t window, double& min, double& max) const {
+  if (m_samples.empty() || window == 0) return false;
+  uint64_t first = m_total - std::min<uint64_t>(window, m_samples.size());
+  MinMax range = GetRange(first, m_total);
+  min = range.min;
+  max = range.max;
+  return true;
+}
+
+time_t HistorySeries::GetOldestTime(size_t window) const {
+  if (m_samples.empty() || window == 0) return 0;
+  return At(m_total - std::min<uint64_t>(window, m_samples.size())).time;
+}
+
+void HistorySeries::Decimate(size_t window, size_t columns,
+                             std::vector<Column>& out) const {
+  out.clear();
+  if (m_samples.empty() || window == 0 || columns == 0) return;
+  columns = std::min(columns, window);
+  // Sequence numbers may be negative for slots older than any sample.
+  int64_t base = int64_t(m_total) - int64_t(window);
+  int64_t oldest = int64_t(Oldest());
+  for (size_t c = 0; c < columns; c++) {
+    int64_t first = base + int64_t(c * window / columns);
+    int64_t last = base + int64_t((c + 1) * window / columns);
+    if (last <= oldest) continue;
+    first = std::max(first, oldest);
+    const Sample& newest = At(last - 1);
+    MinMax range = GetRange(first, last);
+    Column column;
+    column.slot = size_t(last - 1 - base);
+    column.count = size_t(last - first);
+    column.open = At(first).value;
+    column.close = newest.value;
+    column.min = range.min;
+    column.max = range.max;
+    column.smoothed = newest.smoothed;
+    column.time = newest.time;
+    out.push_back(column);
+  }
+}
@@ -0,0 +1,128 @@
+/***************************************************************************
+ *   Copyright (C) 2025 by OpenCPN developer team                          *
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ *   This program is distributed in the hope that it will be useful,       *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>. *
+ ***************************************************************************/
+
+/**************************************************************************
+ * Time series storage for the history instruments.                       *
+ *                                                                        *
+ * Samples are kept in a ring buffer, so appending does not move the      *
+ * existing history. Each sample stores its exponentially smoothed value, *
+ * computed from the previous one when appended. A pyramid of min/max     *
+ * values over aligned blocks of 2, 4, 8... samples is updated as blocks  *
+ * complete (amortized O(1) per sample) and answers min/max queries over  *
+ * any range in O(log n). This lets an instrument draw any number of      *
+ * samples at the window width in pixels without visiting every sample.   *
+ *                                                                        *
+ * Memory grows with the number of samples up to the capacity; the        *
+ * oldest samples are then overwritten.                                   *
+ **************************************************************************
+ */
+
+#ifndef HISTORY_SERIES_H_
+#define HISTORY_SERIES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+class HistorySeries {
+public:
+  /** One column of a decimated window, typically one pixel wide. */
+  struct Column {
+    size_t slot;      // Window slot of the newest sample in column
+    size_t count;     // Number of samples in column
+    double open;      // Oldest value
+    double close;     // Newest value
+    double min;
+    double max;
+    double smoothed;  // Smoothed value of newest sample
+    time_t time;      // Time of newest sample
+
+    /**
+     * Store the values to draw for the column in time order: open, the
+     * extremes and close, or just the value if the column has one sample.
+     * @return Number of values stored, 1 or 4.
+     */
+    int Trace(double values[4]) const;
+  };
+
+  /**
+   * @param capacity Max number of retained samples, at least 2.
+   * @param alpha Exponential smoothing constant.
+   */
+  HistorySeries(size_t capacity, double alpha = 0.01);
+
+  void Append(double value, time_t time);
+  void Clear();
+
+  /** Number of retained samples. */
+  size_t Size() const { return m_samples.size(); }
+  size_t GetCapacity() const { return m_capacity; }
+
+  /** Newest value and its smoothed value, undefined if empty. */
+  double GetLast() const;
+  double GetLastSmoothed() const;
+
+  /**
+   * Get min and max of the raw values among the window newest samples.
+   * @return false if there are no samples.
+   */
+  bool GetMinMax(size_t window, double& min, double& max) const;
+
+  /** Time of oldest retained sample among the window newest, 0 if none. */
+  time_t GetOldestTime(size_t window) const;
+
+  /**
+   * Reduce the window newest sample slots to at most columns columns. Slot
+   * 0 is the oldest slot; slots older than the retained samples are left
+   * out. Cost is O(columns * log(window / columns)).
+   */
+  void Decimate(size_t window, size_t columns, std::vector<Column>& out) const;
+
+private:
+  struct Sample {
+    float value;
+    float smoothed;
+    time_t time;
+  };
+
+  struct MinMax {
+    float min;
+    float max;
+  };
+
+  const Sample& At(uint64_t seq) const { return m_samples[seq % m_capacity]; }
+
+  /** Sequence number of oldest retained sample. */
+  uint64_t Oldest() const { return m_total - m_samples.size(); }
+
+  /** Pyramid node covering samples [index << level, (index + 1) << level). */
+  const MinMax& Node(size_t level, uint64_t index) const;
+  void SetNode(size_t level, uint64_t index, MinMax node);
+
+  /** Min/max of samples [first, last), all retained. */
+  MinMax GetRange(uint64_t first, uint64_t last) const;
+
+  size_t m_capacity;
+  double m_alpha;
+  double m_smoothed;
+  uint64_t m_total;  // Number of samples appended since Clear()
+  std::vector<Sample> m_samples;
+  std::vector<std::vector<MinMax> > m_levels;  // [level - 1], level >= 1
+};
+
+#endif  // HISTORY_SERIES_H_
@@ -44,7 +44,10 @@
 DashboardInstrument_WindDirHistory::DashboardInstrument_WindDirHistory(
     wxWindow* parent, wxWindowID id, wxString title,
     InstrumentProperties* Properties)
-    : DashboardInstrument(parent, id, title, OCPN_DBP_STC_TWD, Properties) {
+    : DashboardInstrument(parent, id, title, OCPN_DBP_STC_TWD, Properties),
+      m_WindDirHistory(WIND_HISTORY_RETENTION),
+      m_WindSpdHistory(WIND_HISTORY_RETENTION),
+      m_VisibleCount(WIND_RECORD_COUNT) {
   m_cap_flag.set(OCPN_DBP_STC_TWS);
   SetDrawSoloInPane(true);
   m_MaxWindDir = -1;
@@ -70,22 +73,14 @@ DashboardInstrument_WindDirHistory::DashboardInstrument_WindDirHistory(
   m_DirStartVal = -1;
   m_IsRunning = false;
   m_SetNewData = 0;
-  m_SampleCount = 0;
   m_LeftLegend = 3;
   m_RightLegend = 3;
-  for (int idx = 0; idx < WIND_RECORD_COUNT; idx++) {
-    m_ArrayWindDirHistory[idx] = -1;
-    m_ArrayWindSpdHistory[idx] = -1;
-    m_ExpSmoothArrayWindSpd[idx] = -1;
-    m_ExpSmoothArrayWindDir[idx] = -1;
-    m_ArrayRecTime[idx] = wxDateTime::Now().GetTm();
-    m_ArrayRecTime[idx].year = 999;
-  }
-  alpha = 0.01;  // smoothing constant
   m_WindowRect = GetClientRect();
   m_DrawAreaRect = GetClientRect();
   m_DrawAreaRect.SetHeight(m_WindowRect.height - m_TopLineHeight -
                            m_TitleHeight);
+  Bind(wxEVT_MOUSEWHEEL, &DashboardInstrument_WindDirHistory::OnMouseWheel,
+       this);
 }
 
 wxSize DashboardInstrument_WindDirHistory::GetSize(int orient, wxSize hint) {
@@ -145,55 +140,19 @@ void DashboardInstrument_WindDirHistory::SetData(DASH_CAP st, double data,
       // the smoothed curves
       if (m_SpdRecCnt > 5 && m_DirRecCnt > 5) {
         m_IsRunning = true;
-        m_SampleCount = m_SampleCount < WIND_RECORD_COUNT ? m_SampleCount + 1
-                                                          : WIND_RECORD_COUNT;
-        m_MaxWindDir = 0;
-        m_MinWindDir = 360;
-        m_MaxWindSpd = 0;
-        // data shifting
-        for (int idx = 1; idx < WIND_RECORD_COUNT; idx++) {
-          if (WIND_RECORD_COUNT - m_SampleCount <= idx)
-            m_MinWindDir = wxMin(m_ArrayWindDirHistory[idx], m_MinWindDir);
-          m_MaxWindDir = wxMax(m_ArrayWindDirHistory[idx - 1], m_MaxWindDir);
-          m_MaxWindSpd = wxMax(m_ArrayWindSpdHistory[idx - 1], m_MaxWindSpd);
-          m_ArrayWindDirHistory[idx - 1] = m_ArrayWindDirHistory[idx];
-          m_ArrayWindSpdHistory[idx - 1] = m_ArrayWindSpdHistory[idx];
-          m_ExpSmoothArrayWindSpd[idx - 1] = m_ExpSmoothArrayWindSpd[idx];
-          m_ExpSmoothArrayWindDir[idx - 1] = m_ExpSmoothArrayWindDir[idx];
-          m_ArrayRecTime[idx - 1] = m_ArrayRecTime[idx];
-        }
         double diff = m_WindDir - m_oldDirVal;
         if (diff < -270) {
           m_WindDir += 360;
         } else if (diff > 270) {
           m_WindDir -= 360;
         }
-        m_ArrayWindDirHistory[WIND_RECORD_COUNT - 1] = m_WindDir;
-        m_ArrayWindSpdHistory[WIND_RECORD_COUNT - 1] = m_WindSpd;
-        if (m_SampleCount < 2) {
-          m_ArrayWindSpdHistory[WIND_RECORD_COUNT - 2] = m_WindSpd;
-          m_ExpSmoothArrayWindSpd[WIND_RECORD_COUNT - 2] = m_WindSpd;
-          m_ArrayWindDirHistory[WIND_RECORD_COUNT - 2] = m_WindDir;
-          m_ExpSmoothArrayWindDir[WIND_RECORD_COUNT - 2] = m_WindDir;
-        }
-        m_ExpSmoothArrayWindSpd[WIND_RECORD_COUNT - 1] =
-            alpha * m_ArrayWindSpdHistory[WIND_RECORD_COUNT - 2] +
-            (1 - alpha) * m_ExpSmoothArrayWindSpd[WIND_RECORD_COUNT - 2];
-        m_ExpSmoothArrayWindDir[WIND_RECORD_COUNT - 1] =
-            alpha * m_ArrayWindDirHistory[WIND_RECORD_COUNT - 2] +
-            (1 - alpha) * m_ExpSmoothArrayWindDir[WIND_RECORD_COUNT - 2];
-        m_ArrayRecTime[WIND_RECORD_COUNT - 1] = wxDateTime::Now().GetTm();
-        m_oldDirVal = m_ExpSmoothArrayWindDir[WIND_RECORD_COUNT - 1];
-        // include the new/latest value in the max/min value test too
-        m_MaxWindDir = wxMax(m_WindDir, m_MaxWindDir);
-        m_MinWindDir = wxMin(m_WindDir, m_MinWindDir);
-        m_MaxWindSpd = wxMax(m_WindSpd, m_MaxWindSpd);
+        time_t now = wxDateTime::Now().GetTicks();
+        m_WindDirHistory.Append(m_WindDir, now);
+        m_WindSpdHistory.Append(m_WindSpd, now);
+        m_oldDirVal = m_WindDirHistory.GetLastSmoothed();
         // get the overall max Wind Speed
         m_TotalMaxWindSpd = wxMax(m_WindSpd, m_TotalMaxWindSpd);
-
-        // set wind angle scale to full +/- 90 degr depending on the real
-        // max/min value recorded
-        SetMinMaxWindScale();
+        UpdateMinMax();
         // Wait two times until new data.
         m_SetNewData = 2;
       }
@@ -215,17 +174,10 @@ void DashboardInstrument_WindDirHistory::ResetData() {
   m_DirStartVal = -1;
   m_IsRunning = false;
   m_SetNewData = 0;
-  m_SampleCount = 0;
   m_LeftLegend = 3;
   m_RightLegend = 3;
-  for (int idx = 0; idx < WIND_RECORD_COUNT; idx++) {
-    m_ArrayWindDirHistory[idx] = -1;
-    m_ArrayWindSpdHistory[idx] = -1;
-    m_ExpSmoothArrayWindSpd[idx] = -1;
-    m_ExpSmoothArrayWindDir[idx] = -1;
-    m_ArrayRecTime[idx] = wxDateTime::Now().GetTm();
-    m_ArrayRecTime[idx].year = 999;
-  }
+  m_WindDirHistory.Clear();
+  m_WindSpdHistory.Clear();
 }
 
 void DashboardInstrument_WindDirHistory::Draw(wxGCDC* dc) {
@@ -238,6 +190,40 @@ void DashboardInstrument_WindDirHistory::Draw(wxGCDC* dc) {
   DrawForeground(dc);
 }
 
+//*********************************************************************************
+// min and max values of the visible samples, then the direction scale
+//*********************************************************************************
+void DashboardInstrument_WindDirHistory::UpdateMinMax() {
+  double min, max;
+  m_MaxWindDir = 0;
+  m_MinWindDir = 360;
+  if (m_WindDirHistory.GetMinMax(m_VisibleCount, min, max)) {
+    m_MaxWindDir = wxMax(max, m_MaxWindDir);
+    m_MinWindDir = wxMin(min, m_MinWindDir);
+  }
+  m_MaxWindSpd = 0;
+  if (m_WindSpdHistory.GetMinMax(m_VisibleCount, min, max))
+    m_MaxWindSpd = wxMax(max, m_MaxWindSpd);
+  // set wind angle scale to full +/- 90 degr depending on the real
+  // max/min value recorded
+  SetMinMaxWindScale();
+}
+
+//*********************************************************************************
+// zoom the time axis between the default span and the retained history
+//*********************************************************************************
+void DashboardInstrument_WindDirHistory::OnMouseWheel(wxMouseEvent& event) {
+  size_t visible = m_VisibleCount;
+  if (event.GetWheelRotation() < 0)
+    visible = wxMin(visible * 2, (size_t)WIND_HISTORY_RETENTION);
+  else
+    visible = wxMax(visible / 2, (size_t)WIND_RECORD_COUNT);
+  if (visible == m_VisibleCount) return;
+  m_VisibleCount = visible;
+  if (m_IsRunning) UpdateMinMax();
+  Refresh();
+}
+
 //*********************************************************************************
 // determine and set  min and max values for the direction
 //*********************************************************************************
@@ -664,30 +650,19 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
   ratioH = (double)m_DrawAreaRect.height / m_WindDirRange;
   m_DrawAreaRect.SetWidth(m_WindowRect.width - 6 - m_LeftLegend -
                           m_RightLegend);
-  m_ratioW = double(m_DrawAreaRect.width) / (WIND_RECORD_COUNT - 1);
+  m_ratioW = double(m_DrawAreaRect.width) / (m_VisibleCount - 1);
+
+  // One column per pixel, regardless of the number of visible samples
+  std::vector<HistorySeries::Column> columns;
+  std::vector<wxPoint> points;
+  m_WindDirHistory.Decimate(m_VisibleCount, wxMax(m_DrawAreaRect.width, 1),
+                            columns);
 
   //---------------------------------------------------------------------------------
   // live direction data
   //---------------------------------------------------------------------------------
-  wxPoint points[WIND_RECORD_COUNT + 2];
-  wxPoint wdDraw[WIND_RECORD_COUNT + 2];
-  int ld = 0;
-  wdDraw[ld].x = m_ratioW + 3 + m_LeftLegend;
-  wdDraw[ld].y = m_TopLineHeight + m_DrawAreaRect.height -
-                 (m_ArrayWindDirHistory[1] - m_MinWindDir) * ratioH;
-
-  for (int idx = 1; idx < WIND_RECORD_COUNT; idx++) {
-    points[idx].x = idx * m_ratioW + 3 + m_LeftLegend;
-    points[idx].y = m_TopLineHeight + m_DrawAreaRect.height -
-                    (m_ArrayWindDirHistory[idx] - m_MinWindDir) * ratioH;
-    if (WIND_RECORD_COUNT - m_SampleCount <= idx &&
-        points[idx].y > m_TopLineHeight &&
-        points[idx].y <= m_TopLineHeight + m_DrawAreaRect.height) {
-      wdDraw[ld] = points[idx];
-      ld++;
-    }
-  }
-  if (ld > 1) dc->DrawLines(ld, wdDraw);
+  GetPolyline(columns, false, m_MinWindDir, ratioH, points);
+  if (points.size() > 1) dc->DrawLines(points.size(), &points[0]);
 
   //---------------------------------------------------------------------------------
   // exponential smoothing of direction
@@ -706,23 +681,8 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
   pen.SetWidth(2);
   dc->SetPen(pen);
 
-  ld = 0;
-  wdDraw[ld].x = m_ratioW + 3 + m_LeftLegend;
-  wdDraw[ld].y = m_TopLineHeight + m_DrawAreaRect.height -
-                 (m_ExpSmoothArrayWindDir[ld] - m_MinWindDir) * ratioH;
-
-  for (int idx = 1; idx < WIND_RECORD_COUNT; idx++) {
-    points[idx].x = idx * m_ratioW + 3 + m_LeftLegend;
-    points[idx].y = m_TopLineHeight + m_DrawAreaRect.height -
-                    (m_ExpSmoothArrayWindDir[idx] - m_MinWindDir) * ratioH;
-    if (WIND_RECORD_COUNT - m_SampleCount <= idx &&
-        points[idx].y > m_TopLineHeight &&
-        points[idx].y <= m_TopLineHeight + m_DrawAreaRect.height) {
-      wdDraw[ld] = points[idx];
-      ld++;
-    }
-  }
-  if (ld > 1) dc->DrawLines(ld, wdDraw);
+  GetPolyline(columns, true, m_MinWindDir, ratioH, points);
+  if (points.size() > 1) dc->DrawLines(points.size(), &points[0]);
 
   //---------------------------------------------------------------------------------
   // wind speed
@@ -769,13 +729,12 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
     dc->SetTextForeground(GetColourSchemeFont(g_pFontSmall->GetColour()));
   }
   // determine the time range of the available data (=oldest data value)
-  int i = 0;
-  while (m_ArrayRecTime[i].year == 999 && i < WIND_RECORD_COUNT - 1) i++;
-  if (i == WIND_RECORD_COUNT - 1) {
+  time_t oldest = m_WindSpdHistory.GetOldestTime(m_VisibleCount);
+  if (oldest == 0) {
     min = 0;
     hour = 0;
   } else {
-    wxDateTime localTime(m_ArrayRecTime[i]);
+    wxDateTime localTime(oldest);
     min = localTime.GetMinute();
     hour = localTime.GetHour();
   }
@@ -836,30 +795,14 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
   pen.SetWidth(1);
   dc->SetPen(pen);
   ratioH = (double)m_DrawAreaRect.height / m_MaxWindSpdScale;
-  wxPoint pointsSpd[WIND_RECORD_COUNT + 2];
-  wxPoint spdDraw[WIND_RECORD_COUNT + 2];
+  m_WindSpdHistory.Decimate(m_VisibleCount, wxMax(m_DrawAreaRect.width, 1),
+                            columns);
 
   //---------------------------------------------------------------------------------
   // live speed data
   //---------------------------------------------------------------------------------
-
-  int ls = 0;
-  spdDraw[ls].x = 1 * m_ratioW + 3 + m_LeftLegend;
-  spdDraw[ls].y = m_TopLineHeight + m_DrawAreaRect.height -
-                  m_ArrayWindSpdHistory[1] * ratioH;
-
-  for (int idx = 1; idx < WIND_RECORD_COUNT; idx++) {
-    pointsSpd[idx].x = idx * m_ratioW + 3 + m_LeftLegend;
-    pointsSpd[idx].y = m_TopLineHeight + m_DrawAreaRect.height -
-                       m_ArrayWindSpdHistory[idx] * ratioH;
-    if (WIND_RECORD_COUNT - m_SampleCount <= idx &&
-        pointsSpd[idx].y > m_TopLineHeight &&
-        pointsSpd[idx].y <= m_TopLineHeight + m_DrawAreaRect.height) {
-      spdDraw[ls] = pointsSpd[idx];
-      ls++;
-    }
-  }
-  if (ls > 1) dc->DrawLines(ls, spdDraw);
+  GetPolyline(columns, false, 0, ratioH, points);
+  if (points.size() > 1) dc->DrawLines(points.size(), &points[0]);
 
   //---------------------------------------------------------------------------------
   // exponential smoothing of speed
@@ -877,26 +820,11 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
   // pen.SetColour(wxColour(61, 61, 204, 255));  // blue, opaque
   pen.SetWidth(2);
   dc->SetPen(pen);
-  ls = 0;
-  spdDraw[ls].x = 1 * m_ratioW + 3 + m_LeftLegend;
-  spdDraw[ls].y = m_TopLineHeight + m_DrawAreaRect.height -
-                  m_ExpSmoothArrayWindSpd[1] * ratioH;
-
-  for (int idx = 1; idx < WIND_RECORD_COUNT; idx++) {
-    pointsSpd[idx].x = idx * m_ratioW + 3 + m_LeftLegend;
-    pointsSpd[idx].y = m_TopLineHeight + m_DrawAreaRect.height -
-                       m_ExpSmoothArrayWindSpd[idx] * ratioH;
-    if (WIND_RECORD_COUNT - m_SampleCount <= idx &&
-        pointsSpd[idx].y > m_TopLineHeight &&
-        pointsSpd[idx].y <= m_TopLineHeight + m_DrawAreaRect.height) {
-      spdDraw[ls] = pointsSpd[idx];
-      ls++;
-    }
-  }
-  if (ls > 1) dc->DrawLines(ls, spdDraw);
+  GetPolyline(columns, true, 0, ratioH, points);
+  if (points.size() > 1) dc->DrawLines(points.size(), &points[0]);
 
   //---------------------------------------------------------------------------------
-  // draw vertical timelines every 10 minutes
+  // draw vertical timelines every 15 minutes, wider apart when zoomed out
   //---------------------------------------------------------------------------------
   GetGlobalColor(_T("DASHL"), &col);
   pen.SetColour(col);
@@ -904,24 +832,57 @@ void DashboardInstrument_WindDirHistory::DrawForeground(wxGCDC* dc) {
   dc->SetPen(pen);
   dc->SetTextForeground(col);
   dc->SetFont((g_pFontSmall->GetChosenFont()));
+  if (columns.empty()) return;
+  static const int kIntervals[] = {15, 30, 60, 120, 180, 360, 720};
+  time_t span = columns.back().time - columns.front().time;
+  int interval = 0;
+  for (int minutes : kIntervals) {
+    interval = minutes;
+    if (span / 60 / minutes < 8) break;
+  }
   int done = -1;
   wxPoint pointTime;
-  for (int idx = 0; idx < WIND_RECORD_COUNT; idx++) {
-    if (m_ArrayRecTime[idx].year != 999) {
-      wxDateTime localTime(m_ArrayRecTime[idx]);
-      hour = localTime.GetHour();
-      min = localTime.GetMinute();
-      if ((hour * 100 + min) != done && (min % 15 == 0)) {
-        pointTime.x = idx * m_ratioW + 3 + m_LeftLegend;
-        dc->DrawLine(pointTime.x, m_TopLineHeight + 1, pointTime.x,
-                     (m_TopLineHeight + m_DrawAreaRect.height + 1));
-        label.Printf(_T("%02d:%02d"), hour, min);
-        f = g_pFontSmall->GetChosenFont();
-        dc->GetTextExtent(label, &width, &height, 0, 0, &f);
-        dc->DrawText(label, pointTime.x - width / 2,
-                     m_WindowRect.height - height);
-        done = hour * 100 + min;
-      }
+  for (const auto& column : columns) {
+    wxDateTime localTime(column.time);
+    int line = (localTime.GetHour() * 60 + localTime.GetMinute()) / interval;
+    // Draw where a new interval starts, on the first column only if exact
+    bool is_start = done == -1 ? localTime.GetMinute() % interval == 0
+                               : line != done;
+    if (is_start) {
+      hour = line * interval / 60;
+      min = line * interval % 60;
+      pointTime.x = column.slot * m_ratioW + 3 + m_LeftLegend;
+      dc->DrawLine(pointTime.x, m_TopLineHeight + 1, pointTime.x,
+                   (m_TopLineHeight + m_DrawAreaRect.height + 1));
+      label.Printf(_T("%02d:%02d"), hour, min);
+      f = g_pFontSmall->GetChosenFont();
+      dc->GetTextExtent(label, &width, &height, 0, 0, &f);
+      dc->DrawText(label, pointTime.x - width / 2,
+                   m_WindowRect.height - height);
+    }
+    done = line;
+  }
+}
+
+//*********************************************************************************
+// polyline through the columns, skipping points outside the drawing area
+//*********************************************************************************
+void DashboardInstrument_WindDirHistory::GetPolyline(
+    const std::vector<HistorySeries::Column>& columns, bool smoothed,
+    double offset, double ratioH, std::vector<wxPoint>& points) {
+  points.clear();
+  int bottom = m_TopLineHeight + m_DrawAreaRect.height;
+  for (const auto& column : columns) {
+    double values[4];
+    int count = 1;
+    if (smoothed)
+      values[0] = column.smoothed;
+    else
+      count = column.Trace(values);
+    int x = column.slot * m_ratioW + 3 + m_LeftLegend;
+    for (int i = 0; i < count; i++) {
+      int y = bottom - (values[i] - offset) * ratioH;
+      if (y > m_TopLineHeight && y <= bottom) points.push_back(wxPoint(x, y));
     }
   }
 }
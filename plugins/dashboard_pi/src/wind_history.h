@@ -41,11 +41,16 @@
 #include <wx/wx.h>
 #endif
 
-// Warn: div by 0 if count == 1
+#include <vector>
+
+// Default number of samples shown. Warn: div by 0 if count == 1
 #define WIND_RECORD_COUNT 2000
+// Samples retained, 24 hours at one sample per second
+#define WIND_HISTORY_RETENTION (24 * 3600)
 
 #include "instrument.h"
 #include "dial.h"
+#include "history_series.h"
 
 class DashboardInstrument_WindDirHistory : public DashboardInstrument {
 public:
@@ -63,12 +68,9 @@ private:
   int m_WindDirShift;
 
 protected:
-  double alpha;
-  double m_ArrayWindDirHistory[WIND_RECORD_COUNT];
-  double m_ArrayWindSpdHistory[WIND_RECORD_COUNT];
-  double m_ExpSmoothArrayWindSpd[WIND_RECORD_COUNT];
-  double m_ExpSmoothArrayWindDir[WIND_RECORD_COUNT];
-  wxDateTime::Tm m_ArrayRecTime[WIND_RECORD_COUNT];
+  HistorySeries m_WindDirHistory;
+  HistorySeries m_WindSpdHistory;
+  size_t m_VisibleCount;  // Number of newest samples shown
 
   double m_MaxWindDir;
   double m_MinWindDir;
@@ -81,7 +83,6 @@ protected:
   double m_ratioW;
   double m_oldDirVal;
   bool m_IsRunning;
-  int m_SampleCount;
   wxString m_WindSpeedUnit;
   int m_SetNewData;  // No need for data every second
   int speedw, degw, degh;
@@ -98,6 +99,11 @@ protected:
   void DrawBackground(wxGCDC* dc);
   void DrawForeground(wxGCDC* dc);
   void SetMinMaxWindScale();
+  void UpdateMinMax();
+  void GetPolyline(const std::vector<HistorySeries::Column>& columns,
+                   bool smoothed, double offset, double ratioH,
+                   std::vector<wxPoint>& points);
+  void OnMouseWheel(wxMouseEvent& event);
   void DrawWindDirScale(wxGCDC* dc);
   void DrawWindSpeedScale(wxGCDC* dc);
   void ResetData();
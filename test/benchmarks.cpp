@@ -0,0 +1,508 @@
+#include "config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <wx/app.h>
+#include <wx/geometry.h>
+
+#include <gtest/gtest.h>
+
+#include "model/comm_bridge.h"
+#include "model/comm_can_util.h"
+#include "model/comm_decoder.h"
+#include "model/comm_navmsg.h"
+#include "model/gshhs_crossing.h"
+#include "model/ll_projector.h"
+#include "model/nmea0183_parser.h"
+#include "model/nmea_ctx_factory.h"
+#include "model/plugin_comm.h"
+#include "model/plugin_loader.h"
+#include "model/serial_io.h"
+#include "nmea0183.h"
+#include "LLRegion.h"
+#include "mygeom.h"
+#include "ocpn_plugin.h"
+#include "raster/raster.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// Macos up to 10.13
+#if (defined(OCPN_GHC_FILESYSTEM) || \
+     (defined(__clang_major__) && (__clang_major__ < 15)))
+#include <ghc/filesystem.hpp>
+namespace fs = ghc::filesystem;
+
+// Ubuntu Bionic:
+#elif !defined(__clang_major__) && defined(__GNUC__) && (__GNUC__ < 8)
+#include <experimental/filesystem>
+namespace fs = std::experimental::filesystem;
+
+#else
+#include <filesystem>
+namespace fs = std::filesystem;
+#endif
+
+// Timing benchmarks, built on request only and not run by ctest:
+//   cmake --build build --target benchmarks && build/test/benchmarks
+// Correctness of the benchmarked code is covered in tests.cpp.
+
+void* g_pi_manager = reinterpret_cast<void*>(1L);
+
+/** Seconds elapsed since start. */
+static double Since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+class CountingNmeaPlugin : public opencpn_plugin_118 {
+public:
+  CountingNmeaPlugin() : opencpn_plugin_118(nullptr), sentences(0) {}
+  void SetNMEASentence(wxString& sentence) override { sentences++; }
+  int sentences;
+};
+
+TEST(PluginDispatch, Throughput) {
+  const int kPlugins = 12;
+  const int kSentences = 100000;
+  const int kBatchSize = 50;
+
+  std::vector<std::unique_ptr<CountingNmeaPlugin>> plugins;
+  std::vector<std::unique_ptr<PlugInContainer>> containers;
+  ArrayOfPlugIns array;
+  for (int i = 0; i < kPlugins; i++) {
+    plugins.push_back(std::make_unique<CountingNmeaPlugin>());
+    containers.push_back(std::make_unique<PlugInContainer>());
+    auto pic = containers.back().get();
+    pic->m_pplugin = plugins.back().get();
+    pic->m_api_version = 118;
+    pic->m_enabled = true;
+    pic->m_init_state = true;
+    pic->m_cap_flag = i % 2 ? WANTS_NMEA_SENTENCES : WANTS_PLUGIN_MESSAGING;
+    array.Add(pic);
+  }
+  PluginDispatchTable table(array);
+
+  std::vector<wxString> batch(kBatchSize,
+                              "$GPGLL,5958.613,N,02325.928,E,121022,A,D*40");
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kSentences / kBatchSize; i++)
+    table.SendNmeaSentences(&batch[0], batch.size());
+  std::cout << "Plugin dispatch: " << kSentences / Since(start)
+            << " sentences/s to " << table.nmea_sentences.size()
+            << " plugins\n";
+}
+
+TEST(N0183Parser, Benchmark) {
+  const std::string rmc =
+      "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+  const int kCount = 200000;
+
+  auto start = std::chrono::steady_clock::now();
+  double sum = 0;
+  for (int i = 0; i < kCount; i++) {
+    N0183Sentence s;
+    N0183Rmc decoded;
+    if (s.Parse(rmc) && DecodeN0183(s, decoded)) sum += decoded.lat;
+  }
+  double view_us = Since(start) * 1e6;
+  EXPECT_NEAR(sum / kCount, 48.1173, 1e-4);
+
+  NMEA0183 legacy(NmeaCtxFactory());
+  start = std::chrono::steady_clock::now();
+  sum = 0;
+  for (int i = 0; i < kCount; i++) {
+    legacy << wxString(rmc);
+    if (legacy.PreParse() && legacy.Parse())
+      sum += legacy.Rmc.Position.Latitude.Latitude;
+  }
+  double legacy_us = Since(start) * 1e6;
+  std::cout << "N0183 RMC parse: " << view_us * 1000 / kCount
+            << " ns, libs/nmea0183: " << legacy_us * 1000 / kCount << " ns\n";
+}
+
+TEST(CommBridge, PriorityBenchmark) {
+  CommBridge comm_bridge;
+  PriorityMap priority_map;
+  auto& heading = comm_bridge.GetPriorityContainer("heading");
+
+  // Like the drivers, a new source address for each message.
+  const int kCount = 200000;
+  std::vector<std::shared_ptr<const Nmea0183Msg>> msgs;
+  for (int i = 0; i < kCount; i++) {
+    auto addr = std::make_shared<NavAddr0183>(i % 2 ? "/dev/ttyUSB1"
+                                                    : "/dev/ttyUSB0");
+    msgs.push_back(std::make_shared<const Nmea0183Msg>(
+        i % 2 ? "HCHDT" : "GPHDT", i % 2 ? "$HCHDT,124.0,T" : "$GPHDT,123.4,T",
+        addr));
+  }
+  auto start = std::chrono::steady_clock::now();
+  for (const auto& msg : msgs)
+    comm_bridge.EvalPriority(msg, heading, priority_map);
+  std::cout << "Priority arbitration: " << Since(start) * 1e9 / kCount
+            << " ns/msg\n";
+}
+
+TEST(GshhsCrossing, Benchmark) {
+  auto path = fs::path(TESTDATA) / ".." / ".." / "data" / "gshhs";
+  GshhsCrossing crossing((path / "poly-c-1.dat").string());
+  ASSERT_TRUE(crossing.IsOk());
+
+  // Short legs of the kind a weather router tests, all around the world.
+  std::vector<GshhsCrossing::Segment> segments;
+  unsigned seed = 1;
+  auto random = [&seed](double range) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % 100000 * range / 100000;
+  };
+  for (int i = 0; i < 100000; i++) {
+    double lat = random(140) - 70, lon = random(360) - 180;
+    segments.push_back({lat, lon, lat + random(2) - 1, lon + random(2) - 1});
+  }
+  std::vector<char> crosses;
+  auto start = std::chrono::steady_clock::now();
+  crossing.CrossesLand(segments, crosses);
+  std::cout << "GSHHS land crossing: " << segments.size() / Since(start)
+            << " segments/s\n";
+}
+
+static LLRegion StarRegion(double lat, double lon, double r, int n) {
+  std::vector<double> points;
+  for (int i = 0; i < n; i++) {
+    double angle = 2 * M_PI * i / n, radius = i % 2 ? r / 2 : r;
+    points.push_back(lat + radius * sin(angle));
+    points.push_back(lon + radius * cos(angle));
+  }
+  return LLRegion(n, points.data());
+}
+
+TEST(LLRegion, ComposeBenchmark) {
+  // The region operations of a quilt composition over 200 overlapping cells.
+  std::vector<LLRegion> cells;
+  unsigned seed = 5;
+  auto random = [&seed](double min, double max) {
+    seed = seed * 1103515245 + 12345;
+    return min + (seed >> 8) % 100000 * (max - min) / 100000;
+  };
+  for (int c = 0; c < 200; c++) {
+    double lat = random(40, 50), lon = random(-5, 5), size = random(0.2, 2);
+    if (c % 2)
+      cells.push_back(LLRegion(lat, lon, lat + size, lon + size * 1.3));
+    else
+      cells.push_back(StarRegion(lat, lon, size, 20 + c % 80));
+  }
+  LLRegion vp_region(43, -2, 47, 2);
+  const int kReps = 10;
+  auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < kReps; rep++) {
+    LLRegion uncovered = vp_region, covered;
+    for (const auto& cell : cells) {
+      LLRegion in_vp = vp_region;
+      in_vp.Intersect(cell);
+      if (in_vp.Empty()) continue;
+      uncovered.Subtract(cell);
+      covered.Union(in_vp);
+    }
+  }
+  std::cout << "LLRegion compose, 200 cells: " << Since(start) * 1e3 / kReps
+            << " ms\n";
+}
+
+/** Encode runs of (color index, count) as a BSB row, line number first. */
+static std::vector<unsigned char> EncodeBsbRow(
+    int color_size, const std::vector<std::pair<int, int>>& runs) {
+  std::vector<unsigned char> row = {1};
+  int count_bits = 7 - color_size;
+  for (const auto& run : runs) {
+    unsigned n = run.second - 1;
+    int groups = 0;
+    while ((n >> (count_bits + 7 * groups)) != 0) groups++;
+    unsigned char first = (run.first << count_bits) |
+                          ((n >> (7 * groups)) & ((1 << count_bits) - 1));
+    row.push_back(first | (groups ? 0x80 : 0));
+    for (int g = groups - 1; g >= 0; g--)
+      row.push_back(((n >> (7 * g)) & 0x7f) | (g ? 0x80 : 0));
+  }
+  row.push_back(0);
+  return row;
+}
+
+TEST(Raster, DecodeBenchmark) {
+  // Typical chart rows: mostly short runs, some long ones.
+  Raster_ResolveRoutines();
+  const int color_size = 4, width = 10000, rows = 64;
+  int palette[16];
+  for (int i = 0; i < 16; i++) palette[i] = 0x10305 * i;
+  std::vector<std::vector<unsigned char>> encoded;
+  unsigned seed = 11;
+  for (int r = 0; r < rows; r++) {
+    std::vector<std::pair<int, int>> runs;
+    int total = 0;
+    while (total < width) {
+      seed = seed * 1103515245 + 12345;
+      int count = 1 + (seed >> 12) % ((seed >> 8) % 8 ? 12 : 400);
+      runs.push_back({1 + (seed >> 20) % 15, count});
+      total += count;
+    }
+    encoded.push_back(EncodeBsbRow(color_size, runs));
+  }
+  std::vector<unsigned char> rgb(width * 3);
+  const int kReps = 20;
+  auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < kReps; rep++) {
+    for (const auto& row : encoded)
+      Raster_ExpandBSB_24(row.data() + 1, row.data() + row.size(), 0, 0,
+                          width, color_size, palette, rgb.data());
+  }
+  std::cout << "BSB decode: "
+            << double(width) * rows * kReps / Since(start) / 1e6
+            << " MPixel/s\n";
+}
+
+TEST(LLProjector, Benchmark) {
+  const size_t n = 100000;
+  std::vector<double> lat(n), lon(n);
+  for (size_t i = 0; i < n; i++) {
+    lat[i] = 60. + 4. * sin(i * 0.001);
+    lon[i] = 10. + 4. * cos(i * 0.0013);
+  }
+  std::vector<float> out(2 * n);
+  const char* names[] = {"Mercator",      "Transverse Mercator",
+                         "Polyconic",     "Orthographic",
+                         "Polar",         "Stereographic",
+                         "Gnomonic",      "Equirectangular"};
+  for (int type = 0; type < 8; type++) {
+    LLProjector projector(LLProjector::Type(type), 60., 10.);
+    projector.SetTransform(0.01, 0.3, 500., 400., 1.);
+    auto start = std::chrono::steady_clock::now();
+    projector.Project(lat.data(), lon.data(), n, out.data());
+    std::cout << names[type] << ": " << n / Since(start) / 1e6
+              << " MPoint/s\n";
+  }
+}
+
+/** Deferred cm93 style area: a star with n points, in cell units. */
+static PolyTessGeo* DeferredStar(double x, double y, double r, int n) {
+  auto* geom = new Extended_Geometry();
+  geom->pogrGeom = nullptr;
+  geom->n_contours = 1;
+  geom->contour_array = (int*)malloc(sizeof(int));
+  geom->contour_array[0] = n;
+  //  The tesselator skips the first vertex, like cm93 geometry.
+  geom->n_max_vertex = n + 1;
+  geom->vertex_array =
+      (wxPoint2DDouble*)malloc((n + 1) * sizeof(wxPoint2DDouble));
+  geom->vertex_array[0] = wxPoint2DDouble(x, y);
+  for (int i = 0; i < n; i++) {
+    double angle = 2 * M_PI * i / n, radius = i % 2 ? r / 2 : r;
+    geom->vertex_array[i + 1] =
+        wxPoint2DDouble(x + radius * cos(angle), y + radius * sin(angle));
+  }
+  geom->xmin = x - r;
+  geom->xmax = x + r;
+  geom->ymin = y - r;
+  geom->ymax = y + r;
+  geom->x_rate = geom->y_rate = 1.;
+  geom->x_offset = geom->y_offset = 0.;
+  geom->ref_lat = 45.;
+  geom->ref_lon = 5.;
+  return new PolyTessGeo(geom);
+}
+
+TEST(PolyTessGeo, DeferredBatch) {
+  // The areas of a cm93 cell: tesselated one by one on first render, or
+  // as a batch on the worker pool at cell load.
+  const int kPolys = 2000;
+  std::vector<PolyTessGeo*> lazy, batch;
+  unsigned seed = 7;
+  for (int i = 0; i < kPolys; i++) {
+    seed = seed * 1103515245 + 12345;
+    double x = (seed >> 8) % 60000, y = (seed >> 4) % 60000;
+    int n = 20 + (seed >> 16) % 400;
+    lazy.push_back(DeferredStar(x, y, 2000., n));
+    batch.push_back(DeferredStar(x, y, 2000., n));
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  for (PolyTessGeo* ptg : lazy) ptg->BuildDeferredTess();
+  double lazy_s = Since(start);
+  start = std::chrono::steady_clock::now();
+  int n_batch = PolyTessGeo::BuildDeferredTessBatch(batch);
+  double batch_s = Since(start);
+
+  std::cout << "Tesselation, " << kPolys << " areas: one by one "
+            << lazy_s * 1e3 << " ms, batch " << batch_s * 1e3 << " ms ("
+            << n_batch << " tesselated on workers)\n";
+  for (PolyTessGeo* ptg : lazy) delete ptg;
+  for (PolyTessGeo* ptg : batch) delete ptg;
+}
+
+#ifndef _WIN32
+/** CPU time used by the process, all threads, in seconds. */
+static double CpuSeconds() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+         (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+TEST(SerialIo, Latency) {
+  // A pseudo terminal stands in for the serial port.
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  ASSERT_GE(master, 0);
+  ASSERT_EQ(grantpt(master), 0);
+  ASSERT_EQ(unlockpt(master), 0);
+  std::string port = ptsname(master);
+
+  auto start = std::chrono::steady_clock::now();
+  std::atomic<int> lines(0);
+  std::atomic<double> received(0);
+  auto serial_io = SerialIo::Create(
+      [&](const std::vector<unsigned char>&) {
+        received = Since(start);
+        lines++;
+      },
+      port, 4800);
+  serial_io->Start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+  double cpu = CpuSeconds();
+  std::this_thread::sleep_for(std::chrono::seconds(2));
+  cpu = CpuSeconds() - cpu;
+
+  const int kLines = 100;
+  const std::string sentence = "$GPHDT,123.4,T*2B\r\n";
+  double total = 0, worst = 0;
+  for (int i = 0; i < kLines; i++) {
+    int expected = lines + 1;
+    double sent = Since(start);
+    ASSERT_EQ(write(master, sentence.c_str(), sentence.size()),
+              ssize_t(sentence.size()));
+    while (lines < expected && Since(start) - sent < 1.)
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    ASSERT_EQ(lines, expected);
+    total += received - sent;
+    worst = std::max(worst, received - sent);
+    std::this_thread::sleep_for(std::chrono::milliseconds(7));
+  }
+  std::cout << "Serial input latency: " << total * 1e3 / kLines
+            << " ms mean, " << worst * 1e3 << " ms max; idle port: "
+            << cpu * 1e3 / 2 << " ms CPU/s\n";
+
+  serial_io->RequestStop();
+  serial_io->WaitUntilStopped(std::chrono::seconds(10));
+  close(master);
+}
+#endif
+
+#ifdef __linux__
+/** Read the frames in a candump log, lines like "(ts) can0 ID#DATA". */
+static std::vector<can_frame> ReadCandump(const std::string& path) {
+  std::vector<can_frame> frames;
+  std::ifstream stream(path);
+  std::string ts, iface, frame_spec;
+  while (stream >> ts >> iface >> frame_spec) {
+    auto hash = frame_spec.find('#');
+    if (hash == std::string::npos) continue;
+    can_frame frame = {};
+    frame.can_id = std::stoul(frame_spec.substr(0, hash), nullptr, 16);
+    std::string data = frame_spec.substr(hash + 1);
+    frame.can_dlc = data.size() / 2;
+    for (size_t i = 0; i < frame.can_dlc && i < CAN_MAX_DLEN; i++)
+      frame.data[i] = std::stoul(data.substr(2 * i, 2), nullptr, 16);
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+/**
+ * Reassemble frames like the CAN drivers do and decode the position
+ * PGNs. Return number of decoded positions, last one in nav_data.
+ */
+static int DecodeFrames(const std::vector<can_frame>& frames,
+                        NavData& nav_data) {
+  FastMessageMap fast_messages;
+  CommDecoder decoder;
+  auto src = std::make_shared<const NavAddr2000>("can0", 1);
+  int positions = 0;
+  for (const auto& frame : frames) {
+    CanHeader header(frame);
+    int position = -1;
+    bool ready = true;
+    if (header.IsFastMessage()) {
+      position = fast_messages.FindMatchingEntry(header, frame.data[0]);
+      if (position == -1) {
+        position = fast_messages.AddNewEntry();
+        ready = fast_messages.InsertEntry(header, frame.data, position);
+      } else {
+        ready = fast_messages.AppendEntry(header, frame.data, position);
+      }
+    }
+    if (!ready) continue;
+    const unsigned char* data = frame.data;
+    unsigned len = CAN_MAX_DLEN;
+    if (position >= 0) {
+      data = fast_messages[position].data.data();
+      len = fast_messages[position].expected_length;
+    }
+    std::vector<unsigned char> payload = {
+        0x93,
+        static_cast<unsigned char>(len + 11),
+        header.priority,
+        static_cast<unsigned char>(header.pgn & 0xFF),
+        static_cast<unsigned char>((header.pgn >> 8) & 0xFF),
+        static_cast<unsigned char>((header.pgn >> 16) & 0xFF),
+        header.destination,
+        header.source,
+        0xFF,
+        0xFF,
+        0xFF,
+        0xFF,
+        static_cast<unsigned char>(len)};
+    payload.insert(payload.end(), data, data + len);
+    payload.push_back(0x55);
+    if (position >= 0) fast_messages.Remove(position);
+
+    Nmea2000Msg msg(header.pgn, std::move(payload), src);
+    if (header.pgn == 129025) {
+      if (decoder.DecodePGN129025(msg.GetN2kMsg(), nav_data)) positions++;
+    } else if (header.pgn == 129029) {
+      if (decoder.DecodePGN129029(msg.GetN2kMsg(), nav_data)) positions++;
+    }
+  }
+  return positions;
+}
+
+TEST(FastMessage, DecodeBenchmark) {
+  fs::path path(TESTDATA);
+  path /= "candump-2022-07-30_102821-head.log";
+  auto frames = ReadCandump(path.string());
+  ASSERT_FALSE(frames.empty());
+
+  const int kRounds = 200;
+  NavData nav_data = {};
+  int positions = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRounds; i++) positions += DecodeFrames(frames, nav_data);
+  double elapsed = Since(start);
+  EXPECT_GT(positions, 0);
+  std::cout << "FastMessage decode: " << frames.size() * kRounds / elapsed
+            << " frames/s\n";
+}
+#endif
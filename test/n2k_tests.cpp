@@ -4,6 +4,8 @@
 
 #include <stdio.h>
 
+#include <fstream>
+
 #include <gtest/gtest.h>
 
 #include <wx/app.h>
@@ -16,6 +18,8 @@
 #include "model/comm_ais.h"
 #include "model/comm_appmsg_bus.h"
 #include "model/comm_bridge.h"
+#include "model/comm_can_util.h"
+#include "model/comm_decoder.h"
 #include "model/comm_drv_file.h"
 #include "model/comm_drv_registry.h"
 #include "model/comm_navmsg_bus.h"
@@ -96,6 +100,83 @@ static void CheckAisTargets() {
   }
 }
 
+/** Read the frames in a candump log, lines like "(ts) can0 ID#DATA". */
+static std::vector<can_frame> ReadCandump(const string& path) {
+  std::vector<can_frame> frames;
+  std::ifstream stream(path);
+  string ts, iface, frame_spec;
+  while (stream >> ts >> iface >> frame_spec) {
+    auto hash = frame_spec.find('#');
+    if (hash == string::npos) continue;
+    can_frame frame = {};
+    frame.can_id = std::stoul(frame_spec.substr(0, hash), nullptr, 16);
+    string data = frame_spec.substr(hash + 1);
+    frame.can_dlc = data.size() / 2;
+    for (size_t i = 0; i < frame.can_dlc && i < CAN_MAX_DLEN; i++)
+      frame.data[i] = std::stoul(data.substr(2 * i, 2), nullptr, 16);
+    frames.push_back(frame);
+  }
+  return frames;
+}
+
+/**
+ * Reassemble frames like the CAN drivers do and decode the position
+ * PGNs. Return number of decoded positions, last one in nav_data.
+ */
+static int DecodeFrames(const std::vector<can_frame>& frames,
+                        NavData& nav_data) {
+  FastMessageMap fast_messages;
+  CommDecoder decoder;
+  auto src = std::make_shared<const NavAddr2000>("can0", 1);
+  int positions = 0;
+  for (const auto& frame : frames) {
+    CanHeader header(frame);
+    int position = -1;
+    bool ready = true;
+    if (header.IsFastMessage()) {
+      position = fast_messages.FindMatchingEntry(header, frame.data[0]);
+      if (position == -1) {
+        position = fast_messages.AddNewEntry();
+        ready = fast_messages.InsertEntry(header, frame.data, position);
+      } else {
+        ready = fast_messages.AppendEntry(header, frame.data, position);
+      }
+    }
+    if (!ready) continue;
+    const unsigned char* data = frame.data;
+    unsigned len = CAN_MAX_DLEN;
+    if (position >= 0) {
+      data = fast_messages[position].data.data();
+      len = fast_messages[position].expected_length;
+    }
+    std::vector<unsigned char> payload = {
+        0x93,
+        static_cast<unsigned char>(len + 11),
+        header.priority,
+        static_cast<unsigned char>(header.pgn & 0xFF),
+        static_cast<unsigned char>((header.pgn >> 8) & 0xFF),
+        static_cast<unsigned char>((header.pgn >> 16) & 0xFF),
+        header.destination,
+        header.source,
+        0xFF,
+        0xFF,
+        0xFF,
+        0xFF,
+        static_cast<unsigned char>(len)};
+    payload.insert(payload.end(), data, data + len);
+    payload.push_back(0x55);
+    if (position >= 0) fast_messages.Remove(position);
+
+    Nmea2000Msg msg(header.pgn, std::move(payload), src);
+    if (header.pgn == 129025) {
+      if (decoder.DecodePGN129025(msg.GetN2kMsg(), nav_data)) positions++;
+    } else if (header.pgn == 129029) {
+      if (decoder.DecodePGN129029(msg.GetN2kMsg(), nav_data)) positions++;
+    }
+  }
+  return positions;
+}
+
 FILE* RunRecordedBuffer() {
   string path("..");
   path += kSEP + ".." + kSEP + "test" + kSEP + "testdata" + kSEP +
@@ -248,6 +329,19 @@ TEST(DriverRegistry, RegisterDriver) {
 }
 #endif
 
+TEST(FastMessage, DecodeLog) {
+  string path(TESTDATA);
+  path += kSEP + "candump-2022-07-30_102821-head.log";
+  auto frames = ReadCandump(path);
+  ASSERT_FALSE(frames.empty());
+
+  NavData nav_data = {};
+  int positions = DecodeFrames(frames, nav_data);
+  EXPECT_GT(positions, 0);
+  EXPECT_NEAR(nav_data.gLat, 56.7064, 0.0001);
+  EXPECT_NEAR(nav_data.gLon, 8.22156, 0.0001);
+}
+
 #ifdef ENABLE_VCAN_TESTS
 TEST(CanEnvironment, vcan0) {
   char line[256];
@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
@@ -27,6 +29,7 @@
 #include "model/comm_ais.h"
 #include "model/comm_appmsg_bus.h"
 #include "model/comm_bridge.h"
+#include "model/comm_drv_capture.h"
 #include "model/comm_drv_factory.h"
 #include "model/comm_drv_file.h"
 #include "model/comm_drv_loopback.h"
@@ -34,13 +37,25 @@
 #include "model/comm_navmsg_bus.h"
 #include "model/config_vars.h"
 #include "model/datetime.h"
+#include "model/georef.h"
+#include "model/gshhs_crossing.h"
 #include "model/ipc_api.h"
+#include "model/ll_projector.h"
 #include "model/logger.h"
+#include "model/logline_buffer.h"
+#include "model/mapped_file.h"
 #include "model/multiplexer.h"
+#include "model/navmsg_capture.h"
 #include "model/navutil_base.h"
+#include "model/nmea0183_parser.h"
+#include "model/nmea_ctx_factory.h"
+#include "model/pipeline_stats.h"
 #include "model/ocpn_types.h"
 #include "model/ocpn_utils.h"
 #include "model/own_ship.h"
+#include "model/plugin_comm.h"
+#include "model/plugin_loader.h"
+#include "model/quilt_region_cache.h"
 #include "model/routeman.h"
 #include "model/select.h"
 #include "model/semantic_vers.h"
@@ -48,7 +63,11 @@
 #include "model/wait_continue.h"
 #include "model/wx_instance_chk.h"
 #include "observable_confvar.h"
+#include "LLRegion.h"
+#include "iso8211.h"
+#include "nmea0183.h"
 #include "ocpn_plugin.h"
+#include "raster/raster.h"
 
 // Macos up to 10.13
 #if (defined(OCPN_GHC_FILESYSTEM) || \
@@ -1368,3 +1387,868 @@ TEST(Loopback, n2k) {
   ASSERT_TRUE(n2kptr->PGN.to_string() == "12");
   ASSERT_TRUE(n2kptr->source->iface == "foo");
 }
+
+TEST(Capture, RoundtripSeekTruncated) {
+  auto path = fs::path(CMAKE_BINARY_DIR) / "capture.ocap";
+  uintmax_t data_end = 16;  // file header
+  {
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.Open(path.string()));
+    for (int i = 0; i < 10000; i++) {
+      CaptureRecord record;
+      record.timestamp_us = 1000000000 + 1000LL * i;  // 1 ms apart
+      record.bus = NavAddr::Bus::N0183;
+      record.iface = "/dev/ttyUSB0";
+      record.id = "GPGGA";
+      std::string raw = "$GPGGA," + std::to_string(i);
+      record.payload.assign(raw.begin(), raw.end());
+      writer.Add(record);
+      data_end += 4 + 24 + record.iface.size() + 5 + raw.size();
+    }
+    writer.Close();
+    EXPECT_EQ(writer.GetDropped(), 0);
+  }
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path.string()));
+  EXPECT_EQ(reader.GetRecordCount(), 10000);
+  EXPECT_EQ(reader.GetStartTime(), 1000000000);
+  EXPECT_EQ(reader.GetEndTime(), 1000000000 + 1000LL * 9999);
+
+  CaptureRecord record;
+  ASSERT_TRUE(reader.Seek(1000000000 + 1000LL * 5000 + 1));
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(std::string(record.payload.begin(), record.payload.end()),
+            "$GPGGA,5001");
+  auto msg = std::static_pointer_cast<const Nmea0183Msg>(record.ToNavMsg());
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(msg->type, "GGA");
+  EXPECT_EQ(msg->source->iface, "/dev/ttyUSB0");
+
+  // Lose the index and part of the last record as in a crash.
+  ASSERT_GT(fs::file_size(path), data_end);
+  fs::resize_file(path, data_end - 3);
+  ASSERT_TRUE(reader.Open(path.string()));
+  EXPECT_EQ(reader.GetRecordCount(), 9999);
+  ASSERT_TRUE(reader.Seek(1000000000 + 1000LL * 9998));
+  ASSERT_TRUE(reader.Next(record));
+  EXPECT_EQ(std::string(record.payload.begin(), record.payload.end()),
+            "$GPGGA,9998");
+  EXPECT_FALSE(reader.Next(record));
+}
+
+TEST(Capture, SeekNonMonotonic) {
+  // Interleaved drivers and a wall clock step back make times go back.
+  auto path = fs::path(CMAKE_BINARY_DIR) / "capture-steps.ocap";
+  const int64_t base = 1000000000;
+  std::vector<int64_t> times;
+  for (int i = 0; i < 6000; i++) times.push_back(base + 1000LL * i);
+  for (int i = 0; i < 6000; i++) times.push_back(base + 1000LL * i + 500);
+  {
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.Open(path.string()));
+    EXPECT_TRUE(writer.IsOpen());
+    for (size_t i = 0; i < times.size(); i++) {
+      CaptureRecord record;
+      record.timestamp_us = times[i];
+      record.bus = NavAddr::Bus::N0183;
+      record.id = "GPGGA";
+      std::string raw = std::to_string(i);
+      record.payload.assign(raw.begin(), raw.end());
+      writer.Add(record);
+    }
+    writer.Close();
+    EXPECT_FALSE(writer.IsOpen());
+  }
+  CaptureReader reader;
+  ASSERT_TRUE(reader.Open(path.string()));
+  EXPECT_EQ(reader.GetEndTime(), base + 1000LL * 5999 + 500);
+  for (int64_t t : {base, base + 1000LL * 3000 + 1, base + 1000LL * 5999 + 1,
+                    base + 1000LL * 5999 + 500}) {
+    size_t expected = 0;
+    while (times[expected] < t) expected++;
+    CaptureRecord record;
+    ASSERT_TRUE(reader.Seek(t));
+    ASSERT_TRUE(reader.Next(record));
+    EXPECT_EQ(std::string(record.payload.begin(), record.payload.end()),
+              std::to_string(expected))
+        << "seek " << t - base;
+  }
+}
+
+/** Collect replayed N0183 payloads in arrival order. */
+class ReplayListener : public DriverListener {
+public:
+  ReplayListener() : done(false) {}
+
+  void Notify(std::shared_ptr<const NavMsg> message) override {
+    auto msg = std::dynamic_pointer_cast<const Nmea0183Msg>(message);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (msg) payloads.push_back(msg->payload);
+  }
+
+  void Notify(const AbstractCommDriver& driver) override { done = true; }
+
+  std::mutex mutex;
+  std::vector<std::string> payloads;
+  std::atomic<bool> done;
+};
+
+TEST(Capture, Replay) {
+  auto path = fs::path(CMAKE_BINARY_DIR) / "capture-replay.ocap";
+  auto src = std::make_shared<const NavAddr0183>("/dev/ttyUSB0");
+  std::vector<std::string> sentences;
+  {
+    CaptureWriter writer;
+    ASSERT_TRUE(writer.Open(path.string()));
+    for (int i = 0; i < 200; i++) {
+      sentences.push_back("$GPHDT," + std::to_string(i) + ",T");
+      writer.Add(Nmea0183Msg("GPHDT", sentences.back(), src));
+    }
+    writer.Close();
+  }
+
+  ReplayListener listener;
+  CaptureReplayDriver missing("no-such-file.ocap", listener, 0);
+  EXPECT_FALSE(missing.Start());
+  EXPECT_FALSE(missing.IsRunning());
+
+  CaptureReplayDriver driver(path.string(), listener, 0);
+  ASSERT_TRUE(driver.Start());
+  for (int i = 0; i < 1000 && !listener.done; i++)
+    std::this_thread::sleep_for(10ms);
+  ASSERT_TRUE(listener.done);
+  driver.Stop();
+  EXPECT_FALSE(driver.IsRunning());
+  EXPECT_EQ(driver.GetReplayed(), sentences.size());
+  EXPECT_EQ(listener.payloads, sentences);
+}
+
+class MockNmeaPlugin : public opencpn_plugin_118 {
+public:
+  MockNmeaPlugin() : opencpn_plugin_118(nullptr), sentences(0) {}
+  void SetNMEASentence(wxString& sentence) override { sentences++; }
+  int sentences;
+};
+
+TEST(PluginDispatch, Subscribers) {
+  const int kPlugins = 12;
+  const int kSentences = 1000;
+  const int kBatchSize = 50;
+
+  std::vector<std::unique_ptr<MockNmeaPlugin>> plugins;
+  std::vector<std::unique_ptr<PlugInContainer>> containers;
+  ArrayOfPlugIns array;
+  for (int i = 0; i < kPlugins; i++) {
+    plugins.push_back(std::make_unique<MockNmeaPlugin>());
+    containers.push_back(std::make_unique<PlugInContainer>());
+    auto pic = containers.back().get();
+    pic->m_pplugin = plugins.back().get();
+    pic->m_api_version = 118;
+    pic->m_enabled = true;
+    pic->m_init_state = i != kPlugins - 1;
+    // Every other plugin subscribes to sentences, the rest to messaging.
+    pic->m_cap_flag = i % 2 ? WANTS_NMEA_SENTENCES : WANTS_PLUGIN_MESSAGING;
+    array.Add(pic);
+  }
+  PluginDispatchTable table(array);
+  EXPECT_EQ(table.nmea_sentences.size(), kPlugins / 2 - 1);
+  EXPECT_EQ(table.plugin_messages.size(), kPlugins / 2);
+  EXPECT_EQ(table.json_message_targets, kPlugins / 2);
+
+  std::vector<wxString> batch(kBatchSize,
+                              "$GPGLL,5958.613,N,02325.928,E,121022,A,D*40");
+  for (int i = 0; i < kSentences / kBatchSize; i++)
+    table.SendNmeaSentences(&batch[0], batch.size());
+
+  for (int i = 0; i < kPlugins; i++) {
+    int expected = (i % 2 && i != kPlugins - 1) ? kSentences : 0;
+    EXPECT_EQ(plugins[i]->sentences, expected);
+  }
+}
+
+TEST(N0183Parser, Decode) {
+  N0183Sentence s;
+  ASSERT_TRUE(s.Parse("$GPRMC,123519,A,4807.038,N,01131.000,W,022.4,084.4,"
+                      "230394,003.1,W*78\r\n"));
+  EXPECT_EQ(s.GetId(), N0183Id::kRmc);
+  EXPECT_EQ(s.GetTalker(), "GP");
+  N0183Rmc rmc;
+  ASSERT_TRUE(DecodeN0183(s, rmc));
+  EXPECT_TRUE(rmc.is_valid);
+  EXPECT_NEAR(rmc.lat, 48.1173, 1e-4);
+  EXPECT_NEAR(rmc.lon, -11.516667, 1e-4);
+  EXPECT_NEAR(rmc.variation, -3.1, 1e-6);
+  EXPECT_EQ(rmc.date, "230394");
+
+  // Bad checksum, tag block, missing fields.
+  EXPECT_FALSE(s.Parse("$GPHDT,123.4,T*00"));
+  ASSERT_TRUE(s.Parse("\\s:GP0001*3E\\$GPHDT,123.4,T"));
+  N0183Heading hdt;
+  ASSERT_TRUE(DecodeN0183(s, hdt));
+  EXPECT_DOUBLE_EQ(hdt.heading, 123.4);
+  ASSERT_TRUE(s.Parse("$IIDBT,,f,,M,,F"));
+  N0183Depth dbt;
+  ASSERT_TRUE(DecodeN0183(s, dbt));
+  EXPECT_TRUE(std::isnan(dbt.depth_m));
+  N0183Rmc not_rmc;
+  EXPECT_FALSE(DecodeN0183(s, not_rmc));
+}
+
+TEST(CommBridge, PriorityArbitration) {
+  CommBridge comm_bridge;
+  PriorityMap priority_map;
+  auto& heading = comm_bridge.GetPriorityContainer("heading");
+  auto addr1 = std::make_shared<NavAddr0183>("/dev/ttyUSB0");
+  auto addr2 = std::make_shared<NavAddr0183>("/dev/ttyUSB1");
+  auto msg1 = std::make_shared<const Nmea0183Msg>("GPHDT", "$GPHDT,123.4,T",
+                                                  addr1);
+  auto msg2 = std::make_shared<const Nmea0183Msg>("HCHDT", "$HCHDT,124.0,T",
+                                                  addr2);
+  EXPECT_TRUE(comm_bridge.EvalPriority(msg1, heading, priority_map));
+  EXPECT_FALSE(comm_bridge.EvalPriority(msg2, heading, priority_map));
+  EXPECT_EQ(heading.active_source, "/dev/ttyUSB0:0");
+  EXPECT_EQ(heading.active_identifier, "GPHDT");
+
+  // The active source keeps winning while it is alive. Drivers create a
+  // new address for each message.
+  int accepted = 0;
+  for (int i = 0; i < 100; i++) {
+    auto addr = std::make_shared<NavAddr0183>(i % 2 ? "/dev/ttyUSB1"
+                                                    : "/dev/ttyUSB0");
+    auto msg = std::make_shared<const Nmea0183Msg>(
+        i % 2 ? "HCHDT" : "GPHDT", i % 2 ? "$HCHDT,124.0,T" : "$GPHDT,123.4,T",
+        addr);
+    if (comm_bridge.EvalPriority(msg, heading, priority_map)) accepted++;
+  }
+  EXPECT_EQ(accepted, 50);
+  EXPECT_EQ(heading.active_source, "/dev/ttyUSB0:0");
+}
+
+TEST(PipelineStats, Histogram) {
+  LatencyHistogram h;
+  for (uint64_t ns = 1000; ns <= 1000000; ns += 1000) h.Record(ns);
+  EXPECT_EQ(h.GetCount(), 1000u);
+  EXPECT_EQ(h.GetMax(), 1000000u);
+  EXPECT_EQ(h.GetMean(), 500500u);
+  EXPECT_NEAR(h.Percentile(0.5), 500000, 500000 * 0.125);
+  EXPECT_NEAR(h.Percentile(0.99), 990000, 990000 * 0.125);
+
+  auto& stats = PipelineStats::GetInstance();
+  stats.Reset();
+  auto addr = std::make_shared<NavAddr0183>("pipeline-test");
+  Nmea0183Msg msg("GPRMC", "$GPRMC", addr);
+  stats.Record(PipelineStage::kBusNotify, msg);
+  stats.MarkFix(msg);
+  stats.RecordCanvasRefresh();
+  stats.RecordCanvasRefresh();  // No pending fix, ignored
+  EXPECT_EQ(stats.GetStage(PipelineStage::kBusNotify).latency.GetCount(), 1u);
+  EXPECT_EQ(stats.GetStage(PipelineStage::kCanvasRefresh).latency.GetCount(),
+            1u);
+  auto driver = stats.GetStage(PipelineStage::kBusNotify, "pipeline-test");
+  ASSERT_NE(driver, nullptr);
+  EXPECT_EQ(driver->latency.GetCount(), 1u);
+  EXPECT_NE(stats.ToJson().find("\"iface\": \"pipeline-test\""),
+            std::string::npos);
+
+  stats.RecordTiming(PipelineTiming::kQuiltPan, 2000000);
+  EXPECT_EQ(stats.GetTiming(PipelineTiming::kQuiltPan).GetCount(), 1u);
+  EXPECT_NE(stats.ToJson().find("\"name\": \"quilt_pan\""),
+            std::string::npos);
+}
+
+TEST(LoglineBuffer, FilterHistory) {
+  auto addr = std::make_shared<NavAddr0183>("logline-test");
+  std::vector<std::shared_ptr<const NavMsg>> msgs = {
+      std::make_shared<const Nmea0183Msg>("GPRMC", "$GPRMC", addr),
+      std::make_shared<const Nmea0183Msg>("GPGGA", "$GPGGA", addr),
+      std::make_shared<const Nmea0183Msg>("GPGLL", "$GPGLL", addr)};
+
+  // Background rescan is exercised, the history exceeds the inline limit.
+  LoglineBuffer buffer(30000, true);
+  for (int i = 0; i < 40000; i++) buffer.Add(Logline(msgs[i % 3]));
+  EXPECT_TRUE(buffer.Update());
+  EXPECT_EQ(buffer.Size(), 30000u);
+  EXPECT_EQ(buffer.GetMatchCount(), 30000u);
+
+  buffer.SetFilter([](const Logline& ll) {
+    return ll.GetText().find("GGA") != std::string::npos;
+  });
+  for (int i = 40000; i < 40300; i++) buffer.Add(Logline(msgs[i % 3]));
+  while (buffer.IsScanning()) {
+    buffer.Update();
+    std::this_thread::yield();
+  }
+  buffer.Update();
+  // Lines 10300..40299 retained, every third is a GGA.
+  EXPECT_EQ(buffer.GetMatchCount(), 10000u);
+  for (size_t i = 0; i < buffer.GetMatchCount(); i++) {
+    auto ll = buffer.GetMatch(i);
+    ASSERT_TRUE(ll);
+    EXPECT_EQ(ll->navmsg, msgs[1]);
+  }
+  buffer.Clear();
+  EXPECT_EQ(buffer.GetMatchCount(), 0u);
+}
+
+TEST(GshhsCrossing, CrossesLand) {
+  auto path = fs::path(TESTDATA) / ".." / ".." / "data" / "gshhs";
+  GshhsCrossing crossing((path / "poly-c-1.dat").string());
+  ASSERT_TRUE(crossing.IsOk());
+  EXPECT_EQ(crossing.GetVersion(), 220);
+  EXPECT_TRUE(crossing.CrossesLand(50, 0, 50, 20));      // Europe
+  EXPECT_FALSE(crossing.CrossesLand(30, -40, 31, -39));  // Atlantic
+  // Fiji, across the antimeridian.
+  EXPECT_TRUE(crossing.CrossesLand(-16.8, -179.3, -15.7, 177.7));
+
+  GshhsCrossing missing((path / "no-such-file.dat").string());
+  EXPECT_FALSE(missing.IsOk());
+  EXPECT_FALSE(missing.CrossesLand(50, 0, 50, 20));
+
+  // Short legs of the kind a weather router tests, all around the world.
+  std::vector<GshhsCrossing::Segment> segments;
+  unsigned seed = 1;
+  auto random = [&seed](double range) {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 8) % 100000 * range / 100000;
+  };
+  for (int i = 0; i < 5000; i++) {
+    double lat = random(140) - 70, lon = random(360) - 180;
+    segments.push_back({lat, lon, lat + random(2) - 1, lon + random(2) - 1});
+  }
+  std::vector<char> crosses;
+  crossing.CrossesLand(segments, crosses, 4);
+  ASSERT_EQ(crosses.size(), segments.size());
+  for (size_t i = 0; i < segments.size(); i++) {
+    const auto& s = segments[i];
+    EXPECT_EQ(crosses[i] != 0,
+              crossing.CrossesLand(s.lat1, s.lon1, s.lat2, s.lon2));
+  }
+}
+
+static double RegionArea(const LLRegion& region) {
+  double area = 0;
+  for (const auto& contour : region.contours)
+    for (size_t i = 0; i < contour.size(); i++) {
+      const contour_pt& p = contour[i];
+      const contour_pt& n = contour[(i + 1) % contour.size()];
+      area += p.x * n.y - n.x * p.y;
+    }
+  return area / 2;
+}
+
+static LLRegion StarRegion(double lat, double lon, double r, int n) {
+  std::vector<double> points;
+  for (int i = 0; i < n; i++) {
+    double angle = 2 * M_PI * i / n, radius = i % 2 ? r / 2 : r;
+    points.push_back(lat + radius * sin(angle));
+    points.push_back(lon + radius * cos(angle));
+  }
+  return LLRegion(n, points.data());
+}
+
+TEST(LLRegion, Operations) {
+  LLRegion a(0, 0, 2, 2), b(1, 1, 3, 3);
+  LLRegion i = a, u = a, s = a;
+  i.Intersect(b);
+  u.Union(b);
+  s.Subtract(b);
+  EXPECT_NEAR(RegionArea(i), 1, 1e-4);
+  EXPECT_NEAR(RegionArea(u), 7, 1e-4);
+  EXPECT_NEAR(RegionArea(s), 3, 1e-4);
+  EXPECT_TRUE(i.Contains(1.5, 1.5));
+  EXPECT_FALSE(s.Contains(1.5, 1.5));
+  EXPECT_TRUE(u.Contains(2.5, 2.5));
+
+  // A hole is a clockwise contour inside the outer one.
+  LLRegion hole(0, 0, 4, 4);
+  hole.Subtract(LLRegion(1, 1, 3, 3));
+  EXPECT_EQ(hole.contours.size(), 2u);
+  EXPECT_NEAR(RegionArea(hole), 12, 1e-4);
+  EXPECT_FALSE(hole.Contains(2, 2));
+  EXPECT_TRUE(hole.Contains(0.5, 2));
+  LLRegion filled = hole;
+  filled.Union(LLRegion(1, 1, 3, 3));
+  EXPECT_EQ(filled.contours.size(), 1u);
+  EXPECT_NEAR(RegionArea(filled), 16, 1e-4);
+
+  // Disjoint and nested regions.
+  LLRegion disjoint = a;
+  disjoint.Intersect(LLRegion(5, 5, 6, 6));
+  EXPECT_TRUE(disjoint.Empty());
+  LLRegion nested(-1, -1, 3, 3);
+  nested.Intersect(a);
+  EXPECT_NEAR(RegionArea(nested), 4, 1e-4);
+
+  LLRegion star = StarRegion(0, 0, 2, 10);
+  double star_area = RegionArea(star);
+  LLRegion clipped = star;
+  clipped.Intersect(LLRegion(0, -3, 3, 3));
+  LLRegion rest = star;
+  rest.Subtract(LLRegion(0, -3, 3, 3));
+  EXPECT_NEAR(RegionArea(clipped) + RegionArea(rest), star_area, 1e-4);
+}
+
+TEST(LLRegion, Compose) {
+  // The region operations of a quilt composition over 200 overlapping cells.
+  std::vector<LLRegion> cells;
+  unsigned seed = 5;
+  auto random = [&seed](double min, double max) {
+    seed = seed * 1103515245 + 12345;
+    return min + (seed >> 8) % 100000 * (max - min) / 100000;
+  };
+  for (int c = 0; c < 200; c++) {
+    double lat = random(40, 50), lon = random(-5, 5), size = random(0.2, 2);
+    if (c % 2)
+      cells.push_back(LLRegion(lat, lon, lat + size, lon + size * 1.3));
+    else
+      cells.push_back(StarRegion(lat, lon, size, 20 + c % 80));
+  }
+  LLRegion vp_region(43, -2, 47, 2);
+  LLRegion uncovered, covered;
+  uncovered = vp_region;
+  for (const auto& cell : cells) {
+    LLRegion in_vp = vp_region;
+    in_vp.Intersect(cell);
+    if (in_vp.Empty()) continue;
+    uncovered.Subtract(cell);
+    covered.Union(in_vp);
+  }
+  EXPECT_FALSE(covered.Empty());
+  EXPECT_NEAR(RegionArea(covered) + RegionArea(uncovered),
+              RegionArea(vp_region), 1e-3);
+}
+
+/** Compose patches with cache, return the patch regions and coverage. */
+static std::vector<LLRegion> ComposeRegions(
+    QuiltRegionCache& cache,
+    const std::vector<QuiltRegionCache::Patch>& patches, bool subtract,
+    LLRegion& covered) {
+  std::vector<LLRegion> regions;
+  covered.Clear();
+  cache.Begin(subtract, -1, &covered);
+  for (const auto& patch : patches) {
+    const LLRegion* region = cache.Add(patch);
+    regions.push_back(region ? *region : LLRegion());
+  }
+  cache.End();
+  return regions;
+}
+
+TEST(QuiltRegionCache, PrefixReuse) {
+  std::vector<LLRegion> charts = {
+      LLRegion(0, 0, 2, 2), LLRegion(1, 1, 4, 4), StarRegion(3, 3, 2, 12),
+      LLRegion(-1, -1, 6, 6)};
+  std::vector<QuiltRegionCache::Patch> patches;
+  for (size_t i = 0; i < charts.size(); i++)
+    patches.push_back({int(i), 1, &charts[i], 1000 << (2 * i), 0, true,
+                       i == 1, &charts[i]});
+
+  for (bool subtract : {true, false}) {
+    QuiltRegionCache cache;
+    LLRegion covered;
+    auto expected = ComposeRegions(cache, patches, subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), 0u);
+    LLRegion all_covered = covered;
+
+    // A pan keeps the same patches, all regions come from the cache.
+    auto regions = ComposeRegions(cache, patches, subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), patches.size());
+    for (size_t i = 0; i < patches.size(); i++)
+      EXPECT_NEAR(RegionArea(regions[i]), RegionArea(expected[i]), 1e-6);
+    EXPECT_NEAR(RegionArea(covered), RegionArea(all_covered), 1e-6);
+
+    // A patch list starting the same way reuses the common prefix only, and
+    // gives the same regions as a fresh composition.
+    auto changed = patches;
+    changed[2].used = false;
+    changed.pop_back();
+    regions = ComposeRegions(cache, changed, subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), 2u);
+    QuiltRegionCache fresh;
+    LLRegion fresh_covered;
+    expected = ComposeRegions(fresh, changed, subtract, fresh_covered);
+    for (size_t i = 0; i < changed.size(); i++)
+      EXPECT_NEAR(RegionArea(regions[i]), RegionArea(expected[i]), 1e-6)
+          << "patch " << i << (subtract ? " subtracting" : "");
+    EXPECT_NEAR(RegionArea(covered), RegionArea(fresh_covered), 1e-6);
+    EXPECT_TRUE(regions[2].Empty());
+
+    // Changing the mode drops the cache.
+    ComposeRegions(cache, patches, !subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), 0u);
+
+    // So does clearing it, and a new chart database generation.
+    ComposeRegions(cache, patches, subtract, covered);
+    cache.Clear();
+    ComposeRegions(cache, patches, subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), 0u);
+    auto rebuilt = patches;
+    for (auto& patch : rebuilt) patch.generation = 2;
+    regions = ComposeRegions(cache, rebuilt, subtract, covered);
+    EXPECT_EQ(cache.GetReusedCount(), 0u);
+    QuiltRegionCache rebuilt_fresh;
+    expected = ComposeRegions(rebuilt_fresh, rebuilt, subtract, fresh_covered);
+    for (size_t i = 0; i < patches.size(); i++)
+      EXPECT_NEAR(RegionArea(regions[i]), RegionArea(expected[i]), 1e-6);
+  }
+}
+
+/** Encode runs of (color index, count) as a BSB row, line number first. */
+static std::vector<unsigned char> EncodeBsbRow(
+    int color_size, const std::vector<std::pair<int, int>>& runs) {
+  std::vector<unsigned char> row = {1};
+  int count_bits = 7 - color_size;
+  for (const auto& run : runs) {
+    unsigned n = run.second - 1;
+    int groups = 0;
+    while ((n >> (count_bits + 7 * groups)) != 0) groups++;
+    unsigned char first = (run.first << count_bits) |
+                          ((n >> (7 * groups)) & ((1 << count_bits) - 1));
+    row.push_back(first | (groups ? 0x80 : 0));
+    for (int g = groups - 1; g >= 0; g--)
+      row.push_back(((n >> (7 * g)) & 0x7f) | (g ? 0x80 : 0));
+  }
+  row.push_back(0);
+  return row;
+}
+
+TEST(Raster, ExpandBsb) {
+  Raster_ResolveRoutines();
+  const int color_size = 4;
+  int palette[16];
+  for (int i = 0; i < 16; i++) palette[i] = 0x10305 * i + 0x203040 * (i & 1);
+  unsigned seed = 3;
+  auto random = [&seed](int max) {
+    seed = seed * 1103515245 + 12345;
+    return int((seed >> 8) % max);
+  };
+  for (int t = 0; t < 200; t++) {
+    std::vector<std::pair<int, int>> runs;
+    std::vector<int> pixels;
+    while (pixels.size() < 3000) {
+      int count = 1 + (t % 2 ? random(40) : random(2000));
+      runs.push_back({1 + random(15), count});
+      pixels.insert(pixels.end(), count, runs.back().first);
+    }
+    std::vector<unsigned char> row = EncodeBsbRow(color_size, runs);
+    int xs = random(1000), xl = xs + 1 + random(2000);
+    std::vector<unsigned char> rgb((xl - xs) * 3, 0xaa);
+    Raster_ExpandBSB_24(row.data() + 1, row.data() + row.size(), 0, xs, xl,
+                        color_size, palette, rgb.data());
+    for (int x = xs; x < xl; x++) {
+      int expected = palette[pixels[x]];
+      const unsigned char* p = &rgb[(x - xs) * 3];
+      ASSERT_EQ(p[0] | p[1] << 8 | p[2] << 16, expected) << "x " << x;
+    }
+  }
+}
+
+TEST(Raster, SumRows) {
+  Raster_ResolveRoutines();
+  // Widths that leave 0, 1 and 2 pixels past the last full vector.
+  for (int width : {6, 11, 301}) {
+    const int n = width * 3, rows = 5, stride = n + 7;
+    std::vector<unsigned char> source(stride * rows);
+    for (size_t i = 0; i < source.size(); i++) source[i] = (i * 7919) % 251;
+    std::vector<uint16_t> sums(n + 8, 0xCDCD);
+    Raster_SumRows_24(source.data(), stride, rows, width, sums.data());
+    for (int i = 0; i < n; i++) {
+      unsigned sum = 0;
+      for (int r = 0; r < rows; r++) sum += source[r * stride + i];
+      EXPECT_EQ(sums[i], sum) << "width " << width << " byte " << i;
+    }
+    EXPECT_EQ(sums[n], 0xCDCD) << "width " << width;
+  }
+}
+
+TEST(Raster, BoxFilter) {
+  Raster_ResolveRoutines();
+  // Large boxes are summed in several passes and divided the slow way.
+  for (int width : {6, 11, 301}) {
+    for (int size : {2, 3, 40, 300}) {
+      double factor = size * 0.9;
+      std::vector<unsigned char> source(width * size * 3);
+      for (size_t i = 0; i < source.size(); i++) source[i] = (i * 7919) % 251;
+      int target_width = std::max(int(width / factor + 0.5), 1);
+      std::vector<unsigned char> target(target_width * 3);
+      std::vector<uint32_t> work(Raster_BoxFilterWorkSize(width),
+                                 0xCDCDCDCD);
+      Raster_BoxFilter_24(source.data(), width, size, factor, width,
+                          target_width, target.data(), work.data());
+      for (int x = 0; x < target_width; x++) {
+        int c0 = int(x * factor), c1 = std::min(c0 + size, width);
+        for (int c = 0; c < 3; c++) {
+          unsigned sum = 0;
+          for (int r = 0; r < size; r++)
+            for (int col = c0; col < c1; col++)
+              sum += source[(r * width + col) * 3 + c];
+          int expected = c0 < width ? sum / (size * (c1 - c0)) : 0;
+          EXPECT_EQ(target[x * 3 + c], expected)
+              << "width " << width << " size " << size << " x " << x;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Project lat, lon to pixels one point at a time, like
+ * ViewPort::GetDoublePixFromLL() with the center at 500, 400.
+ */
+static void ReferencePix(LLProjector::Type type, double clat, double clon,
+                         double ppm, double rotation, double lat, double lon,
+                         double* x, double* y) {
+  double xlon = lon;
+  if (xlon * clon < 0.) xlon += xlon < 0. ? 360. : -360.;
+  if (fabs(xlon - clon) > 180.) xlon += xlon > clon ? -360. : 360.;
+  double e = 0, n = 0, ce, cn, c0, c1;
+  switch (type) {
+    case LLProjector::Type::kMercator:
+      toSMcache(lat, xlon, toSMcache_y30(clat), clon, &e, &n);
+      break;
+    case LLProjector::Type::kTransverseMercator:
+      toTM(clat, clon, 0., clon, &ce, &cn);
+      toTM(lat, xlon, 0., clon, &e, &n);
+      e -= ce;
+      n -= cn;
+      break;
+    case LLProjector::Type::kPolyconic:
+      toPOLY(clat, clon, 0., clon, &ce, &cn);
+      toPOLY(lat, xlon, 0., clon, &e, &n);
+      n -= cn;
+      break;
+    case LLProjector::Type::kOrthographic:
+      cache_phi0(clat, &c0, &c1);
+      toORTHO(lat, xlon, c0, c1, clon, &e, &n);
+      break;
+    case LLProjector::Type::kPolar:
+      toPOLAR(lat, xlon, toPOLARcache_e(clat), clat, clon, &e, &n);
+      break;
+    case LLProjector::Type::kStereographic:
+      cache_phi0(clat, &c0, &c1);
+      toSTEREO(lat, xlon, c0, c1, clon, &e, &n);
+      break;
+    case LLProjector::Type::kGnomonic:
+      cache_phi0(clat, &c0, &c1);
+      toGNO(lat, xlon, c0, c1, clon, &e, &n);
+      break;
+    case LLProjector::Type::kEquirectangular:
+      toEQUIRECT(lat, xlon, clat, clon, &e, &n);
+      break;
+  }
+  double epix = e * ppm, npix = n * ppm;
+  *x = 500. + epix * cos(rotation) + npix * sin(rotation);
+  *y = 400. - (npix * cos(rotation) - epix * sin(rotation));
+}
+
+TEST(LLProjector, Project) {
+  // Each projection, rotated or not, also across the antimeridian.
+  const double centers[][2] = {{60., 10.}, {-20., 178.}};
+  const double ppm = 0.01;
+  const size_t n = 1000;
+  for (const auto& center : centers) {
+    const double clat = center[0], clon = center[1];
+    std::vector<double> lat(n), lon(n);
+    for (size_t i = 0; i < n; i++) {
+      lat[i] = clat + 4. * sin(i * 0.01);
+      lon[i] = clon + 4. * cos(i * 0.013);
+      if (lon[i] >= 180.) lon[i] -= 360.;
+    }
+    for (int type = 0; type < 8; type++) {
+      for (double rotation : {0., 0.3}) {
+        LLProjector projector(LLProjector::Type(type), clat, clon);
+        projector.SetTransform(ppm, rotation, 500., 400., 1.);
+        std::vector<float> out(2 * n);
+        projector.Project(lat.data(), lon.data(), n, out.data());
+        for (size_t i = 0; i < n; i++) {
+          double x, y;
+          ReferencePix(LLProjector::Type(type), clat, clon, ppm, rotation,
+                       lat[i], lon[i], &x, &y);
+          ASSERT_NEAR(out[2 * i], x, 1e-3)
+              << "type " << type << ", rotation " << rotation << ", " << i;
+          ASSERT_NEAR(out[2 * i + 1], y, 1e-3)
+              << "type " << type << ", rotation " << rotation << ", " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(MappedFile, ConcurrentWriter) {
+  // The texture cache maps its file while appending tiles to it.
+  auto path = fs::path(CMAKE_BINARY_DIR) / "mapped.bin";
+  FILE* f = fopen(path.string().c_str(), "wb+");
+  ASSERT_TRUE(f);
+  fwrite("abcdefgh", 1, 8, f);
+  fflush(f);
+  MappedFile map;
+  ASSERT_TRUE(map.Open(path.string()));
+  ASSERT_EQ(map.GetSize(), 8u);
+
+  fseek(f, 2, SEEK_SET);
+  fwrite("XY", 1, 2, f);
+  fseek(f, 0, SEEK_END);
+  fwrite("ijkl", 1, 4, f);
+  fflush(f);
+  EXPECT_EQ(std::string((const char*)map.GetData(), 8), "abXYefgh");
+  EXPECT_EQ(map.GetSize(), 8u);
+
+  ASSERT_TRUE(map.Open(path.string()));
+  EXPECT_EQ(std::string((const char*)map.GetData(), map.GetSize()),
+            "abXYefghijkl");
+  fclose(f);
+  map.Close();
+  fs::remove(path);
+}
+
+TEST(Georef, ConcurrentSolve) {
+  // Raster charts may be georeferenced from several threads.
+  const int n = 12;
+  std::vector<double> tx(n), ty(n), east(n), north(n);
+  for (int i = 0; i < n; i++) {
+    tx[i] = (i * 2731) % 8000;
+    ty[i] = (i * 1931) % 6000;
+    east[i] = 100000. + 3.1 * tx[i] + 0.02 * ty[i];
+    north[i] = 5000000. - 3.05 * ty[i] + 0.01 * tx[i];
+  }
+  auto solve = [&](double coeff[4][12]) {
+    GeoRef cp = {};
+    cp.count = n;
+    cp.tx = tx.data();
+    cp.ty = ty.data();
+    cp.lon = east.data();
+    cp.lat = north.data();
+    cp.pwx = coeff[0];
+    cp.pwy = coeff[1];
+    cp.wpx = coeff[2];
+    cp.wpy = coeff[3];
+    cp.txmax = 8000;
+    cp.tymax = 6000;
+    cp.lonmin = 100000.;
+    cp.lonmax = 100000. + 3.1 * 8000;
+    cp.latmin = 5000000. - 3.05 * 6000;
+    cp.latmax = 5000000.;
+    return Georef_Calculate_Coefficients_Proj(&cp);
+  };
+  double expected[4][12] = {};
+  ASSERT_EQ(solve(expected), 0);
+  EXPECT_NEAR(expected[0][1], 3.1, 1e-6);
+  EXPECT_NEAR(expected[1][2], -3.05, 1e-6);
+
+  std::vector<std::thread> threads;
+  std::vector<int> mismatches(4, 0);
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&, t] {
+      for (int rep = 0; rep < 200; rep++) {
+        double coeff[4][12] = {};
+        if (solve(coeff) != 0 ||
+            memcmp(coeff, expected, sizeof(expected)) != 0)
+          mismatches[t]++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int t = 0; t < 4; t++) EXPECT_EQ(mismatches[t], 0);
+}
+
+TEST(MappedFile, CopyOnWrite) {
+  // The ISO 8211 reader patches S-57 records in place when updating.
+  auto path = fs::path(CMAKE_BINARY_DIR) / "mapped_cow.bin";
+  FILE* f = fopen(path.string().c_str(), "wb");
+  ASSERT_TRUE(f);
+  fwrite("abcdefgh", 1, 8, f);
+  fclose(f);
+  MappedFile map;
+  ASSERT_TRUE(map.Open(path.string()));
+  EXPECT_EQ(map.GetWritableData(), nullptr);
+  ASSERT_TRUE(map.Open(path.string(), true));
+  unsigned char* data = map.GetWritableData();
+  ASSERT_NE(data, nullptr);
+  data[2] = 'X';
+  data[3] = 'Y';
+  EXPECT_EQ(std::string((const char*)map.GetData(), 8), "abXYefgh");
+
+  MappedFile other(path.string());
+  ASSERT_TRUE(other.IsOk());
+  EXPECT_EQ(std::string((const char*)other.GetData(), 8), "abcdefgh");
+  map.Close();
+  other.Close();
+  fs::remove(path);
+}
+
+/** Write an ISO 8211 file of n records, each a RECD and a NOTE field. */
+static void WriteDdfFile(const std::string& path, int n) {
+  DDFModule module;
+  module.Initialize();
+  auto recd = new DDFFieldDefn();
+  recd->Create("RECD", "Record", "", dsc_vector, dtc_mixed_data_type);
+  recd->AddSubfield("RCID", "b14");
+  recd->AddSubfield("NAME", "A");
+  module.AddField(recd);
+  auto note = new DDFFieldDefn();
+  note->Create("NOTE", "Note", "", dsc_vector, dtc_mixed_data_type);
+  note->AddSubfield("TEXT", "A");
+  module.AddField(note);
+  ASSERT_TRUE(module.Create(path.c_str()));
+  for (int i = 0; i < n; i++) {
+    DDFRecord record(&module);
+    record.AddField(recd);
+    record.SetIntSubfield("RECD", 0, "RCID", 0, i);
+    std::string name = "name" + std::to_string(i);
+    record.SetStringSubfield("RECD", 0, "NAME", 0, name.c_str());
+    record.AddField(note);
+    record.SetStringSubfield("NOTE", 0, "TEXT", 0, "note");
+    record.Write();
+  }
+  module.Close();
+}
+
+TEST(DDFModule, CopyOnWrite) {
+  auto path = fs::path(CMAKE_BINARY_DIR) / "ddf_cow.000";
+  WriteDdfFile(path.string(), 3);
+  for (int map_file : {TRUE, FALSE}) {
+    DDFModule module;
+    ASSERT_TRUE(module.Open(path.string().c_str(), FALSE, map_file));
+    EXPECT_EQ(module.GetMappedFile() != nullptr, map_file == TRUE);
+    DDFRecord* record = module.ReadRecord();
+    ASSERT_NE(record, nullptr);
+
+    // Edits in place, shrinking and growing a field.
+    DDFRecord* copy = record->Copy();
+    EXPECT_TRUE(copy->SetIntSubfield("RECD", 0, "RCID", 0, 42));
+    EXPECT_TRUE(copy->SetStringSubfield("RECD", 0, "NAME", 0, "abcde"));
+    DDFRecord* clone = record->Clone();
+    EXPECT_TRUE(clone->SetStringSubfield("RECD", 0, "NAME", 0, "ab"));
+    EXPECT_TRUE(clone->SetStringSubfield("NOTE", 0, "TEXT", 0, "longer"));
+    EXPECT_EQ(copy->GetIntSubfield("RECD", 0, "RCID", 0), 42);
+    EXPECT_STREQ(copy->GetStringSubfield("RECD", 0, "NAME", 0), "abcde");
+    EXPECT_STREQ(clone->GetStringSubfield("RECD", 0, "NAME", 0), "ab");
+    EXPECT_STREQ(clone->GetStringSubfield("NOTE", 0, "TEXT", 0), "longer");
+
+    // Growing a field keeps the data of the following ones.
+    DDFField* field = copy->FindField("RECD");
+    ASSERT_TRUE(copy->ResizeField(field, field->GetDataSize() + 4));
+    EXPECT_STREQ(copy->GetStringSubfield("NOTE", 0, "TEXT", 0), "note");
+
+    EXPECT_EQ(record->GetIntSubfield("RECD", 0, "RCID", 0), 0);
+    EXPECT_STREQ(record->GetStringSubfield("RECD", 0, "NAME", 0), "name0");
+    EXPECT_STREQ(record->GetStringSubfield("NOTE", 0, "TEXT", 0), "note");
+
+    // Editing the module record leaves the copies alone.
+    EXPECT_TRUE(record->SetStringSubfield("RECD", 0, "NAME", 0, "other"));
+    EXPECT_STREQ(copy->GetStringSubfield("RECD", 0, "NAME", 0), "abcde");
+    EXPECT_STREQ(clone->GetStringSubfield("RECD", 0, "NAME", 0), "ab");
+    delete copy;
+
+    // The file data is unchanged when read again.
+    module.Rewind();
+    record = module.ReadRecord();
+    ASSERT_NE(record, nullptr);
+    EXPECT_EQ(record->GetIntSubfield("RECD", 0, "RCID", 0), 0);
+    EXPECT_STREQ(record->GetStringSubfield("RECD", 0, "NAME", 0), "name0");
+    int count = 1;
+    while (module.ReadRecord()) count++;
+    EXPECT_EQ(count, 3);
+  }
+  fs::remove(path);
+}